@@ -45,11 +45,13 @@ SOURCES +=  \
     $$PWD/src/util/util.cpp \
     $$PWD/src/importexport/settingsauto.cpp \
     $$PWD/src/models/graphdatamodel.cpp \
+    $$PWD/src/models/timebasealigner.cpp \
     $$PWD/src/models/graphdata.cpp \
     $$PWD/src/communication/modbusresult.cpp \
     $$PWD/src/customwidgets/legend.cpp \
     $$PWD/src/dialogs/registerdialog.cpp \
     $$PWD/src/dialogs/registerconndelegate.cpp \
+    $$PWD/src/dialogs/registertypedelegate.cpp \
     $$PWD/src/customwidgets/verticalscrollareacontents.cpp \
     $$PWD/src/customwidgets/markerinfo.cpp \
     $$PWD/src/customwidgets/markerinfoitem.cpp \
@@ -72,8 +74,41 @@ SOURCES +=  \
     $$PWD/src/util/scopelogging.cpp \
     $$PWD/src/communication/modbusconnection.cpp \
     $$PWD/src/communication/readregisters.cpp \
+    $$PWD/src/communication/modbusudpclient.cpp \
+    $$PWD/src/communication/stimulusscheduler.cpp \
+    $$PWD/src/models/stimulus.cpp \
+    $$PWD/src/models/stimulusmodel.cpp \
+    $$PWD/src/communication/triggercapture.cpp \
+    $$PWD/src/models/triggercondition.cpp \
     $$PWD/src/importexport/datafilehandler.cpp \
-    $$PWD/src/importexport/projectfilehandler.cpp
+    $$PWD/src/importexport/projectfilehandler.cpp \
+    $$PWD/src/models/polltracemodel.cpp \
+    $$PWD/src/customwidgets/polltimeline.cpp \
+    $$PWD/src/customwidgets/polltimelinedock.cpp \
+    $$PWD/src/models/sampletimebase.cpp \
+    $$PWD/src/models/samplecolumn.cpp \
+    $$PWD/src/models/sampleseries.cpp \
+    $$PWD/src/graphview/samplegraph.cpp \
+    $$PWD/src/models/samplepyramid.cpp \
+    $$PWD/src/models/samplechunkstore.cpp \
+    $$PWD/src/models/samplespillfile.cpp \
+    $$PWD/src/models/samplecodec.cpp \
+    $$PWD/src/models/ingestfilter.cpp \
+    $$PWD/src/importexport/sessionfile.cpp \
+    $$PWD/src/importexport/sessionfilehandler.cpp \
+    $$PWD/src/importexport/livesegmentwriter.cpp \
+    $$PWD/src/importexport/livesegmentreader.cpp \
+    $$PWD/src/models/memoryforecast.cpp \
+    $$PWD/src/models/channelexpression.cpp \
+    $$PWD/src/models/signalfilter.cpp \
+    $$PWD/src/models/alarmrule.cpp \
+    $$PWD/src/communication/alarmmonitor.cpp \
+    $$PWD/src/models/runningstatistics.cpp \
+    $$PWD/src/models/statisticsmodel.cpp \
+    $$PWD/src/customwidgets/statisticsdock.cpp \
+    $$PWD/src/models/fftplan.cpp \
+    $$PWD/src/models/spectrumanalyzer.cpp \
+    $$PWD/src/customwidgets/spectrumdock.cpp
 
 FORMS    += \
     $$PWD/src/dialogs/connectiondialog.ui \
@@ -98,6 +133,7 @@ HEADERS += \
     $$PWD/src/dialogs/mainwindow.h \
     $$PWD/src/dialogs/registerdialog.h \
     $$PWD/src/dialogs/registerconndelegate.h \
+    $$PWD/src/dialogs/registertypedelegate.h \
     $$PWD/src/graphview/basicgraphview.h \
     $$PWD/src/graphview/extendedgraphview.h \
     $$PWD/src/models/guimodel.h \
@@ -109,6 +145,7 @@ HEADERS += \
     $$PWD/src/graphview/myqcustomplot.h \
     $$PWD/src/importexport/settingsauto.h \
     $$PWD/src/models/graphdatamodel.h \
+    $$PWD/src/models/timebasealigner.h \
     $$PWD/src/models/graphdata.h \
     $$PWD/src/communication/modbusresult.h \
     $$PWD/src/customwidgets/legend.h \
@@ -135,8 +172,42 @@ HEADERS += \
     $$PWD/src/util/scopelogging.h \
     $$PWD/src/communication/modbusconnection.h \
     $$PWD/src/communication/readregisters.h \
+    $$PWD/src/communication/modbusudpclient.h \
+    $$PWD/src/communication/stimulusscheduler.h \
+    $$PWD/src/models/stimulus.h \
+    $$PWD/src/models/stimulusmodel.h \
+    $$PWD/src/communication/triggercapture.h \
+    $$PWD/src/models/triggercondition.h \
     $$PWD/src/importexport/datafilehandler.h \
-    $$PWD/src/importexport/projectfilehandler.h
+    $$PWD/src/importexport/projectfilehandler.h \
+    $$PWD/src/models/polltracemodel.h \
+    $$PWD/src/customwidgets/polltimeline.h \
+    $$PWD/src/customwidgets/polltimelinedock.h \
+    $$PWD/src/models/sampletimebase.h \
+    $$PWD/src/models/samplecolumn.h \
+    $$PWD/src/models/sampleseries.h \
+    $$PWD/src/graphview/samplegraph.h \
+    $$PWD/src/models/samplepyramid.h \
+    $$PWD/src/models/samplechunkstore.h \
+    $$PWD/src/models/samplespillfile.h \
+    $$PWD/src/models/samplecodec.h \
+    $$PWD/src/models/ingestfilter.h \
+    $$PWD/src/importexport/sessionfile.h \
+    $$PWD/src/importexport/sessionfilehandler.h \
+    $$PWD/src/importexport/livesegmentdefinitions.h \
+    $$PWD/src/importexport/livesegmentwriter.h \
+    $$PWD/src/importexport/livesegmentreader.h \
+    $$PWD/src/models/memoryforecast.h \
+    $$PWD/src/models/channelexpression.h \
+    $$PWD/src/models/signalfilter.h \
+    $$PWD/src/models/alarmrule.h \
+    $$PWD/src/communication/alarmmonitor.h \
+    $$PWD/src/models/runningstatistics.h \
+    $$PWD/src/models/statisticsmodel.h \
+    $$PWD/src/customwidgets/statisticsdock.h \
+    $$PWD/src/models/fftplan.h \
+    $$PWD/src/models/spectrumanalyzer.h \
+    $$PWD/src/customwidgets/spectrumdock.h
 
 RESOURCES += \
     $$PWD/src/resources/resource.qrc
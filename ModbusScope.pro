@@ -5,4 +5,5 @@ CONFIG += ordered
 
 SUBDIRS += \
     src \
+    examples/livereader \
     tests_integration
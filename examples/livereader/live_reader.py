@@ -0,0 +1,119 @@
+#!/usr/bin/python3
+
+# Follows the live data of ModbusScope ("Publish live data to shared memory" in log settings)
+# Layout is described in src/importexport/livesegmentdefinitions.h
+#
+# Usage: live_reader.py [segment path]
+
+import math
+import mmap
+import os
+import struct
+import sys
+import tempfile
+import time
+
+MAGIC = 0x564C424D
+VERSION = 1
+
+HEADER = struct.Struct("=8I2Qq2I")
+CHANNEL = struct.Struct("=48sHHB11x")
+ROW_HEADER = struct.Struct("=Qq")
+
+
+class LiveSegmentReader:
+
+    def __init__(self, path):
+        self.path = path
+        self.map = None
+
+    def open(self):
+        self.close()
+        try:
+            with open(self.path, "rb") as segment_file:
+                self.map = mmap.mmap(segment_file.fileno(), 0, access=mmap.ACCESS_READ)
+        except (OSError, ValueError):
+            return False
+
+        (magic, version, _, channel_count, self.capacity, self.row_size,
+         channel_offset, self.ring_offset, self.generation, _, self.start_time, _, _) = HEADER.unpack_from(self.map, 0)
+
+        if magic != MAGIC or version != VERSION or self.generation & 1:
+            self.close()
+            return False
+
+        self.labels = []
+        for idx in range(channel_count):
+            label = CHANNEL.unpack_from(self.map, channel_offset + idx * CHANNEL.size)[0]
+            self.labels.append(label.split(b"\0", 1)[0].decode("utf-8"))
+
+        self.values = struct.Struct("={}d".format(channel_count))
+
+        if self.generation != self._read_u64(32):
+            self.close()
+            return False
+
+        return True
+
+    def close(self):
+        if self.map is not None:
+            self.map.close()
+            self.map = None
+
+    def is_layout_changed(self):
+        return self._read_u64(32) != self.generation
+
+    def write_count(self):
+        return self._read_u64(40)
+
+    def first_available_row(self):
+        return max(0, self.write_count() - self.capacity)
+
+    def read_row(self, row_idx):
+        """ Returns (timestamp, values) or None when row is overwritten """
+        offset = self.ring_offset + (row_idx % self.capacity) * self.row_size
+
+        sequence, timestamp = ROW_HEADER.unpack_from(self.map, offset)
+        values = self.values.unpack_from(self.map, offset + ROW_HEADER.size)
+
+        if sequence != row_idx + 1 or self._read_u64(offset) != row_idx + 1 or self.is_layout_changed():
+            return None
+
+        return timestamp, values
+
+    def _read_u64(self, offset):
+        return struct.unpack_from("=Q", self.map, offset)[0]
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(tempfile.gettempdir(), "ModbusScope-live.shm")
+
+    reader = LiveSegmentReader(path)
+    next_row = 0
+
+    while True:
+        if reader.map is None or reader.is_layout_changed():
+            if not reader.open():
+                time.sleep(0.5)
+                continue
+
+            print("Time (ms);" + ";".join(reader.labels))
+            next_row = reader.first_available_row()
+
+        while next_row < reader.write_count():
+            row = reader.read_row(next_row)
+            if row is not None:
+                timestamp, values = row
+                fields = [str(timestamp - reader.start_time)] + ["" if math.isnan(value) else str(value) for value in values]
+                print(";".join(fields))
+                next_row += 1
+            elif next_row < reader.first_available_row():
+                next_row = reader.first_available_row()
+            else:
+                break
+
+        time.sleep(0.01)
+
+
+if __name__ == "__main__":
+    main()
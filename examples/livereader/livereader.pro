@@ -0,0 +1,18 @@
+QT = core
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+TARGET = livereader
+TEMPLATE = app
+
+INCLUDEPATH += \
+    $$PWD/../../src/importexport
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$PWD/../../src/importexport/livesegmentreader.cpp
+
+HEADERS += \
+    $$PWD/../../src/importexport/livesegmentdefinitions.h \
+    $$PWD/../../src/importexport/livesegmentreader.h
@@ -0,0 +1,81 @@
+
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QThread>
+#include <QStringList>
+
+#include "livesegmentreader.h"
+
+/*
+ * Follows the live data of ModbusScope ("Publish live data to shared memory" in log settings)
+ * and prints every row as it is polled.
+ *
+ * Usage: livereader [segment path]
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    const QString filePath = app.arguments().size() > 1 ? app.arguments()[1] : LiveSegmentDefinitions::defaultPath();
+
+    LiveSegmentReader reader;
+    quint64 nextRow = 0;
+
+    while (true)
+    {
+        if (!reader.isOpen() || reader.isLayoutChanged())
+        {
+            if (!reader.open(filePath))
+            {
+                /* ModbusScope isn't publishing (yet) */
+                QThread::msleep(500);
+                continue;
+            }
+
+            QStringList labels;
+            for (qint32 channelIdx = 0; channelIdx < reader.channelCount(); channelIdx++)
+            {
+                labels.append(reader.label(channelIdx));
+            }
+            out << "Time (ms);" << labels.join(";") << endl;
+
+            nextRow = reader.firstAvailableRow();
+        }
+
+        const quint64 writeCount = reader.writeCount();
+        while (nextRow < writeCount)
+        {
+            qint64 timestamp;
+            QList<double> values;
+
+            if (reader.readRow(nextRow, &timestamp, &values))
+            {
+                QStringList fields;
+                fields.append(QString::number(timestamp - reader.startTime()));
+                for (qint32 idx = 0; idx < values.size(); idx++)
+                {
+                    fields.append(QString::number(values[idx]));
+                }
+                out << fields.join(";") << endl;
+
+                nextRow++;
+            }
+            else if (nextRow < reader.firstAvailableRow())
+            {
+                /* Too slow: rows are overwritten, continue with oldest row */
+                out << "# skipped " << reader.firstAvailableRow() - nextRow << " rows" << endl;
+                nextRow = reader.firstAvailableRow();
+            }
+            else
+            {
+                /* Layout changed, segment is reopened */
+                break;
+            }
+        }
+
+        QThread::msleep(10);
+    }
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include <QDateTime>
+#include <QtNumeric>
+#include <QProcess>
+#include <QDebug>
+
+#include "settingsmodel.h"
+#include "graphdatamodel.h"
+
+#include "alarmmonitor.h"
+
+AlarmMonitor::AlarmMonitor(SettingsModel * pSettingsModel, GraphDataModel * pGraphDataModel, QObject *parent) :
+    QObject(parent)
+{
+    _pSettingsModel = pSettingsModel;
+    _pGraphDataModel = pGraphDataModel;
+
+    _activeAlarmCount = 0;
+    _alarmCount = 0;
+    _bCommandFailed = false;
+}
+
+/*!
+ * Start monitoring with current alarm rules of active graphs
+ */
+void AlarmMonitor::start()
+{
+    _monitoredGraphs.clear();
+    _activeAlarmCount = 0;
+    _alarmCount = 0;
+    _bCommandFailed = false;
+    _command = _pSettingsModel->alarmCommand();
+
+    /* Samples are ordered as active graph list */
+    QList<quint16> activeIndexList;
+    _pGraphDataModel->activeGraphIndexList(&activeIndexList);
+
+    for (qint32 idx = 0; idx < activeIndexList.size(); idx++)
+    {
+        const AlarmRule rule = _pGraphDataModel->alarmRule(activeIndexList[idx]);
+
+        if (rule.isEnabled())
+        {
+            MonitoredGraph monitoredGraph;
+            monitoredGraph.activeIdx = idx;
+            monitoredGraph.graphIdx = activeIndexList[idx];
+            monitoredGraph.bRawValue = !_pGraphDataModel->isVirtual(activeIndexList[idx]);
+            monitoredGraph.rule = rule;
+            monitoredGraph.rule.reset();
+
+            _monitoredGraphs.append(monitoredGraph);
+        }
+    }
+}
+
+void AlarmMonitor::stop()
+{
+    _monitoredGraphs.clear();
+    _activeAlarmCount = 0;
+}
+
+/*!
+ * Number of alarms that are raised and not cleared yet
+ */
+qint32 AlarmMonitor::activeAlarmCount() const
+{
+    return _activeAlarmCount;
+}
+
+/*!
+ * Number of times an alarm is raised since start
+ */
+quint32 AlarmMonitor::alarmCount() const
+{
+    return _alarmCount;
+}
+
+/*!
+ * Return true when alarm command couldn't be started since start (see commandFailed)
+ */
+bool AlarmMonitor::isCommandFailed() const
+{
+    return _bCommandFailed;
+}
+
+void AlarmMonitor::handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    if (!_monitoredGraphs.isEmpty())
+    {
+        processSample(QDateTime::currentMSecsSinceEpoch(), successList, values, timestampList, rawValues);
+    }
+}
+
+/*!
+ * Check a new sample against the alarm rules
+ * \param timestamp     Time of sample (ms since epoch)
+ * \param successList   Success of each active register
+ * \param values        Value of each active register
+ * \param timestampList Raw timestamp of each active register (empty: all registers are sampled on timestamp)
+ * \param rawValues     Raw register value of each active register, used by bit rules (empty: integer part of value)
+ */
+void AlarmMonitor::processSample(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    for (qint32 idx = 0; idx < _monitoredGraphs.size(); idx++)
+    {
+        MonitoredGraph &monitoredGraph = _monitoredGraphs[idx];
+        const qint32 activeIdx = monitoredGraph.activeIdx;
+
+        /* Failed read doesn't change alarm state */
+        if ((activeIdx >= successList.size()) || (activeIdx >= values.size()) || !successList[activeIdx])
+        {
+            continue;
+        }
+
+        const qint64 sampleTime = activeIdx < timestampList.size() ? timestampList[activeIdx] : timestamp;
+        const double value = values[activeIdx];
+        quint32 rawValue;
+
+        if (monitoredGraph.bRawValue && (activeIdx < rawValues.size()))
+        {
+            rawValue = rawValues[activeIdx];
+        }
+        else
+        {
+            /* Virtual channel has no register bits */
+            rawValue = qIsFinite(value) ? static_cast<quint32>(static_cast<qint64>(value)) : 0;
+        }
+
+        const AlarmRule::Transition transition = monitoredGraph.rule.process(static_cast<double>(sampleTime), value, rawValue);
+
+        if (transition == AlarmRule::TRANSITION_RAISED)
+        {
+            _activeAlarmCount++;
+            _alarmCount++;
+
+            if (!_command.isEmpty())
+            {
+                startCommand(monitoredGraph, sampleTime, value);
+            }
+
+            emit alarmRaised(monitoredGraph.graphIdx, sampleTime, value);
+        }
+        else if (transition == AlarmRule::TRANSITION_CLEARED)
+        {
+            _activeAlarmCount--;
+
+            emit alarmCleared(monitoredGraph.graphIdx, sampleTime, value);
+        }
+        else
+        {
+            // Alarm state is unchanged
+        }
+    }
+}
+
+void AlarmMonitor::startCommand(const MonitoredGraph &monitoredGraph, qint64 timestamp, double value)
+{
+    const QStringList arguments = QStringList() << _pGraphDataModel->label(monitoredGraph.graphIdx)
+                                                << monitoredGraph.rule.toString()
+                                                << QString::number(value, 'g', 10)
+                                                << QDateTime::fromMSecsSinceEpoch(timestamp).toString(Qt::ISODateWithMs);
+
+    /* Detached: acquisition isn't blocked by command */
+    if (!QProcess::startDetached(_command, arguments))
+    {
+        qWarning() << QString("AlarmMonitor: command (%1) couldn't be started").arg(_command);
+
+        _bCommandFailed = true;
+        emit commandFailed(_command);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef ALARMMONITOR_H
+#define ALARMMONITOR_H
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+
+#include "alarmrule.h"
+
+//Forward declaration
+class SettingsModel;
+class GraphDataModel;
+
+/*!
+ * Checks the alarm rules of the active graphs on the sample stream of the communication manager
+ *
+ * The monitor is connected directly to the communication manager, so every value is checked as soon as
+ * it is processed: before triggered capture and independent of plotting (throttled replot or hidden plot).
+ * The rules are copied at start, so the rules of the graphs can be edited while logging without affecting
+ * the monitor. When a rule is raised, the optional alarm command is started as a detached process with
+ * label, rule, value and time of the sample as arguments.
+ */
+class AlarmMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AlarmMonitor(SettingsModel * pSettingsModel, GraphDataModel * pGraphDataModel, QObject *parent = nullptr);
+
+    void start();
+    void stop();
+
+    qint32 activeAlarmCount() const;
+    quint32 alarmCount() const;
+    bool isCommandFailed() const;
+
+    void processSample(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList = QList<qint64>(), QList<quint32> rawValues = QList<quint32>());
+
+public slots:
+    void handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+
+signals:
+    void alarmRaised(quint32 graphIdx, qint64 timestamp, double value);
+    void alarmCleared(quint32 graphIdx, qint64 timestamp, double value);
+    void commandFailed(QString command);
+
+private:
+
+    typedef struct
+    {
+        qint32 activeIdx;
+        quint32 graphIdx;
+        bool bRawValue; /* false for virtual channel */
+        AlarmRule rule;
+    } MonitoredGraph;
+
+    void startCommand(const MonitoredGraph &monitoredGraph, qint64 timestamp, double value);
+
+    SettingsModel * _pSettingsModel;
+    GraphDataModel * _pGraphDataModel;
+
+    QVector<MonitoredGraph> _monitoredGraphs;
+    QString _command;
+
+    qint32 _activeAlarmCount;
+    quint32 _alarmCount;
+
+    /* Alarm command couldn't be started since start */
+    bool _bCommandFailed;
+};
+
+#endif // ALARMMONITOR_H
@@ -22,10 +22,19 @@ CommunicationManager::CommunicationManager(SettingsModel * pSettingsModel, GuiMo
     /* Setup modbus master */
     for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
     {
+        _endpointGroups.append(QList<quint8>() << i);
+
         auto modbusData = new ModbusMasterData(new ModbusMaster(_pSettingsModel, i));
         _modbusMasters.append(modbusData);
 
         connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusPollDone, this, &CommunicationManager::handlePollDone);
+        connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusWriteDone, this, &CommunicationManager::handleWriteDone);
+        connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusTraceEvent, this, &CommunicationManager::traceEvent);
+
+        connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusFailover,
+            [=](QString ipAddress, qint64 timestamp, quint8 connectionId){
+                emit connectionFailover(connectionId, ipAddress, timestamp);
+            });
 
         connect(_modbusMasters.last()->pModbusMaster, SIGNAL(modbusLogError(QString)), this, SLOT(handleModbusError(QString)));
         connect(_modbusMasters.last()->pModbusMaster, SIGNAL(modbusLogInfo(QString)), this, SLOT(handleModbusInfo(QString)));
@@ -91,31 +100,63 @@ void CommunicationManager::handlePollDone(QMap<quint16, ModbusResult> partialRes
         lastResult = true;
     }
 
+    // Raw timestamp of this connection: samples of different connections are not aligned here
+    const qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
     // Always add data to result map
-    QMapIterator<quint16, ModbusResult> i(partialResultMap);
-    while (i.hasNext())
+    for(quint16 listIdx = 0; listIdx < _activeIndexList.size(); listIdx++)
     {
-        i.next();
-
-        for(quint16 listIdx = 0; listIdx < _activeIndexList.size(); listIdx++)
+        const quint16 activeIndex = _activeIndexList[listIdx];
+        const quint16 registerAddress = _pGraphDataModel->registerAddress(activeIndex);
+
+        // Results of a merged read are fanned out to all connections with the same endpoint
+        if (
+            !_pGraphDataModel->isVirtual(activeIndex)
+            && _endpointGroups[connectionId].contains(_pGraphDataModel->connectionId(activeIndex))
+            && partialResultMap.contains(registerAddress)
+        )
         {
-            const quint16 activeIndex = _activeIndexList[listIdx];
-            if (_pGraphDataModel->connectionId(activeIndex) == connectionId)
+            const ModbusResult result = partialResultMap.value(registerAddress);
+
+            if (_pGraphDataModel->isRegisterPair(activeIndex))
             {
-                if (_pGraphDataModel->registerAddress(activeIndex) == i.key())
-                {
-                    ModbusResult result = i.value();
-                    _processedValues[listIdx] = processValue(activeIndex, result.value());
-                    _successList[listIdx] = result.isSuccess();
-                }
+                // Both registers are read in the same request
+                const ModbusResult secondResult = partialResultMap.value(static_cast<quint16>(registerAddress + 1), ModbusResult(0, false));
+
+                _rawValues[listIdx] = GraphData::packRegisterPair(result.value(), secondResult.value());
+                _successList[listIdx] = result.isSuccess() && secondResult.isSuccess();
+            }
+            else
+            {
+                _rawValues[listIdx] = result.value();
+                _successList[listIdx] = result.isSuccess();
             }
+
+            // Errors are kept as raw value 0, so they are shown as 0 whatever the settings
+            if (!_successList[listIdx])
+            {
+                _rawValues[listIdx] = 0;
+            }
+
+            _processedValues[listIdx] = _pGraphDataModel->processValue(activeIndex, _rawValues[listIdx]);
+
+            _timestampList[listIdx] = timestamp;
         }
     }
 
     if (lastResult)
     {
+        // Virtual channels are computed from the processed values of all connections
+        _pGraphDataModel->evaluateVirtualChannels(&_successList, &_processedValues, &_timestampList);
+
         // propagate processed data
-        emit handleReceivedData(_successList, _processedValues);
+        emit handleReceivedData(_successList, _processedValues, _timestampList, _rawValues);
+
+        // Data is handled synchronously, so this marks the end of processing in the application
+        for (qint32 idx = 0; idx < _pollConnectionList.size(); idx++)
+        {
+            emit traceEvent(_pollConnectionList[idx], PollTraceModel::PROCESSED, 0, 0);
+        }
     }
 
     // Set master as inactive
@@ -160,6 +201,12 @@ void CommunicationManager::stopCommunication()
 {
     _active = false;
     _pPollTimer->stop();
+
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+    {
+        _modbusMasters[i]->pModbusMaster->closeStandbyConnection();
+    }
+
     _pGuiModel->setCommunicationEndTime(QDateTime::currentMSecsSinceEpoch());
 }
 
@@ -168,6 +215,36 @@ bool CommunicationManager::isActive()
     return _active;
 }
 
+/*!
+ * Write holding register(s) on a connection
+ * The write is inserted in the request pipeline of the connection, result is reported with registerWritten signal
+ *
+ * \param connectionId        Connection id
+ * \param registerAddress     Address of first register
+ * \param registerDataList    Values to write
+ * \return false when communication isn't active
+ */
+bool CommunicationManager::writeRegister(quint8 connectionId, quint16 registerAddress, QList<quint16> registerDataList)
+{
+    if (
+        _active
+        && (connectionId < SettingsModel::CONNECTION_ID_CNT)
+        && !registerDataList.isEmpty()
+    )
+    {
+        _modbusMasters[endpointOwner(connectionId)]->pModbusMaster->writeRegister(registerAddress, registerDataList);
+
+        return true;
+    }
+
+    return false;
+}
+
+void CommunicationManager::handleWriteDone(quint16 registerAddress, QList<quint16> registerDataList, bool bSuccess, qint64 timestamp, quint8 connectionId)
+{
+    emit registerWritten(connectionId, registerAddress, registerDataList, bSuccess, timestamp);
+}
+
 void CommunicationManager::readData()
 {
     if(_active)
@@ -176,13 +253,17 @@ void CommunicationManager::readData()
 
         /* Prepare result lists */
         _processedValues.clear();
+        _rawValues.clear();
         _successList.clear();
+        _timestampList.clear();
         _pGraphDataModel->activeGraphIndexList(&_activeIndexList);
 
         for(int idx = 0; idx < _activeIndexList.size(); idx++)
         {
             _processedValues.append(0);
+            _rawValues.append(0);
             _successList.append(false);
+            _timestampList.append(_lastPollStart);
         }
 
         /* Strange construction is required to avoid race condition:
@@ -194,18 +275,66 @@ void CommunicationManager::readData()
          */
 
         _activeMastersCount = 0;
+        _pollConnectionList.clear();
 
         QList<QList<quint16> > regAddrList;
+        QList<QList<quint16> > pairStartList;
 
         for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
         {
             regAddrList.append(QList<quint16>());
+            pairStartList.append(QList<quint16>());
 
             _pGraphDataModel->activeGraphAddresList(&regAddrList.last(), i);
+            _pGraphDataModel->activeGraphPairList(&pairStartList.last(), i);
+        }
+
+        /* Connections with the same endpoint share one master: merge their reads in the first connection */
+        QList<QList<quint8> > endpointGroups;
+        for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+        {
+            endpointGroups.append(QList<quint8>() << i);
 
-            if (regAddrList.last().count() > 0)
+            for (quint8 ownerId = 0u; ownerId < i; ownerId++)
+            {
+                if (
+                    (regAddrList.at(ownerId).count() > 0)
+                    && (regAddrList.at(i).count() > 0)
+                    && _pSettingsModel->isSameEndpoint(ownerId, i)
+                )
+                {
+                    mergeAddressList(&regAddrList[ownerId], regAddrList.at(i));
+                    mergeAddressList(&pairStartList[ownerId], pairStartList.at(i));
+
+                    regAddrList[i].clear();
+                    pairStartList[i].clear();
+
+                    endpointGroups[ownerId].append(i);
+                    endpointGroups[i].clear();
+                    break;
+                }
+            }
+        }
+
+        if (endpointGroups != _endpointGroups)
+        {
+            for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+            {
+                for (qint32 idx = 1; idx < endpointGroups.at(i).size(); idx++)
+                {
+                    handleModbusInfo(QString("[Conn %0] Same endpoint as connection %1: reads are merged").arg(endpointGroups.at(i).at(idx)).arg(i));
+                }
+            }
+
+            _endpointGroups = endpointGroups;
+        }
+
+        for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+        {
+            if (regAddrList.at(i).count() > 0)
             {
                 _activeMastersCount++;
+                _pollConnectionList.append(i);
             }
         }
 
@@ -214,7 +343,7 @@ void CommunicationManager::readData()
             if (regAddrList.at(i).count() > 0)
             {
                 _modbusMasters[i]->bActive = true;
-                _modbusMasters[i]->pModbusMaster->readRegisterList(regAddrList.at(i));
+                _modbusMasters[i]->pModbusMaster->readRegisterList(regAddrList.at(i), pairStartList.at(i));
             }
         }
 
@@ -222,52 +351,34 @@ void CommunicationManager::readData()
 
 }
 
-double CommunicationManager::processValue(quint32 graphIndex, quint16 value)
+/*!
+ * Get connection whose master handles the requests of a connection (connections with same endpoint are merged)
+ */
+quint8 CommunicationManager::endpointOwner(quint8 connectionId)
 {
-    double processedValue = 0;
-
-    if (_pGraphDataModel->isUnsigned(graphIndex))
-    {
-        processedValue = value;
-    }
-    else
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
     {
-        processedValue = static_cast<qint16>(value);
+        if (_endpointGroups.at(i).contains(connectionId))
+        {
+            return i;
+        }
     }
 
-    // Apply bitmask
-    if (_pGraphDataModel->isUnsigned(graphIndex))
-    {
-        processedValue = static_cast<quint16>(processedValue) & _pGraphDataModel->bitmask(graphIndex);
-    }
-    else
-    {
-        processedValue = static_cast<qint16>(static_cast<qint16>(processedValue) & _pGraphDataModel->bitmask(graphIndex));
-    }
+    return connectionId;
+}
 
-    // Apply shift
-    if (_pGraphDataModel->shift(graphIndex) != 0)
+/*!
+ * Add addresses of source list that are not yet in target list, target list stays sorted
+ */
+void CommunicationManager::mergeAddressList(QList<quint16> * pTargetList, QList<quint16> sourceList)
+{
+    for (qint32 idx = 0; idx < sourceList.size(); idx++)
     {
-        if (_pGraphDataModel->shift(graphIndex) > 0)
+        if (!pTargetList->contains(sourceList.at(idx)))
         {
-            processedValue = static_cast<qint16>(processedValue) << _pGraphDataModel->shift(graphIndex);
-        }
-        else
-        {
-            processedValue = static_cast<qint16>(processedValue) >> abs(_pGraphDataModel->shift(graphIndex));
-        }
-
-        if (!_pGraphDataModel->isUnsigned(graphIndex))
-        {
-            processedValue = static_cast<qint16>(processedValue);
+            pTargetList->append(sourceList.at(idx));
         }
     }
 
-    // Apply multiplyFactor
-    processedValue *= _pGraphDataModel->multiplyFactor(graphIndex);
-
-    // Apply divideFactor
-    processedValue /= _pGraphDataModel->divideFactor(graphIndex);
-
-    return processedValue;
+    qSort(*pTargetList);
 }
@@ -43,25 +43,37 @@ public:
     bool isActive();
     void resetCommunicationStats();
 
+    bool writeRegister(quint8 connectionId, quint16 registerAddress, QList<quint16> registerDataList);
+
 signals:
-    void handleReceivedData(QList<bool> successList, QList<double> values);
+    void handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+    void registerWritten(quint8 connectionId, quint16 registerAddress, QList<quint16> registerDataList, bool bSuccess, qint64 timestamp);
+    void traceEvent(quint8 connectionId, PollTraceModel::EventType type, quint16 address, quint16 count);
+    void connectionFailover(quint8 connectionId, QString ipAddress, qint64 timestamp);
 
 private slots:
     void handlePollDone(QMap<quint16, ModbusResult> resultMap, quint8 connectionId);
     void handleModbusError(QString msg);
     void handleModbusInfo(QString msg);
+    void handleWriteDone(quint16 registerAddress, QList<quint16> registerDataList, bool bSuccess, qint64 timestamp, quint8 connectionId);
     void readData();
 
 private:
 
-   double processValue(quint32 graphIndex, quint16 value);
+   quint8 endpointOwner(quint8 connectionId);
+
+   static void mergeAddressList(QList<quint16> * pTargetList, QList<quint16> sourceList);
 
     QList<ModbusMasterData *> _modbusMasters;
     quint32 _activeMastersCount;
 
     QList<double> _processedValues;
+    QList<quint32> _rawValues;
     QList<bool> _successList;
+    QList<qint64> _timestampList;
     QList<quint16> _activeIndexList;
+    QList<quint8> _pollConnectionList;
+    QList<QList<quint8> > _endpointGroups;
 
     bool _active;
     QTimer * _pPollTimer;
@@ -18,8 +18,9 @@ ModbusConnection::ModbusConnection(QObject *parent) : QObject(parent)
  * \param[in]   ip          IP address of server
  * \param[in]   port        Port on the server
  * \param[in]   timeout     Timeout of connection (in seconds)
+ * \param[in]   bUdp        Use Modbus/UDP instead of Modbus/TCP
  */
-void ModbusConnection::openConnection(QString ip, qint32 port, quint32 timeout)
+void ModbusConnection::openConnection(QString ip, qint32 port, quint32 timeout, bool bUdp)
 {
     if (connectionState() == QModbusDevice::ConnectedState)
     {
@@ -28,29 +29,37 @@ void ModbusConnection::openConnection(QString ip, qint32 port, quint32 timeout)
     }
     else
     {
-        auto connectionData = QPointer<ConnectionData>(new ConnectionData());
+        auto connectionData = QPointer<ConnectionData>(new ConnectionData(bUdp));
 
         connect(&connectionData->connectionTimeoutTimer, &QTimer::timeout, this, &ModbusConnection::connectionTimeOut);
-        connect(&connectionData->modbusClient, &QModbusTcpClient::stateChanged, this, &ModbusConnection::handleConnectionStateChanged);
-        connect(&connectionData->modbusClient, &QModbusTcpClient::errorOccurred, this, &ModbusConnection::handleConnectionErrorOccurred);
+        connect(connectionData->pModbusClient, &QModbusDevice::stateChanged, this, &ModbusConnection::handleConnectionStateChanged);
+        connect(connectionData->pModbusClient, &QModbusDevice::errorOccurred, this, &ModbusConnection::handleConnectionErrorOccurred);
 
-        connectionData->modbusClient.setNumberOfRetries(0);
-        connectionData->modbusClient.setTimeout(static_cast<int>(timeout));
+        if (bUdp)
+        {
+            // Lost datagrams are retransmitted within the timeout
+            connectionData->pTransport->setNumberOfRetries(_cUdpRetransmissions);
+        }
+        else
+        {
+            connectionData->pTransport->setNumberOfRetries(0);
+        }
+        connectionData->pTransport->setTimeout(static_cast<int>(timeout));
 
-        connectionData->modbusClient.setConnectionParameter(QModbusDevice::NetworkAddressParameter, QVariant(ip));
-        connectionData->modbusClient.setConnectionParameter(QModbusDevice::NetworkPortParameter, QVariant(port));
+        connectionData->pModbusClient->setConnectionParameter(QModbusDevice::NetworkAddressParameter, QVariant(ip));
+        connectionData->pModbusClient->setConnectionParameter(QModbusDevice::NetworkPortParameter, QVariant(port));
 
         _connectionList.append(QPointer<ConnectionData>(connectionData));
 
         qCDebug(scopeConnection) << "Connection start: " << _connectionList.last();
-        if (_connectionList.last()->modbusClient.connectDevice())
+        if (_connectionList.last()->pModbusClient->connectDevice())
         {
             _bWaitingForConnection = true;
             _connectionList.last()->connectionTimeoutTimer.start(static_cast<int>(timeout));
         }
         else
         {
-            auto pClient = &_connectionList.last()->modbusClient;
+            auto pClient = _connectionList.last()->pModbusClient;
             handleConnectionError(_connectionList.last(), QString("Connect failed: %0").arg(pClient->error()));
         }
     }
@@ -63,12 +72,12 @@ void ModbusConnection::closeConnection(void)
 {
     if (
             !_connectionList.isEmpty()
-            && _connectionList.last()->modbusClient.state() != QModbusDevice::UnconnectedState
+            && _connectionList.last()->pModbusClient->state() != QModbusDevice::UnconnectedState
         )
     {
         qCDebug(scopeConnection) << "Connection close: " << _connectionList.last();
         _connectionList.last()->connectionTimeoutTimer.stop();
-        _connectionList.last()->modbusClient.disconnectDevice();
+        _connectionList.last()->pModbusClient->disconnectDevice();
     }
 }
 
@@ -84,7 +93,8 @@ void ModbusConnection::sendReadRequest(quint32 regAddress, quint16 size, int ser
     if (connectionState() == QModbusDevice::ConnectedState)
     {
         QModbusDataUnit _dataUnit(QModbusDataUnit::HoldingRegisters, static_cast<int>(regAddress - 40001), size);
-        _connectionList.last()->pReply = _connectionList.last()->modbusClient.sendReadRequest(_dataUnit, serverAddress);
+        _connectionList.last()->pReply = _connectionList.last()->pTransport->sendReadRequest(_dataUnit, serverAddress);
+        _connectionList.last()->bWriteReply = false;
 
         connect(_connectionList.last()->pReply, &QModbusReply::finished, this, &ModbusConnection::handleRequestFinished);
     }
@@ -94,6 +104,30 @@ void ModbusConnection::sendReadRequest(quint32 regAddress, quint16 size, int ser
     }
 }
 
+/*!
+ * Send write request over connection
+ * A single register is written with function code 0x06, multiple registers with 0x10
+ *
+ * \param regAddress          register address
+ * \param registerDataList    values to write
+ * \param serverAddress       slave address
+ */
+void ModbusConnection::sendWriteRequest(quint32 regAddress, QList<quint16> registerDataList, int serverAddress)
+{
+    if (connectionState() == QModbusDevice::ConnectedState)
+    {
+        QModbusDataUnit _dataUnit(QModbusDataUnit::HoldingRegisters, static_cast<int>(regAddress - 40001), registerDataList.toVector());
+        _connectionList.last()->pReply = _connectionList.last()->pTransport->sendWriteRequest(_dataUnit, serverAddress);
+        _connectionList.last()->bWriteReply = true;
+
+        connect(_connectionList.last()->pReply, &QModbusReply::finished, this, &ModbusConnection::handleRequestFinished);
+    }
+    else
+    {
+        emit connectionError(QModbusDevice::WriteError, QString("Not connected"));
+    }
+}
+
 /*!
  *  Get state of connection
  *
@@ -107,7 +141,7 @@ QModbusDevice::State ModbusConnection::connectionState(void)
     }
     else
     {
-        return _connectionList.last()->modbusClient.state();
+        return _connectionList.last()->pModbusClient->state();
     }
 }
 
@@ -118,7 +152,7 @@ QModbusDevice::State ModbusConnection::connectionState(void)
  */
 void ModbusConnection::handleConnectionStateChanged(QModbusDevice::State state)
 {
-    QModbusTcpClient * pClient = qobject_cast<QModbusTcpClient *>(QObject::sender());    
+    QModbusDevice * pClient = qobject_cast<QModbusDevice *>(QObject::sender());    
     const qint32 senderIdx = findConnectionData(nullptr, pClient);
 
     if (senderIdx != -1)
@@ -153,7 +187,7 @@ void ModbusConnection::handleConnectionStateChanged(QModbusDevice::State state)
         else if (senderIdx != -1)
         {
             // Stale connection is open, close it
-            _connectionList[senderIdx]->modbusClient.disconnectDevice();
+            _connectionList[senderIdx]->pModbusClient->disconnectDevice();
         }
         else
         {
@@ -173,7 +207,7 @@ void ModbusConnection::handleConnectionStateChanged(QModbusDevice::State state)
         else if (senderIdx != -1)
         {
             // Prepare to remove old connection
-            _connectionList[senderIdx]->modbusClient.disconnect();
+            _connectionList[senderIdx]->pModbusClient->disconnect();
             _connectionList[senderIdx]->connectionTimeoutTimer.disconnect();
 
             connect(_connectionList[senderIdx], &ConnectionData::destroyed, this, &ModbusConnection::connectionDestroyed);
@@ -198,7 +232,7 @@ void ModbusConnection::handleConnectionStateChanged(QModbusDevice::State state)
  */
 void ModbusConnection::handleConnectionErrorOccurred(QModbusDevice::Error error)
 {
-    QModbusTcpClient * pClient = qobject_cast<QModbusTcpClient *>(QObject::sender());
+    QModbusDevice * pClient = qobject_cast<QModbusDevice *>(QObject::sender());
     const qint32 senderIdx = findConnectionData(nullptr, pClient);
 
     // Only handle error is latest connection, the rest is automaticaly closed on state change
@@ -246,21 +280,44 @@ void ModbusConnection::handleRequestFinished()
      /* Check if reply is for valid connection (the last) */
      if (pReply == _connectionList.last()->pReply)
      {
+         const bool bWriteReply = _connectionList.last()->bWriteReply;
+
          if (err == QModbusDevice::NoError)
          {
              // Success
              QModbusDataUnit dataUnit = pReply->result();
-             emit readRequestSuccess(static_cast<quint16>(dataUnit.startAddress()) + 40001, dataUnit.values().toList());
+             if (bWriteReply)
+             {
+                 emit writeRequestSuccess(static_cast<quint16>(dataUnit.startAddress()) + 40001, dataUnit.values().toList());
+             }
+             else
+             {
+                 emit readRequestSuccess(static_cast<quint16>(dataUnit.startAddress()) + 40001, dataUnit.values().toList());
+             }
          }
          else if (err == QModbusDevice::ProtocolError)
          {
              auto exceptionCode = pReply->rawResult().exceptionCode();
 
-             emit readRequestProtocolError(exceptionCode);
+             if (bWriteReply)
+             {
+                 emit writeRequestProtocolError(exceptionCode);
+             }
+             else
+             {
+                 emit readRequestProtocolError(exceptionCode);
+             }
          }
          else
          {
-            emit readRequestError(pReply->errorString(), pReply->error());
+             if (bWriteReply)
+             {
+                 emit writeRequestError(pReply->errorString(), pReply->error());
+             }
+             else
+             {
+                 emit readRequestError(pReply->errorString(), pReply->error());
+             }
          }
      }
      else
@@ -289,13 +346,13 @@ void ModbusConnection::handleConnectionError(QPointer<ConnectionData> connection
 }
 
 /*!
- * Find specific ConnectionData instance in list based on QTimer or QModbusTcpClient pointer
+ * Find specific ConnectionData instance in list based on QTimer or Modbus client pointer
  * \param pTimer Pointer to QTimer object to find (nullptr when ignored)
- * \param pClient Pointer to QModbusTcpClient oject to find (nullptr when ignored)
+ * \param pClient Pointer to Modbus client oject to find (nullptr when ignored)
  * \retval -1       Not found
  * \retval != -1    Index in list
  */
-qint32 ModbusConnection::findConnectionData(QTimer * pTimer, QModbusTcpClient * pClient)
+qint32 ModbusConnection::findConnectionData(QTimer * pTimer, QModbusDevice * pClient)
 {
     for(qint32 idx = 0; idx < _connectionList.size(); idx++)
     {
@@ -308,7 +365,7 @@ qint32 ModbusConnection::findConnectionData(QTimer * pTimer, QModbusTcpClient *
         }
         else if (
                  (pClient != nullptr)
-                 && (pClient == &_connectionList[idx]->modbusClient)
+                 && (pClient == _connectionList[idx]->pModbusClient)
             )
         {
             return idx;
@@ -8,23 +8,87 @@
 #include <QModbusReply>
 #include <QModbusTcpClient>
 #include <QPointer>
+#include <QScopedPointer>
+
+#include "modbusudpclient.h"
+
+/*!
+ * Requests that every transport supports: QModbusTcpClient and ModbusUdpClient have the same
+ * interface, but don't share a base class that has it
+ */
+class ModbusTransport
+{
+public:
+    virtual ~ModbusTransport() {}
+
+    virtual void setTimeout(int timeout) = 0;
+    virtual void setNumberOfRetries(int number) = 0;
+    virtual QModbusReply * sendReadRequest(const QModbusDataUnit &read, int serverAddress) = 0;
+    virtual QModbusReply * sendWriteRequest(const QModbusDataUnit &write, int serverAddress) = 0;
+};
+
+template <class TClient>
+class ModbusClientTransport : public ModbusTransport
+{
+public:
+    explicit ModbusClientTransport(TClient * pClient) : _pClient(pClient)
+    {
+    }
+
+    void setTimeout(int timeout)
+    {
+        _pClient->setTimeout(timeout);
+    }
+
+    void setNumberOfRetries(int number)
+    {
+        _pClient->setNumberOfRetries(number);
+    }
+
+    QModbusReply * sendReadRequest(const QModbusDataUnit &read, int serverAddress)
+    {
+        return _pClient->sendReadRequest(read, serverAddress);
+    }
+
+    QModbusReply * sendWriteRequest(const QModbusDataUnit &write, int serverAddress)
+    {
+        return _pClient->sendWriteRequest(write, serverAddress);
+    }
+
+private:
+    TClient * _pClient;
+};
 
 class ConnectionData : public QObject
 {
     Q_OBJECT
 public:
 
-    explicit ConnectionData():
-        connectionTimeoutTimer(this), modbusClient(this), bConnectionErrorHandled(false), pReply(nullptr)
+    explicit ConnectionData(bool bUdp):
+        connectionTimeoutTimer(this), bConnectionErrorHandled(false), pReply(nullptr), bWriteReply(false)
     {
-
+        /* Only place that depends on type of transport */
+        if (bUdp)
+        {
+            ModbusUdpClient * pClient = new ModbusUdpClient(this);
+            pModbusClient = pClient;
+            pTransport.reset(new ModbusClientTransport<ModbusUdpClient>(pClient));
+        }
+        else
+        {
+            QModbusTcpClient * pClient = new QModbusTcpClient(this);
+            pModbusClient = pClient;
+            pTransport.reset(new ModbusClientTransport<QModbusClient>(pClient));
+        }
     }
 
     QTimer connectionTimeoutTimer;
-    QModbusTcpClient modbusClient;
+    QModbusDevice * pModbusClient;
+    QScopedPointer<ModbusTransport> pTransport;
     bool bConnectionErrorHandled;
 
     QModbusReply * pReply;
+    bool bWriteReply;
 };
 
 
@@ -34,10 +98,11 @@ class ModbusConnection : public QObject
 public:
     explicit ModbusConnection(QObject *parent = nullptr);
 
-    void openConnection(QString ip, qint32 port, quint32 timeout);
+    void openConnection(QString ip, qint32 port, quint32 timeout, bool bUdp = false);
     void closeConnection(void);
 
     void sendReadRequest(quint32 regAddress, quint16 size, int serverAddress);
+    void sendWriteRequest(quint32 regAddress, QList<quint16> registerDataList, int serverAddress);
 
     QModbusDevice::State connectionState(void);
 
@@ -49,6 +114,10 @@ signals:
     void readRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode);
     void readRequestError(QString errorString, QModbusDevice::Error error);
 
+    void writeRequestSuccess(quint16 startRegister, QList<quint16> registerDataList);
+    void writeRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode);
+    void writeRequestError(QString errorString, QModbusDevice::Error error);
+
 private slots:
     void handleConnectionStateChanged(QModbusDevice::State connectionState);
     void handleConnectionErrorOccurred(QModbusDevice::Error error);
@@ -61,7 +130,9 @@ private slots:
 private:
 
     void handleConnectionError(QPointer<ConnectionData> connectionData, QString errMsg);
-    qint32 findConnectionData(QTimer * pTimer, QModbusTcpClient * pClient);
+    qint32 findConnectionData(QTimer * pTimer, QModbusDevice * pClient);
+
+    static const int _cUdpRetransmissions = 3;
 
     QList<QPointer<ConnectionData>> _connectionList;
     bool _bWaitingForConnection;
@@ -4,6 +4,7 @@
 #include "modbusconnection.h"
 #include "readregisters.h"
 
+#include <QDateTime>
 #include <util.h>
 
 typedef QMap<quint16,ModbusResult> ModbusResultMap;
@@ -19,30 +20,37 @@ ModbusMaster::ModbusMaster(SettingsModel * pSettingsModel, quint8 connectionId)
 
     _pSettingsModel = pSettingsModel;
     _pModbusConnection = new ModbusConnection();
+    _pStandbyConnection = new ModbusConnection();
     _pReadRegisters = new ReadRegisters();
 
     _connectionId = connectionId;
 
+    _bReadActive = false;
+    _bConnecting = false;
+    _bRequestPending = false;
+    _bWritePending = false;
+    _bSecondaryActive = false;
+    _bStandbyConnecting = false;
+    _bStandbyAvailable = false;
+    _pendingWriteTimestamp = 0;
+    _pendingReadAddress = 0;
+    _pendingReadCount = 0;
+
     // Use queued connection to make sure reply is deleted before closing connection
     connect(this, &ModbusMaster::triggerNextRequest, this, &ModbusMaster::handleTriggerNextRequest, Qt::QueuedConnection);
 
-    // Connection signals/slots
-    connect(_pModbusConnection, &ModbusConnection::connectionSuccess, this, &ModbusMaster::handleConnectionOpened);
-    connect(_pModbusConnection, &ModbusConnection::connectionError, this, &ModbusMaster::handlerConnectionError);
-
-    // Read request signals/slots
-    connect(_pModbusConnection, &ModbusConnection::readRequestSuccess, this, &ModbusMaster::handleRequestSuccess);
-    connect(_pModbusConnection, &ModbusConnection::readRequestProtocolError, this, &ModbusMaster::handleRequestProtocolError);
-    connect(_pModbusConnection, &ModbusConnection::readRequestError, this, &ModbusMaster::handleRequestError);
+    connectActiveConnection();
+    connectStandbyConnection();
 }
 
 ModbusMaster::~ModbusMaster()
 {
     delete _pModbusConnection;
+    delete _pStandbyConnection;
     delete _pReadRegisters;
 }
 
-void ModbusMaster::readRegisterList(QList<quint16> registerList)
+void ModbusMaster::readRegisterList(QList<quint16> registerList, QList<quint16> pairStartList)
 {
     _success = 0;
     _error = 0;
@@ -50,11 +58,13 @@ void ModbusMaster::readRegisterList(QList<quint16> registerList)
     if (registerList.count() > 0)
     {
         logInfo("Register list read: " + dumpToString(registerList));
+        openStandbyConnection();
+        trace(PollTraceModel::CYCLE_START, 0, static_cast<quint16>(registerList.count()));
 
-        _pReadRegisters->resetRead(registerList, _pSettingsModel->consecutiveMax(_connectionId));
+        _pReadRegisters->resetRead(registerList, _pSettingsModel->consecutiveMax(_connectionId), pairStartList);
 
-        /* Open connection */
-        _pModbusConnection->openConnection(_pSettingsModel->ipAddress(_connectionId), _pSettingsModel->port(_connectionId), _pSettingsModel->timeout(_connectionId));
+        _bReadActive = true;
+        startTransaction();
     }
     else
     {
@@ -63,9 +73,39 @@ void ModbusMaster::readRegisterList(QList<quint16> registerList)
     }
 }
 
+/*!
+ * Queue write of holding register(s)
+ * Writes are sent before the remaining reads of an active poll,
+ * when no poll is active a connection is opened for the write only.
+ *
+ * \param registerAddress     Address of first register
+ * \param registerDataList    Values to write
+ */
+void ModbusMaster::writeRegister(quint16 registerAddress, QList<quint16> registerDataList)
+{
+    WriteItem writeItem;
+    writeItem.registerAddress = registerAddress;
+    writeItem.registerDataList = registerDataList;
+
+    _writeQueue.append(writeItem);
+
+    startTransaction();
+}
+
+/*!
+ * Close connection to standby device (when communication is stopped)
+ */
+void ModbusMaster::closeStandbyConnection()
+{
+    _pStandbyConnection->closeConnection();
+}
+
 void ModbusMaster::handleConnectionOpened()
 {
+    _bConnecting = false;
+
     logInfo("Connection opened");
+    trace(PollTraceModel::CONNECT_END);
 
     emit triggerNextRequest();
 }
@@ -74,18 +114,42 @@ void ModbusMaster::handlerConnectionError(QModbusDevice::Error error, QString ms
 {
     Q_UNUSED(error);
 
-    _error++;
+    _bConnecting = false;
+    _bRequestPending = false;
 
     logError(QString("Connection error (fatal):") + msg);
+    trace(PollTraceModel::CONNECT_ERROR);
 
-    _pReadRegisters->addAllErrors();
+    if (_bWritePending)
+    {
+        finishWrite(false);
+    }
+
+    if (failover())
+    {
+        // Continue remaining requests of this cycle on standby device
+        emit triggerNextRequest();
+        return;
+    }
+
+    failQueuedWrites();
+
+    if (_bReadActive)
+    {
+        _error++;
+
+        _pReadRegisters->addAllErrors();
 
-    finishRead();
+        finishRead();
+    }
 }
 
 void ModbusMaster::handleRequestSuccess(quint16 startRegister, QList<quint16> registerDataList)
 {
+    _bRequestPending = false;
+
     logInfo(QString("Read success"));
+    trace(PollTraceModel::READ_SUCCESS, startRegister, static_cast<quint16>(registerDataList.size()));
 
     // Success
     _pReadRegisters->addSuccess(startRegister, registerDataList);
@@ -98,21 +162,24 @@ void ModbusMaster::handleRequestSuccess(quint16 startRegister, QList<quint16> re
 
 void ModbusMaster::handleRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode)
 {
+    _bRequestPending = false;
+
     logError(QString("Modbus Exception: %0").arg(exceptionCode));
+    trace(PollTraceModel::READ_EXCEPTION, _pendingReadAddress, _pendingReadCount);
 
     if (
         (exceptionCode == QModbusPdu::IllegalDataAddress)
         || (exceptionCode == QModbusPdu::IllegalDataValue)
         )
     {
-        if (_pReadRegisters->next().count() > 1)
+        // Split read into separate reads on specific exception code (register pairs are kept together)
+        if (_pReadRegisters->splitNextToSingleReads())
         {
-            // Split read into separate reads on specific exception code and count is more than 1
-            _pReadRegisters->splitNextToSingleReads();
+            trace(PollTraceModel::SPLIT, _pendingReadAddress, _pendingReadCount);
         }
         else
         {
-            // Add error to results
+            // Nothing left to split: add error to results
             _pReadRegisters->addError();
         }
     }
@@ -134,7 +201,17 @@ void ModbusMaster::handleRequestProtocolError(QModbusPdu::ExceptionCode exceptio
 
 void ModbusMaster::handleRequestError(QString errorString, QModbusDevice::Error error)
 {
+    _bRequestPending = false;
+
     emit modbusLogError(QString("Request Failed:  %0 (%1)").arg(errorString).arg(error));
+    trace(PollTraceModel::READ_ERROR, _pendingReadAddress, _pendingReadCount);
+
+    if (failover())
+    {
+        // Retry failed read on standby device
+        emit triggerNextRequest();
+        return;
+    }
 
     // When we don't receive an exception, abort read and close connection
     _pReadRegisters->addAllErrors();
@@ -145,33 +222,275 @@ void ModbusMaster::handleRequestError(QString errorString, QModbusDevice::Error
     emit triggerNextRequest();
 }
 
+void ModbusMaster::handleWriteSuccess(quint16 startRegister, QList<quint16> registerDataList)
+{
+    Q_UNUSED(startRegister);
+    Q_UNUSED(registerDataList);
+
+    logInfo(QString("Write success"));
+
+    finishWrite(true);
+
+    // Start next request
+    emit triggerNextRequest();
+}
+
+void ModbusMaster::handleWriteProtocolError(QModbusPdu::ExceptionCode exceptionCode)
+{
+    logError(QString("Write Modbus Exception: %0").arg(exceptionCode));
+
+    finishWrite(false);
+
+    // Start next request
+    emit triggerNextRequest();
+}
+
+void ModbusMaster::handleWriteError(QString errorString, QModbusDevice::Error error)
+{
+    logError(QString("Write Request Failed:  %0 (%1)").arg(errorString).arg(error));
+
+    finishWrite(false);
+
+    // Next requests are sent to standby device when available
+    failover();
+
+    // Start next request
+    emit triggerNextRequest();
+}
+
 void ModbusMaster::handleTriggerNextRequest(void)
 {
-    if (_pReadRegisters->hasNext())
+    if (_bRequestPending || _bConnecting)
+    {
+        // Next request is triggered when pending action is done
+    }
+    else if (!_writeQueue.isEmpty())
+    {
+        // Writes have priority to keep their timing
+        _pendingWrite = _writeQueue.takeFirst();
+        _pendingWriteTimestamp = QDateTime::currentMSecsSinceEpoch();
+        _bWritePending = true;
+        _bRequestPending = true;
+
+        logInfo("Register write: " + QString("Start address (%0) and values %1").arg(_pendingWrite.registerAddress).arg(dumpToString(_pendingWrite.registerDataList)));
+
+        trace(PollTraceModel::WRITE_SEND, _pendingWrite.registerAddress, static_cast<quint16>(_pendingWrite.registerDataList.size()));
+
+        _pModbusConnection->sendWriteRequest(_pendingWrite.registerAddress, _pendingWrite.registerDataList, _pSettingsModel->slaveId(_connectionId));
+    }
+    else if (_bReadActive && _pReadRegisters->hasNext())
     {
         ModbusReadItem readItem = _pReadRegisters->next();
 
+        _bRequestPending = true;
+        _pendingReadAddress = readItem.address();
+        _pendingReadCount = readItem.count();
+
         logInfo("Partial list read: " + QString("Start address (%0) and count (%1)").arg(readItem.address()).arg(readItem.count()));
 
+        trace(PollTraceModel::READ_SEND, _pendingReadAddress, _pendingReadCount);
+
         _pModbusConnection->sendReadRequest(readItem.address(), readItem.count(), _pSettingsModel->slaveId(_connectionId));
     }
-    else
+    else if (_bReadActive)
     {
         // Done reading
         finishRead();
     }
+    else
+    {
+        // Done writing
+        logInfo("Connection closed");
+
+        _pModbusConnection->closeConnection();
+    }
+}
+
+void ModbusMaster::handleStandbyConnectionOpened()
+{
+    _bStandbyConnecting = false;
+
+    if (!_bStandbyAvailable)
+    {
+        _bStandbyAvailable = true;
+        logInfo(QString("Standby connection opened (%1)").arg(standbyIpAddress()));
+    }
+}
+
+void ModbusMaster::handleStandbyConnectionError(QModbusDevice::Error error, QString msg)
+{
+    Q_UNUSED(error);
+
+    _bStandbyConnecting = false;
+
+    if (_bStandbyAvailable)
+    {
+        _bStandbyAvailable = false;
+        logError(QString("Standby connection error (%1): %2").arg(standbyIpAddress()).arg(msg));
+    }
+}
+
+void ModbusMaster::connectActiveConnection()
+{
+    // Connection signals/slots
+    connect(_pModbusConnection, &ModbusConnection::connectionSuccess, this, &ModbusMaster::handleConnectionOpened);
+    connect(_pModbusConnection, &ModbusConnection::connectionError, this, &ModbusMaster::handlerConnectionError);
+
+    // Read request signals/slots
+    connect(_pModbusConnection, &ModbusConnection::readRequestSuccess, this, &ModbusMaster::handleRequestSuccess);
+    connect(_pModbusConnection, &ModbusConnection::readRequestProtocolError, this, &ModbusMaster::handleRequestProtocolError);
+    connect(_pModbusConnection, &ModbusConnection::readRequestError, this, &ModbusMaster::handleRequestError);
+
+    // Write request signals/slots
+    connect(_pModbusConnection, &ModbusConnection::writeRequestSuccess, this, &ModbusMaster::handleWriteSuccess);
+    connect(_pModbusConnection, &ModbusConnection::writeRequestProtocolError, this, &ModbusMaster::handleWriteProtocolError);
+    connect(_pModbusConnection, &ModbusConnection::writeRequestError, this, &ModbusMaster::handleWriteError);
+}
+
+void ModbusMaster::connectStandbyConnection()
+{
+    connect(_pStandbyConnection, &ModbusConnection::connectionSuccess, this, &ModbusMaster::handleStandbyConnectionOpened);
+    connect(_pStandbyConnection, &ModbusConnection::connectionError, this, &ModbusMaster::handleStandbyConnectionError);
+}
+
+/*!
+ * Open connection to standby device in background when a secondary address is configured
+ * The standby connection is kept open, so polling can switch over without connecting first
+ */
+void ModbusMaster::openStandbyConnection()
+{
+    if (
+        _pSettingsModel->secondaryIpAddress(_connectionId).isEmpty()
+        || _bStandbyConnecting
+        || (_pStandbyConnection->connectionState() != QModbusDevice::UnconnectedState)
+    )
+    {
+        // No standby device or already (being) connected
+    }
+    else
+    {
+        _bStandbyConnecting = true;
+
+        _pStandbyConnection->openConnection(standbyIpAddress(),
+                                            _pSettingsModel->port(_connectionId),
+                                            _pSettingsModel->timeout(_connectionId),
+                                            _pSettingsModel->udpTransport(_connectionId));
+    }
+}
+
+/*!
+ * Switch polling to the standby device, the failed device becomes the standby device
+ * \retval true     Switched to standby device
+ * \retval false    No connected standby device available
+ */
+bool ModbusMaster::failover()
+{
+    if (_pStandbyConnection->connectionState() != QModbusDevice::ConnectedState)
+    {
+        return false;
+    }
+
+    disconnect(_pModbusConnection, nullptr, this, nullptr);
+    disconnect(_pStandbyConnection, nullptr, this, nullptr);
+
+    ModbusConnection * pFailedConnection = _pModbusConnection;
+    _pModbusConnection = _pStandbyConnection;
+    _pStandbyConnection = pFailedConnection;
+    _bSecondaryActive = !_bSecondaryActive;
+
+    connectActiveConnection();
+    connectStandbyConnection();
+
+    // Failed device is reconnected in background on next cycle
+    _pStandbyConnection->closeConnection();
+    _bStandbyConnecting = false;
+    _bStandbyAvailable = false;
+
+    logError(QString("Failover to %1").arg(activeIpAddress()));
+    emit modbusFailover(activeIpAddress(), QDateTime::currentMSecsSinceEpoch(), _connectionId);
+
+    return true;
+}
+
+QString ModbusMaster::activeIpAddress()
+{
+    return _bSecondaryActive ? _pSettingsModel->secondaryIpAddress(_connectionId) : _pSettingsModel->ipAddress(_connectionId);
+}
+
+QString ModbusMaster::standbyIpAddress()
+{
+    return _bSecondaryActive ? _pSettingsModel->ipAddress(_connectionId) : _pSettingsModel->secondaryIpAddress(_connectionId);
+}
+
+/*!
+ * Send next request when connection is open, otherwise open connection first
+ */
+void ModbusMaster::startTransaction()
+{
+    if (_bConnecting || _bRequestPending)
+    {
+        // Next request is triggered when pending action is done
+    }
+    else if (_pModbusConnection->connectionState() == QModbusDevice::ConnectedState)
+    {
+        emit triggerNextRequest();
+    }
+    else
+    {
+        _bConnecting = true;
+
+        trace(PollTraceModel::CONNECT_START);
+
+        /* Open connection */
+        _pModbusConnection->openConnection(activeIpAddress(),
+                                           _pSettingsModel->port(_connectionId),
+                                           _pSettingsModel->timeout(_connectionId),
+                                           _pSettingsModel->udpTransport(_connectionId));
+    }
+}
+
+void ModbusMaster::finishWrite(bool bSuccess)
+{
+    _bRequestPending = false;
+    _bWritePending = false;
+
+    trace(bSuccess ? PollTraceModel::WRITE_SUCCESS : PollTraceModel::WRITE_ERROR,
+          _pendingWrite.registerAddress, static_cast<quint16>(_pendingWrite.registerDataList.size()));
+
+    emit modbusWriteDone(_pendingWrite.registerAddress, _pendingWrite.registerDataList, bSuccess, _pendingWriteTimestamp, _connectionId);
+}
+
+void ModbusMaster::failQueuedWrites()
+{
+    while (!_writeQueue.isEmpty())
+    {
+        WriteItem writeItem = _writeQueue.takeFirst();
+        emit modbusWriteDone(writeItem.registerAddress, writeItem.registerDataList, false, QDateTime::currentMSecsSinceEpoch(), _connectionId);
+    }
 }
 
 void ModbusMaster::finishRead()
 {
+    _bReadActive = false;
+
     QMap<quint16, ModbusResult> results = _pReadRegisters->resultMap();
 
     logInfo("Result map: " + dumpToString(results));
     emit modbusAddToStats(_success, _error);
+    trace(PollTraceModel::RESULT, 0, static_cast<quint16>(results.size()));
     emit modbusPollDone(results, _connectionId);
-    logInfo("Connection closed");
 
-    _pModbusConnection->closeConnection();
+    if (_writeQueue.isEmpty())
+    {
+        logInfo("Connection closed");
+
+        _pModbusConnection->closeConnection();
+    }
+    else
+    {
+        // Send writes that were queued during last read
+        emit triggerNextRequest();
+    }
 }
 
 QString ModbusMaster::dumpToString(QMap<quint16, ModbusResult> map)
@@ -203,3 +522,8 @@ void ModbusMaster::logError(QString msg)
 {
     emit modbusLogError(QString("[Conn %0] %1").arg(_connectionId).arg(msg));
 }
+
+void ModbusMaster::trace(PollTraceModel::EventType type, quint16 address, quint16 count)
+{
+    emit modbusTraceEvent(_connectionId, type, address, count);
+}
@@ -7,6 +7,7 @@
 #include <QModbusReply>
 
 #include "modbusresult.h"
+#include "polltracemodel.h"
 
 /* Forward declaration */
 class SettingsModel;
@@ -21,40 +22,87 @@ public:
     explicit ModbusMaster(SettingsModel * pSettingsModel, quint8 connectionId);
     virtual ~ModbusMaster();
 
-    void readRegisterList(QList<quint16> registerList);
+    void readRegisterList(QList<quint16> registerList, QList<quint16> pairStartList = QList<quint16>());
+    void writeRegister(quint16 registerAddress, QList<quint16> registerDataList);
+    void closeStandbyConnection();
 
 signals:
     void modbusPollDone(QMap<quint16, ModbusResult> modbusResults, quint8 connectionId);
+    void modbusWriteDone(quint16 registerAddress, QList<quint16> registerDataList, bool bSuccess, qint64 timestamp, quint8 connectionId);
     void modbusAddToStats(quint32 successes, quint32 errors);
     void modbusLogError(QString msg);
     void modbusLogInfo(QString msg);
+    void modbusFailover(QString ipAddress, qint64 timestamp, quint8 connectionId);
+    void modbusTraceEvent(quint8 connectionId, PollTraceModel::EventType type, quint16 address, quint16 count);
     void triggerNextRequest();
 
 private slots:
     void handleConnectionOpened();
     void handlerConnectionError(QModbusDevice::Error error, QString msg);
 
+    void handleStandbyConnectionOpened();
+    void handleStandbyConnectionError(QModbusDevice::Error error, QString msg);
+
     void handleRequestSuccess(quint16 startRegister, QList<quint16> registerDataList);
     void handleRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode);
     void handleRequestError(QString errorString, QModbusDevice::Error error);
 
+    void handleWriteSuccess(quint16 startRegister, QList<quint16> registerDataList);
+    void handleWriteProtocolError(QModbusPdu::ExceptionCode exceptionCode);
+    void handleWriteError(QString errorString, QModbusDevice::Error error);
+
     void handleTriggerNextRequest(void);
 
 private:
+
+    typedef struct
+    {
+        quint16 registerAddress;
+        QList<quint16> registerDataList;
+    } WriteItem;
+
+    void connectActiveConnection();
+    void connectStandbyConnection();
+    void openStandbyConnection();
+    bool failover();
+    QString activeIpAddress();
+    QString standbyIpAddress();
+
+    void startTransaction();
+    void finishWrite(bool bSuccess);
+    void failQueuedWrites();
     void finishRead();
     QString dumpToString(QMap<quint16, ModbusResult> map);
     QString dumpToString(QList<quint16> list);
 
     void logInfo(QString msg);
     void logError(QString msg);
+    void trace(PollTraceModel::EventType type, quint16 address = 0, quint16 count = 0);
 
     quint32 _success;
     quint32 _error;
 
     quint8 _connectionId;
 
+    bool _bReadActive;
+    bool _bConnecting;
+    bool _bRequestPending;
+    bool _bWritePending;
+
+    bool _bSecondaryActive;
+    bool _bStandbyConnecting;
+    bool _bStandbyAvailable;
+
+    QList<WriteItem> _writeQueue;
+    WriteItem _pendingWrite;
+    qint64 _pendingWriteTimestamp;
+
+    quint16 _pendingReadAddress;
+    quint16 _pendingReadCount;
+
     SettingsModel * _pSettingsModel;
     ModbusConnection * _pModbusConnection;
+    ModbusConnection * _pStandbyConnection;
     ReadRegisters * _pReadRegisters;
 
 };
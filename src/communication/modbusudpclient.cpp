@@ -0,0 +1,522 @@
+
+#include <QDataStream>
+#include <QVariant>
+#include <QtMath>
+#include <limits>
+
+#include "scopelogging.h"
+#include "modbusudpclient.h"
+
+/*!
+ * Constructor for ModbusUdpClient
+ */
+ModbusUdpClient::ModbusUdpClient(QObject *parent) :
+    QModbusDevice(parent), _retransmitTimer(this)
+{
+    _pSocket = new QUdpSocket(this);
+
+    _transactionId = 0;
+    _timeout = 1000;
+    _numberOfRetries = 3;
+
+    _bRoundTripTimeValid = false;
+    _smoothedRoundTripTime = 0;
+    _roundTripTimeVariation = 0;
+
+    _retransmitTimer.setSingleShot(true);
+    _retransmitTimer.setTimerType(Qt::PreciseTimer);
+
+    _clock.start();
+
+    connect(_pSocket, &QUdpSocket::connected, this, &ModbusUdpClient::handleSocketConnected);
+    connect(_pSocket, &QUdpSocket::readyRead, this, &ModbusUdpClient::handleReadyRead);
+    connect(_pSocket, static_cast<void (QUdpSocket::*)(QAbstractSocket::SocketError)>(&QUdpSocket::error), this, &ModbusUdpClient::handleSocketError);
+    connect(&_retransmitTimer, &QTimer::timeout, this, &ModbusUdpClient::handleRetransmitTimer);
+}
+
+ModbusUdpClient::~ModbusUdpClient()
+{
+    close();
+}
+
+/*!
+ * Set total time a request can take before it fails (retransmissions included)
+ * \param timeout   Timeout in ms
+ */
+void ModbusUdpClient::setTimeout(int timeout)
+{
+    if (timeout >= _cMinimumRetransmitTimeout)
+    {
+        _timeout = timeout;
+    }
+}
+
+int ModbusUdpClient::timeout() const
+{
+    return _timeout;
+}
+
+/*!
+ * Set maximum number of retransmissions of a single request
+ * \param number    Number of retransmissions
+ */
+void ModbusUdpClient::setNumberOfRetries(int number)
+{
+    if (number >= 0)
+    {
+        _numberOfRetries = number;
+    }
+}
+
+int ModbusUdpClient::numberOfRetries() const
+{
+    return _numberOfRetries;
+}
+
+/*!
+ * Get current retransmission timeout (RFC 6298 estimator)
+ * Until a round trip time is measured, the timeout is divided over all transmissions.
+ * \return Retransmission timeout in ms
+ */
+int ModbusUdpClient::retransmitTimeout() const
+{
+    int rto;
+
+    if (_bRoundTripTimeValid)
+    {
+        rto = qCeil(_smoothedRoundTripTime + qMax(1.0, 4 * _roundTripTimeVariation));
+    }
+    else
+    {
+        rto = _timeout / (_numberOfRetries + 1);
+    }
+
+    return qBound(static_cast<int>(_cMinimumRetransmitTimeout), rto, _timeout);
+}
+
+/*!
+ * Send read request for holding registers
+ * \param read              Data unit describing the registers to read
+ * \param serverAddress     Slave id
+ * \return Reply object, nullptr when request couldn't be send
+ */
+QModbusReply * ModbusUdpClient::sendReadRequest(const QModbusDataUnit &read, int serverAddress)
+{
+    if (read.registerType() != QModbusDataUnit::HoldingRegisters)
+    {
+        setError(tr("Only holding registers are supported."), QModbusDevice::ReadError);
+        return nullptr;
+    }
+
+    QModbusRequest request(QModbusRequest::ReadHoldingRegisters,
+                           static_cast<quint16>(read.startAddress()),
+                           static_cast<quint16>(read.valueCount()));
+
+    return enqueueRequest(request, read, serverAddress);
+}
+
+/*!
+ * Send write request for holding registers
+ * A single register is written with function code 0x06, multiple registers with 0x10
+ * \param write             Data unit with the register values
+ * \param serverAddress     Slave id
+ * \return Reply object, nullptr when request couldn't be send
+ */
+QModbusReply * ModbusUdpClient::sendWriteRequest(const QModbusDataUnit &write, int serverAddress)
+{
+    if (
+        (write.registerType() != QModbusDataUnit::HoldingRegisters)
+        || (write.valueCount() == 0)
+    )
+    {
+        setError(tr("Only holding registers are supported."), QModbusDevice::WriteError);
+        return nullptr;
+    }
+
+    QModbusRequest request;
+    if (write.valueCount() == 1)
+    {
+        request = QModbusRequest(QModbusRequest::WriteSingleRegister,
+                                 static_cast<quint16>(write.startAddress()),
+                                 write.value(0));
+    }
+    else
+    {
+        request = QModbusRequest(QModbusRequest::WriteMultipleRegisters,
+                                 static_cast<quint16>(write.startAddress()),
+                                 static_cast<quint16>(write.valueCount()),
+                                 static_cast<quint8>(write.valueCount() * 2),
+                                 write.values());
+    }
+
+    return enqueueRequest(request, write, serverAddress);
+}
+
+bool ModbusUdpClient::open()
+{
+    if (state() == QModbusDevice::ConnectedState)
+    {
+        return true;
+    }
+
+    const QString host = connectionParameter(QModbusDevice::NetworkAddressParameter).toString();
+    const quint16 port = static_cast<quint16>(connectionParameter(QModbusDevice::NetworkPortParameter).toUInt());
+
+    _bRoundTripTimeValid = false;
+
+    /* UDP has no handshake: connected only fixes the peer address */
+    _pSocket->connectToHost(host, port);
+
+    return true;
+}
+
+void ModbusUdpClient::close()
+{
+    if (state() == QModbusDevice::UnconnectedState)
+    {
+        return;
+    }
+
+    _retransmitTimer.stop();
+    _pSocket->abort();
+
+    abortPendingRequests(QModbusDevice::ReplyAbortedError, tr("Connection closed."));
+
+    setState(QModbusDevice::UnconnectedState);
+}
+
+void ModbusUdpClient::handleSocketConnected()
+{
+    qCDebug(scopeConnection) << "UDP socket bound to peer: " << _pSocket->peerAddress() << _pSocket->peerPort();
+
+    setState(QModbusDevice::ConnectedState);
+}
+
+void ModbusUdpClient::handleSocketError(QAbstractSocket::SocketError socketError)
+{
+    qCDebug(scopeConnection) << "UDP socket error: " << socketError << _pSocket->errorString();
+
+    if (state() == QModbusDevice::ConnectingState)
+    {
+        setError(_pSocket->errorString(), QModbusDevice::ConnectionError);
+        _pSocket->abort();
+        setState(QModbusDevice::UnconnectedState);
+    }
+    else if (socketError == QAbstractSocket::ConnectionRefusedError)
+    {
+        /* ICMP port unreachable: waiting for a reply is pointless */
+        abortPendingRequests(QModbusDevice::ConnectionError, _pSocket->errorString());
+    }
+    else
+    {
+        // Loss is handled by retransmission
+    }
+}
+
+void ModbusUdpClient::handleReadyRead()
+{
+    while (_pSocket->hasPendingDatagrams())
+    {
+        QByteArray datagram;
+        datagram.resize(static_cast<int>(_pSocket->pendingDatagramSize()));
+
+        const qint64 size = _pSocket->readDatagram(datagram.data(), datagram.size());
+        if (size >= 0)
+        {
+            datagram.resize(static_cast<int>(size));
+            processDatagram(datagram);
+        }
+    }
+}
+
+/*!
+ * Retransmit requests of which the retransmission timeout expired and
+ * fail requests that passed their deadline
+ */
+void ModbusUdpClient::handleRetransmitTimer()
+{
+    const qint64 now = _clock.elapsed();
+
+    QList<quint16> expiredList;
+
+    auto it = _pendingRequests.begin();
+    while (it != _pendingRequests.end())
+    {
+        if (it->pReply.isNull())
+        {
+            /* Reply was deleted by the user: drop request */
+            it = _pendingRequests.erase(it);
+            continue;
+        }
+
+        if (now >= it->deadline)
+        {
+            expiredList.append(it.key());
+        }
+        else if ((it->retransmitCount < _numberOfRetries) && (now >= it->retransmitTime))
+        {
+            it->retransmitCount++;
+
+            /* Exponential backoff, but never beyond the deadline */
+            const qint64 backoff = static_cast<qint64>(retransmitTimeout()) << qMin(it->retransmitCount, 6);
+            it->retransmitTime = qMin(now + backoff, it->deadline);
+
+            qCDebug(scopeConnection) << "UDP retransmit transaction" << it.key() << "attempt" << it->retransmitCount;
+
+            _pSocket->write(it->frame);
+        }
+        else
+        {
+            // Wait for reply
+        }
+
+        ++it;
+    }
+
+    foreach(quint16 transactionId, expiredList)
+    {
+        QPointer<QModbusReply> pReply = _pendingRequests.take(transactionId).pReply;
+        if (!pReply.isNull())
+        {
+            pReply->setError(QModbusDevice::TimeoutError, tr("Request timeout."));
+        }
+    }
+
+    scheduleRetransmitTimer();
+}
+
+QModbusReply * ModbusUdpClient::enqueueRequest(const QModbusRequest &request, const QModbusDataUnit &dataUnit, int serverAddress)
+{
+    if (state() != QModbusDevice::ConnectedState)
+    {
+        setError(tr("Device not connected."), QModbusDevice::ConnectionError);
+        return nullptr;
+    }
+
+    if (!request.isValid())
+    {
+        setError(tr("Invalid Modbus request."), QModbusDevice::ProtocolError);
+        return nullptr;
+    }
+
+    const quint16 transactionId = nextTransactionId();
+
+    PendingRequest pendingRequest;
+
+    QDataStream stream(&pendingRequest.frame, QIODevice::WriteOnly);
+    stream << transactionId
+           << static_cast<quint16>(0) /* Protocol id */
+           << static_cast<quint16>(request.size() + 1)
+           << static_cast<quint8>(serverAddress)
+           << request;
+
+    const qint64 now = _clock.elapsed();
+
+    pendingRequest.pReply = new QModbusReply(QModbusReply::Common, serverAddress, this);
+    pendingRequest.dataUnit = dataUnit;
+    pendingRequest.functionCode = request.functionCode();
+    pendingRequest.sendTime = now;
+    pendingRequest.retransmitTime = qMin(now + retransmitTimeout(), now + _timeout);
+    pendingRequest.deadline = now + _timeout;
+    pendingRequest.retransmitCount = 0;
+
+    _pendingRequests.insert(transactionId, pendingRequest);
+
+    if (_pSocket->write(pendingRequest.frame) < 0)
+    {
+        /* Treat as lost datagram, it will be retransmitted */
+        qCDebug(scopeConnection) << "UDP write failed: " << _pSocket->errorString();
+    }
+
+    scheduleRetransmitTimer();
+
+    return pendingRequest.pReply;
+}
+
+void ModbusUdpClient::processDatagram(const QByteArray &datagram)
+{
+    if (datagram.size() < _cMbapHeaderSize + 1)
+    {
+        qCDebug(scopeConnection) << "UDP datagram too short: " << datagram.toHex();
+        return;
+    }
+
+    quint16 transactionId;
+    quint16 protocolId;
+    quint16 length;
+    quint8 unitId;
+    quint8 functionCode;
+
+    QDataStream stream(datagram);
+    stream >> transactionId >> protocolId >> length >> unitId >> functionCode;
+
+    if (
+        (protocolId != 0)
+        || (length < 2)
+        || (datagram.size() < (_cMbapHeaderSize - 1 + length))
+    )
+    {
+        qCDebug(scopeConnection) << "UDP datagram with invalid header: " << datagram.toHex();
+        return;
+    }
+
+    if (!_pendingRequests.contains(transactionId))
+    {
+        /* Reply on retransmitted or timed out request */
+        qCDebug(scopeConnection) << "UDP stale reply for transaction" << transactionId;
+        return;
+    }
+
+    PendingRequest pendingRequest = _pendingRequests.value(transactionId);
+
+    if (
+        pendingRequest.pReply.isNull()
+        || (unitId != pendingRequest.pReply->serverAddress())
+        || ((functionCode & ~QModbusPdu::ExceptionByte) != pendingRequest.functionCode)
+    )
+    {
+        qCDebug(scopeConnection) << "UDP reply doesn't match request of transaction" << transactionId;
+        return;
+    }
+
+    _pendingRequests.remove(transactionId);
+
+    /* Karn's algorithm: ambiguous samples of retransmitted requests are ignored */
+    if (pendingRequest.retransmitCount == 0)
+    {
+        updateRoundTripTime(_clock.elapsed() - pendingRequest.sendTime);
+    }
+
+    const QByteArray pduData = datagram.mid(_cMbapHeaderSize + 1, length - 2);
+    processResponse(QModbusResponse(static_cast<QModbusPdu::FunctionCode>(functionCode), pduData), pendingRequest);
+
+    scheduleRetransmitTimer();
+}
+
+void ModbusUdpClient::processResponse(const QModbusResponse &response, const PendingRequest &pendingRequest)
+{
+    QModbusReply * pReply = pendingRequest.pReply;
+
+    pReply->setRawResult(response);
+
+    if (response.isException())
+    {
+        pReply->setError(QModbusDevice::ProtocolError, tr("Modbus exception: 0x%1").arg(static_cast<int>(response.exceptionCode()), 2, 16, QChar('0')));
+    }
+    else if (response.functionCode() == QModbusPdu::ReadHoldingRegisters)
+    {
+        const QByteArray data = response.data();
+        const int valueCount = pendingRequest.dataUnit.valueCount();
+
+        if (
+            (data.size() != (1 + 2 * valueCount))
+            || (static_cast<quint8>(data.at(0)) != (2 * valueCount))
+        )
+        {
+            pReply->setError(QModbusDevice::ProtocolError, tr("Invalid read response size."));
+            return;
+        }
+
+        QVector<quint16> values;
+        QDataStream stream(data.mid(1));
+        for (int idx = 0; idx < valueCount; idx++)
+        {
+            quint16 value;
+            stream >> value;
+            values.append(value);
+        }
+
+        QModbusDataUnit result(pendingRequest.dataUnit);
+        result.setValues(values);
+
+        pReply->setResult(result);
+        pReply->setFinished(true);
+    }
+    else if (
+             (response.functionCode() == QModbusPdu::WriteSingleRegister)
+             || (response.functionCode() == QModbusPdu::WriteMultipleRegisters)
+    )
+    {
+        /* Echo of address and value/count */
+        if (response.data().size() != 4)
+        {
+            pReply->setError(QModbusDevice::ProtocolError, tr("Invalid write response size."));
+            return;
+        }
+
+        pReply->setResult(pendingRequest.dataUnit);
+        pReply->setFinished(true);
+    }
+    else
+    {
+        pReply->setError(QModbusDevice::ProtocolError, tr("Unexpected function code."));
+    }
+}
+
+/*!
+ * Update round trip time estimation (RFC 6298)
+ * \param sample    Measured round trip time in ms
+ */
+void ModbusUdpClient::updateRoundTripTime(qint64 sample)
+{
+    if (!_bRoundTripTimeValid)
+    {
+        _smoothedRoundTripTime = sample;
+        _roundTripTimeVariation = sample / 2.0;
+        _bRoundTripTimeValid = true;
+    }
+    else
+    {
+        _roundTripTimeVariation = 0.75 * _roundTripTimeVariation + 0.25 * qAbs(_smoothedRoundTripTime - sample);
+        _smoothedRoundTripTime = 0.875 * _smoothedRoundTripTime + 0.125 * sample;
+    }
+}
+
+void ModbusUdpClient::scheduleRetransmitTimer()
+{
+    if (_pendingRequests.isEmpty())
+    {
+        _retransmitTimer.stop();
+        return;
+    }
+
+    qint64 nextEvent = std::numeric_limits<qint64>::max();
+    foreach(const PendingRequest &pendingRequest, _pendingRequests)
+    {
+        if (pendingRequest.retransmitCount < _numberOfRetries)
+        {
+            nextEvent = qMin(nextEvent, pendingRequest.retransmitTime);
+        }
+
+        nextEvent = qMin(nextEvent, pendingRequest.deadline);
+    }
+
+    const qint64 delay = qMax(nextEvent - _clock.elapsed(), static_cast<qint64>(0));
+    _retransmitTimer.start(static_cast<int>(delay));
+}
+
+void ModbusUdpClient::abortPendingRequests(QModbusDevice::Error error, QString errorText)
+{
+    QHash<quint16, PendingRequest> pendingRequests = _pendingRequests;
+    _pendingRequests.clear();
+
+    _retransmitTimer.stop();
+
+    foreach(const PendingRequest &pendingRequest, pendingRequests)
+    {
+        if (!pendingRequest.pReply.isNull())
+        {
+            pendingRequest.pReply->setError(error, errorText);
+        }
+    }
+}
+
+quint16 ModbusUdpClient::nextTransactionId()
+{
+    do
+    {
+        _transactionId++;
+    } while (_pendingRequests.contains(_transactionId));
+
+    return _transactionId;
+}
@@ -0,0 +1,95 @@
+#ifndef MODBUSUDPCLIENT_H
+#define MODBUSUDPCLIENT_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include <QUdpSocket>
+
+#include <QModbusDevice>
+#include <QModbusReply>
+#include <QModbusDataUnit>
+#include <QModbusPdu>
+
+/*!
+ * Modbus client using MBAP framed requests over UDP (Modbus/UDP)
+ *
+ * Offers the same request interface as QModbusTcpClient. Replies are matched to
+ * requests by transaction id, so late or duplicated datagrams are dropped. Lost
+ * datagrams are retransmitted after an adaptive retransmission timeout that
+ * follows the measured round trip time. The configured timeout is the total
+ * time a request is allowed to take, retransmissions included.
+ */
+class ModbusUdpClient : public QModbusDevice
+{
+    Q_OBJECT
+public:
+    explicit ModbusUdpClient(QObject *parent = nullptr);
+    ~ModbusUdpClient();
+
+    void setTimeout(int timeout);
+    int timeout() const;
+
+    void setNumberOfRetries(int number);
+    int numberOfRetries() const;
+
+    int retransmitTimeout() const;
+
+    QModbusReply * sendReadRequest(const QModbusDataUnit &read, int serverAddress);
+    QModbusReply * sendWriteRequest(const QModbusDataUnit &write, int serverAddress);
+
+protected:
+    bool open();
+    void close();
+
+private slots:
+    void handleSocketConnected();
+    void handleSocketError(QAbstractSocket::SocketError socketError);
+    void handleReadyRead();
+    void handleRetransmitTimer();
+
+private:
+
+    typedef struct
+    {
+        QPointer<QModbusReply> pReply;
+        QModbusDataUnit dataUnit;
+        QModbusPdu::FunctionCode functionCode;
+        QByteArray frame;
+        qint64 sendTime;
+        qint64 retransmitTime;
+        qint64 deadline;
+        int retransmitCount;
+
+    } PendingRequest;
+
+    QModbusReply * enqueueRequest(const QModbusRequest &request, const QModbusDataUnit &dataUnit, int serverAddress);
+    void processDatagram(const QByteArray &datagram);
+    void processResponse(const QModbusResponse &response, const PendingRequest &pendingRequest);
+
+    void updateRoundTripTime(qint64 sample);
+    void scheduleRetransmitTimer();
+    void abortPendingRequests(QModbusDevice::Error error, QString errorText);
+    quint16 nextTransactionId();
+
+    static const int _cMinimumRetransmitTimeout = 10; /* in ms */
+    static const int _cMbapHeaderSize = 7;
+
+    QUdpSocket * _pSocket;
+    QTimer _retransmitTimer;
+    QElapsedTimer _clock;
+
+    QHash<quint16, PendingRequest> _pendingRequests;
+    quint16 _transactionId;
+
+    int _timeout;
+    int _numberOfRetries;
+
+    bool _bRoundTripTimeValid;
+    double _smoothedRoundTripTime;
+    double _roundTripTimeVariation;
+};
+
+#endif // MODBUSUDPCLIENT_H
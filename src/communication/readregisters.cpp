@@ -9,72 +9,45 @@ ReadRegisters::ReadRegisters()
  * Load ReadRegisterCollection with register read list
  * \param registerList  Register read list
  * \param consecutiveMax Number of consecutive registers that is allowed to read at once
+ * \param pairStartList  Start addresses of 32 bit register pairs (both registers are always read in the same request)
  */
-void ReadRegisters::resetRead(QList<quint16> registerList, quint16 consecutiveMax)
+void ReadRegisters::resetRead(QList<quint16> registerList, quint16 consecutiveMax, QList<quint16> pairStartList)
 {
     _resultMap.clear();
-
-    if (registerList.size() == 0)
-    {
-        _readItemList.clear();
-    }
+    _readItemList.clear();
+    _pairStartList = pairStartList;
 
     while(registerList.size() > 0)
     {
-        if (
-            (registerList.size() == 1)
-            || (consecutiveMax == 1)
-        )
-        {
-            // Only single reads allowed
-            _readItemList.append(ModbusReadItem(registerList.first(), 1));
+        const quint16 startAddress = registerList.first();
 
+        // A register pair is never split, even when consecutiveMax is smaller
+        quint8 count = unitSize(startAddress, registerList);
+        for (int idx = 0; idx < count; idx++)
+        {
             registerList.removeFirst();
         }
-        else
-        {
-            int currentIdx = 0;
 
-            bool bSubsequent = false;
-            do
+        // Add subsequent registers (or pairs) while limit allows it
+        while (
+               (registerList.size() > 0)
+               && (registerList.first() == startAddress + count)
+              )
+        {
+            const quint8 nextSize = unitSize(registerList.first(), registerList);
+            if (count + nextSize > consecutiveMax)
             {
+                break;
+            }
 
-                // if next is current + 1, dan subsequent = true
-                if (registerList.at(currentIdx) + 1 == registerList.at(currentIdx + 1))
-                {
-                    bSubsequent = true;
-                    currentIdx++;
-                }
-                else
-                {
-                    bSubsequent = false;
-                }
-
-                // Break loop when end of list
-                if (currentIdx >= (registerList.size() - 1))
-                {
-                    break;
-                }
-
-                // Limit number of register in 1 read
-                if ((currentIdx + 1) >= consecutiveMax)
-                {
-                    break;
-                }
-
-            } while(bSubsequent == true);
-
-
-            // Convert idx to count
-            quint8 count = static_cast<quint8>(currentIdx) + 1;
-
-            _readItemList.append(ModbusReadItem(registerList.first(), count));
-
-            for (int idx = 0; idx < count; idx++)
+            count += nextSize;
+            for (int idx = 0; idx < nextSize; idx++)
             {
                 registerList.removeFirst();
             }
         }
+
+        _readItemList.append(ModbusReadItem(startAddress, count));
     }
 }
 
@@ -161,21 +134,51 @@ void ReadRegisters::addAllErrors()
 }
 
 /*!
- * Split "next" ModbusReadItem into single reads.
+ * Split "next" ModbusReadItem into single reads. Register pairs are kept together.
+ * \retval true     Item is split
+ * \retval false    Item can't be split further
  */
-void ReadRegisters::splitNextToSingleReads()
+bool ReadRegisters::splitNextToSingleReads()
 {
+    bool bSplit = false;
+
     if (hasNext())
     {
         ModbusReadItem firstItem = _readItemList.first();
 
-        _readItemList.removeFirst();
+        QList<quint16> registerList;
+        for (quint16 idx = 0; idx < firstItem.count(); idx++)
+        {
+            registerList.append(firstItem.address() + idx);
+        }
 
-        for(int idx = firstItem.count(); idx > 0; idx--)
+        QList<ModbusReadItem> splitList;
+        while (registerList.size() > 0)
         {
-            _readItemList.prepend(ModbusReadItem(static_cast<quint16>(firstItem.address()) + static_cast<quint16>(idx - 1), 1));
+            const quint8 count = unitSize(registerList.first(), registerList);
+
+            splitList.append(ModbusReadItem(registerList.first(), count));
+
+            for (int idx = 0; idx < count; idx++)
+            {
+                registerList.removeFirst();
+            }
+        }
+
+        if (splitList.size() > 1)
+        {
+            _readItemList.removeFirst();
+
+            for(int idx = splitList.size(); idx > 0; idx--)
+            {
+                _readItemList.prepend(splitList[idx - 1]);
+            }
+
+            bSplit = true;
         }
     }
+
+    return bSplit;
 }
 
 /*!
@@ -186,3 +189,23 @@ QMap<quint16, ModbusResult> ReadRegisters::resultMap()
 {
     return _resultMap;
 }
+
+/*!
+ * Return number of registers that should be read together, starting with address
+ * \param address       Register address (first item of registerList)
+ * \param registerList  Remaining registers
+ * \return 2 for start of register pair when second register is also in list, otherwise 1
+ */
+quint8 ReadRegisters::unitSize(quint16 address, QList<quint16> registerList)
+{
+    if (
+        _pairStartList.contains(address)
+        && (registerList.size() > 1)
+        && (registerList.at(1) == address + 1)
+    )
+    {
+        return 2;
+    }
+
+    return 1;
+}
@@ -29,7 +29,7 @@ class ReadRegisters
 public:
     ReadRegisters();
 
-    void resetRead(QList<quint16> registerList, quint16 consecutiveMax);
+    void resetRead(QList<quint16> registerList, quint16 consecutiveMax, QList<quint16> pairStartList = QList<quint16>());
 
     bool hasNext();
     ModbusReadItem next();
@@ -37,14 +37,16 @@ public:
     void addSuccess(quint16 startRegister, QList<quint16> registerDataList);
     void addError();
     void addAllErrors();
-    void splitNextToSingleReads();
+    bool splitNextToSingleReads();
 
     QMap<quint16, ModbusResult> resultMap();
 
 private:
 
+    quint8 unitSize(quint16 address, QList<quint16> registerList);
 
     QList<ModbusReadItem> _readItemList;
+    QList<quint16> _pairStartList;
 
     QMap<quint16, ModbusResult> _resultMap;
 
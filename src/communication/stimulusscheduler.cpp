@@ -0,0 +1,97 @@
+
+#include "stimulusmodel.h"
+#include "communicationmanager.h"
+
+#include "stimulusscheduler.h"
+
+StimulusScheduler::StimulusScheduler(StimulusModel * pStimulusModel, CommunicationManager * pCommunicationManager, QObject *parent) :
+    QObject(parent), _bActive(false)
+{
+    _pStimulusModel = pStimulusModel;
+    _pCommunicationManager = pCommunicationManager;
+
+    _writeTimer.setSingleShot(true);
+    _writeTimer.setTimerType(Qt::PreciseTimer);
+
+    connect(&_writeTimer, &QTimer::timeout, this, &StimulusScheduler::handleWriteTimeout);
+}
+
+/*!
+ * Start writing stimuli, time 0 is now
+ * Changes to the stimulus model are only applied on next start
+ */
+void StimulusScheduler::start()
+{
+    _stimulusList.clear();
+    _nextWriteTimes.clear();
+
+    foreach(Stimulus stimulus, _pStimulusModel->stimulusList())
+    {
+        if (stimulus.isValid())
+        {
+            _stimulusList.append(stimulus);
+            _nextWriteTimes.append(stimulus.nextWriteTime(0));
+        }
+    }
+
+    _bActive = true;
+    _elapsedTimer.start();
+
+    scheduleNextWrite();
+}
+
+void StimulusScheduler::stop()
+{
+    _bActive = false;
+    _writeTimer.stop();
+}
+
+bool StimulusScheduler::isActive()
+{
+    return _bActive;
+}
+
+void StimulusScheduler::handleWriteTimeout()
+{
+    if (!_bActive)
+    {
+        return;
+    }
+
+    const qint64 now = _elapsedTimer.elapsed();
+
+    for (qint32 idx = 0; idx < _stimulusList.size(); idx++)
+    {
+        if ((_nextWriteTimes[idx] >= 0) && (_nextWriteTimes[idx] <= now))
+        {
+            const Stimulus &stimulus = _stimulusList[idx];
+
+            _pCommunicationManager->writeRegister(stimulus.connectionId(),
+                                                  stimulus.registerAddress(),
+                                                  QList<quint16>() << stimulus.registerValue(now));
+
+            _nextWriteTimes[idx] = stimulus.nextWriteTime(now + 1);
+        }
+    }
+
+    scheduleNextWrite();
+}
+
+void StimulusScheduler::scheduleNextWrite()
+{
+    qint64 nextTime = -1;
+
+    foreach(qint64 writeTime, _nextWriteTimes)
+    {
+        if ((writeTime >= 0) && ((nextTime < 0) || (writeTime < nextTime)))
+        {
+            nextTime = writeTime;
+        }
+    }
+
+    if (nextTime >= 0)
+    {
+        const qint64 waitTime = qMax(nextTime - _elapsedTimer.elapsed(), static_cast<qint64>(0));
+        _writeTimer.start(static_cast<int>(waitTime));
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef STIMULUSSCHEDULER_H
+#define STIMULUSSCHEDULER_H
+
+#include <QObject>
+#include <QList>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "stimulus.h"
+
+//Forward declaration
+class StimulusModel;
+class CommunicationManager;
+
+/*!
+ * Writes the stimuli of the stimulus model during logging
+ *
+ * Write times are based on a monotonic clock that is started together with the logging.
+ * When writes are overdue, only the current waveform value is written.
+ */
+class StimulusScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StimulusScheduler(StimulusModel * pStimulusModel, CommunicationManager * pCommunicationManager, QObject *parent = nullptr);
+
+    void start();
+    void stop();
+
+    bool isActive();
+
+private slots:
+    void handleWriteTimeout();
+
+private:
+    void scheduleNextWrite();
+
+    StimulusModel * _pStimulusModel;
+    CommunicationManager * _pCommunicationManager;
+
+    QList<Stimulus> _stimulusList;
+    QList<qint64> _nextWriteTimes;
+
+    QElapsedTimer _elapsedTimer;
+    QTimer _writeTimer;
+
+    bool _bActive;
+};
+
+#endif // STIMULUSSCHEDULER_H
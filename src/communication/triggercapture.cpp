@@ -0,0 +1,247 @@
+
+#include <QDateTime>
+#include <QtNumeric>
+
+#include "settingsmodel.h"
+#include "graphdatamodel.h"
+
+#include "triggercapture.h"
+
+TriggerCapture::TriggerCapture(SettingsModel * pSettingsModel, GraphDataModel * pGraphDataModel, QObject *parent) :
+    QObject(parent)
+{
+    _pSettingsModel = pSettingsModel;
+    _pGraphDataModel = pGraphDataModel;
+
+    _state = DISABLED;
+    _eventCount = 0;
+    _triggerIdx = -1;
+    _bTriggerOnRawValue = true;
+    _preTriggerTime = 0;
+    _postTriggerTime = 0;
+    _captureEndTime = 0;
+    _bPreviousValid = false;
+    _previousValue = 0;
+    _ringStart = 0;
+    _ringCount = 0;
+}
+
+/*!
+ * Start filtering with current trigger settings
+ * \return false when trigger register isn't an active register, all samples are released in that case
+ */
+bool TriggerCapture::start()
+{
+    bool bRet = true;
+
+    _eventCount = 0;
+    _bPreviousValid = false;
+    _triggerIdx = -1;
+    _ringStart = 0;
+    _ringCount = 0;
+    _preTriggerRing.clear();
+
+    if (_pSettingsModel->triggerCapture())
+    {
+        _condition = _pSettingsModel->triggerCondition();
+        _preTriggerTime = _pSettingsModel->preTriggerTime();
+        _postTriggerTime = _pSettingsModel->postTriggerTime();
+
+        /* Samples are ordered as active graph list */
+        QList<quint16> activeIndexList;
+        _pGraphDataModel->activeGraphIndexList(&activeIndexList);
+
+        for (qint32 idx = 0; idx < activeIndexList.size(); idx++)
+        {
+            if (
+                (_pGraphDataModel->connectionId(activeIndexList[idx]) == _condition.connectionId())
+                && (_pGraphDataModel->registerAddress(activeIndexList[idx]) == _condition.registerAddress())
+            )
+            {
+                _triggerIdx = idx;
+
+                /* Virtual channel has no register bits */
+                _bTriggerOnRawValue = !_pGraphDataModel->isVirtual(activeIndexList[idx]);
+                break;
+            }
+        }
+
+        if (_triggerIdx >= 0)
+        {
+            /* Samples are never closer than poll time */
+            const quint32 pollTime = qMax(_pSettingsModel->pollTime(), static_cast<quint32>(1));
+            const qint32 ringSize = static_cast<qint32>(qMin(_preTriggerTime / pollTime + 2, static_cast<quint32>(_cMaxPreTriggerSamples)));
+
+            _preTriggerRing.resize(ringSize);
+
+            setState(ARMED);
+        }
+        else
+        {
+            bRet = false;
+            setState(DISABLED);
+        }
+    }
+    else
+    {
+        setState(DISABLED);
+    }
+
+    return bRet;
+}
+
+void TriggerCapture::stop()
+{
+    _preTriggerRing.clear();
+    _ringCount = 0;
+
+    setState(DISABLED);
+}
+
+TriggerCapture::State TriggerCapture::state() const
+{
+    return _state;
+}
+
+quint32 TriggerCapture::eventCount() const
+{
+    return _eventCount;
+}
+
+void TriggerCapture::handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    processSample(QDateTime::currentMSecsSinceEpoch(), successList, values, timestampList, rawValues);
+}
+
+/*!
+ * Process a new sample
+ * \param timestamp     Time of sample (ms since epoch)
+ * \param successList   Success of each active register
+ * \param values        Value of each active register
+ * \param timestampList Raw timestamp of each active register (empty: all registers are sampled on timestamp)
+ * \param rawValues     Raw register value of each active register (bit condition, passed through unchanged)
+ */
+void TriggerCapture::processSample(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    while (timestampList.size() < values.size())
+    {
+        timestampList.append(timestamp);
+    }
+
+    if (_state == DISABLED)
+    {
+        emit sampleReleased(timestamp, successList, values, timestampList, rawValues);
+        return;
+    }
+
+    bool bTriggered = false;
+    double value = 0;
+
+    if ((_triggerIdx < successList.size()) && (_triggerIdx < values.size()) && successList[_triggerIdx])
+    {
+        value = values[_triggerIdx];
+
+        const double previousValue = _bPreviousValid ? _previousValue : value;
+        quint32 rawValue;
+
+        if (_bTriggerOnRawValue && (_triggerIdx < rawValues.size()))
+        {
+            rawValue = rawValues[_triggerIdx];
+        }
+        else
+        {
+            /* No raw value: bits of integer part of value */
+            rawValue = qIsFinite(value) ? static_cast<quint32>(static_cast<qint64>(value)) : 0;
+        }
+
+        bTriggered = (_state == ARMED) && _condition.isMet(previousValue, value, rawValue);
+
+        _previousValue = value;
+        _bPreviousValid = true;
+    }
+
+    if (_state == ARMED)
+    {
+        if (bTriggered)
+        {
+            _eventCount++;
+            _captureEndTime = timestamp + _postTriggerTime;
+
+            releasePreTriggerSamples(timestamp);
+
+            emit sampleReleased(timestamp, successList, values, timestampList, rawValues);
+            emit triggered(timestamp, value);
+
+            setState(CAPTURING);
+        }
+        else
+        {
+            Sample sample;
+            sample.timestamp = timestamp;
+            sample.successList = successList;
+            sample.values = values;
+            sample.timestampList = timestampList;
+            sample.rawValues = rawValues;
+
+            pushPreTriggerSample(sample);
+        }
+    }
+    else
+    {
+        emit sampleReleased(timestamp, successList, values, timestampList, rawValues);
+
+        if (timestamp >= _captureEndTime)
+        {
+            setState(ARMED);
+        }
+    }
+}
+
+void TriggerCapture::pushPreTriggerSample(const Sample &sample)
+{
+    if (_preTriggerRing.isEmpty())
+    {
+        return;
+    }
+
+    const qint32 ringSize = _preTriggerRing.size();
+
+    if (_ringCount < ringSize)
+    {
+        _preTriggerRing[(_ringStart + _ringCount) % ringSize] = sample;
+        _ringCount++;
+    }
+    else
+    {
+        /* Overwrite oldest sample */
+        _preTriggerRing[_ringStart] = sample;
+        _ringStart = (_ringStart + 1) % ringSize;
+    }
+}
+
+void TriggerCapture::releasePreTriggerSamples(qint64 triggerTime)
+{
+    const qint32 ringSize = _preTriggerRing.size();
+
+    for (qint32 idx = 0; idx < _ringCount; idx++)
+    {
+        const Sample &sample = _preTriggerRing[(_ringStart + idx) % ringSize];
+
+        if (sample.timestamp >= triggerTime - _preTriggerTime)
+        {
+            emit sampleReleased(sample.timestamp, sample.successList, sample.values, sample.timestampList, sample.rawValues);
+        }
+    }
+
+    _ringStart = 0;
+    _ringCount = 0;
+}
+
+void TriggerCapture::setState(State state)
+{
+    if (_state != state)
+    {
+        _state = state;
+        emit stateChanged();
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef TRIGGERCAPTURE_H
+#define TRIGGERCAPTURE_H
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+
+#include "triggercondition.h"
+
+//Forward declaration
+class SettingsModel;
+class GraphDataModel;
+
+/*!
+ * Filters the sample stream of the communication manager for triggered capture
+ *
+ * When triggered capture is disabled, all samples are released immediately.
+ * Otherwise samples are kept in a fixed size pre-trigger ring until the trigger
+ * condition is met. Then the samples of the pre-trigger window and all samples
+ * of the post-trigger window are released. Afterwards the trigger is armed again.
+ */
+class TriggerCapture : public QObject
+{
+    Q_OBJECT
+public:
+
+    typedef enum
+    {
+        DISABLED = 0,
+        ARMED,
+        CAPTURING
+    } State;
+
+    explicit TriggerCapture(SettingsModel * pSettingsModel, GraphDataModel * pGraphDataModel, QObject *parent = nullptr);
+
+    bool start();
+    void stop();
+
+    State state() const;
+    quint32 eventCount() const;
+
+    void processSample(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList = QList<qint64>(), QList<quint32> rawValues = QList<quint32>());
+
+public slots:
+    void handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+
+signals:
+    void sampleReleased(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+    void triggered(qint64 timestamp, double value);
+    void stateChanged();
+
+private:
+
+    typedef struct
+    {
+        qint64 timestamp;
+        QList<bool> successList;
+        QList<double> values;
+        QList<qint64> timestampList;
+        QList<quint32> rawValues;
+    } Sample;
+
+    void pushPreTriggerSample(const Sample &sample);
+    void releasePreTriggerSamples(qint64 triggerTime);
+    void setState(State state);
+
+    static const qint32 _cMaxPreTriggerSamples = 100000;
+
+    SettingsModel * _pSettingsModel;
+    GraphDataModel * _pGraphDataModel;
+
+    State _state;
+    quint32 _eventCount;
+
+    TriggerCondition _condition;
+    qint32 _triggerIdx;
+    bool _bTriggerOnRawValue;
+    quint32 _preTriggerTime;
+    quint32 _postTriggerTime;
+    qint64 _captureEndTime;
+
+    bool _bPreviousValid;
+    double _previousValue;
+
+    QVector<Sample> _preTriggerRing;
+    qint32 _ringStart;
+    qint32 _ringCount;
+};
+
+#endif // TRIGGERCAPTURE_H
@@ -91,6 +91,7 @@ void Legend::setModels(GuiModel *pGuiModel, GraphDataModel * pGraphDataModel)
     connect(_pGraphDataModel, SIGNAL(activeChanged(quint32)), this, SLOT(updateLegend()));
     connect(_pGraphDataModel, SIGNAL(added(quint32)), this, SLOT(updateLegend()));
     connect(_pGraphDataModel, SIGNAL(removed(quint32)), this, SLOT(updateLegend()));
+    connect(_pGraphDataModel, SIGNAL(modelReset()), this, SLOT(updateLegend()));
     connect(_pGraphDataModel, SIGNAL(visibilityChanged(quint32)), this, SLOT(showGraph(const quint32)));
     connect(_pGraphDataModel, SIGNAL(colorChanged(quint32)), this, SLOT(changeGraphColor(quint32)));
     connect(_pGraphDataModel, SIGNAL(labelChanged(quint32)), this, SLOT(changeGraphLabel(quint32)));
@@ -284,7 +285,7 @@ void Legend::updateCursorDataInLegend(QStringList &cursorValueList)
 
     for (qint32 i = 0; i < valueList.size(); i++)
     {
-        if (bInRange)
+        if (bInRange && !qIsNaN(valueList[i]))
         {
             // No error
             cursorValueList.append(QString("[%1]").arg(Util::formatDoubleForExport(valueList[i])));
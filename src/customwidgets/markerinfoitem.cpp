@@ -3,6 +3,7 @@
 
 #include "guimodel.h"
 #include "graphdatamodel.h"
+#include "timebasealigner.h"
 
 #include "util.h"
 #include "markerinfoitem.h"
@@ -47,6 +48,7 @@ void MarkerInfoItem::setModel(GuiModel * pGuiModel, GraphDataModel * pGraphDataM
     connect(_pGraphDataModel, SIGNAL(activeChanged(quint32)), this, SLOT(updateGraphList()));
     connect(_pGraphDataModel, SIGNAL(added(quint32)), this, SLOT(updateGraphList()));
     connect(_pGraphDataModel, SIGNAL(removed(quint32)), this, SLOT(removeFromGraphList(quint32)));
+    connect(_pGraphDataModel, SIGNAL(modelReset()), this, SLOT(resetGraphList()));
     connect(_pGraphDataModel, SIGNAL(colorChanged(quint32)), this, SLOT(updateColor(quint32)));
     connect(_pGraphDataModel, SIGNAL(labelChanged(quint32)), this, SLOT(updateLabel(quint32)));
 
@@ -55,6 +57,7 @@ void MarkerInfoItem::setModel(GuiModel * pGuiModel, GraphDataModel * pGraphDataM
 
     connect(_pGuiModel, SIGNAL(markerExpressionMaskChanged()), this, SLOT(updateData()));
     connect(_pGuiModel, SIGNAL(markerExpressionCustomScriptChanged()), this, SLOT(updateData()));
+    connect(_pGuiModel, SIGNAL(linearInterpolationChanged()), this, SLOT(updateData()));
 
     updateGraphList();
 }
@@ -65,7 +68,7 @@ void MarkerInfoItem::updateData()
 
     if (graphIdx >= 0)
     {
-        QSharedPointer<QCPGraphDataContainer> dataMap = _pGraphDataModel->dataMap(graphIdx);
+        const SampleSeries series = _pGraphDataModel->series(graphIdx);
         QStringList expressionList;
         const quint32 mask = _pGuiModel->markerExpressionMask();
 
@@ -81,8 +84,9 @@ void MarkerInfoItem::updateData()
         }
 
         /* Add permanent items (y1, y2) */
-        expressionList.prepend(GuiModel::cMarkerExpressionEnd.arg(Util::formatDoubleForExport(dataMap->findBegin(_pGuiModel->endMarkerPos(), false)->value)));
-        expressionList.prepend(GuiModel::cMarkerExpressionStart.arg(Util::formatDoubleForExport(dataMap->findBegin(_pGuiModel->startMarkerPos(), false)->value)));
+        const bool bLinear = _pGuiModel->linearInterpolation() || _pGraphDataModel->ingestFilter(graphIdx).isLinear();
+        expressionList.prepend(GuiModel::cMarkerExpressionEnd.arg(Util::formatDoubleForExport(TimebaseAligner::alignedValue(series, _pGuiModel->endMarkerPos(), bLinear))));
+        expressionList.prepend(GuiModel::cMarkerExpressionStart.arg(Util::formatDoubleForExport(TimebaseAligner::alignedValue(series, _pGuiModel->startMarkerPos(), bLinear))));
 
         /* Construct labels data */
         const qint32 leftRowCount = expressionList.size() - expressionList.size() / 2;
@@ -166,6 +170,14 @@ void MarkerInfoItem::removeFromGraphList(const quint32 index)
 
 }
 
+void MarkerInfoItem::resetGraphList()
+{
+    /* Graphs were added or removed in bulk: indexes have changed */
+    updateList();
+
+    selectGraph(-1);
+}
+
 void MarkerInfoItem::graphSelected(qint32 index)
 {
     if (index > 0)
@@ -216,26 +228,28 @@ double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask)
     if (graphIdx >= 0)
     {
 
-        QSharedPointer<QCPGraphDataContainer> pDataMap = _pGraphDataModel->dataMap(graphIdx);
+        const SampleSeries series = _pGraphDataModel->series(graphIdx);
 
-        const double valueDiff = pDataMap->findBegin(_pGuiModel->endMarkerPos(), false)->value - pDataMap->findBegin(_pGuiModel->startMarkerPos(), false)->value;
+        /* Markers are placed on the common timebase: align values of graph to marker positions */
+        const bool bLinear = _pGuiModel->linearInterpolation() || _pGraphDataModel->ingestFilter(graphIdx).isLinear();
+        const double valueDiff = TimebaseAligner::alignedValue(series, _pGuiModel->endMarkerPos(), bLinear)
+                                    - TimebaseAligner::alignedValue(series, _pGuiModel->startMarkerPos(), bLinear);
         const double timeDiff = _pGuiModel->endMarkerPos() - _pGuiModel->startMarkerPos();
 
-        QCPGraphDataContainer::const_iterator dataPoint;
-        QCPGraphDataContainer::const_iterator start;
-        QCPGraphDataContainer::const_iterator end;
+        qint32 start;
+        qint32 end;
 
         /* make sure we go in ascending order */
         if (_pGuiModel->endMarkerPos() > _pGuiModel->startMarkerPos())
         {
-            start = pDataMap->findBegin(_pGuiModel->startMarkerPos(), false);
-            end = pDataMap->findEnd(_pGuiModel->endMarkerPos(), false);
+            start = series.findBegin(_pGuiModel->startMarkerPos(), false);
+            end = series.findEnd(_pGuiModel->endMarkerPos(), false);
         }
         else
         {
             /* Change order */
-            start = pDataMap->findBegin(_pGuiModel->endMarkerPos());
-            end = pDataMap->findEnd(_pGuiModel->startMarkerPos());
+            start = series.findBegin(_pGuiModel->endMarkerPos());
+            end = series.findEnd(_pGuiModel->startMarkerPos());
         }
 
 
@@ -251,10 +265,14 @@ double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask)
         {
             double avg = 0;
             quint32 count = 0;
-            for (dataPoint = start; dataPoint != end; dataPoint++)
+            for (qint32 sampleIdx = start; sampleIdx < end; sampleIdx++)
             {
-                count++;
-                avg += dataPoint->value;
+                /* Skip missing samples */
+                if (!series.isMissing(sampleIdx))
+                {
+                    count++;
+                    avg += series.value(sampleIdx);
+                }
             }
 
             if (count == 0)
@@ -270,11 +288,12 @@ double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask)
         {
             double min = std::numeric_limits<double>::max();
 
-            for (dataPoint = start; dataPoint != end; dataPoint++)
+            for (qint32 sampleIdx = start; sampleIdx < end; sampleIdx++)
             {
-                if (dataPoint->value < min)
+                const double value = series.value(sampleIdx);
+                if (value < min)
                 {
-                    min = dataPoint->value;
+                    min = value;
                 }
             }
 
@@ -284,11 +303,12 @@ double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask)
         {
             double max = std::numeric_limits<double>::lowest();
 
-            for (dataPoint = start; dataPoint != end; dataPoint++)
+            for (qint32 sampleIdx = start; sampleIdx < end; sampleIdx++)
             {
-                if (dataPoint->value > max)
+                const double value = series.value(sampleIdx);
+                if (value > max)
                 {
-                    max = dataPoint->value;
+                    max = value;
                 }
             }
 
@@ -31,6 +31,7 @@ private slots:
     void updateColor(quint32 graphIdx);
     void updateLabel(quint32 graphIdx);
     void removeFromGraphList(const quint32 index);
+    void resetGraphList();
     void graphSelected(qint32 index);
 
 
@@ -0,0 +1,284 @@
+#include <QPainter>
+#include <QHelpEvent>
+#include <QToolTip>
+
+#include "settingsmodel.h"
+#include "polltimeline.h"
+
+PollTimeline::PollTimeline(PollTraceModel * pPollTraceModel, QWidget *parent) : QWidget(parent)
+{
+    _pPollTraceModel = pPollTraceModel;
+
+    connect(_pPollTraceModel, &PollTraceModel::traceChanged, this, &PollTimeline::handleTraceChanged);
+    connect(_pPollTraceModel, &PollTraceModel::traceReset, this, &PollTimeline::handleTraceChanged);
+
+    setMouseTracking(true);
+}
+
+QSize PollTimeline::sizeHint() const
+{
+    return QSize(400, rowCount() * _cRowHeight + SettingsModel::CONNECTION_ID_CNT * _cHeaderHeight);
+}
+
+/*!
+ * Convert events of a cycle to segments: a bar per connect/request, ticks for splits and results
+ * \param cycle     Events of one cycle
+ * \return List of segments, times are absolute trace times in us
+ */
+QList<PollTimeline::Segment> PollTimeline::segments(const PollTraceModel::Cycle &cycle)
+{
+    QList<Segment> segmentList;
+
+    qint32 connectStartIdx = -1;
+    qint32 requestStartIdx = -1;
+    qint32 resultIdx = -1;
+
+    for (qint32 idx = 0; idx < cycle.size(); idx++)
+    {
+        const PollTraceModel::Event &event = cycle[idx];
+        qint32 startIdx = -1;
+
+        switch (event.type)
+        {
+        case PollTraceModel::CONNECT_START:
+            connectStartIdx = idx;
+            break;
+
+        case PollTraceModel::CONNECT_END:
+        case PollTraceModel::CONNECT_ERROR:
+            startIdx = connectStartIdx;
+            connectStartIdx = -1;
+            break;
+
+        case PollTraceModel::READ_SEND:
+        case PollTraceModel::WRITE_SEND:
+            requestStartIdx = idx;
+            break;
+
+        case PollTraceModel::READ_SUCCESS:
+        case PollTraceModel::READ_EXCEPTION:
+        case PollTraceModel::READ_ERROR:
+        case PollTraceModel::WRITE_SUCCESS:
+        case PollTraceModel::WRITE_ERROR:
+            startIdx = requestStartIdx;
+            requestStartIdx = -1;
+            break;
+
+        case PollTraceModel::SPLIT:
+            startIdx = idx;
+            break;
+
+        case PollTraceModel::RESULT:
+            startIdx = idx;
+            resultIdx = idx;
+            break;
+
+        case PollTraceModel::PROCESSED:
+            startIdx = resultIdx;
+            break;
+
+        default:
+            break;
+        }
+
+        if (startIdx >= 0)
+        {
+            Segment segment;
+            segment.type = event.type;
+            segment.startTime = cycle[startIdx].time;
+            segment.endTime = event.time;
+            segment.address = event.address;
+            segment.count = event.count;
+
+            segmentList.append(segment);
+        }
+    }
+
+    return segmentList;
+}
+
+void PollTimeline::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    _segmentAreas.clear();
+
+    /* Use same time scale for all connections */
+    qint64 maxDuration = 1000;
+    for (quint8 connectionId = 0u; connectionId < SettingsModel::CONNECTION_ID_CNT; connectionId++)
+    {
+        for (qint32 cycleIdx = 0; cycleIdx < _pPollTraceModel->cycleCount(connectionId); cycleIdx++)
+        {
+            const PollTraceModel::Cycle cycle = _pPollTraceModel->cycle(connectionId, cycleIdx);
+            if (!cycle.isEmpty())
+            {
+                maxDuration = qMax(maxDuration, cycle.last().time - cycle.first().time);
+            }
+        }
+    }
+
+    const qint32 timelineWidth = qMax(width() - _cLabelWidth - 4, 1);
+    const double pixelsPerUs = static_cast<double>(timelineWidth) / maxDuration;
+
+    qint32 top = 0;
+    for (quint8 connectionId = 0u; connectionId < SettingsModel::CONNECTION_ID_CNT; connectionId++)
+    {
+        const qint32 cycleCount = _pPollTraceModel->cycleCount(connectionId);
+
+        if (cycleCount == 0)
+        {
+            continue;
+        }
+
+        /* Connection header with time scale */
+        const QRect headerRect(0, top, width() - 4, _cHeaderHeight);
+        painter.setPen(palette().text().color());
+        painter.drawText(headerRect, Qt::AlignLeft | Qt::AlignVCenter, QString("Connection %1").arg(connectionId + 1));
+        painter.drawText(headerRect, Qt::AlignRight | Qt::AlignVCenter, QString("%1 ms").arg(maxDuration / 1000.0, 0, 'f', 1));
+        top += _cHeaderHeight;
+
+        /* Newest cycle on top */
+        for (qint32 cycleIdx = cycleCount - 1; cycleIdx >= 0; cycleIdx--)
+        {
+            const PollTraceModel::Cycle cycle = _pPollTraceModel->cycle(connectionId, cycleIdx);
+
+            if (cycle.isEmpty())
+            {
+                continue;
+            }
+
+            const qint64 cycleStart = cycle.first().time;
+            const qint64 cycleDuration = cycle.last().time - cycleStart;
+
+            painter.setPen(palette().text().color());
+            painter.drawText(QRect(0, top, _cLabelWidth - 4, _cRowHeight), Qt::AlignRight | Qt::AlignVCenter,
+                             QString("%1 ms").arg(cycleDuration / 1000.0, 0, 'f', 1));
+
+            painter.setPen(palette().mid().color());
+            painter.drawLine(_cLabelWidth, top + _cRowHeight / 2, _cLabelWidth + static_cast<qint32>(cycleDuration * pixelsPerUs), top + _cRowHeight / 2);
+
+            const QList<Segment> segmentList = segments(cycle);
+            for (qint32 segmentIdx = 0; segmentIdx < segmentList.size(); segmentIdx++)
+            {
+                const Segment &segment = segmentList[segmentIdx];
+
+                const qint32 left = _cLabelWidth + static_cast<qint32>((segment.startTime - cycleStart) * pixelsPerUs);
+                const qint32 barWidth = qMax(static_cast<qint32>((segment.endTime - segment.startTime) * pixelsPerUs), 2);
+                const QRect segmentRect(left, top + 2, barWidth, _cRowHeight - 4);
+
+                painter.fillRect(segmentRect, segmentColor(segment.type));
+
+                SegmentArea area;
+                area.rect = segmentRect;
+                area.segment = segment;
+                _segmentAreas.append(area);
+            }
+
+            top += _cRowHeight;
+        }
+    }
+
+    if (top == 0)
+    {
+        painter.setPen(palette().text().color());
+        painter.drawText(rect(), Qt::AlignCenter, tr("No poll cycles traced"));
+    }
+}
+
+bool PollTimeline::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip)
+    {
+        QHelpEvent * pHelpEvent = static_cast<QHelpEvent *>(event);
+
+        /* Ticks are drawn after bars, so search backwards */
+        for (qint32 idx = _segmentAreas.size() - 1; idx >= 0; idx--)
+        {
+            if (_segmentAreas[idx].rect.adjusted(-1, 0, 1, 0).contains(pHelpEvent->pos()))
+            {
+                QToolTip::showText(pHelpEvent->globalPos(), segmentDescription(_segmentAreas[idx].segment));
+                return true;
+            }
+        }
+
+        QToolTip::hideText();
+        event->ignore();
+
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+void PollTimeline::handleTraceChanged()
+{
+    setMinimumHeight(sizeHint().height());
+    update();
+}
+
+QColor PollTimeline::segmentColor(PollTraceModel::EventType type)
+{
+    switch (type)
+    {
+    case PollTraceModel::CONNECT_END:
+        return QColor(255, 165, 0);
+    case PollTraceModel::READ_SUCCESS:
+        return QColor(60, 170, 60);
+    case PollTraceModel::READ_EXCEPTION:
+        return QColor(230, 200, 0);
+    case PollTraceModel::WRITE_SUCCESS:
+        return QColor(50, 110, 220);
+    case PollTraceModel::CONNECT_ERROR:
+    case PollTraceModel::READ_ERROR:
+    case PollTraceModel::WRITE_ERROR:
+        return QColor(220, 40, 40);
+    case PollTraceModel::SPLIT:
+        return QColor(200, 0, 200);
+    case PollTraceModel::RESULT:
+        return QColor(0, 0, 0);
+    case PollTraceModel::PROCESSED:
+        return QColor(150, 150, 150);
+    default:
+        return QColor(0, 0, 0);
+    }
+}
+
+QString PollTimeline::segmentDescription(const Segment &segment)
+{
+    QString description = PollTraceModel::eventTypeToString(segment.type);
+
+    if (segment.address != 0)
+    {
+        description.append(QString(": address %1, count %2").arg(segment.address).arg(segment.count));
+    }
+    else if (segment.count != 0)
+    {
+        description.append(QString(": %1 registers").arg(segment.count));
+    }
+    else
+    {
+        // No address information
+    }
+
+    if (segment.endTime > segment.startTime)
+    {
+        description.append(QString(" (%1 ms)").arg((segment.endTime - segment.startTime) / 1000.0, 0, 'f', 2));
+    }
+
+    return description;
+}
+
+qint32 PollTimeline::rowCount() const
+{
+    qint32 count = 0;
+
+    for (quint8 connectionId = 0u; connectionId < SettingsModel::CONNECTION_ID_CNT; connectionId++)
+    {
+        count += _pPollTraceModel->cycleCount(connectionId);
+    }
+
+    return count;
+}
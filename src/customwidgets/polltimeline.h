@@ -0,0 +1,66 @@
+#ifndef POLLTIMELINE_H
+#define POLLTIMELINE_H
+
+#include <QWidget>
+#include <QColor>
+
+#include "polltracemodel.h"
+
+/*!
+ * Gantt-style view of the last poll cycles of every connection
+ *
+ * Every cycle is a row, time is relative to the start of the cycle. Connect, read and write requests
+ * are drawn as bars from send to reply, splits and result emission as ticks and the handling of the
+ * results by the application as a bar after the result.
+ */
+class PollTimeline : public QWidget
+{
+    Q_OBJECT
+
+public:
+
+    typedef struct
+    {
+        PollTraceModel::EventType type; /* Type of closing event */
+        qint64 startTime;
+        qint64 endTime;
+        quint16 address;
+        quint16 count;
+    } Segment;
+
+    explicit PollTimeline(PollTraceModel * pPollTraceModel, QWidget *parent = nullptr);
+
+    QSize sizeHint() const;
+
+    static QList<Segment> segments(const PollTraceModel::Cycle &cycle);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    bool event(QEvent *event);
+
+private slots:
+    void handleTraceChanged();
+
+private:
+
+    typedef struct
+    {
+        QRect rect;
+        Segment segment;
+    } SegmentArea;
+
+    static QColor segmentColor(PollTraceModel::EventType type);
+    static QString segmentDescription(const Segment &segment);
+
+    qint32 rowCount() const;
+
+    static const qint32 _cRowHeight = 14;
+    static const qint32 _cHeaderHeight = 18;
+    static const qint32 _cLabelWidth = 70;
+
+    QList<SegmentArea> _segmentAreas;
+
+    PollTraceModel * _pPollTraceModel;
+};
+
+#endif // POLLTIMELINE_H
@@ -0,0 +1,52 @@
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+
+#include "polltimelinedock.h"
+
+PollTimelineDock::PollTimelineDock(PollTraceModel * pPollTraceModel, QWidget *parent) :
+    QDockWidget(parent)
+{
+    _pPollTraceModel = pPollTraceModel;
+
+    setAllowedAreas(Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
+    setFeatures(QDockWidget::DockWidgetClosable
+                | QDockWidget::DockWidgetFloatable
+                | QDockWidget::DockWidgetMovable
+                );
+
+    setWindowTitle("Poll Timeline");
+    setFloating(true);
+
+    QWidget * pContents = new QWidget(this);
+
+    _pCycleCountSpinBox = new QSpinBox(pContents);
+    _pCycleCountSpinBox->setRange(1, 200);
+    _pCycleCountSpinBox->setValue(_pPollTraceModel->maxCycles());
+    connect(_pCycleCountSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), _pPollTraceModel, &PollTraceModel::setMaxCycles);
+
+    _pClearButton = new QPushButton("Clear", pContents);
+    connect(_pClearButton, &QPushButton::clicked, _pPollTraceModel, &PollTraceModel::clear);
+
+    QHBoxLayout * pControlLayout = new QHBoxLayout();
+    pControlLayout->addWidget(new QLabel("Cycles per connection:", pContents));
+    pControlLayout->addWidget(_pCycleCountSpinBox);
+    pControlLayout->addStretch();
+    pControlLayout->addWidget(_pClearButton);
+
+    _pPollTimeline = new PollTimeline(_pPollTraceModel);
+
+    _pScrollArea = new QScrollArea(pContents);
+    _pScrollArea->setWidgetResizable(true);
+    _pScrollArea->setWidget(_pPollTimeline);
+
+    QVBoxLayout * pLayout = new QVBoxLayout();
+    pLayout->addLayout(pControlLayout);
+    pLayout->addWidget(_pScrollArea);
+    pContents->setLayout(pLayout);
+
+    setWidget(pContents);
+    resize(600, 300);
+
+    hide();
+}
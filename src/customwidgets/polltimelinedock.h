@@ -0,0 +1,29 @@
+#ifndef POLLTIMELINEDOCK_H
+#define POLLTIMELINEDOCK_H
+
+#include <QDockWidget>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QScrollArea>
+
+#include "polltracemodel.h"
+#include "polltimeline.h"
+
+class PollTimelineDock : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PollTimelineDock(PollTraceModel * pPollTraceModel, QWidget *parent = nullptr);
+
+private:
+
+    PollTraceModel * _pPollTraceModel;
+
+    PollTimeline * _pPollTimeline;
+    QScrollArea * _pScrollArea;
+    QSpinBox * _pCycleCountSpinBox;
+    QPushButton * _pClearButton;
+};
+
+#endif // POLLTIMELINEDOCK_H
@@ -0,0 +1,219 @@
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QDateTime>
+
+#include "graphdatamodel.h"
+#include "guimodel.h"
+#include "util.h"
+
+#include "spectrumdock.h"
+
+SpectrumDock::SpectrumDock(GraphDataModel * pGraphDataModel, GuiModel * pGuiModel, QWidget *parent) :
+    QDockWidget(parent)
+{
+    _pGraphDataModel = pGraphDataModel;
+    _pGuiModel = pGuiModel;
+    _activeIdx = -1;
+
+    setAllowedAreas(Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
+    setFeatures(QDockWidget::DockWidgetClosable
+                | QDockWidget::DockWidgetFloatable
+                | QDockWidget::DockWidgetMovable
+                );
+
+    setWindowTitle("Spectrum");
+    setFloating(true);
+
+    QWidget * pContents = new QWidget(this);
+
+    _pGraphCombo = new QComboBox(pContents);
+    _pGraphCombo->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+
+    _pWindowSizeCombo = new QComboBox(pContents);
+    for (qint32 windowSize = 256; windowSize <= 65536; windowSize *= 4)
+    {
+        _pWindowSizeCombo->addItem(QString("%1 samples").arg(windowSize), windowSize);
+    }
+    _pWindowSizeCombo->setCurrentIndex(_pWindowSizeCombo->findData(_analyzer.windowSize()));
+
+    _pMarkerButton = new QPushButton("Analyze markers", pContents);
+    _pMarkerButton->setToolTip("Average spectrum of samples between markers");
+
+    _pStatusLabel = new QLabel(pContents);
+
+    QHBoxLayout * pControlLayout = new QHBoxLayout();
+    pControlLayout->addWidget(_pGraphCombo);
+    pControlLayout->addWidget(new QLabel("Window:", pContents));
+    pControlLayout->addWidget(_pWindowSizeCombo);
+    pControlLayout->addWidget(_pMarkerButton);
+    pControlLayout->addStretch();
+    pControlLayout->addWidget(_pStatusLabel);
+
+    _pPlot = new QCustomPlot(pContents);
+    _pPlot->addGraph();
+    _pPlot->xAxis->setLabel("Frequency (Hz)");
+    _pPlot->yAxis->setLabel("Amplitude");
+
+    QVBoxLayout * pLayout = new QVBoxLayout();
+    pLayout->addLayout(pControlLayout);
+    pLayout->addWidget(_pPlot);
+    pContents->setLayout(pLayout);
+
+    setWidget(pContents);
+    resize(700, 400);
+
+    _updateTimer.setSingleShot(true);
+    _updateTimer.setInterval(_cUpdateInterval);
+    connect(&_updateTimer, &QTimer::timeout, this, &SpectrumDock::updatePlot);
+
+    connect(_pGraphCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SpectrumDock::graphSelected);
+    connect(_pWindowSizeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SpectrumDock::windowSizeSelected);
+    connect(_pMarkerButton, &QPushButton::clicked, this, &SpectrumDock::analyzeMarkerRange);
+
+    connect(_pGraphDataModel, &GraphDataModel::added, this, &SpectrumDock::updateGraphList);
+    connect(_pGraphDataModel, &GraphDataModel::removed, this, &SpectrumDock::updateGraphList);
+    connect(_pGraphDataModel, &GraphDataModel::activeChanged, this, &SpectrumDock::updateGraphList);
+    connect(_pGraphDataModel, &GraphDataModel::labelChanged, this, &SpectrumDock::updateGraphList);
+    connect(_pGraphDataModel, &GraphDataModel::modelReset, this, &SpectrumDock::updateGraphList);
+
+    connect(_pGuiModel, &GuiModel::markerStateChanged, this, &SpectrumDock::updateMarkerState);
+
+    updateGraphList();
+    updateMarkerState();
+
+    hide();
+}
+
+/*!
+ * Start new spectrum of selected graph, called when logging starts
+ */
+void SpectrumDock::start()
+{
+    graphSelected();
+}
+
+void SpectrumDock::handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    Q_UNUSED(rawValues);
+
+    if ((_activeIdx < 0) || (_activeIdx >= successList.size()) || (_activeIdx >= values.size()) || !successList[_activeIdx])
+    {
+        return;
+    }
+
+    const qint64 timestamp = _activeIdx < timestampList.size() ? timestampList[_activeIdx] : QDateTime::currentMSecsSinceEpoch();
+
+    /* Only transform when spectrum is shown, samples are always kept */
+    if (_analyzer.add(static_cast<double>(timestamp), values[_activeIdx]) && isVisible())
+    {
+        _analyzer.update();
+
+        if (!_updateTimer.isActive())
+        {
+            _updateTimer.start();
+        }
+    }
+}
+
+void SpectrumDock::updateGraphList()
+{
+    const QVariant currentGraph = _pGraphCombo->currentData();
+
+    _pGraphCombo->blockSignals(true);
+    _pGraphCombo->clear();
+
+    QList<quint16> activeIndexList;
+    _pGraphDataModel->activeGraphIndexList(&activeIndexList);
+    for (qint32 idx = 0; idx < activeIndexList.size(); idx++)
+    {
+        const quint32 graphIdx = activeIndexList[idx];
+        _pGraphCombo->addItem(_pGraphDataModel->label(graphIdx), graphIdx);
+    }
+
+    const qint32 comboIdx = currentGraph.isValid() ? _pGraphCombo->findData(currentGraph) : -1;
+    _pGraphCombo->setCurrentIndex(comboIdx >= 0 ? comboIdx : 0);
+    _pGraphCombo->blockSignals(false);
+
+    /* Graph indexes might be changed */
+    graphSelected();
+}
+
+void SpectrumDock::graphSelected()
+{
+    const QVariant graphData = _pGraphCombo->currentData();
+
+    if (graphData.isValid())
+    {
+        _activeIdx = _pGraphDataModel->convertToActiveGraphIndex(graphData.toUInt());
+    }
+    else
+    {
+        _activeIdx = -1;
+    }
+
+    clearSpectrum();
+}
+
+void SpectrumDock::windowSizeSelected()
+{
+    _analyzer.setWindowSize(_pWindowSizeCombo->currentData().toInt());
+    clearSpectrum();
+}
+
+void SpectrumDock::updateMarkerState()
+{
+    _pMarkerButton->setEnabled(_pGuiModel->markerState());
+}
+
+void SpectrumDock::analyzeMarkerRange()
+{
+    const QVariant graphData = _pGraphCombo->currentData();
+
+    if (graphData.isValid() && _pGuiModel->markerState())
+    {
+        const SampleSeries series = _pGraphDataModel->series(graphData.toUInt());
+
+        _analyzer.analyze(series, _pGuiModel->startMarkerPos(), _pGuiModel->endMarkerPos());
+
+        /* Received samples are ignored until graph is selected again or logging is started */
+        _activeIdx = -1;
+
+        updatePlot();
+    }
+}
+
+void SpectrumDock::updatePlot()
+{
+    if (_analyzer.hasSpectrum())
+    {
+        const QVector<double> &amplitudes = _analyzer.amplitudes();
+
+        _frequencies.resize(amplitudes.size());
+        for (qint32 idx = 0; idx < _frequencies.size(); idx++)
+        {
+            _frequencies[idx] = idx * _analyzer.frequencyResolution();
+        }
+
+        _pPlot->graph(0)->setData(_frequencies, amplitudes, true);
+        _pPlot->rescaleAxes();
+
+        _pStatusLabel->setText(QString("Resolution: %1 Hz, windows: %2")
+                               .arg(Util::formatDoubleForExport(_analyzer.frequencyResolution()))
+                               .arg(_analyzer.segmentCount()));
+    }
+    else
+    {
+        _pPlot->graph(0)->data()->clear();
+        _pStatusLabel->setText(QString("No spectrum"));
+    }
+
+    _pPlot->replot();
+}
+
+void SpectrumDock::clearSpectrum()
+{
+    _updateTimer.stop();
+    _analyzer.reset();
+
+    updatePlot();
+}
@@ -0,0 +1,68 @@
+#ifndef SPECTRUMDOCK_H
+#define SPECTRUMDOCK_H
+
+#include <QDockWidget>
+#include <QComboBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+
+#include "qcustomplot.h"
+#include "spectrumanalyzer.h"
+
+//Forward declaration
+class GraphDataModel;
+class GuiModel;
+
+/*!
+ * Amplitude spectrum of a selected graph
+ *
+ * While logging, the values of the selected graph are added to the analyzer as they are received and a new
+ * spectrum is calculated every hop, but only when the dock is visible. The plot is updated at most once per
+ * update interval. For loaded data files (or after logging), the range between the markers can be analyzed.
+ */
+class SpectrumDock : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumDock(GraphDataModel * pGraphDataModel, GuiModel * pGuiModel, QWidget *parent = nullptr);
+
+public slots:
+    void start();
+    void handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+
+private slots:
+    void updateGraphList();
+    void graphSelected();
+    void windowSizeSelected();
+    void updateMarkerState();
+    void analyzeMarkerRange();
+    void updatePlot();
+
+private:
+
+    void clearSpectrum();
+
+    GraphDataModel * _pGraphDataModel;
+    GuiModel * _pGuiModel;
+
+    SpectrumAnalyzer _analyzer;
+
+    /* Position of selected graph in received values, -1 when graph isn't sampled */
+    qint32 _activeIdx;
+
+    QVector<double> _frequencies;
+
+    QComboBox * _pGraphCombo;
+    QComboBox * _pWindowSizeCombo;
+    QPushButton * _pMarkerButton;
+    QLabel * _pStatusLabel;
+    QCustomPlot * _pPlot;
+
+    QTimer _updateTimer;
+
+    static const qint32 _cUpdateInterval = 250; /* in ms */
+};
+
+#endif // SPECTRUMDOCK_H
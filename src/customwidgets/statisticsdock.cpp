@@ -0,0 +1,59 @@
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+
+#include "statisticsdock.h"
+
+StatisticsDock::StatisticsDock(StatisticsModel * pStatisticsModel, QWidget *parent) :
+    QDockWidget(parent)
+{
+    _pStatisticsModel = pStatisticsModel;
+
+    setAllowedAreas(Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
+    setFeatures(QDockWidget::DockWidgetClosable
+                | QDockWidget::DockWidgetFloatable
+                | QDockWidget::DockWidgetMovable
+                );
+
+    setWindowTitle("Statistics");
+    setFloating(true);
+
+    QWidget * pContents = new QWidget(this);
+
+    _pWindowSpinBox = new QSpinBox(pContents);
+    _pWindowSpinBox->setRange(1, 3600);
+    _pWindowSpinBox->setSuffix(" s");
+    _pWindowSpinBox->setValue(static_cast<int>(_pStatisticsModel->windowDuration()));
+    connect(_pWindowSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+        [=](int value){
+            _pStatisticsModel->setWindowDuration(static_cast<quint32>(value));
+        });
+
+    _pResetButton = new QPushButton("Reset", pContents);
+    connect(_pResetButton, &QPushButton::clicked, _pStatisticsModel, &StatisticsModel::reset);
+
+    QHBoxLayout * pControlLayout = new QHBoxLayout();
+    pControlLayout->addWidget(new QLabel("Window:", pContents));
+    pControlLayout->addWidget(_pWindowSpinBox);
+    pControlLayout->addStretch();
+    pControlLayout->addWidget(_pResetButton);
+
+    _pTableView = new QTableView(pContents);
+    _pTableView->setModel(_pStatisticsModel);
+    _pTableView->verticalHeader()->hide();
+    /* Fixed columns: resize to contents would scan all rows on every update */
+    _pTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    _pTableView->horizontalHeader()->setSectionResizeMode(StatisticsModel::COLUMN_NAME, QHeaderView::Stretch);
+    _pTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    QVBoxLayout * pLayout = new QVBoxLayout();
+    pLayout->addLayout(pControlLayout);
+    pLayout->addWidget(_pTableView);
+    pContents->setLayout(pLayout);
+
+    setWidget(pContents);
+    resize(700, 300);
+
+    hide();
+}
@@ -0,0 +1,27 @@
+#ifndef STATISTICSDOCK_H
+#define STATISTICSDOCK_H
+
+#include <QDockWidget>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QTableView>
+
+#include "statisticsmodel.h"
+
+class StatisticsDock : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StatisticsDock(StatisticsModel * pStatisticsModel, QWidget *parent = nullptr);
+
+private:
+
+    StatisticsModel * _pStatisticsModel;
+
+    QTableView * _pTableView;
+    QSpinBox * _pWindowSpinBox;
+    QPushButton * _pResetButton;
+};
+
+#endif // STATISTICSDOCK_H
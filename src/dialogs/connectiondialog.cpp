@@ -15,11 +15,13 @@ ConnectionDialog::ConnectionDialog(SettingsModel * pSettingsModel, QWidget *pare
     _pSettingsModel = pSettingsModel;
 
     connect(_pSettingsModel, &SettingsModel::ipChanged, this, &ConnectionDialog::updateIp);
+    connect(_pSettingsModel, &SettingsModel::secondaryIpChanged, this, &ConnectionDialog::updateSecondaryIp);
     connect(_pSettingsModel, &SettingsModel::portChanged, this, &ConnectionDialog::updatePort);
     connect(_pSettingsModel, &SettingsModel::slaveIdChanged, this, &ConnectionDialog::updateSlaveId);
     connect(_pSettingsModel, &SettingsModel::timeoutChanged, this, &ConnectionDialog::updateTimeout);
     connect(_pSettingsModel, &SettingsModel::consecutiveMaxChanged, this, &ConnectionDialog::updateConsecutiveMax);
     connect(_pSettingsModel, &SettingsModel::connectionStateChanged, this, &ConnectionDialog::updateConnectionState);
+    connect(_pSettingsModel, &SettingsModel::udpTransportChanged, this, &ConnectionDialog::updateUdpTransport);
 
     connect(_pUi->checkSecondConn, &QCheckBox::stateChanged, this, &ConnectionDialog::secondConnectionStateChanged);
 }
@@ -34,10 +36,12 @@ void ConnectionDialog::secondConnectionStateChanged(int state)
     bool bState = (state == Qt::Checked);
 
     _pUi->lineIP_2->setEnabled(bState);
+    _pUi->lineSecondaryIP_2->setEnabled(bState);
     _pUi->spinPort_2->setEnabled(bState);
     _pUi->spinSlaveId_2->setEnabled(bState);
     _pUi->spinTimeout_2->setEnabled(bState);
     _pUi->spinConsecutiveMax_2->setEnabled(bState);
+    _pUi->comboTransport_2->setEnabled(bState);
 
 }
 
@@ -53,6 +57,18 @@ void ConnectionDialog::updateIp(quint8 connectionId)
     }
 }
 
+void ConnectionDialog::updateSecondaryIp(quint8 connectionId)
+{
+    if (connectionId == SettingsModel::CONNECTION_ID_0)
+    {
+        _pUi->lineSecondaryIP->setText(_pSettingsModel->secondaryIpAddress(connectionId));
+    }
+    else
+    {
+        _pUi->lineSecondaryIP_2->setText(_pSettingsModel->secondaryIpAddress(connectionId));
+    }
+}
+
 void ConnectionDialog::updatePort(quint8 connectionId)
 {
     if (connectionId == SettingsModel::CONNECTION_ID_0)
@@ -111,6 +127,20 @@ void ConnectionDialog::updateConnectionState(quint8 connectionId)
     }
 }
 
+void ConnectionDialog::updateUdpTransport(quint8 connectionId)
+{
+    const int transportIdx = _pSettingsModel->udpTransport(connectionId) ? cTransportUdpIdx : cTransportTcpIdx;
+
+    if (connectionId == SettingsModel::CONNECTION_ID_0)
+    {
+        _pUi->comboTransport->setCurrentIndex(transportIdx);
+    }
+    else
+    {
+        _pUi->comboTransport_2->setCurrentIndex(transportIdx);
+    }
+}
+
 void ConnectionDialog::done(int r)
 {
     bool bValid = true;
@@ -118,16 +148,20 @@ void ConnectionDialog::done(int r)
     if(QDialog::Accepted == r)  // ok was pressed
     {
         _pSettingsModel->setIpAddress(SettingsModel::CONNECTION_ID_0, _pUi->lineIP->text());
+        _pSettingsModel->setSecondaryIpAddress(SettingsModel::CONNECTION_ID_0, _pUi->lineSecondaryIP->text().trimmed());
         _pSettingsModel->setPort(SettingsModel::CONNECTION_ID_0, _pUi->spinPort->text().toUInt());
         _pSettingsModel->setSlaveId(SettingsModel::CONNECTION_ID_0, _pUi->spinSlaveId->text().toInt());
         _pSettingsModel->setTimeout(SettingsModel::CONNECTION_ID_0, _pUi->spinTimeout->text().toUInt());
         _pSettingsModel->setConsecutiveMax(SettingsModel::CONNECTION_ID_0, _pUi->spinConsecutiveMax->text().toUInt());
+        _pSettingsModel->setUdpTransport(SettingsModel::CONNECTION_ID_0, _pUi->comboTransport->currentIndex() == cTransportUdpIdx);
 
         _pSettingsModel->setIpAddress(SettingsModel::CONNECTION_ID_1, _pUi->lineIP_2->text());
+        _pSettingsModel->setSecondaryIpAddress(SettingsModel::CONNECTION_ID_1, _pUi->lineSecondaryIP_2->text().trimmed());
         _pSettingsModel->setPort(SettingsModel::CONNECTION_ID_1, _pUi->spinPort_2->text().toUInt());
         _pSettingsModel->setSlaveId(SettingsModel::CONNECTION_ID_1, _pUi->spinSlaveId_2->text().toUInt());
         _pSettingsModel->setTimeout(SettingsModel::CONNECTION_ID_1, _pUi->spinTimeout_2->text().toUInt());
         _pSettingsModel->setConsecutiveMax(SettingsModel::CONNECTION_ID_1, _pUi->spinConsecutiveMax_2->text().toUInt());
+        _pSettingsModel->setUdpTransport(SettingsModel::CONNECTION_ID_1, _pUi->comboTransport_2->currentIndex() == cTransportUdpIdx);
         _pSettingsModel->setConnectionState(SettingsModel::CONNECTION_ID_1, _pUi->checkSecondConn->checkState() == Qt::Checked);
 
         // Validate the data
@@ -25,13 +25,19 @@ private slots:
     void secondConnectionStateChanged(int state);
 
     void updateIp(quint8 connectionId);
+    void updateSecondaryIp(quint8 connectionId);
     void updatePort(quint8 connectionId);
     void updateSlaveId(quint8 connectionId);
     void updateTimeout(quint8 connectionId);
     void updateConsecutiveMax(quint8 connectionId);
     void updateConnectionState(quint8 connectionId);
+    void updateUdpTransport(quint8 connectionId);
 
 private:
+
+    static const int cTransportTcpIdx = 0;
+    static const int cTransportUdpIdx = 1;
+
     Ui::ConnectionDialog * _pUi;
 
     SettingsModel * _pSettingsModel;
@@ -22,12 +22,21 @@ LogDialog::LogDialog(SettingsModel * pSettingsModel, GuiModel * pGuiModel, QWidg
     connect(_pUi->checkWriteDuringLog, SIGNAL(toggled(bool)), _pSettingsModel, SLOT(setWriteDuringLog(bool)));
     connect(_pUi->buttonWriteDuringLogFile, SIGNAL(clicked()), this, SLOT(selectLogFile()));
     connect(_pUi->checkAbsoluteTimes, SIGNAL(toggled(bool)), _pSettingsModel, SLOT(setAbsoluteTimes(bool)));
+    connect(_pUi->checkSpillToDisk, SIGNAL(toggled(bool)), _pSettingsModel, SLOT(setSpillToDisk(bool)));
+    connect(_pUi->checkCompressSamples, SIGNAL(toggled(bool)), _pSettingsModel, SLOT(setCompressSamples(bool)));
+    connect(_pUi->checkStopAtMemoryLimit, SIGNAL(toggled(bool)), _pSettingsModel, SLOT(setStopAtMemoryLimit(bool)));
+    connect(_pUi->checkPublishLiveData, SIGNAL(toggled(bool)), _pSettingsModel, SLOT(setPublishLiveData(bool)));
 
     /*-- connect model to view --*/
     connect(_pSettingsModel, SIGNAL(pollTimeChanged()), this, SLOT(updatePollTime()));
     connect(_pSettingsModel, SIGNAL(writeDuringLogChanged()), this, SLOT(updateWriteDuringLog()));
     connect(_pSettingsModel, SIGNAL(writeDuringLogFileChanged()), this, SLOT(updateWriteDuringLogFile()));
     connect(_pSettingsModel, SIGNAL(absoluteTimesChanged()), this, SLOT(updateAbsoluteTime()));
+    connect(_pSettingsModel, SIGNAL(retentionChanged()), this, SLOT(updateRetention()));
+    connect(_pSettingsModel, SIGNAL(spillToDiskChanged()), this, SLOT(updateSpillToDisk()));
+    connect(_pSettingsModel, SIGNAL(compressSamplesChanged()), this, SLOT(updateCompressSamples()));
+    connect(_pSettingsModel, SIGNAL(publishLiveDataChanged()), this, SLOT(updatePublishLiveData()));
+    connect(_pSettingsModel, SIGNAL(alarmCommandChanged()), this, SLOT(updateAlarmCommand()));
 }
 
 LogDialog::~LogDialog()
@@ -43,6 +52,10 @@ void LogDialog::done(int r)
     {
         _pSettingsModel->setPollTime(_pUi->spinPollTime->text().toUInt());
         _pSettingsModel->setWriteDuringLogFile(_pUi->lineWriteDuringLogFile->text());
+        _pSettingsModel->setAlarmCommand(_pUi->lineAlarmCommand->text().trimmed());
+        _pSettingsModel->setRetentionDuration(static_cast<quint32>(_pUi->spinRetentionDuration->value()));
+        _pSettingsModel->setRetentionSamples(static_cast<quint32>(_pUi->spinRetentionSamples->value()));
+        _pSettingsModel->setRetentionMemory(static_cast<quint32>(_pUi->spinRetentionMemory->value()));
 
         // Validate the data
         //bValid = validateSettingsData();
@@ -108,4 +121,31 @@ void LogDialog::updateAbsoluteTime()
     _pUi->checkAbsoluteTimes->setChecked(_pSettingsModel->absoluteTimes());
 }
 
+void LogDialog::updateRetention()
+{
+    _pUi->spinRetentionDuration->setValue(static_cast<int>(_pSettingsModel->retentionDuration()));
+    _pUi->spinRetentionSamples->setValue(static_cast<int>(_pSettingsModel->retentionSamples()));
+    _pUi->spinRetentionMemory->setValue(static_cast<int>(_pSettingsModel->retentionMemory()));
+    _pUi->checkStopAtMemoryLimit->setChecked(_pSettingsModel->stopAtMemoryLimit());
+}
+
+void LogDialog::updateSpillToDisk()
+{
+    _pUi->checkSpillToDisk->setChecked(_pSettingsModel->spillToDisk());
+}
+
+void LogDialog::updateCompressSamples()
+{
+    _pUi->checkCompressSamples->setChecked(_pSettingsModel->compressSamples());
+}
+
+void LogDialog::updatePublishLiveData()
+{
+    _pUi->checkPublishLiveData->setChecked(_pSettingsModel->publishLiveData());
+}
+
+void LogDialog::updateAlarmCommand()
+{
+    _pUi->lineAlarmCommand->setText(_pSettingsModel->alarmCommand());
+}
 
@@ -27,6 +27,11 @@ private slots:
     void updateWriteDuringLog();
     void updateWriteDuringLogFile();
     void updateAbsoluteTime();
+    void updateRetention();
+    void updateSpillToDisk();
+    void updateCompressSamples();
+    void updatePublishLiveData();
+    void updateAlarmCommand();
 
 private:
 
@@ -9,6 +9,11 @@
 #include "registerdialog.h"
 #include "connectiondialog.h"
 #include "notesdock.h"
+#include "polltracemodel.h"
+#include "polltimelinedock.h"
+#include "statisticsmodel.h"
+#include "statisticsdock.h"
+#include "spectrumdock.h"
 #include "settingsmodel.h"
 #include "logdialog.h"
 #include "errorlogdialog.h"
@@ -18,15 +23,28 @@
 #include "extendedgraphview.h"
 #include "datafilehandler.h"
 #include "projectfilehandler.h"
+#include "sessionfilehandler.h"
+#include "sessionfile.h"
+#include "stimulusmodel.h"
+#include "stimulusscheduler.h"
+#include "triggercapture.h"
+#include "alarmmonitor.h"
+#include "livesegmentwriter.h"
+#include "memoryforecast.h"
 #include "util.h"
 
 #include <QDateTime>
+#include <algorithm>
 
 const QString MainWindow::_cStateRunning = QString("Running");
 const QString MainWindow::_cStateStopped = QString("Stopped");
+const QString MainWindow::_cStateTriggerArmed = QString("Running - Trigger armed (%1 events)");
+const QString MainWindow::_cStateTriggerCapturing = QString("Running - Capturing (%1 events)");
 const QString MainWindow::_cStateDataLoaded = QString("Data File loaded");
 const QString MainWindow::_cStatsTemplate = QString("Success: %1\tErrors: %2");
 const QString MainWindow::_cRuntime = QString("Runtime: %1");
+const QString MainWindow::_cMemory = QString("Memory: %1");
+const QString MainWindow::_cAlarms = QString("Alarms: %1 active (%2 raised)");
 
 MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     QMainWindow(parent),
@@ -40,18 +58,33 @@ MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     _pGraphDataModel = new GraphDataModel(_pSettingsModel);
     _pNoteModel = new NoteModel();
     _pErrorLogModel = new ErrorLogModel();
+    _pStimulusModel = new StimulusModel();
+    _pPollTraceModel = new PollTraceModel();
+    _pStatisticsModel = new StatisticsModel(_pGraphDataModel);
 
     _pConnectionDialog = new ConnectionDialog(_pSettingsModel, this);
     _pLogDialog = new LogDialog(_pSettingsModel, _pGuiModel, this);
     _pErrorLogDialog = new ErrorLogDialog(_pErrorLogModel, this);
 
     _pNotesDock = new NotesDock(_pNoteModel, _pGuiModel, this);
+    _pPollTimelineDock = new PollTimelineDock(_pPollTraceModel, this);
+    _pStatisticsDock = new StatisticsDock(_pStatisticsModel, this);
+    _pSpectrumDock = new SpectrumDock(_pGraphDataModel, _pGuiModel, this);
 
     _pConnMan = new CommunicationManager(_pSettingsModel, _pGuiModel, _pGraphDataModel, _pErrorLogModel);
     _pGraphView = new ExtendedGraphView(_pConnMan, _pGuiModel, _pSettingsModel, _pGraphDataModel, _pNoteModel, _pUi->customPlot, this);
 
+    // Direct connection: events are timestamped on arrival
+    connect(_pConnMan, &CommunicationManager::traceEvent, _pPollTraceModel, &PollTraceModel::addEvent);
+
     _pDataFileHandler = new DataFileHandler(_pGuiModel, _pGraphDataModel, _pNoteModel, _pSettingsModel);
-    _pProjectFileHandler = new ProjectFileHandler(_pGuiModel, _pSettingsModel, _pGraphDataModel);
+    _pProjectFileHandler = new ProjectFileHandler(_pGuiModel, _pSettingsModel, _pGraphDataModel, _pStimulusModel);
+    _pSessionFileHandler = new SessionFileHandler(_pGuiModel, _pGraphDataModel, _pNoteModel);
+    _pStimulusScheduler = new StimulusScheduler(_pStimulusModel, _pConnMan);
+    _pTriggerCapture = new TriggerCapture(_pSettingsModel, _pGraphDataModel);
+    _pAlarmMonitor = new AlarmMonitor(_pSettingsModel, _pGraphDataModel);
+    _pLiveSegmentWriter = new LiveSegmentWriter(_pGraphDataModel);
+    _pMemoryForecast = new MemoryForecast();
 
     _pLegend = _pUi->legend;
     _pLegend->setModels(_pGuiModel, _pGraphDataModel);
@@ -65,15 +98,21 @@ MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     connect(_pUi->actionStop, SIGNAL(triggered()), this, SLOT(stopScope()));
     connect(_pUi->actionErrorLog, SIGNAL(triggered()), this, SLOT(showErrorLog()));
     connect(_pUi->actionManageNotes, SIGNAL(triggered()), this, SLOT(showNotesDialog()));
+    connect(_pUi->actionPollTimeline, SIGNAL(triggered()), this, SLOT(showPollTimeline()));
+    connect(_pUi->actionStatistics, SIGNAL(triggered()), this, SLOT(showStatistics()));
+    connect(_pUi->actionSpectrum, SIGNAL(triggered()), this, SLOT(showSpectrum()));
     connect(_pUi->actionExit, SIGNAL(triggered()), this, SLOT(exitApplication()));
     connect(_pUi->actionExportDataCsv, SIGNAL(triggered()), _pDataFileHandler, SLOT(selectDataExportFile()));
     connect(_pUi->actionLoadProjectFile, SIGNAL(triggered()), _pProjectFileHandler, SLOT(selectProjectSettingFile()));
     connect(_pUi->actionReloadProjectFile, SIGNAL(triggered()), _pProjectFileHandler, SLOT(reloadProjectFile()));
     connect(_pUi->actionImportDataFile, SIGNAL(triggered()), _pDataFileHandler, SLOT(selectDataImportFile()));
+    connect(_pUi->actionOpenSession, SIGNAL(triggered()), _pSessionFileHandler, SLOT(selectSessionOpenFile()));
+    connect(_pUi->actionSaveSession, SIGNAL(triggered()), _pSessionFileHandler, SLOT(selectSessionSaveFile()));
     connect(_pUi->actionExportImage, SIGNAL(triggered()), this, SLOT(selectImageExportFile()));
     connect(_pUi->actionExportSettings, SIGNAL(triggered()), _pProjectFileHandler, SLOT(selectSettingsExportFile()));
     connect(_pUi->actionAbout, SIGNAL(triggered()), this, SLOT(showAbout()));
     connect(_pUi->actionHighlightSamplePoints, SIGNAL(toggled(bool)), _pGuiModel, SLOT(setHighlightSamples(bool)));
+    connect(_pUi->actionLinearInterpolation, SIGNAL(toggled(bool)), _pGuiModel, SLOT(setLinearInterpolation(bool)));
     connect(_pUi->actionClearData, SIGNAL(triggered()), this, SLOT(clearData()));
     connect(_pUi->actionClearMarkers, SIGNAL(triggered()), _pGuiModel, SLOT(clearMarkersState()));
     connect(_pUi->actionConnectionSettings, SIGNAL(triggered()), this, SLOT(showConnectionDialog()));
@@ -86,6 +125,8 @@ MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     connect(_pGuiModel, SIGNAL(frontGraphChanged()), _pGraphView, SLOT(bringToFront()));
     connect(_pGuiModel, SIGNAL(highlightSamplesChanged()), this, SLOT(updateHighlightSampleMenu()));
     connect(_pGuiModel, SIGNAL(highlightSamplesChanged()), _pGraphView, SLOT(enableSamplePoints()));
+    connect(_pGuiModel, SIGNAL(linearInterpolationChanged()), this, SLOT(updateLinearInterpolationMenu()));
+    connect(_pGuiModel, SIGNAL(linearInterpolationChanged()), _pLegend, SLOT(updateDataInLegend()));
     connect(_pGuiModel, SIGNAL(cursorValuesChanged()), _pGraphView, SLOT(updateTooltip()));
     connect(_pGuiModel, SIGNAL(cursorValuesChanged()), _pLegend, SLOT(updateDataInLegend()));
 
@@ -126,12 +167,17 @@ MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     connect(_pGraphDataModel, SIGNAL(removed(quint32)), this, SLOT(rebuildGraphMenu()));
     connect(_pGraphDataModel, SIGNAL(removed(quint32)), _pGraphView, SLOT(updateGraphs()));
 
-    connect(_pGraphDataModel, SIGNAL(unsignedChanged(quint32)), _pGraphView, SLOT(clearGraph(quint32)));
-    connect(_pGraphDataModel, SIGNAL(multiplyFactorChanged(quint32)), _pGraphView, SLOT(clearGraph(quint32)));
-    connect(_pGraphDataModel, SIGNAL(divideFactorChanged(quint32)), _pGraphView, SLOT(clearGraph(quint32)));
+    connect(_pGraphDataModel, SIGNAL(modelReset()), this, SLOT(rebuildGraphMenu()));
+    connect(_pGraphDataModel, SIGNAL(modelReset()), _pGraphView, SLOT(updateGraphs()));
+
+    /* Raw register values are kept: recalculate graph when conversion settings change */
+    connect(_pGraphDataModel, SIGNAL(unsignedChanged(quint32)), _pGraphView, SLOT(reprocessGraph(quint32)));
+    connect(_pGraphDataModel, SIGNAL(multiplyFactorChanged(quint32)), _pGraphView, SLOT(reprocessGraph(quint32)));
+    connect(_pGraphDataModel, SIGNAL(divideFactorChanged(quint32)), _pGraphView, SLOT(reprocessGraph(quint32)));
+    connect(_pGraphDataModel, SIGNAL(bitmaskChanged(quint32)), _pGraphView, SLOT(reprocessGraph(quint32)));
+    connect(_pGraphDataModel, SIGNAL(shiftChanged(quint32)), _pGraphView, SLOT(reprocessGraph(quint32)));
+    connect(_pGraphDataModel, SIGNAL(wordOrderChanged(quint32)), _pGraphView, SLOT(reprocessGraph(quint32)));
     connect(_pGraphDataModel, SIGNAL(registerAddressChanged(quint32)), _pGraphView, SLOT(clearGraph(quint32)));
-    connect(_pGraphDataModel, SIGNAL(bitmaskChanged(quint32)), _pGraphView, SLOT(clearGraph(quint32)));
-    connect(_pGraphDataModel, SIGNAL(shiftChanged(quint32)), _pGraphView, SLOT(clearGraph(quint32)));
 
     // Update cursor values in legend
     connect(_pGraphView, SIGNAL(cursorValueUpdate()), _pLegend, SLOT(updateDataInLegend()));
@@ -160,10 +206,20 @@ MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     _pStatusStats->setFrameStyle(QFrame::Panel | QFrame::Sunken);
     _pStatusRuntime = new QLabel("", this);
     _pStatusRuntime->setFrameStyle(QFrame::Panel | QFrame::Sunken);
+    _pStatusMemory = new QLabel("", this);
+    _pStatusMemory->setFrameStyle(QFrame::Panel | QFrame::Sunken);
+    _pStatusAlarm = new QLabel("", this);
+    _pStatusAlarm->setFrameStyle(QFrame::Panel | QFrame::Sunken);
+    _pStatusAlarm->setVisible(false);
 
     _pUi->statusBar->addPermanentWidget(_pStatusState, 1);
     _pUi->statusBar->addPermanentWidget(_pStatusRuntime, 2);
     _pUi->statusBar->addPermanentWidget(_pStatusStats, 3);
+    _pUi->statusBar->addPermanentWidget(_pStatusMemory, 2);
+    _pUi->statusBar->addPermanentWidget(_pStatusAlarm, 2);
+
+    connect(&_memoryTimer, SIGNAL(timeout()), this, SLOT(updateMemoryUsage()));
+    _memoryTimer.start(1000);
 
     this->setAcceptDrops(true);
 
@@ -211,8 +267,22 @@ MainWindow::MainWindow(QStringList cmdArguments, QWidget *parent) :
     _pGuiModel->setxAxisScale(BasicGraphView::SCALE_AUTO);
     _pGuiModel->setyAxisScale(BasicGraphView::SCALE_AUTO);
 
-    connect(_pConnMan, SIGNAL(handleReceivedData(QList<bool>, QList<double>)), _pGraphView, SLOT(plotResults(QList<bool>, QList<double>)));
-    connect(_pConnMan, SIGNAL(handleReceivedData(QList<bool>, QList<double>)), _pLegend, SLOT(addLastReceivedDataToLegend(QList<bool>, QList<double>)));
+    /* Alarms are checked first, before samples are held by trigger capture or plot */
+    connect(_pConnMan, &CommunicationManager::handleReceivedData, _pAlarmMonitor, &AlarmMonitor::handleReceivedData);
+    connect(_pConnMan, &CommunicationManager::handleReceivedData, _pStatisticsModel, &StatisticsModel::handleReceivedData);
+    connect(_pConnMan, &CommunicationManager::handleReceivedData, _pSpectrumDock, &SpectrumDock::handleReceivedData);
+    connect(_pConnMan, &CommunicationManager::handleReceivedData, _pTriggerCapture, &TriggerCapture::handleReceivedData);
+    connect(_pConnMan, &CommunicationManager::handleReceivedData, _pLiveSegmentWriter, &LiveSegmentWriter::publishData);
+    connect(_pGraphDataModel, &GraphDataModel::memoryLimitReached, this, &MainWindow::handleMemoryLimitReached, Qt::QueuedConnection);
+    connect(_pTriggerCapture, &TriggerCapture::sampleReleased, _pGraphView, &ExtendedGraphView::plotResults);
+    connect(_pTriggerCapture, &TriggerCapture::triggered, this, &MainWindow::handleTriggered);
+    connect(_pTriggerCapture, &TriggerCapture::stateChanged, this, &MainWindow::updateTriggerState);
+    connect(_pAlarmMonitor, &AlarmMonitor::alarmRaised, this, &MainWindow::handleAlarmRaised);
+    connect(_pAlarmMonitor, &AlarmMonitor::alarmCleared, this, &MainWindow::handleAlarmCleared);
+    connect(_pAlarmMonitor, &AlarmMonitor::commandFailed, this, &MainWindow::handleAlarmCommandFailed);
+    connect(_pConnMan, SIGNAL(handleReceivedData(QList<bool>, QList<double>, QList<qint64>, QList<quint32>)), _pLegend, SLOT(addLastReceivedDataToLegend(QList<bool>, QList<double>)));
+    connect(_pConnMan, &CommunicationManager::registerWritten, this, &MainWindow::handleRegisterWritten);
+    connect(_pConnMan, &CommunicationManager::connectionFailover, this, &MainWindow::handleConnectionFailover);
 
     /* Update interface via model */
     _pGuiModel->triggerUpdate();
@@ -253,7 +323,16 @@ MainWindow::~MainWindow()
     delete _pGraphBringToFront;
     delete _pErrorLogModel;
     delete _pDataFileHandler;
+    delete _pSessionFileHandler;
     delete _pProjectFileHandler;
+    delete _pStimulusScheduler;
+    delete _pStimulusModel;
+    delete _pTriggerCapture;
+    delete _pAlarmMonitor;
+    delete _pLiveSegmentWriter;
+    delete _pMemoryForecast;
+    delete _pPollTraceModel;
+    delete _pStatisticsModel;
 
     delete _pUi;
 }
@@ -452,6 +531,235 @@ void MainWindow::addNoteToGraph(void)
     }
 }
 
+void MainWindow::handleRegisterWritten(quint8 connectionId, quint16 registerAddress, QList<quint16> registerDataList, bool bSuccess, qint64 timestamp)
+{
+    if (registerDataList.isEmpty())
+    {
+        return;
+    }
+
+    /* Show written value like the graph of the register does */
+    qint32 value;
+    if (_pGraphDataModel->isRegisterUnsigned(connectionId, registerAddress))
+    {
+        value = registerDataList.first();
+    }
+    else
+    {
+        value = static_cast<qint16>(registerDataList.first());
+    }
+
+    QString text = QString("Write %1 = %2 (Conn %3)").arg(registerAddress).arg(value).arg(connectionId);
+    if (!bSuccess)
+    {
+        text.append(" failed");
+    }
+
+    Note newNote;
+    newNote.setKeyData(timestampToKey(timestamp));
+    newNote.setValueData(value);
+    newNote.setText(text);
+
+    _pNoteModel->add(newNote);
+}
+
+void MainWindow::handleTriggered(qint64 timestamp, double value)
+{
+    Note newNote;
+    newNote.setKeyData(timestampToKey(timestamp));
+    newNote.setValueData(value);
+    newNote.setText(QString("Trigger %1: %2").arg(_pTriggerCapture->eventCount()).arg(_pSettingsModel->triggerCondition().description()));
+
+    _pNoteModel->add(newNote);
+}
+
+void MainWindow::handleConnectionFailover(quint8 connectionId, QString ipAddress, qint64 timestamp)
+{
+    Note newNote;
+    newNote.setKeyData(timestampToKey(timestamp));
+    newNote.setValueData(_pUi->customPlot->yAxis->range().center());
+    newNote.setText(QString("Failover to %1 (Conn %2)").arg(ipAddress).arg(connectionId));
+
+    _pNoteModel->add(newNote);
+}
+
+/*!
+ * Alarm note is placed on the sample that raised the alarm, also when the plot isn't updated
+ */
+void MainWindow::handleAlarmRaised(quint32 graphIdx, qint64 timestamp, double value)
+{
+    Note newNote;
+    newNote.setKeyData(timestampToKey(timestamp));
+    newNote.setValueData(value);
+    newNote.setText(QString("Alarm: %1 %2").arg(_pGraphDataModel->label(graphIdx)).arg(_pGraphDataModel->alarmRule(graphIdx).toString()));
+
+    _pNoteModel->add(newNote);
+
+    updateAlarmState();
+
+    QApplication::alert(this);
+}
+
+void MainWindow::handleAlarmCleared(quint32 graphIdx, qint64 timestamp, double value)
+{
+    Note newNote;
+    newNote.setKeyData(timestampToKey(timestamp));
+    newNote.setValueData(value);
+    newNote.setText(QString("Alarm cleared: %1").arg(_pGraphDataModel->label(graphIdx)));
+
+    _pNoteModel->add(newNote);
+
+    updateAlarmState();
+}
+
+/*!
+ * Misconfigured alarm command is reported in error log and alarm status, logging continues
+ */
+void MainWindow::handleAlarmCommandFailed(QString command)
+{
+    ErrorLog log = ErrorLog(ErrorLog::LOG_ERROR, QDateTime::currentDateTime(), tr("Alarm command (%1) couldn't be started").arg(command));
+    _pErrorLogModel->addItem(log);
+
+    updateAlarmState();
+}
+
+void MainWindow::updateAlarmState()
+{
+    if (_pAlarmMonitor->alarmCount() > 0)
+    {
+        QString alarmText = _cAlarms.arg(_pAlarmMonitor->activeAlarmCount()).arg(_pAlarmMonitor->alarmCount());
+
+        if (_pAlarmMonitor->isCommandFailed())
+        {
+            alarmText.append(tr(", command failed (see error log)"));
+        }
+
+        _pStatusAlarm->setText(alarmText);
+        _pStatusAlarm->setVisible(true);
+    }
+    else
+    {
+        _pStatusAlarm->setVisible(false);
+    }
+
+    if (_pAlarmMonitor->activeAlarmCount() > 0)
+    {
+        _pStatusAlarm->setStyleSheet("QLabel { color: white; background-color: red; }");
+    }
+    else
+    {
+        _pStatusAlarm->setStyleSheet("");
+    }
+}
+
+void MainWindow::updateTriggerState()
+{
+    if (_pGuiModel->guiState() == GuiModel::STARTED)
+    {
+        if (_pTriggerCapture->state() == TriggerCapture::ARMED)
+        {
+            _pStatusState->setText(_cStateTriggerArmed.arg(_pTriggerCapture->eventCount()));
+        }
+        else if (_pTriggerCapture->state() == TriggerCapture::CAPTURING)
+        {
+            _pStatusState->setText(_cStateTriggerCapturing.arg(_pTriggerCapture->eventCount()));
+        }
+        else
+        {
+            _pStatusState->setText(_cStateRunning);
+        }
+    }
+}
+
+/*!
+ * Show memory used by samples, plot and error log in status bar
+ * While logging, the time until the retention memory is used is forecast from the growth of the samples.
+ */
+void MainWindow::updateMemoryUsage()
+{
+    const qint64 sampleSize = _pGraphDataModel->totalMemorySize();
+    const qint64 plotSize = _pGraphView->plotMemorySize();
+    const qint64 errorLogSize = _pErrorLogModel->memorySize();
+    const qint64 limit = static_cast<qint64>(_pSettingsModel->retentionMemory()) * 1024 * 1024;
+
+    QString memoryText = formatMemorySize(sampleSize + plotSize + errorLogSize);
+
+    if (_pGuiModel->guiState() == GuiModel::STARTED)
+    {
+        _pMemoryForecast->addMeasurement(QDateTime::currentMSecsSinceEpoch(), sampleSize);
+
+        const qint64 timeUntilLimit = _pMemoryForecast->timeUntilLimit(limit);
+
+        if (_pGraphDataModel->samplesDropped())
+        {
+            memoryText += tr(" (oldest samples removed)");
+        }
+        else if ((limit != 0) && (timeUntilLimit == 0))
+        {
+            memoryText += tr(" (limit reached)");
+        }
+        else if ((limit != 0) && (timeUntilLimit > 0))
+        {
+            const qint64 minutes = timeUntilLimit / (60 * 1000);
+            if (minutes >= 60)
+            {
+                memoryText += tr(" (limit in %1 h %2 min)").arg(minutes / 60).arg(minutes % 60);
+            }
+            else
+            {
+                memoryText += tr(" (limit in %1 min)").arg(qMax(minutes, static_cast<qint64>(1)));
+            }
+        }
+        else if (_pMemoryForecast->growthRate() > 0)
+        {
+            memoryText += tr(" (+%1/h)").arg(formatMemorySize(static_cast<qint64>(_pMemoryForecast->growthRate() * 3600)));
+        }
+        else
+        {
+            // Not enough measurements yet or memory isn't growing
+        }
+    }
+
+    _pStatusMemory->setText(_cMemory.arg(memoryText));
+
+    /* Breakdown: largest graphs first */
+    QList<QPair<qint64, quint32> > graphSizeList;
+    for (qint32 idx = 0; idx < _pGraphDataModel->size(); idx++)
+    {
+        graphSizeList.append(qMakePair(_pGraphDataModel->memorySize(static_cast<quint32>(idx)), static_cast<quint32>(idx)));
+    }
+    std::sort(graphSizeList.begin(), graphSizeList.end(), [](const QPair<qint64, quint32> &a, const QPair<qint64, quint32> &b) { return a.first > b.first; });
+
+    QString toolTip = tr("Samples: %1").arg(formatMemorySize(sampleSize));
+    if (limit != 0)
+    {
+        toolTip += tr(" of %1").arg(formatMemorySize(limit));
+    }
+
+    for (qint32 idx = 0; idx < qMin(graphSizeList.size(), static_cast<qint32>(_cMemoryToolTipGraphs)); idx++)
+    {
+        toolTip += QString("\n    %1: %2").arg(_pGraphDataModel->label(graphSizeList[idx].second)).arg(formatMemorySize(graphSizeList[idx].first));
+    }
+
+    toolTip += tr("\nPlot: %1").arg(formatMemorySize(plotSize));
+    toolTip += tr("\nError log: %1").arg(formatMemorySize(errorLogSize));
+
+    _pStatusMemory->setToolTip(toolTip);
+}
+
+/*!
+ * Retention memory is used while log is set to stop at memory limit
+ */
+void MainWindow::handleMemoryLimitReached()
+{
+    if (_pGuiModel->guiState() == GuiModel::STARTED)
+    {
+        stopScope();
+
+        Util::showError(tr("Memory limit of %1 MB is reached, logging is stopped.").arg(_pSettingsModel->retentionMemory()));
+    }
+}
+
 void MainWindow::clearData()
 {
     _pConnMan->resetCommunicationStats();
@@ -482,6 +790,27 @@ void MainWindow::startScope()
         if (_pConnMan->startCommunication())
         {
             clearData();
+            _pPollTraceModel->clear();
+            _pMemoryForecast->clear();
+
+            /* Start stimuli after clear, so write notes are kept */
+            _pStimulusScheduler->start();
+
+            if (!_pTriggerCapture->start())
+            {
+                Util::showError(tr("Trigger register %1 is not an active register in the scope list. All data is logged.").arg(_pSettingsModel->triggerCondition().description()));
+            }
+
+            if (_pSettingsModel->publishLiveData() && !_pLiveSegmentWriter->start(LiveSegmentDefinitions::defaultPath()))
+            {
+                Util::showError(_pLiveSegmentWriter->errorString());
+            }
+
+            _pAlarmMonitor->start();
+            updateAlarmState();
+
+            _pStatisticsModel->start();
+            _pSpectrumDock->start();
         }
 
         if (_pSettingsModel->writeDuringLog())
@@ -508,7 +837,14 @@ void MainWindow::startScope()
 
 void MainWindow::stopScope()
 {
+    _pStimulusScheduler->stop();
+    _pTriggerCapture->stop();
+    _pAlarmMonitor->stop();
+    updateAlarmState();
     _pConnMan->stopCommunication();
+    _pLiveSegmentWriter->stop();
+
+    _pGraphView->flushResults();
 
     if (_pSettingsModel->writeDuringLog())
     {
@@ -528,6 +864,21 @@ void MainWindow::showNotesDialog()
     _pNotesDock->show();
 }
 
+void MainWindow::showPollTimeline()
+{
+    _pPollTimelineDock->show();
+}
+
+void MainWindow::showStatistics()
+{
+    _pStatisticsDock->show();
+}
+
+void MainWindow::showSpectrum()
+{
+    _pSpectrumDock->show();
+}
+
 void MainWindow::handleGraphVisibilityChange(const quint32 graphIdx)
 {
     if (_pGraphDataModel->isActive(graphIdx))
@@ -594,6 +945,12 @@ void MainWindow::updateHighlightSampleMenu()
     _pUi->actionHighlightSamplePoints->setChecked(_pGuiModel->highlightSamples());
 }
 
+void MainWindow::updateLinearInterpolationMenu()
+{
+    /* set menu to checked */
+    _pUi->actionLinearInterpolation->setChecked(_pGuiModel->linearInterpolation());
+}
+
 void MainWindow::rebuildGraphMenu()
 {
     // Regenerate graph menu
@@ -712,8 +1069,10 @@ void MainWindow::updateGuiState()
         _pUi->actionRegisterSettings->setEnabled(true);
         _pUi->actionStart->setEnabled(true);
         _pUi->actionImportDataFile->setEnabled(true);
+        _pUi->actionOpenSession->setEnabled(true);
         _pUi->actionLoadProjectFile->setEnabled(true);
         _pUi->actionExportDataCsv->setEnabled(false);
+        _pUi->actionSaveSession->setEnabled(false);
         _pUi->actionExportImage->setEnabled(false);
         _pUi->actionExportSettings->setEnabled(true);
 
@@ -737,8 +1096,10 @@ void MainWindow::updateGuiState()
         _pUi->actionRegisterSettings->setEnabled(false);
         _pUi->actionStart->setEnabled(false);
         _pUi->actionImportDataFile->setEnabled(false);
+        _pUi->actionOpenSession->setEnabled(false);
         _pUi->actionLoadProjectFile->setEnabled(false);
         _pUi->actionExportDataCsv->setEnabled(false);
+        _pUi->actionSaveSession->setEnabled(false);
         _pUi->actionExportSettings->setEnabled(false);
         _pUi->actionExportImage->setEnabled(false);
         _pUi->actionReloadProjectFile->setEnabled(false);
@@ -760,8 +1121,10 @@ void MainWindow::updateGuiState()
         _pUi->actionRegisterSettings->setEnabled(true);
         _pUi->actionStart->setEnabled(true);
         _pUi->actionImportDataFile->setEnabled(true);
+        _pUi->actionOpenSession->setEnabled(true);
         _pUi->actionLoadProjectFile->setEnabled(true);
         _pUi->actionExportDataCsv->setEnabled(true);
+        _pUi->actionSaveSession->setEnabled(true);
         _pUi->actionExportSettings->setEnabled(true);
         _pUi->actionExportImage->setEnabled(true);
 
@@ -786,8 +1149,10 @@ void MainWindow::updateGuiState()
         _pUi->actionRegisterSettings->setEnabled(true);
         _pUi->actionStart->setEnabled(true);
         _pUi->actionImportDataFile->setEnabled(true);
+        _pUi->actionOpenSession->setEnabled(true);
         _pUi->actionLoadProjectFile->setEnabled(true);
         _pUi->actionExportDataCsv->setEnabled(false); // Can't export data when viewing data
+        _pUi->actionSaveSession->setEnabled(true);
         _pUi->actionExportSettings->setEnabled(false); // Can't export data when viewing data
         _pUi->actionExportImage->setEnabled(true);
 
@@ -894,6 +1259,10 @@ void MainWindow::dropEvent(QDropEvent *e)
         {
             _pDataFileHandler->loadDataFile(filename);
         }
+        else if (fileInfo.completeSuffix().toLower() == SessionFile::cFileExtension)
+        {
+            _pSessionFileHandler->loadSessionFile(filename);
+        }
         else if (fileInfo.completeSuffix().toLower() == QString("mbc"))
         {
             showRegisterDialog(filename);
@@ -961,6 +1330,33 @@ void MainWindow::updateDataFileNotes()
     }
 }
 
+/*!
+ * Convert timestamp (ms since epoch) to key in graph, same time base as received data
+ */
+double MainWindow::timestampToKey(qint64 timestamp)
+{
+    if (_pSettingsModel->absoluteTimes())
+    {
+        return timestamp;
+    }
+    else
+    {
+        return timestamp - _pGuiModel->communicationStartTime();
+    }
+}
+
+QString MainWindow::formatMemorySize(qint64 size)
+{
+    if (size < 1024 * 1024)
+    {
+        return QString("%1 kB").arg(static_cast<double>(size) / 1024, 0, 'f', 1);
+    }
+    else
+    {
+        return QString("%1 MB").arg(static_cast<double>(size) / (1024 * 1024), 0, 'f', 1);
+    }
+}
+
 void MainWindow::handleCommandLineArguments(QStringList cmdArguments)
 {
     QCommandLineParser argumentParser;
@@ -30,7 +30,19 @@ class GuiModel;
 class ExtendedGraphView;
 class MarkerInfo;
 class DataFileHandler;
+class SessionFileHandler;
 class ProjectFileHandler;
+class StimulusModel;
+class StimulusScheduler;
+class TriggerCapture;
+class AlarmMonitor;
+class LiveSegmentWriter;
+class MemoryForecast;
+class PollTraceModel;
+class PollTimelineDock;
+class StatisticsModel;
+class StatisticsDock;
+class SpectrumDock;
 
 class MainWindow : public QMainWindow
 {
@@ -70,6 +82,9 @@ private slots:
     void stopScope();
     void showErrorLog();
     void showNotesDialog();
+    void showPollTimeline();
+    void showStatistics();
+    void showSpectrum();
 
     /* Model change handlers */
     void handleGraphVisibilityChange(const quint32 graphIdx);
@@ -78,6 +93,7 @@ private slots:
 
     void updateBringToFrontGrapMenu();
     void updateHighlightSampleMenu();
+    void updateLinearInterpolationMenu();
     void rebuildGraphMenu();
     void updateWindowTitle();
     void updatexAxisSlidingMode();
@@ -101,10 +117,22 @@ private slots:
     void yAxisScaleGroupClicked(int id);
     void updateRuntime();
     void updateDataFileNotes();
+    void handleRegisterWritten(quint8 connectionId, quint16 registerAddress, QList<quint16> registerDataList, bool bSuccess, qint64 timestamp);
+    void handleTriggered(qint64 timestamp, double value);
+    void handleConnectionFailover(quint8 connectionId, QString ipAddress, qint64 timestamp);
+    void updateTriggerState();
+    void handleAlarmRaised(quint32 graphIdx, qint64 timestamp, double value);
+    void handleAlarmCleared(quint32 graphIdx, qint64 timestamp, double value);
+    void handleAlarmCommandFailed(QString command);
+    void updateAlarmState();
+    void updateMemoryUsage();
+    void handleMemoryLimitReached();
 
 private:
 
     void handleCommandLineArguments(QStringList cmdArguments);
+    double timestampToKey(qint64 timestamp);
+    static QString formatMemorySize(qint64 size);
 
     Ui::MainWindow * _pUi;
     CommunicationManager * _pConnMan;
@@ -114,6 +142,9 @@ private:
     GraphDataModel * _pGraphDataModel;
     NoteModel * _pNoteModel;
     ErrorLogModel * _pErrorLogModel;
+    StimulusModel * _pStimulusModel;
+    PollTraceModel * _pPollTraceModel;
+    StatisticsModel * _pStatisticsModel;
     GuiModel * _pGuiModel;
 
     ConnectionDialog * _pConnectionDialog;
@@ -121,19 +152,31 @@ private:
     ErrorLogDialog * _pErrorLogDialog;
 
     DataFileHandler* _pDataFileHandler;
+    SessionFileHandler* _pSessionFileHandler;
     ProjectFileHandler* _pProjectFileHandler;
+    StimulusScheduler* _pStimulusScheduler;
+    TriggerCapture* _pTriggerCapture;
+    AlarmMonitor* _pAlarmMonitor;
+    LiveSegmentWriter* _pLiveSegmentWriter;
+    MemoryForecast* _pMemoryForecast;
 
     NotesDock * _pNotesDock;
+    PollTimelineDock * _pPollTimelineDock;
+    StatisticsDock * _pStatisticsDock;
+    SpectrumDock * _pSpectrumDock;
     MarkerInfo * _pMarkerInfo;
     Legend * _pLegend;
 
     QLabel * _pStatusStats;
     QLabel * _pStatusState;
     QLabel * _pStatusRuntime;
+    QLabel * _pStatusMemory;
+    QLabel * _pStatusAlarm;
     QButtonGroup * _pXAxisScaleGroup;
     QButtonGroup * _pYAxisScaleGroup;
 
     QTimer _runtimeTimer;
+    QTimer _memoryTimer;
 
     QMenu _menuRightClick;
 
@@ -145,9 +188,16 @@ private:
 
     static const QString _cStateRunning;
     static const QString _cStateStopped;
+    static const QString _cStateTriggerArmed;
+    static const QString _cStateTriggerCapturing;
     static const QString _cStatsTemplate;
     static const QString _cStateDataLoaded;
     static const QString _cRuntime;
+    static const QString _cMemory;
+    static const QString _cAlarms;
+
+    /* Number of graphs in breakdown of memory tooltip */
+    static const qint32 _cMemoryToolTipGraphs = 8;
 };
 
 #endif // MAINWINDOW_H
@@ -4,6 +4,7 @@
 #include "registerdialog.h"
 #include "importmbcdialog.h"
 #include "registerconndelegate.h"
+#include "registertypedelegate.h"
 
 #include "ui_registerdialog.h"
 
@@ -26,6 +27,9 @@ RegisterDialog::RegisterDialog(GuiModel *pGuiModel, GraphDataModel * pGraphDataM
     RegisterConnDelegate* cbConn = new RegisterConnDelegate(pSettingsModel,_pUi->registerView);
     _pUi->registerView->setItemDelegateForColumn(9, cbConn);
 
+    RegisterTypeDelegate* cbType = new RegisterTypeDelegate(_pUi->registerView);
+    _pUi->registerView->setItemDelegateForColumn(10, cbType);
+
     /* Don't stretch columns */
     _pUi->registerView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
 
@@ -158,17 +162,12 @@ void RegisterDialog::removeRegisterRow()
     QItemSelectionModel *selected = _pUi->registerView->selectionModel();
     QModelIndexList rowList = selected->selectedRows();
 
-    // sort QModelIndexList
-    // We need to remove the highest rows first
-    std::sort(rowList.begin(), rowList.end(), &RegisterDialog::sortRegistersLastFirst);
-
+    // Remove all selected rows at once
+    QList<qint32> idxList;
     foreach(QModelIndex rowIndex, rowList)
     {
-        _pGraphDataModel->removeRow(rowIndex.row());
+        idxList.append(rowIndex.row());
     }
-}
 
-bool RegisterDialog::sortRegistersLastFirst(const QModelIndex &s1, const QModelIndex &s2)
-{
-    return s1.row() > s2.row();
+    _pGraphDataModel->removeRegisters(idxList);
 }
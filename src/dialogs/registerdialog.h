@@ -36,8 +36,6 @@ private slots:
 
 private:
 
-    static bool sortRegistersLastFirst(const QModelIndex &s1, const QModelIndex &s2);
-
     Ui::RegisterDialog * _pUi;
 
     GraphDataModel * _pGraphDataModel;
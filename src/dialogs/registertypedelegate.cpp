@@ -0,0 +1,51 @@
+#include <QComboBox>
+
+#include "graphdata.h"
+#include "registertypedelegate.h"
+
+RegisterTypeDelegate::RegisterTypeDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+RegisterTypeDelegate::~RegisterTypeDelegate()
+{
+}
+
+QWidget *RegisterTypeDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+
+    // Create the combobox and populate it (index is value type)
+    QComboBox *cb = new QComboBox(parent);
+
+    for (qint32 idx = GraphData::VALUE_16BIT; idx <= GraphData::VALUE_FLOAT32; idx++)
+    {
+        cb->addItem(GraphData::valueTypeToString(static_cast<GraphData::ValueType>(idx)));
+    }
+
+    return cb;
+}
+
+void RegisterTypeDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    QComboBox *cb = qobject_cast<QComboBox *>(editor);
+    Q_ASSERT(cb);
+
+    const qint32 cbIndex = static_cast<qint32>(index.data(Qt::EditRole).toUInt());
+
+    cb->setCurrentIndex(cbIndex);
+}
+
+void RegisterTypeDelegate::setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const
+{
+    QComboBox *cb = qobject_cast<QComboBox *>(editor);
+    Q_ASSERT(cb);
+    model->setData(index, cb->currentIndex(), Qt::EditRole);
+}
+
+void RegisterTypeDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option, const QModelIndex &/* index */) const
+{
+    editor->setGeometry(option.rect);
+}
@@ -0,0 +1,19 @@
+#ifndef REGISTER_TYPE_DELEGATE_H
+#define REGISTER_TYPE_DELEGATE_H
+
+#include <QStyledItemDelegate>
+
+class RegisterTypeDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    RegisterTypeDelegate(QObject *parent = nullptr);
+    ~RegisterTypeDelegate() override;
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const override;
+    void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option, const QModelIndex &/* index */) const override;
+};
+
+#endif // REGISTER_TYPE_DELEGATE_H
@@ -9,8 +9,10 @@
 #include "util.h"
 #include "graphdatamodel.h"
 #include "notemodel.h"
+#include "timebasealigner.h"
 #include "myqcpaxistickertime.h"
 #include "myqcpaxis.h"
+#include "samplegraph.h"
 #include "basicgraphview.h"
 
 BasicGraphView::BasicGraphView(GuiModel * pGuiModel, GraphDataModel * pGraphDataModel, NoteModel *pNoteModel, MyQCustomPlot * pPlot, QObject *parent) :
@@ -108,7 +110,22 @@ BasicGraphView::~BasicGraphView()
 
 qint32 BasicGraphView::graphDataSize()
 {
-    return _pPlot->graph(0)->data()->size();
+    return referenceSeries().size();
+}
+
+/*!
+ * Memory (in bytes) used by the plot: render data of graphs (only visible samples) and paint buffers
+ */
+qint64 BasicGraphView::plotMemorySize() const
+{
+    qint64 size = _pPlot->paintBufferMemorySize();
+
+    for (qint32 graphIdx = 0; graphIdx < _pPlot->graphCount(); graphIdx++)
+    {
+        size += _pPlot->graph(graphIdx)->data()->size() * static_cast<qint64>(sizeof(QCPGraphData));
+    }
+
+    return size;
 }
 
 bool BasicGraphView::valuesUnderCursor(QList<double> &valueList)
@@ -119,10 +136,11 @@ bool BasicGraphView::valuesUnderCursor(QList<double> &valueList)
 
     if (_pPlot->graphCount() > 0)
     {
-        QCPGraphDataContainer::const_iterator tooltipIt = getClosestPoint(xPos);
+        const SampleSeries referenceSeries = this->referenceSeries();
+        const qint32 tooltipIdx = getClosestPoint(referenceSeries, xPos);
 
         bool bValid;
-        const QCPRange keyRange = _pPlot->graph(0)->data()->keyRange(bValid);
+        const QCPRange keyRange = referenceSeries.keyRange(bValid);
 
         // Check all graphs
         for (qint32 activeGraphIndex = 0; activeGraphIndex < _pPlot->graphCount(); activeGraphIndex++)
@@ -134,8 +152,9 @@ bool BasicGraphView::valuesUnderCursor(QList<double> &valueList)
                 )
             {
                 const qint32 graphIdx = _pGraphDataModel->convertToGraphIndex(activeGraphIndex);
-                QCPGraphDataContainer::const_iterator graphDataIt = _pGraphDataModel->dataMap(graphIdx).data()->findBegin(tooltipIt->key, false);
-                valueList.append(graphDataIt->value);
+                // Graphs of other connections are sampled on different timestamps: align to key of reference graph
+                const bool bLinear = _pGuiModel->linearInterpolation() || _pGraphDataModel->ingestFilter(graphIdx).isLinear();
+                valueList.append(TimebaseAligner::alignedValue(_pGraphDataModel->series(graphIdx), referenceSeries.key(tooltipIdx), bLinear));
             }
             else
             {
@@ -214,24 +233,37 @@ void BasicGraphView::clearGraph(const quint32 graphIdx)
         else if (activeGraphList.size() == 1)
         {
             /* Only one graph active: clear all data */
-            _pGraphDataModel->dataMap(graphIdx)->clear();
+            _pGraphDataModel->clearSamples();
 
             _pPlot->replot();
         }
         else
         {
             /* Several active graph, keep time data but clear data */
-            QCPGraphDataContainer::iterator it = _pGraphDataModel->dataMap(graphIdx)->begin();
+            _pGraphDataModel->clearValues(graphIdx);
 
-            /* Clear all values, keep keys */
-            while(it != _pGraphDataModel->dataMap(graphIdx)->end())
-            {
-                it->value = 0u;
-                it++;
-            }
+            _pPlot->replot();
+        }
+    }
+}
 
+/*!
+ * Update graph after change of conversion settings
+ * Values are converted from the raw register values on read, so the history is kept.
+ * Graphs without raw values (loaded from data file) are cleared.
+ */
+void BasicGraphView::reprocessGraph(const quint32 graphIdx)
+{
+    if (_pGraphDataModel->isActive(graphIdx))
+    {
+        if (_pGraphDataModel->hasRawValues(graphIdx))
+        {
             _pPlot->replot();
         }
+        else
+        {
+            clearGraph(graphIdx);
+        }
     }
 }
 
@@ -243,63 +275,24 @@ void BasicGraphView::updateGraphs()
     QList<quint16> activeGraphList;
     _pGraphDataModel->activeGraphIndexList(&activeGraphList);
 
-    if (activeGraphList.size() > 0)
+    foreach(quint16 graphIdx, activeGraphList)
     {
-        // All graphs should have the same amount of points.
-        // Loop over graphs and get maximum count of samples
-        qint32 maxSampleCount = 0;
-        quint32 maxSampleIdx = 0;
-
-        foreach(quint16 graphIdx, activeGraphList)
-        {
-            const qint32 sampleCount = _pGraphDataModel->dataMap(graphIdx)->size();
-            if (sampleCount > maxSampleCount)
-            {
-                maxSampleCount = sampleCount;
-                maxSampleIdx = graphIdx;
-            }
-        }
-
-        // Graph that have less points will be zeroed with that amount of points
-        foreach(quint16 graphIdx, activeGraphList)
-        {
-            // Add graph
-            QCPGraph * pGraph = _pPlot->addGraph();
-
-            pGraph->setName(_pGraphDataModel->label(graphIdx));
+        // Add graph: samples are read from graph data model when graph is drawn
+        QCPGraph * pGraph = new SampleGraph(_pGraphDataModel, graphIdx, _pPlot->xAxis, _pPlot->yAxis);
 
-            QPen pen;
-            pen.setColor(_pGraphDataModel->color(graphIdx));
-            pen.setWidth(2);
-            pen.setCosmetic(true);
+        pGraph->setName(_pGraphDataModel->label(graphIdx));
 
-            pGraph->setPen(pen);
-
-            /* Keep visibility state */
-            /* TODO: partial duplicate of showGraph in ExtendedGraph */
-            const bool bShow = _pGraphDataModel->isVisible(graphIdx);
-            pGraph->setVisible(bShow);
-
-            QSharedPointer<QCPGraphDataContainer> pMap = _pGraphDataModel->dataMap(graphIdx);
-
-            // Set data to zero when needed
-            if (pMap->size() != maxSampleCount)
-            {
-                const QSharedPointer<QCPGraphDataContainer> pReferenceMap = _pGraphDataModel->dataMap(maxSampleIdx);
-                pMap->clear();
+        QPen pen;
+        pen.setColor(_pGraphDataModel->color(graphIdx));
+        pen.setWidth(2);
+        pen.setCosmetic(true);
 
-                // Add zero value for every key (x-coordinate)
-                QCPGraphDataContainer::const_iterator refIt = pReferenceMap->constBegin();
-                while(refIt != pReferenceMap->constEnd())
-                {
-                    pMap->add(QCPGraphData(refIt->key, 0));
-                    refIt++;
-                }
-            }
+        pGraph->setPen(pen);
 
-            // Set graph datamap
-            pGraph->setData(pMap);
-        }
+        /* Keep visibility state */
+        /* TODO: partial duplicate of showGraph in ExtendedGraph */
+        const bool bShow = _pGraphDataModel->isVisible(graphIdx);
+        pGraph->setVisible(bShow);
     }
 
     _pPlot->replot();
@@ -442,18 +435,19 @@ void BasicGraphView::mousePress(QMouseEvent *event)
        _pPlot->setInteraction(QCP::iRangeDrag, false);
        _pPlot->setInteraction(QCP::iRangeZoom, false);
 
-       if (_pPlot->graphCount() > 0)
+       const SampleSeries referenceSeries = this->referenceSeries();
+       if ((_pPlot->graphCount() > 0) && !referenceSeries.isEmpty())
        {
            const double xPos = _pPlot->xAxis->pixelToCoord(event->pos().x());
-           QCPGraphDataContainer::const_iterator markerPosIt = getClosestPoint(xPos);
+           const qint32 markerPosIdx = getClosestPoint(referenceSeries, xPos);
 
            if (event->button() & Qt::LeftButton)
            {
-                _pGuiModel->setStartMarkerPos(markerPosIt->key);
+                _pGuiModel->setStartMarkerPos(referenceSeries.key(markerPosIdx));
            }
            else if (event->button() & Qt::RightButton)
            {
-                _pGuiModel->setEndMarkerPos(markerPosIt->key);
+                _pGuiModel->setEndMarkerPos(referenceSeries.key(markerPosIdx));
            }
            else
            {
@@ -586,15 +580,17 @@ void BasicGraphView::paintTimeStampToolTip(QPoint pos)
     {
 
         const double xPos = _pPlot->xAxis->pixelToCoord(pos.x());
-        QCPGraphDataContainer::const_iterator tooltipIt = getClosestPoint(xPos);
+        const SampleSeries referenceSeries = this->referenceSeries();
 
         bool bValid;
-        const QCPRange keyRange = _pPlot->graph(0)->data()->keyRange(bValid);
+        const QCPRange keyRange = referenceSeries.keyRange(bValid);
 
         if (bValid && keyRange.contains(xPos))
         {
+            const qint32 tooltipIdx = getClosestPoint(referenceSeries, xPos);
+
             // Add tick key string
-            QString toolText = Util::formatTime(tooltipIt->key, false);
+            QString toolText = Util::formatTime(referenceSeries.key(tooltipIdx), false);
 
             QToolTip::showText(_pPlot->mapToGlobal(pos), toolText, _pPlot);
 
@@ -623,19 +619,20 @@ void BasicGraphView::handleSamplePoints()
         if (_pPlot->graphCount() > 0 && (graphDataSize() > 0))
         {
             QCPRange axisRange = _pPlot->xAxis->range();
+            const SampleSeries referenceSeries = this->referenceSeries();
 
-            auto lowerBoundIt = _pPlot->graph(0)->data()->findBegin(axisRange.lower, false);
-            auto upperBoundIt = _pPlot->graph(0)->data()->findBegin(axisRange.upper);
+            const qint32 lowerBoundIdx = qMin(referenceSeries.findBegin(axisRange.lower, false), referenceSeries.size() - 1);
+            const qint32 upperBoundIdx = referenceSeries.findBegin(axisRange.upper);
 
-            const int pointCount = upperBoundIt - lowerBoundIt;
+            const int pointCount = upperBoundIdx - lowerBoundIdx;
 
             /* Get size in pixels */
-            const double sizePx = _pPlot->xAxis->coordToPixel(upperBoundIt->key) - _pPlot->xAxis->coordToPixel(lowerBoundIt->key);
+            const double sizePx = _pPlot->xAxis->coordToPixel(referenceSeries.key(upperBoundIdx)) - _pPlot->xAxis->coordToPixel(referenceSeries.key(lowerBoundIdx));
 
             /* Calculate number of pixels per point */
             double nrOfPixelsPerPoint;
 
-            if (lowerBoundIt != upperBoundIt)
+            if (lowerBoundIdx != upperBoundIdx)
             {
                 nrOfPixelsPerPoint = sizePx / qAbs(pointCount);
             }
@@ -703,31 +700,44 @@ qint32 BasicGraphView::graphIndex(QCPGraph * pGraph)
     return ret;
 }
 
-QCPGraphDataContainer::const_iterator BasicGraphView::getClosestPoint(double xPos)
+/*!
+ * Get index of sample closest to key
+ * \param series    Samples (not empty)
+ * \param xPos      Key
+ */
+qint32 BasicGraphView::getClosestPoint(const SampleSeries &series, double xPos)
 {
-    QCPGraphDataContainer::const_iterator closestIt = _pPlot->graph(0)->data()->constBegin();
-    QCPGraphDataContainer::const_iterator leftIt = _pPlot->graph(0)->data()->findBegin(xPos);
+    qint32 closestIdx;
+    const qint32 leftIdx = series.findBegin(xPos);
 
-    auto rightIt = leftIt + 1;
-    if (rightIt !=  _pPlot->graph(0)->data()->constEnd())
+    const qint32 rightIdx = leftIdx + 1;
+    if (rightIdx < series.size())
     {
 
-        const double diffReference = rightIt->key - leftIt->key;
-        const double diffPos = xPos - leftIt->key;
+        const double diffReference = series.key(rightIdx) - series.key(leftIdx);
+        const double diffPos = xPos - series.key(leftIdx);
 
         if (diffPos > (diffReference / 2))
         {
-            closestIt = rightIt;
+            closestIdx = rightIdx;
         }
         else
         {
-            closestIt = leftIt;
+            closestIdx = leftIdx;
         }
     }
     else
     {
-        closestIt = leftIt;
+        closestIdx = leftIdx;
     }
 
-    return closestIt;
+    return closestIdx;
+}
+
+/*!
+ * Get samples of reference graph (first active graph), its keys form the common timebase
+ */
+SampleSeries BasicGraphView::referenceSeries()
+{
+    return _pGraphDataModel->referenceSeries();
 }
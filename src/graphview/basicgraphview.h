@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include "myqcustomplot.h"
+#include "sampleseries.h"
 
 
 /* forward declaration */
@@ -28,6 +29,7 @@ public:
     virtual ~BasicGraphView();
 
     qint32 graphDataSize();
+    qint64 plotMemorySize() const;
     bool valuesUnderCursor(QList<double> &valueList);
 
     double pixelToKey(double pixel);
@@ -44,6 +46,7 @@ public slots:
     virtual void updateTooltip();
     virtual void enableSamplePoints();
     virtual void clearGraph(const quint32 graphIdx);
+    void reprocessGraph(const quint32 graphIdx);
     virtual void updateGraphs();
     virtual void changeGraphColor(const quint32 graphIdx);
     virtual void changeGraphLabel(const quint32 graphIdx);
@@ -75,6 +78,7 @@ protected slots:
 
 protected:
     void paintTimeStampToolTip(QPoint pos);
+    SampleSeries referenceSeries();
 
     GuiModel * _pGuiModel;
     GraphDataModel * _pGraphDataModel;
@@ -85,7 +89,7 @@ protected:
 private:
     void highlightSamples(bool bState);
     qint32 graphIndex(QCPGraph * pGraph);
-    QCPGraphDataContainer::const_iterator getClosestPoint(double xPos);
+    qint32 getClosestPoint(const SampleSeries &series, double xPos);
 
     QVector<QString> _tickLabels;
     QList<QCPItemText *> _notesItems;
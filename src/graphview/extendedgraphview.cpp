@@ -8,13 +8,17 @@
 #include "settingsmodel.h"
 
 ExtendedGraphView::ExtendedGraphView(CommunicationManager * pConnMan, GuiModel * pGuiModel, SettingsModel * pSettingsModel, GraphDataModel * pRegisterDataModel, NoteModel * pNoteModel, MyQCustomPlot *pPlot, QObject *parent):
-    BasicGraphView(pGuiModel, pRegisterDataModel, pNoteModel, pPlot)
+    BasicGraphView(pGuiModel, pRegisterDataModel, pNoteModel, pPlot),
+    _aligner(pRegisterDataModel, pGuiModel)
 {
     Q_UNUSED(parent);
 
     _pConnMan = pConnMan;
     _pSettingsModel = pSettingsModel;
 
+    _bPendingRow = false;
+    _pendingKey = 0;
+
     connect(_pPlot->xAxis, SIGNAL(rangeChanged(QCPRange, QCPRange)), this, SLOT(xAxisRangeChanged(QCPRange, QCPRange)));
 }
 
@@ -64,12 +68,11 @@ void ExtendedGraphView::rescalePlot()
     {
         // sliding window scale routine
         const quint64 slidingInterval = _pGuiModel->xAxisSlidingSec() * 1000;
-        if ((_pPlot->graphCount() != 0) && (graphDataSize() != 0))
+        const SampleSeries series = referenceSeries();
+        if ((_pPlot->graphCount() != 0) && !series.isEmpty())
         {
-            auto lastDataIt = _pPlot->graph(0)->data()->constEnd();
-            lastDataIt--; /* Point to last existing item */
-
-            const quint64 lastTime = (quint64)lastDataIt->key;
+            /* Last existing item */
+            const quint64 lastTime = (quint64)series.key(series.size() - 1);
             if (lastTime > slidingInterval)
             {
                 _pPlot->xAxis->setRange(lastTime - slidingInterval, lastTime);
@@ -118,83 +121,77 @@ void ExtendedGraphView::rescalePlot()
     _pPlot->replot();
 }
 
-void ExtendedGraphView::plotResults(QList<bool> successList, QList<double> valueList)
+void ExtendedGraphView::plotResults(qint64 timestamp, QList<bool> successList, QList<double> valueList, QList<qint64> timestampList, QList<quint32> rawValueList)
 {
     /* QList correspond with activeGraphList */
 
-    quint64 timeData;
-    if (_pSettingsModel->absoluteTimes())
-    {
-        // Epoch is in UTC time
-        timeData = QDateTime::currentMSecsSinceEpoch();
-    }
-    else
+    /* Every graph is plotted on the raw timestamp of its connection */
+    QList<double> keyList;
+    for (qint32 i = 0; i < valueList.size(); i++)
     {
-        timeData = QDateTime::currentMSecsSinceEpoch() - _pGuiModel->communicationStartTime();
+        keyList.append(timestampToKey(i < timestampList.size() ? timestampList[i] : timestamp));
     }
 
-    QList<double> dataList;
+    /* Only raw values are stored, values are converted when graph is drawn (except for virtual channels) */
+    _pGraphDataModel->addSamples(keyList, successList, rawValueList, valueList);
 
-    for (qint32 i = 0; i < valueList.size(); i++)
+    /*
+     * Row on common timebase: timestamp of reference (first) graph
+     * Row is decided one poll later: an ingest filter can still keep the previous sample
+     */
+    if (_bPendingRow)
     {
-        if (successList[i])
-        {
-            // No error, add points
-            _pPlot->graph(i)->addData(timeData, valueList[i]);
-            dataList.append(valueList[i]);
-        }
-        else
+        QList<double> dataList;
+        if (_aligner.alignedRow(_pendingKey, &dataList))
         {
-            _pPlot->graph(i)->addData(timeData, 0);
-            dataList.append(0);
+            emit dataAddedToPlot(_pendingKey, dataList);
         }
     }
 
-    emit dataAddedToPlot(timeData, dataList);
+    _pendingKey = timestampToKey(timestampList.isEmpty() ? timestamp : timestampList.first());
+    _bPendingRow = true;
 
    rescalePlot();
 }
 
-void ExtendedGraphView::clearResults()
+/*!
+ * Emit last row of log (always added, so log ends on last poll)
+ */
+void ExtendedGraphView::flushResults()
 {
-    for (qint32 i = 0; i < _pPlot->graphCount(); i++)
+    if (_bPendingRow)
     {
-        _pPlot->graph(i)->data()->clear();
-        _pPlot->graph(i)->setName(QString("(-) %1").arg(_pGraphDataModel->label(i)));
-    }
+        QList<double> dataList;
+        _aligner.alignedRow(_pendingKey, &dataList);
 
-   rescalePlot();
+        emit dataAddedToPlot(_pendingKey, dataList);
+
+        _bPendingRow = false;
+    }
 }
 
-void ExtendedGraphView::updateData(QList<double> *pTimeData, QList<QList<double> > * pDataLists)
+void ExtendedGraphView::clearResults()
 {
-    quint64 totalPoints = 0;
-    const QVector<double> timeData = pTimeData->toVector();
+    _pGraphDataModel->clearSamples();
 
-    for (qint32 i = 1; i < pDataLists->size(); i++)
+    for (qint32 i = 0; i < _pPlot->graphCount(); i++)
     {
-        //Add data to graphs
-        QVector<double> graphData = pDataLists->at(i).toVector();
-        _pPlot->graph(i - 1)->setData(timeData, graphData);
-
-        totalPoints += graphData.size();
+        _pPlot->graph(i)->setName(QString("(-) %1").arg(_pGraphDataModel->label(i)));
     }
 
-    // Check if optimizations are needed
-    if (totalPoints > _cOptimizeThreshold)
-    {
-        _pGuiModel->setHighlightSamples(false);
+    _aligner.resetCursors();
+    _bPendingRow = false;
 
-        // Set width to 1
-        for (qint32 i = 0; i <  _pPlot->graphCount(); i++)
-        {
-             _pPlot->graph(i)->pen().setWidth(1);
-        }
+   rescalePlot();
+}
 
-        // Disable anti aliasing
-        _pPlot->setNotAntialiasedElements(QCP::aeAll);
-    }
+void ExtendedGraphView::updateData(QList<double> *pTimeData, QList<QList<double> > * pDataLists)
+{
+    Q_UNUSED(pTimeData);
+    Q_UNUSED(pDataLists);
 
+    /* Data and level of detail pyramids are already stored in graph data model,
+     * number of drawn points only depends on the plot width */
     _pPlot->rescaleAxes(true);
     _pPlot->replot();
 }
@@ -215,3 +212,16 @@ void ExtendedGraphView::xAxisRangeChanged(const QCPRange &newRange, const QCPRan
 
     _pPlot->xAxis->setRange(range);
 }
+
+double ExtendedGraphView::timestampToKey(qint64 timestamp)
+{
+    if (_pSettingsModel->absoluteTimes())
+    {
+        // Epoch is in UTC time
+        return static_cast<double>(timestamp);
+    }
+    else
+    {
+        return static_cast<double>(timestamp - _pGuiModel->communicationStartTime());
+    }
+}
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include "basicgraphview.h"
+#include "timebasealigner.h"
 
 /* Forward declaration */
 class CommunicationManager;
@@ -20,8 +21,9 @@ public slots:
     void addData(QList<double> timeData, QList<QList<double> > data);
     void showGraph(quint32 graphIdx);
     void rescalePlot();
-    void plotResults(QList<bool> successList, QList<double> valueList);
+    void plotResults(qint64 timestamp, QList<bool> successList, QList<double> valueList, QList<qint64> timestampList, QList<quint32> rawValueList);
     void clearResults();
+    void flushResults();
 
 signals:
     void dataAddedToPlot(double timeData, QList<double> dataList);
@@ -31,11 +33,17 @@ private slots:
     void xAxisRangeChanged(const QCPRange &newRange, const QCPRange &oldRange);
 
 private:
-    static const quint64 _cOptimizeThreshold = 1000000uL;
+    double timestampToKey(qint64 timestamp);
 
     CommunicationManager * _pConnMan;
     SettingsModel * _pSettingsModel;
 
+    TimebaseAligner _aligner;
+
+    /* Row of previous poll that isn't emitted yet */
+    bool _bPendingRow;
+    double _pendingKey;
+
 };
 
 #endif // EXTENDEDGRAPHVIEW_H
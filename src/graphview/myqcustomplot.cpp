@@ -35,3 +35,13 @@ void MyQCustomPlot::enterEvent(QEvent * event)
 
     QCustomPlot::enterEvent(event);
 }
+
+/*!
+ * Memory (in bytes) used by the paint buffers of the layers (estimate: 32 bit pixels)
+ */
+qint64 MyQCustomPlot::paintBufferMemorySize() const
+{
+    const double pixelCount = width() * height() * bufferDevicePixelRatio() * bufferDevicePixelRatio();
+
+    return mPaintBuffers.size() * static_cast<qint64>(pixelCount) * 4;
+}
@@ -13,6 +13,8 @@ public:
 
     virtual void enterEvent(QEvent * event);
 
+    qint64 paintBufferMemorySize() const;
+
 };
 
 #endif // MYQCUSTOMPLOT_H
@@ -0,0 +1,247 @@
+
+#include "graphdatamodel.h"
+#include "samplegraph.h"
+
+SampleGraph::SampleGraph(GraphDataModel * pGraphDataModel, quint32 graphIdx, QCPAxis *keyAxis, QCPAxis *valueAxis) :
+    QCPGraph(keyAxis, valueAxis)
+{
+    _pGraphDataModel = pGraphDataModel;
+    _graphIdx = graphIdx;
+
+    /* Samples are already reduced to the visible pixels */
+    setAdaptiveSampling(false);
+}
+
+quint32 SampleGraph::graphIndex() const
+{
+    return _graphIdx;
+}
+
+QCPRange SampleGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+    Q_UNUSED(inSignDomain);
+
+    if (static_cast<qint32>(_graphIdx) >= _pGraphDataModel->size())
+    {
+        foundRange = false;
+        return QCPRange();
+    }
+
+    return _pGraphDataModel->series(_graphIdx).keyRange(foundRange);
+}
+
+QCPRange SampleGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+    Q_UNUSED(inSignDomain);
+
+    if (static_cast<qint32>(_graphIdx) >= _pGraphDataModel->size())
+    {
+        foundRange = false;
+        return QCPRange();
+    }
+
+    return _pGraphDataModel->series(_graphIdx).valueRange(foundRange, inKeyRange);
+}
+
+void SampleGraph::draw(QCPPainter *painter)
+{
+    /* Unfiltered values of graph with signal filter are drawn faded, behind the filtered values */
+    if (
+        (static_cast<qint32>(_graphIdx) < _pGraphDataModel->size())
+        && !_pGraphDataModel->rawSeries(_graphIdx).isEmpty()
+    )
+    {
+        const QPen filteredPen = pen();
+
+        QColor rawColor = filteredPen.color();
+        rawColor.setAlpha(_cRawSeriesAlpha);
+
+        QPen rawPen = filteredPen;
+        rawPen.setColor(rawColor);
+        rawPen.setWidth(1);
+
+        updateRenderData(true);
+
+        setPen(rawPen);
+        QCPGraph::draw(painter);
+        setPen(filteredPen);
+    }
+
+    updateRenderData(false);
+
+    QCPGraph::draw(painter);
+}
+
+/*!
+ * Fill data container with the samples of the visible key range, reduced to the first, minimum,
+ * maximum and last sample of every pixel column when there are too many samples.
+ * With a lot of samples per pixel, the buckets of the level of detail pyramid are used instead of
+ * the samples, so the number of steps depends on the number of pixels and not on the number of samples.
+ * Missing samples have a NaN value, which is drawn as a gap in the line.
+ * \param bRawSeries    Use unfiltered values of graph instead of its samples
+ */
+void SampleGraph::updateRenderData(bool bRawSeries)
+{
+    QVector<QCPGraphData> renderData;
+
+    if (
+        (static_cast<qint32>(_graphIdx) < _pGraphDataModel->size())
+        && !mKeyAxis.isNull()
+    )
+    {
+        const SampleSeries series = bRawSeries ? _pGraphDataModel->rawSeries(_graphIdx) : _pGraphDataModel->series(_graphIdx);
+        const QCPRange range = mKeyAxis->range();
+
+        /* Include sample before and after range, so lines cross the axis borders */
+        const qint32 beginIdx = series.findBegin(range.lower);
+        const qint32 endIdx = series.findEnd(range.upper);
+        const qint32 pixelCount = qMax(mKeyAxis->axisRect()->width(), 1);
+
+        if ((endIdx - beginIdx) <= (_cSamplesPerPixel * pixelCount))
+        {
+            renderData.reserve(endIdx - beginIdx);
+
+            for (qint32 idx = beginIdx; idx < endIdx; idx++)
+            {
+                renderData.append(QCPGraphData(series.key(idx), series.value(idx)));
+            }
+        }
+        else
+        {
+            const double keysPerPixel = range.size() / pixelCount;
+            const double samplesPerPixel = static_cast<double>(endIdx - beginIdx) / pixelCount;
+
+            renderData.reserve(4 * (pixelCount + 2));
+
+            PixelColumn pixelColumn;
+            pixelColumn.pixel = 0;
+            pixelColumn.bUsed = false;
+
+            qint32 idx = beginIdx;
+
+            /* Use buckets that fit at least twice in a pixel column, so a bucket never spans more than half a pixel */
+            const QSharedPointer<SamplePyramid> pPyramid = series.pyramid();
+            if (!pPyramid.isNull())
+            {
+                pPyramid->update(series);
+
+                const qint32 level = pPyramid->selectLevel(samplesPerPixel / 2);
+                if (level >= 0)
+                {
+                    const qint32 bucketSize = SamplePyramid::bucketSize(level);
+                    const qint32 firstBucket = (beginIdx + bucketSize - 1) / bucketSize;
+                    const qint32 endBucket = qMin(endIdx, pPyramid->size()) / bucketSize;
+
+                    if (firstBucket < endBucket)
+                    {
+                        /* Samples before first complete bucket */
+                        for (; idx < firstBucket * bucketSize; idx++)
+                        {
+                            const double value = series.value(idx);
+                            addToPixelColumn(&pixelColumn, &renderData, series, pixelOfKey(series.key(idx), range.lower, keysPerPixel),
+                                             idx, idx, value, idx, value, idx);
+                        }
+
+                        for (qint32 bucketIdx = firstBucket; bucketIdx < endBucket; bucketIdx++)
+                        {
+                            const qint32 firstIdx = bucketIdx * bucketSize;
+                            const qint32 minIdx = pPyramid->minIndex(level, bucketIdx);
+                            const qint32 maxIdx = pPyramid->maxIndex(level, bucketIdx);
+
+                            addToPixelColumn(&pixelColumn, &renderData, series, pixelOfKey(series.key(firstIdx), range.lower, keysPerPixel),
+                                             firstIdx, minIdx, series.value(minIdx), maxIdx, series.value(maxIdx), firstIdx + bucketSize - 1);
+                        }
+
+                        idx = endBucket * bucketSize;
+                    }
+                }
+            }
+
+            /* Remaining samples */
+            for (; idx < endIdx; idx++)
+            {
+                const double value = series.value(idx);
+                addToPixelColumn(&pixelColumn, &renderData, series, pixelOfKey(series.key(idx), range.lower, keysPerPixel),
+                                 idx, idx, value, idx, value, idx);
+            }
+
+            flushPixelColumn(&pixelColumn, &renderData, series);
+        }
+    }
+
+    mDataContainer->set(renderData, true);
+}
+
+qint64 SampleGraph::pixelOfKey(double key, double rangeLower, double keysPerPixel)
+{
+    return static_cast<qint64>(qFloor((key - rangeLower) / keysPerPixel));
+}
+
+/*!
+ * Add samples to pixel column, the previous pixel column is added to render data when pixel changes
+ * \param pPixelColumn  Current pixel column
+ * \param pRenderData   Render data
+ * \param series        Samples of graph
+ * \param pixel         Pixel column of samples
+ * \param firstIdx      Index of first sample
+ * \param minIdx        Index of minimum sample
+ * \param minValue      Value of minimum sample
+ * \param maxIdx        Index of maximum sample
+ * \param maxValue      Value of maximum sample
+ * \param lastIdx       Index of last sample
+ */
+void SampleGraph::addToPixelColumn(PixelColumn * pPixelColumn, QVector<QCPGraphData> * pRenderData, const SampleSeries &series,
+                                   qint64 pixel, qint32 firstIdx, qint32 minIdx, double minValue, qint32 maxIdx, double maxValue, qint32 lastIdx)
+{
+    if (pPixelColumn->bUsed && (pPixelColumn->pixel == pixel))
+    {
+        /* Missing samples (NaN) are replaced by any sample with a value */
+        if ((minValue < pPixelColumn->minValue) || qIsNaN(pPixelColumn->minValue))
+        {
+            pPixelColumn->minIdx = minIdx;
+            pPixelColumn->minValue = minValue;
+        }
+
+        if ((maxValue > pPixelColumn->maxValue) || qIsNaN(pPixelColumn->maxValue))
+        {
+            pPixelColumn->maxIdx = maxIdx;
+            pPixelColumn->maxValue = maxValue;
+        }
+
+        pPixelColumn->lastIdx = lastIdx;
+    }
+    else
+    {
+        flushPixelColumn(pPixelColumn, pRenderData, series);
+
+        pPixelColumn->bUsed = true;
+        pPixelColumn->pixel = pixel;
+        pPixelColumn->firstIdx = firstIdx;
+        pPixelColumn->minIdx = minIdx;
+        pPixelColumn->minValue = minValue;
+        pPixelColumn->maxIdx = maxIdx;
+        pPixelColumn->maxValue = maxValue;
+        pPixelColumn->lastIdx = lastIdx;
+    }
+}
+
+void SampleGraph::flushPixelColumn(PixelColumn * pPixelColumn, QVector<QCPGraphData> * pRenderData, const SampleSeries &series)
+{
+    if (pPixelColumn->bUsed)
+    {
+        /* Keep samples of pixel column in order */
+        QList<qint32> pixelIndexList = QList<qint32>() << pPixelColumn->firstIdx << pPixelColumn->minIdx << pPixelColumn->maxIdx << pPixelColumn->lastIdx;
+        qSort(pixelIndexList);
+
+        for (qint32 listIdx = 0; listIdx < pixelIndexList.size(); listIdx++)
+        {
+            if ((listIdx == 0) || (pixelIndexList[listIdx] != pixelIndexList[listIdx - 1]))
+            {
+                const qint32 sampleIdx = pixelIndexList[listIdx];
+                pRenderData->append(QCPGraphData(series.key(sampleIdx), series.value(sampleIdx)));
+            }
+        }
+
+        pPixelColumn->bUsed = false;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef SAMPLEGRAPH_H
+#define SAMPLEGRAPH_H
+
+#include "qcustomplot.h"
+#include "sampleseries.h"
+
+//Forward declaration
+class GraphDataModel;
+
+/*!
+ * Graph that plots the samples of a graph in the sample store
+ *
+ * The data container of the graph only holds the samples of the visible key range. It is refilled
+ * before every draw. When there are more samples than pixels, only the first, minimum, maximum and
+ * last sample of every pixel column are kept, so the line looks the same. For large ranges, the
+ * level of detail pyramid (SamplePyramid) of the graph is used. Key and value ranges
+ * (used for rescaling) are calculated on all samples.
+ */
+class SampleGraph : public QCPGraph
+{
+public:
+    explicit SampleGraph(GraphDataModel * pGraphDataModel, quint32 graphIdx, QCPAxis *keyAxis, QCPAxis *valueAxis);
+
+    quint32 graphIndex() const;
+
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth, const QCPRange &inKeyRange = QCPRange()) const Q_DECL_OVERRIDE;
+
+protected:
+    virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+
+private:
+
+    typedef struct
+    {
+        bool bUsed;
+        qint64 pixel;
+        qint32 firstIdx;
+        qint32 minIdx;
+        double minValue;
+        qint32 maxIdx;
+        double maxValue;
+        qint32 lastIdx;
+    } PixelColumn;
+
+    void updateRenderData(bool bRawSeries);
+    void addToPixelColumn(PixelColumn * pPixelColumn, QVector<QCPGraphData> * pRenderData, const SampleSeries &series,
+                          qint64 pixel, qint32 firstIdx, qint32 minIdx, double minValue, qint32 maxIdx, double maxValue, qint32 lastIdx);
+    void flushPixelColumn(PixelColumn * pPixelColumn, QVector<QCPGraphData> * pRenderData, const SampleSeries &series);
+
+    static qint64 pixelOfKey(double key, double rangeLower, double keysPerPixel);
+
+    /* Decimate when there are more samples than this number of samples per pixel */
+    static const qint32 _cSamplesPerPixel = 4;
+
+    /* Opacity of unfiltered values */
+    static const qint32 _cRawSeriesAlpha = 70;
+
+    GraphDataModel * _pGraphDataModel;
+    quint32 _graphIdx;
+};
+
+#endif // SAMPLEGRAPH_H
@@ -5,6 +5,7 @@
 #include "guimodel.h"
 #include "settingsmodel.h"
 #include "graphdatamodel.h"
+#include "timebasealigner.h"
 
 #include "datafileexporter.h"
 #include "notemodel.h"
@@ -57,6 +58,15 @@ void DataFileExporter::exportDataLine(double timeData, QList <double> dataValues
 
 void DataFileExporter::rewriteDataFile(void)
 {
+    if (_pGraphDataModel->samplesDropped())
+    {
+        /* Memory only holds the most recent samples, the data file has the full history.
+         * Don't overwrite it, changed settings only apply on the lines that are still to be written.
+         */
+        flushExportBuffer();
+        return;
+    }
+
     _dataExportBuffer.clear();
     lastLogTime = QDateTime::currentMSecsSinceEpoch();
 
@@ -67,7 +77,9 @@ void DataFileExporter::exportDataFile(QString dataFile)
 {
     if (_pGraphDataModel->activeCount() != 0)
     {
-        const qint32 dataCount = _pGraphDataModel->dataMap(0)->size();
+        /* Rows are written on timebase of reference graph, other graphs are aligned to it */
+        TimebaseAligner aligner(_pGraphDataModel, _pGuiModel);
+        const SampleSeries referenceSeries = aligner.referenceSeries();
         QStringList logData;
 
         // Create header
@@ -86,31 +98,23 @@ void DataFileExporter::exportDataFile(QString dataFile)
 
         if (bRet)
         {
-            QList<quint16> activeGraphIndexes;
-            _pGraphDataModel->activeGraphIndexList(&activeGraphIndexes);
-            QList<QCPGraphDataContainer::const_iterator> dataListIterators;
-
-            for(qint32 idx = 0; idx < activeGraphIndexes.size(); idx++)
-            {
-                // Save iterators to data lists
-                dataListIterators.append(_pGraphDataModel->dataMap(activeGraphIndexes[idx])->constBegin());
-            }
-
             // Add data lines
-            for(qint32 i = 0; i < dataCount; i++)
+            qint32 i = 0;
+            const qint32 sampleCount = referenceSeries.size();
+            for (qint32 sampleIdx = 0; sampleIdx < sampleCount; sampleIdx++)
             {
                 QList<double> dataRowValues;
-                double key = dataListIterators[0]->key;
-                for(qint32 d = 0; d < dataListIterators.size(); d++)
-                {
-                    dataRowValues.append(dataListIterators[d]->value);
+                const double key = referenceSeries.key(sampleIdx);
 
-                    dataListIterators[d]++;
+                /* Rows without new samples only occur with ingest filters: values are held or interpolated */
+                const bool bNewSamples = aligner.alignedRow(key, &dataRowValues);
+                if (!bNewSamples && (sampleIdx != sampleCount - 1))
+                {
+                    continue;
                 }
 
                 logData.append(formatData(key, dataRowValues));
 
-
                 if ( i % _cLogChunkLineCount == 0)
                 {
                     bRet = writeToFile(dataFile, logData);
@@ -122,6 +126,8 @@ void DataFileExporter::exportDataFile(QString dataFile)
                         break;
                     }
                 }
+
+                i++;
             }
 
             if (bRet && (logData.size() > 0))
@@ -293,11 +299,19 @@ QStringList DataFileExporter::constructDataHeader(bool bDuringLog)
                 header.append(comment + "Slave ID (Connection ID " + QString::number(i) + ")" + Util::separatorCharacter() + QString::number(_pSettingsModel->slaveId(i)));
                 header.append(comment + "Time-out (Connection ID " + QString::number(i) + ")" + Util::separatorCharacter() + QString::number(_pSettingsModel->timeout(i)));
                 header.append(comment + "Consecutive max (Connection ID " + QString::number(i) + ")" + Util::separatorCharacter() + QString::number(_pSettingsModel->consecutiveMax(i)));
+                header.append(comment + "Transport (Connection ID " + QString::number(i) + ")" + Util::separatorCharacter() + (_pSettingsModel->udpTransport(i) ? "UDP" : "TCP"));
             }
         }
 
         header.append(comment + "Poll interval" + Util::separatorCharacter() + QString::number(_pSettingsModel->pollTime()));
 
+        if (_pSettingsModel->triggerCapture())
+        {
+            header.append(comment + "Trigger" + Util::separatorCharacter() + _pSettingsModel->triggerCondition().description());
+            header.append(comment + "Pre-trigger time" + Util::separatorCharacter() + QString::number(_pSettingsModel->preTriggerTime()));
+            header.append(comment + "Post-trigger time" + Util::separatorCharacter() + QString::number(_pSettingsModel->postTriggerTime()));
+        }
+
         quint32 success = _pGuiModel->communicationSuccessCount();
         quint32 error = _pGuiModel->communicationErrorCount();
         header.append(comment + "Communication success" + Util::separatorCharacter() + QString::number(success));
@@ -313,6 +327,8 @@ QStringList DataFileExporter::constructDataHeader(bool bDuringLog)
         header.append("//" + createPropertyRow(E_BITMASK));
         header.append("//" + createPropertyRow(E_SHIFT));
         header.append("//" + createPropertyRow(E_CONNECTION_ID));
+        header.append("//" + createPropertyRow(E_VALUE_TYPE));
+        header.append("//" + createPropertyRow(E_WORD_ORDER));
 
         header.append("//");
 
@@ -393,6 +409,14 @@ QString DataFileExporter::createPropertyRow(registerProperty prop)
         line.append("ConnectionId");
         break;
 
+    case E_VALUE_TYPE:
+        line.append("Type");
+        break;
+
+    case E_WORD_ORDER:
+        line.append("Word order");
+        break;
+
     default:
         break;
     }
@@ -436,6 +460,14 @@ QString DataFileExporter::createPropertyRow(registerProperty prop)
             propertyString = QString("%1").arg(_pGraphDataModel->connectionId(graphIdx));
             break;
 
+        case E_VALUE_TYPE:
+            propertyString = GraphData::valueTypeToString(_pGraphDataModel->valueType(graphIdx));
+            break;
+
+        case E_WORD_ORDER:
+            propertyString = _pGraphDataModel->isLowWordFirst(graphIdx) ? QString("lowfirst") : QString("highfirst");
+            break;
+
         default:
             break;
 
@@ -467,10 +499,15 @@ QString DataFileExporter::formatData(double timeData, QList<double> dataValues)
         line.append(QString::number(t, 'f', 0));
     }
 
-    // Add formatted data (maximum 3 decimals, no trailing zeros)
+    // Add formatted data (maximum 3 decimals, no trailing zeros), missing sample is empty field
     for(qint32 d = 0; d < dataValues.size(); d++)
     {
-        line.append(Util::separatorCharacter() + Util::formatDoubleForExport(dataValues[d]));
+        line.append(Util::separatorCharacter());
+
+        if (!qIsNaN(dataValues[d]))
+        {
+            line.append(Util::formatDoubleForExport(dataValues[d]));
+        }
     }
 
     return line;
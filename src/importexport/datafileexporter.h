@@ -43,6 +43,8 @@ private:
         E_BITMASK,
         E_SHIFT,
         E_CONNECTION_ID,
+        E_VALUE_TYPE,
+        E_WORD_ORDER,
 
     } registerProperty;
 
@@ -243,6 +243,13 @@ bool DataFileParser::parseDataLines(QList<QList<double> > &dataRows)
 
             for (qint32 i = startColumn; i < paramList.size(); i++)
             {
+                if ((i > 0) && paramList[i].trimmed().isEmpty())
+                {
+                    /* No sample of graph in this row */
+                    dataRows[i].append(qQNaN());
+                    continue;
+                }
+
                 bool bError = false;
                 const double number = _pAutoSettingsParser->locale().toDouble(paramList[i], &bError);
 
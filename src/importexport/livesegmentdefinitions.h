@@ -0,0 +1,111 @@
+#ifndef LIVESEGMENTDEFINITIONS_H
+#define LIVESEGMENTDEFINITIONS_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QDir>
+
+#include <atomic>
+
+/*!
+ * Layout of the live data segment: shared memory ring with the samples that are polled
+ *
+ * The segment is a memory mapped file (in the temp directory by default), so any local process can map it
+ * without parsing. All fields are in native byte order and naturally aligned.
+ *
+ *  - header (64 bytes)
+ *  - channel table: one entry (64 bytes) per active graph, in order of the graph list
+ *  - ring: capacity rows of rowSize bytes. Row n is stored in slot (n % capacity):
+ *      - sequence (quint64): n + 1 when the row is complete, 0 while it is written
+ *      - timestamp (qint64): ms since epoch
+ *      - value (double) per channel, NaN when the register couldn't be read
+ *
+ * There is one writer and any number of readers, none of them take a lock:
+ *  - writer: sets sequence of slot to 0, writes the row, sets sequence to n + 1 and then increments writeCount
+ *  - reader: reads sequence, copies the row and reads sequence again. The copy is valid when both are n + 1,
+ *    otherwise the writer has overwritten the slot in the meantime (reader is more than capacity rows behind).
+ *
+ * The generation is odd while the writer (re)writes the layout (new log with other registers). A reader
+ * has to reopen the segment when the generation is different from the one it has opened.
+ */
+namespace LiveSegmentDefinitions
+{
+    const quint32 cMagic = 0x564C424D; /* "MBLV" */
+    const quint32 cVersion = 1;
+
+    const quint32 cLabelSize = 48;
+
+    const QString cDefaultFileName = QString("ModbusScope-live.shm");
+
+    typedef enum
+    {
+        STATE_STOPPED = 0,
+        STATE_RUNNING,
+
+    } State;
+
+    typedef struct
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 headerSize;
+        quint32 channelCount;
+        quint32 capacity;           /* Number of rows in ring */
+        quint32 rowSize;            /* Size of row in bytes */
+        quint32 channelOffset;      /* Offset of channel table */
+        quint32 ringOffset;         /* Offset of first slot of ring */
+        quint64 generation;         /* Odd while layout is written */
+        quint64 writeCount;         /* Number of rows written since start of log */
+        qint64 startTime;           /* Start of log (ms since epoch) */
+        quint32 state;
+        quint32 reserved;
+
+    } Header;
+
+    typedef struct
+    {
+        char label[cLabelSize];     /* UTF-8, zero terminated */
+        quint16 registerAddress;
+        quint16 bitmask;
+        quint8 connectionId;
+        quint8 reserved[11];
+
+    } Channel;
+
+    typedef struct
+    {
+        quint64 sequence;
+        qint64 timestamp;
+
+        /* Followed by a double per channel */
+
+    } RowHeader;
+
+    static_assert(sizeof(Header) == 64, "Layout of live segment header changed");
+    static_assert(sizeof(Channel) == 64, "Layout of live segment channel changed");
+    static_assert(sizeof(RowHeader) == 16, "Layout of live segment row changed");
+    static_assert(sizeof(std::atomic<quint64>) == sizeof(quint64), "Atomic counter isn't shared memory compatible");
+
+    inline QString defaultPath()
+    {
+        return QDir::temp().filePath(cDefaultFileName);
+    }
+
+    inline quint32 rowSize(quint32 channelCount)
+    {
+        return static_cast<quint32>(sizeof(RowHeader) + channelCount * sizeof(double));
+    }
+
+    /* Counters that are shared between processes */
+    inline std::atomic<quint64> * sharedCounter(quint64 * pCounter)
+    {
+        return reinterpret_cast<std::atomic<quint64> *>(pCounter);
+    }
+
+    inline const std::atomic<quint64> * sharedCounter(const quint64 * pCounter)
+    {
+        return reinterpret_cast<const std::atomic<quint64> *>(pCounter);
+    }
+}
+
+#endif // LIVESEGMENTDEFINITIONS_H
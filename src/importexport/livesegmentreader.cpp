@@ -0,0 +1,273 @@
+
+#include <cstring>
+
+#include "livesegmentreader.h"
+
+LiveSegmentReader::LiveSegmentReader()
+{
+    _pMap = nullptr;
+    _mapSize = 0;
+
+    _generation = 0;
+    _capacity = 0;
+    _rowSize = 0;
+    _ringOffset = 0;
+    _startTime = 0;
+}
+
+LiveSegmentReader::~LiveSegmentReader()
+{
+    close();
+}
+
+/*!
+ * Map live data segment and read its layout
+ * Fails when the segment doesn't exist (yet) or the writer is changing the layout: retry later.
+ */
+bool LiveSegmentReader::open(const QString &filePath)
+{
+    close();
+
+    _file.setFileName(filePath);
+    if (!_file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    _mapSize = _file.size();
+    if (_mapSize < static_cast<qint64>(sizeof(LiveSegmentDefinitions::Header)))
+    {
+        close();
+        return false;
+    }
+
+    _pMap = _file.map(0, _mapSize);
+    if (_pMap == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    const LiveSegmentDefinitions::Header * pHeader = header();
+    const std::atomic<quint64> * pGeneration = LiveSegmentDefinitions::sharedCounter(&pHeader->generation);
+
+    _generation = pGeneration->load(std::memory_order_acquire);
+
+    bool bValid = ((_generation & 1) == 0)
+                    && (pHeader->magic == LiveSegmentDefinitions::cMagic)
+                    && (pHeader->version == LiveSegmentDefinitions::cVersion);
+
+    if (bValid)
+    {
+        const quint32 channelCount = pHeader->channelCount;
+
+        _capacity = pHeader->capacity;
+        _rowSize = pHeader->rowSize;
+        _ringOffset = pHeader->ringOffset;
+        _startTime = pHeader->startTime;
+
+        const qint64 channelEnd = static_cast<qint64>(pHeader->channelOffset) + static_cast<qint64>(channelCount) * static_cast<qint64>(sizeof(LiveSegmentDefinitions::Channel));
+        const qint64 ringEnd = static_cast<qint64>(_ringOffset) + static_cast<qint64>(_capacity) * _rowSize;
+
+        bValid = (_capacity > 0)
+                    && (_rowSize == LiveSegmentDefinitions::rowSize(channelCount))
+                    && (channelEnd <= _ringOffset)
+                    && (ringEnd <= _mapSize)
+                    && ((_ringOffset % sizeof(quint64)) == 0);
+
+        if (bValid)
+        {
+            const LiveSegmentDefinitions::Channel * pChannels = reinterpret_cast<const LiveSegmentDefinitions::Channel *>(_pMap + pHeader->channelOffset);
+            for (quint32 channelIdx = 0; channelIdx < channelCount; channelIdx++)
+            {
+                _channels.append(pChannels[channelIdx]);
+            }
+        }
+    }
+
+    /* Layout was rewritten while it was copied */
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (bValid && (pGeneration->load(std::memory_order_relaxed) != _generation))
+    {
+        bValid = false;
+    }
+
+    if (!bValid)
+    {
+        close();
+    }
+
+    return bValid;
+}
+
+void LiveSegmentReader::close()
+{
+    if (_pMap != nullptr)
+    {
+        _file.unmap(_pMap);
+        _pMap = nullptr;
+    }
+    _file.close();
+
+    _mapSize = 0;
+    _generation = 0;
+    _capacity = 0;
+    _rowSize = 0;
+    _ringOffset = 0;
+    _startTime = 0;
+    _channels.clear();
+}
+
+bool LiveSegmentReader::isOpen() const
+{
+    return _pMap != nullptr;
+}
+
+/*!
+ * True when writer has started a new log: segment has to be reopened
+ */
+bool LiveSegmentReader::isLayoutChanged() const
+{
+    if (isOpen())
+    {
+        return LiveSegmentDefinitions::sharedCounter(&header()->generation)->load(std::memory_order_acquire) != _generation;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/*!
+ * True while ModbusScope is logging
+ */
+bool LiveSegmentReader::isRunning() const
+{
+    if (isOpen() && !isLayoutChanged())
+    {
+        return header()->state == LiveSegmentDefinitions::STATE_RUNNING;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+qint32 LiveSegmentReader::channelCount() const
+{
+    return _channels.size();
+}
+
+QString LiveSegmentReader::label(qint32 channelIdx) const
+{
+    const char * pLabel = _channels[channelIdx].label;
+
+    return QString::fromUtf8(pLabel, static_cast<int>(qstrnlen(pLabel, LiveSegmentDefinitions::cLabelSize)));
+}
+
+quint16 LiveSegmentReader::registerAddress(qint32 channelIdx) const
+{
+    return _channels[channelIdx].registerAddress;
+}
+
+quint16 LiveSegmentReader::bitmask(qint32 channelIdx) const
+{
+    return _channels[channelIdx].bitmask;
+}
+
+quint8 LiveSegmentReader::connectionId(qint32 channelIdx) const
+{
+    return _channels[channelIdx].connectionId;
+}
+
+quint32 LiveSegmentReader::capacity() const
+{
+    return _capacity;
+}
+
+/*!
+ * Start of log (ms since epoch)
+ */
+qint64 LiveSegmentReader::startTime() const
+{
+    return _startTime;
+}
+
+/*!
+ * Number of rows written since start of log, rows [firstAvailableRow(), writeCount()[ can be read
+ */
+quint64 LiveSegmentReader::writeCount() const
+{
+    if (isOpen())
+    {
+        return LiveSegmentDefinitions::sharedCounter(&header()->writeCount)->load(std::memory_order_acquire);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/*!
+ * Oldest row that isn't overwritten yet
+ */
+quint64 LiveSegmentReader::firstAvailableRow() const
+{
+    const quint64 count = writeCount();
+
+    return count > _capacity ? count - _capacity : 0;
+}
+
+/*!
+ * Copy row from ring
+ * \param rowIdx        Index of row since start of log
+ * \param pTimestamp    Timestamp of row (ms since epoch)
+ * \param pValues       Value per channel, NaN when the register couldn't be read
+ * \return false when row isn't written yet, is overwritten or layout has changed
+ */
+bool LiveSegmentReader::readRow(quint64 rowIdx, qint64 * pTimestamp, QList<double> * pValues) const
+{
+    if (!isOpen() || (rowIdx >= writeCount()) || isLayoutChanged())
+    {
+        return false;
+    }
+
+    const uchar * pRow = _pMap + _ringOffset + (rowIdx % _capacity) * _rowSize;
+    const LiveSegmentDefinitions::RowHeader * pRowHeader = reinterpret_cast<const LiveSegmentDefinitions::RowHeader *>(pRow);
+    const std::atomic<quint64> * pSequence = LiveSegmentDefinitions::sharedCounter(&pRowHeader->sequence);
+
+    if (pSequence->load(std::memory_order_acquire) != rowIdx + 1)
+    {
+        return false;
+    }
+
+    const qint64 timestamp = pRowHeader->timestamp;
+
+    QList<double> values;
+    values.reserve(_channels.size());
+
+    const uchar * pValueData = pRow + sizeof(LiveSegmentDefinitions::RowHeader);
+    for (qint32 channelIdx = 0; channelIdx < _channels.size(); channelIdx++)
+    {
+        double value;
+        std::memcpy(&value, pValueData + channelIdx * sizeof(double), sizeof(double));
+        values.append(value);
+    }
+
+    /* Slot was overwritten while it was copied */
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((pSequence->load(std::memory_order_relaxed) != rowIdx + 1) || isLayoutChanged())
+    {
+        return false;
+    }
+
+    *pTimestamp = timestamp;
+    *pValues = values;
+
+    return true;
+}
+
+const LiveSegmentDefinitions::Header * LiveSegmentReader::header() const
+{
+    return reinterpret_cast<const LiveSegmentDefinitions::Header *>(_pMap);
+}
@@ -0,0 +1,66 @@
+#ifndef LIVESEGMENTREADER_H
+#define LIVESEGMENTREADER_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#include "livesegmentdefinitions.h"
+
+/*!
+ * Reader of the live data segment that is published by ModbusScope (see LiveSegmentDefinitions)
+ *
+ * Only depends on QtCore, so it can be used in other local tools (see examples/livereader).
+ * Rows are copied straight from the shared ring, the reader never blocks the writer.
+ *
+ * Typical use:
+ *  - open() the segment and read the channel definitions
+ *  - poll writeCount() and read the new rows with readRow()
+ *  - reopen when isLayoutChanged() (ModbusScope started a new log)
+ */
+class LiveSegmentReader
+{
+public:
+    LiveSegmentReader();
+    ~LiveSegmentReader();
+
+    bool open(const QString &filePath = LiveSegmentDefinitions::defaultPath());
+    void close();
+
+    bool isOpen() const;
+    bool isLayoutChanged() const;
+    bool isRunning() const;
+
+    qint32 channelCount() const;
+    QString label(qint32 channelIdx) const;
+    quint16 registerAddress(qint32 channelIdx) const;
+    quint16 bitmask(qint32 channelIdx) const;
+    quint8 connectionId(qint32 channelIdx) const;
+
+    quint32 capacity() const;
+    qint64 startTime() const;
+
+    quint64 writeCount() const;
+    quint64 firstAvailableRow() const;
+
+    bool readRow(quint64 rowIdx, qint64 * pTimestamp, QList<double> * pValues) const;
+
+private:
+    Q_DISABLE_COPY(LiveSegmentReader)
+
+    const LiveSegmentDefinitions::Header * header() const;
+
+    QFile _file;
+    uchar * _pMap;
+    qint64 _mapSize;
+
+    /* Layout of opened generation */
+    quint64 _generation;
+    quint32 _capacity;
+    quint32 _rowSize;
+    quint32 _ringOffset;
+    qint64 _startTime;
+    QList<LiveSegmentDefinitions::Channel> _channels;
+};
+
+#endif // LIVESEGMENTREADER_H
@@ -0,0 +1,253 @@
+
+#include <cstring>
+#include <limits>
+#include <QDateTime>
+
+#include "graphdatamodel.h"
+#include "livesegmentwriter.h"
+
+LiveSegmentWriter::LiveSegmentWriter(GraphDataModel * pGraphDataModel, QObject *parent) :
+    QObject(parent)
+{
+    _pGraphDataModel = pGraphDataModel;
+
+    _pMap = nullptr;
+    _bStarted = false;
+    _channelCount = 0;
+    _capacity = 0;
+    _rowSize = 0;
+    _writeCount = 0;
+}
+
+LiveSegmentWriter::~LiveSegmentWriter()
+{
+    stop();
+    close();
+}
+
+/*!
+ * Create live data segment with a channel per active graph
+ * An existing segment is reused, so readers that have mapped it notice the new layout.
+ * \param filePath  Path of segment
+ * \param capacity  Number of rows in ring, 0 to select capacity based on number of channels
+ */
+bool LiveSegmentWriter::start(const QString &filePath, quint32 capacity)
+{
+    _bStarted = false;
+
+    if (_file.fileName() != filePath)
+    {
+        close();
+        _file.setFileName(filePath);
+    }
+
+    if (!_file.isOpen() && !_file.open(QIODevice::ReadWrite))
+    {
+        _errorString = tr("Couldn't open live data segment: %1").arg(filePath);
+        return false;
+    }
+
+    _channelCount = static_cast<quint32>(_pGraphDataModel->activeCount());
+    _rowSize = LiveSegmentDefinitions::rowSize(_channelCount);
+
+    if (capacity == 0)
+    {
+        capacity = qMax(_cRingBytes / _rowSize, static_cast<quint32>(_cMinimumCapacity));
+    }
+
+    const qint64 requiredSize = static_cast<qint64>(sizeof(LiveSegmentDefinitions::Header))
+                                + static_cast<qint64>(_channelCount) * static_cast<qint64>(sizeof(LiveSegmentDefinitions::Channel))
+                                + static_cast<qint64>(capacity) * _rowSize;
+
+    /* Never shrink: readers can have mapped the complete segment */
+    if (requiredSize > _file.size())
+    {
+        if (_pMap != nullptr)
+        {
+            _file.unmap(_pMap);
+            _pMap = nullptr;
+        }
+
+        if (!_file.resize(requiredSize))
+        {
+            _errorString = tr("Couldn't resize live data segment (is it still used by other process?): %1").arg(filePath);
+            close();
+            return false;
+        }
+    }
+
+    if (_pMap == nullptr)
+    {
+        _pMap = _file.map(0, _file.size());
+        if (_pMap == nullptr)
+        {
+            _errorString = tr("Couldn't map live data segment: %1").arg(filePath);
+            close();
+            return false;
+        }
+    }
+
+    writeLayout(capacity);
+
+    _bStarted = true;
+
+    return true;
+}
+
+/*!
+ * Mark segment as stopped, it stays available so readers can read the last rows
+ */
+void LiveSegmentWriter::stop()
+{
+    if (_bStarted)
+    {
+        header()->state = LiveSegmentDefinitions::STATE_STOPPED;
+        _bStarted = false;
+    }
+}
+
+bool LiveSegmentWriter::isStarted() const
+{
+    return _bStarted;
+}
+
+quint32 LiveSegmentWriter::capacity() const
+{
+    return _capacity;
+}
+
+QString LiveSegmentWriter::errorString() const
+{
+    return _errorString;
+}
+
+/*!
+ * Append row with processed values (list corresponds with active graph list)
+ */
+void LiveSegmentWriter::publishData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    Q_UNUSED(rawValues);
+
+    if (!_bStarted)
+    {
+        return;
+    }
+
+    uchar * pRow = _pMap + header()->ringOffset + (_writeCount % _capacity) * _rowSize;
+    LiveSegmentDefinitions::RowHeader * pRowHeader = reinterpret_cast<LiveSegmentDefinitions::RowHeader *>(pRow);
+    std::atomic<quint64> * pSequence = LiveSegmentDefinitions::sharedCounter(&pRowHeader->sequence);
+
+    /* Readers that are copying this slot, notice that it is overwritten */
+    pSequence->store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    /* Row is on timestamp of reference (first) graph, same as log file */
+    pRowHeader->timestamp = timestampList.isEmpty() ? QDateTime::currentMSecsSinceEpoch() : timestampList.first();
+
+    double * pValues = reinterpret_cast<double *>(pRow + sizeof(LiveSegmentDefinitions::RowHeader));
+    for (quint32 channelIdx = 0; channelIdx < _channelCount; channelIdx++)
+    {
+        const qint32 idx = static_cast<qint32>(channelIdx);
+
+        if ((idx < values.size()) && (idx < successList.size()) && successList[idx])
+        {
+            pValues[channelIdx] = values[idx];
+        }
+        else
+        {
+            pValues[channelIdx] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    _writeCount++;
+
+    pSequence->store(_writeCount, std::memory_order_release);
+    LiveSegmentDefinitions::sharedCounter(&header()->writeCount)->store(_writeCount, std::memory_order_release);
+}
+
+void LiveSegmentWriter::writeLayout(quint32 capacity)
+{
+    LiveSegmentDefinitions::Header * pHeader = header();
+    std::atomic<quint64> * pGeneration = LiveSegmentDefinitions::sharedCounter(&pHeader->generation);
+
+    /* Generation of segment that is reused, readers have to reopen */
+    quint64 generation = 0;
+    if ((pHeader->magic == LiveSegmentDefinitions::cMagic) && (pHeader->version == LiveSegmentDefinitions::cVersion))
+    {
+        generation = pGeneration->load(std::memory_order_relaxed);
+    }
+
+    /* Odd: layout is being written */
+    generation = (generation | 1) + 2;
+    pGeneration->store(generation, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _capacity = capacity;
+    _writeCount = 0;
+
+    pHeader->magic = LiveSegmentDefinitions::cMagic;
+    pHeader->version = LiveSegmentDefinitions::cVersion;
+    pHeader->headerSize = sizeof(LiveSegmentDefinitions::Header);
+    pHeader->channelCount = _channelCount;
+    pHeader->capacity = _capacity;
+    pHeader->rowSize = _rowSize;
+    pHeader->channelOffset = sizeof(LiveSegmentDefinitions::Header);
+    pHeader->ringOffset = pHeader->channelOffset + _channelCount * sizeof(LiveSegmentDefinitions::Channel);
+    pHeader->startTime = QDateTime::currentMSecsSinceEpoch();
+    pHeader->state = LiveSegmentDefinitions::STATE_RUNNING;
+    pHeader->reserved = 0;
+    LiveSegmentDefinitions::sharedCounter(&pHeader->writeCount)->store(0, std::memory_order_relaxed);
+
+    LiveSegmentDefinitions::Channel * pChannels = reinterpret_cast<LiveSegmentDefinitions::Channel *>(_pMap + pHeader->channelOffset);
+    for (quint32 channelIdx = 0; channelIdx < _channelCount; channelIdx++)
+    {
+        const quint32 graphIdx = static_cast<quint32>(_pGraphDataModel->convertToGraphIndex(channelIdx));
+        LiveSegmentDefinitions::Channel * pChannel = &pChannels[channelIdx];
+
+        std::memset(pChannel, 0, sizeof(LiveSegmentDefinitions::Channel));
+
+        /* Label is truncated (on character boundary) to fit */
+        QByteArray label = _pGraphDataModel->label(graphIdx).toUtf8();
+        if (label.size() >= static_cast<qint32>(LiveSegmentDefinitions::cLabelSize))
+        {
+            qint32 size = static_cast<qint32>(LiveSegmentDefinitions::cLabelSize) - 1;
+            while ((size > 0) && ((static_cast<quint8>(label[size]) & 0xC0) == 0x80))
+            {
+                size--;
+            }
+            label.truncate(size);
+        }
+        std::memcpy(pChannel->label, label.constData(), static_cast<size_t>(label.size()));
+
+        pChannel->registerAddress = _pGraphDataModel->registerAddress(graphIdx);
+        pChannel->bitmask = _pGraphDataModel->bitmask(graphIdx);
+        pChannel->connectionId = _pGraphDataModel->connectionId(graphIdx);
+    }
+
+    /* No slot holds a complete row */
+    for (quint32 slot = 0; slot < _capacity; slot++)
+    {
+        uchar * pRow = _pMap + pHeader->ringOffset + static_cast<quint64>(slot) * _rowSize;
+        LiveSegmentDefinitions::sharedCounter(&reinterpret_cast<LiveSegmentDefinitions::RowHeader *>(pRow)->sequence)->store(0, std::memory_order_relaxed);
+    }
+
+    pGeneration->store(generation + 1, std::memory_order_release);
+}
+
+void LiveSegmentWriter::close()
+{
+    _bStarted = false;
+
+    if (_pMap != nullptr)
+    {
+        _file.unmap(_pMap);
+        _pMap = nullptr;
+    }
+
+    _file.close();
+}
+
+LiveSegmentDefinitions::Header * LiveSegmentWriter::header()
+{
+    return reinterpret_cast<LiveSegmentDefinitions::Header *>(_pMap);
+}
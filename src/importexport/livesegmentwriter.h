@@ -0,0 +1,60 @@
+#ifndef LIVESEGMENTWRITER_H
+#define LIVESEGMENTWRITER_H
+
+#include <QObject>
+#include <QFile>
+
+#include "livesegmentdefinitions.h"
+
+/* Forward declaration */
+class GraphDataModel;
+
+/*!
+ * Publishes the polled samples of the active graphs in the live data segment (see LiveSegmentDefinitions)
+ *
+ * Local processes can follow the log at full rate with LiveSegmentReader, without parsing the log file.
+ */
+class LiveSegmentWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LiveSegmentWriter(GraphDataModel * pGraphDataModel, QObject *parent = nullptr);
+    ~LiveSegmentWriter();
+
+    bool start(const QString &filePath, quint32 capacity = 0);
+    void stop();
+
+    bool isStarted() const;
+    quint32 capacity() const;
+    QString errorString() const;
+
+public slots:
+    void publishData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+
+private:
+
+    void writeLayout(quint32 capacity);
+    void close();
+
+    LiveSegmentDefinitions::Header * header();
+
+    /* Size of ring when capacity isn't specified */
+    static const quint32 _cRingBytes = 16 * 1024 * 1024;
+    static const quint32 _cMinimumCapacity = 256;
+
+    GraphDataModel * _pGraphDataModel;
+
+    QFile _file;
+    uchar * _pMap;
+
+    bool _bStarted;
+    quint32 _channelCount;
+    quint32 _capacity;
+    quint32 _rowSize;
+    quint64 _writeCount;
+
+    QString _errorString;
+};
+
+#endif // LIVESEGMENTWRITER_H
@@ -14,11 +14,13 @@ namespace ProjectFileDefinitions
     const QString cConnectionTag = QString("connection");
     const QString cLogTag = QString("log");
     const QString cIpTag = QString("ip");
+    const QString cSecondaryIpTag = QString("secondaryip");
     const QString cConnectionIdTag = QString("connectionid");
     const QString cSlaveIdTag = QString("slaveid");
     const QString cPortTag = QString("port");
     const QString cTimeoutTag = QString("timeout");
     const QString cConsecutiveMaxTag = QString("consecutivemax");
+    const QString cTransportTag = QString("transport");
     const QString cPollTimeTag = QString("polltime");
     const QString cAbsoluteTimesTag = QString("absolutetimes");
     const QString cLogToFileTag = QString("logtofile");
@@ -32,6 +34,11 @@ namespace ProjectFileDefinitions
     const QString cColorTag = QString("color");
     const QString cBitmaskTag = QString("bitmask");
     const QString cShiftTag = QString("shift");
+    const QString cWordOrderTag = QString("wordorder");
+    const QString cFilterTag = QString("filter");
+    const QString cExpressionTag = QString("expression");
+    const QString cSmoothingTag = QString("smoothing");
+    const QString cAlarmTag = QString("alarm");
 
     const QString cScaleTag = QString("scale");
     const QString cXaxisTag = QString("xaxis");
@@ -40,11 +47,39 @@ namespace ProjectFileDefinitions
     const QString cMaxTag = QString("max");
     const QString cSlidingintervalTag = QString("slidinginterval");
 
+    const QString cStimulusTag = QString("stimulus");
+    const QString cTypeTag = QString("type");
+    const QString cStartTag = QString("start");
+    const QString cDurationTag = QString("duration");
+    const QString cIntervalTag = QString("interval");
+    const QString cInitialTag = QString("initial");
+    const QString cFinalTag = QString("final");
+    const QString cOffsetTag = QString("offset");
+    const QString cAmplitudeTag = QString("amplitude");
+    const QString cPeriodTag = QString("period");
+    const QString cPointTag = QString("point");
+
+    const QString cTriggerTag = QString("trigger");
+    const QString cLevelTag = QString("level");
+    const QString cBitTag = QString("bit");
+    const QString cPreTriggerTag = QString("pretrigger");
+    const QString cPostTriggerTag = QString("posttrigger");
+
+    const QString cRetentionTag = QString("retention");
+    const QString cSamplesTag = QString("samples");
+    const QString cMemoryTag = QString("memory");
+    const QString cStopAtLimitTag = QString("stopatlimit");
+    const QString cSpillToDiskTag = QString("spilltodisk");
+    const QString cCompressTag = QString("compress");
+    const QString cAlarmCommandTag = QString("alarmcommand");
+
     /* Attribute string */
     const QString cDatalevelAttribute = QString("datalevel");
     const QString cEnabledAttribute = QString("enabled");
     const QString cActiveAttribute = QString("active");
     const QString cModeAttribute = QString("mode");
+    const QString cTimeAttribute = QString("time");
+    const QString cKeepRawAttribute = QString("keepraw");
 
     /* Value strings */
     const QString cSlidingValue = QString("sliding");
@@ -53,6 +88,10 @@ namespace ProjectFileDefinitions
     const QString cWindowAutoValue = QString("windowauto");
     const QString cTrueValue = QString("true");
     const QString cFalseValue = QString("false");
+    const QString cTcpValue = QString("tcp");
+    const QString cUdpValue = QString("udp");
+    const QString cHighFirstValue = QString("highfirst");
+    const QString cLowFirstValue = QString("lowfirst");
 
     /* Constant values */
     const quint32 cCurrentDataLevel = 2;
@@ -5,17 +5,19 @@
 #include "guimodel.h"
 #include "settingsmodel.h"
 #include "graphdatamodel.h"
+#include "stimulusmodel.h"
 #include "util.h"
 
 #include "projectfiledefinitions.h"
 #include "projectfileexporter.h"
 
 
-ProjectFileExporter::ProjectFileExporter(GuiModel *pGuiModel, SettingsModel *pSettingsModel, GraphDataModel * pGraphDataModel, QObject *parent) : QObject(parent)
+ProjectFileExporter::ProjectFileExporter(GuiModel *pGuiModel, SettingsModel *pSettingsModel, GraphDataModel * pGraphDataModel, StimulusModel * pStimulusModel, QObject *parent) : QObject(parent)
 {
     _pGuiModel = pGuiModel;
     _pSettingsModel = pSettingsModel;
     _pGraphDataModel = pGraphDataModel;
+    _pStimulusModel = pStimulusModel;
 }
 
 void ProjectFileExporter::exportProjectFile(QString projectFile)
@@ -61,6 +63,11 @@ void ProjectFileExporter::createModbusTag(QDomElement * pParentElement)
     createConnectionTags(&modbusElement);
     createLogTag(&modbusElement);
 
+    for (qint32 idx = 0; idx < _pStimulusModel->size(); idx++)
+    {
+        createStimulusTag(&modbusElement, idx);
+    }
+
     pParentElement->appendChild(modbusElement);
 }
 
@@ -72,10 +79,17 @@ void ProjectFileExporter::createConnectionTags(QDomElement * pParentElement)
 
         addTextNode(ProjectFileDefinitions::cConnectionIdTag, QString("%1").arg(i), &connectionElement);
         addTextNode(ProjectFileDefinitions::cIpTag, _pSettingsModel->ipAddress(i), &connectionElement);
+        if (!_pSettingsModel->secondaryIpAddress(i).isEmpty())
+        {
+            addTextNode(ProjectFileDefinitions::cSecondaryIpTag, _pSettingsModel->secondaryIpAddress(i), &connectionElement);
+        }
         addTextNode(ProjectFileDefinitions::cPortTag, QString("%1").arg(_pSettingsModel->port(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cSlaveIdTag, QString("%1").arg(_pSettingsModel->slaveId(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cTimeoutTag, QString("%1").arg(_pSettingsModel->timeout(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cConsecutiveMaxTag, QString("%1").arg(_pSettingsModel->consecutiveMax(i)), &connectionElement);
+        addTextNode(ProjectFileDefinitions::cTransportTag,
+                    _pSettingsModel->udpTransport(i) ? ProjectFileDefinitions::cUdpValue : ProjectFileDefinitions::cTcpValue,
+                    &connectionElement);
 
         pParentElement->appendChild(connectionElement);
     }
@@ -87,6 +101,13 @@ void ProjectFileExporter::createLogTag(QDomElement * pParentElement)
 
     addTextNode(ProjectFileDefinitions::cPollTimeTag, QString("%1").arg(_pSettingsModel->pollTime()), &logElement);
     addTextNode(ProjectFileDefinitions::cAbsoluteTimesTag, convertBoolToText(_pSettingsModel->absoluteTimes()), &logElement);
+    addTextNode(ProjectFileDefinitions::cSpillToDiskTag, convertBoolToText(_pSettingsModel->spillToDisk()), &logElement);
+    addTextNode(ProjectFileDefinitions::cCompressTag, convertBoolToText(_pSettingsModel->compressSamples()), &logElement);
+
+    if (!_pSettingsModel->alarmCommand().isEmpty())
+    {
+        addTextNode(ProjectFileDefinitions::cAlarmCommandTag, _pSettingsModel->alarmCommand(), &logElement);
+    }
 
     /* Create logtofile tag */
     QDomElement logToFileElement = _domDocument.createElement(ProjectFileDefinitions::cLogToFileTag);
@@ -101,9 +122,94 @@ void ProjectFileExporter::createLogTag(QDomElement * pParentElement)
     }
     logElement.appendChild(logToFileElement);
 
+    /* Create trigger tag */
+    const TriggerCondition triggerCondition = _pSettingsModel->triggerCondition();
+    QDomElement triggerElement = _domDocument.createElement(ProjectFileDefinitions::cTriggerTag);
+    triggerElement.setAttribute(ProjectFileDefinitions::cEnabledAttribute, convertBoolToText(_pSettingsModel->triggerCapture()));
+    addTextNode(ProjectFileDefinitions::cTypeTag, TriggerCondition::typeToString(triggerCondition.type()), &triggerElement);
+    addTextNode(ProjectFileDefinitions::cConnectionIdTag, QString("%1").arg(triggerCondition.connectionId()), &triggerElement);
+    addTextNode(ProjectFileDefinitions::cAddressTag, QString("%1").arg(triggerCondition.registerAddress()), &triggerElement);
+    if (triggerCondition.type() == TriggerCondition::BIT_SET)
+    {
+        addTextNode(ProjectFileDefinitions::cBitTag, QString("%1").arg(triggerCondition.bit()), &triggerElement);
+    }
+    else
+    {
+        addTextNode(ProjectFileDefinitions::cLevelTag, Util::formatDoubleForExport(triggerCondition.level()), &triggerElement);
+    }
+    addTextNode(ProjectFileDefinitions::cPreTriggerTag, QString("%1").arg(_pSettingsModel->preTriggerTime()), &triggerElement);
+    addTextNode(ProjectFileDefinitions::cPostTriggerTag, QString("%1").arg(_pSettingsModel->postTriggerTime()), &triggerElement);
+    logElement.appendChild(triggerElement);
+
+    /* Create retention tag */
+    if (_pSettingsModel->retentionEnabled())
+    {
+        QDomElement retentionElement = _domDocument.createElement(ProjectFileDefinitions::cRetentionTag);
+        addTextNode(ProjectFileDefinitions::cDurationTag, QString("%1").arg(_pSettingsModel->retentionDuration()), &retentionElement);
+        addTextNode(ProjectFileDefinitions::cSamplesTag, QString("%1").arg(_pSettingsModel->retentionSamples()), &retentionElement);
+        addTextNode(ProjectFileDefinitions::cMemoryTag, QString("%1").arg(_pSettingsModel->retentionMemory()), &retentionElement);
+        addTextNode(ProjectFileDefinitions::cStopAtLimitTag, convertBoolToText(_pSettingsModel->stopAtMemoryLimit()), &retentionElement);
+        logElement.appendChild(retentionElement);
+    }
+
     pParentElement->appendChild(logElement);
 }
 
+void ProjectFileExporter::createStimulusTag(QDomElement * pParentElement, qint32 idx)
+{
+    const Stimulus stimulus = _pStimulusModel->stimulus(idx);
+
+    QDomElement stimulusElement = _domDocument.createElement(ProjectFileDefinitions::cStimulusTag);
+
+    addTextNode(ProjectFileDefinitions::cTypeTag, Stimulus::typeToString(stimulus.type()), &stimulusElement);
+    addTextNode(ProjectFileDefinitions::cConnectionIdTag, QString("%1").arg(stimulus.connectionId()), &stimulusElement);
+    addTextNode(ProjectFileDefinitions::cAddressTag, QString("%1").arg(stimulus.registerAddress()), &stimulusElement);
+    addTextNode(ProjectFileDefinitions::cStartTag, QString("%1").arg(stimulus.startTime()), &stimulusElement);
+
+    switch (stimulus.type())
+    {
+    case Stimulus::STEP:
+        addTextNode(ProjectFileDefinitions::cInitialTag, Util::formatDoubleForExport(stimulus.initialValue()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cFinalTag, Util::formatDoubleForExport(stimulus.finalValue()), &stimulusElement);
+        break;
+
+    case Stimulus::RAMP:
+        addTextNode(ProjectFileDefinitions::cDurationTag, QString("%1").arg(stimulus.duration()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cIntervalTag, QString("%1").arg(stimulus.interval()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cInitialTag, Util::formatDoubleForExport(stimulus.initialValue()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cFinalTag, Util::formatDoubleForExport(stimulus.finalValue()), &stimulusElement);
+        break;
+
+    case Stimulus::SINE:
+        addTextNode(ProjectFileDefinitions::cDurationTag, QString("%1").arg(stimulus.duration()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cIntervalTag, QString("%1").arg(stimulus.interval()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cOffsetTag, Util::formatDoubleForExport(stimulus.offset()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cAmplitudeTag, Util::formatDoubleForExport(stimulus.amplitude()), &stimulusElement);
+        addTextNode(ProjectFileDefinitions::cPeriodTag, QString("%1").arg(stimulus.period()), &stimulusElement);
+        break;
+
+    case Stimulus::TABLE:
+    {
+        QMapIterator<qint64, double> it(stimulus.tablePoints());
+        while (it.hasNext())
+        {
+            it.next();
+
+            QDomElement pointElement = _domDocument.createElement(ProjectFileDefinitions::cPointTag);
+            pointElement.setAttribute(ProjectFileDefinitions::cTimeAttribute, QString("%1").arg(it.key()));
+            pointElement.appendChild(_domDocument.createTextNode(Util::formatDoubleForExport(it.value())));
+            stimulusElement.appendChild(pointElement);
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    pParentElement->appendChild(stimulusElement);
+}
+
 void ProjectFileExporter::createScopeTag(QDomElement * pParentElement)
 {
     QDomElement scopeElement = _domDocument.createElement(ProjectFileDefinitions::cScopeTag);
@@ -132,6 +238,37 @@ void ProjectFileExporter::createRegisterTag(QDomElement * pParentElement, qint32
     addTextNode(ProjectFileDefinitions::cShiftTag, QString("%1").arg(_pGraphDataModel->shift(idx)), &registerElement);
     addTextNode(ProjectFileDefinitions::cConnectionIdTag, QString("%1").arg(_pGraphDataModel->connectionId(idx)), &registerElement);
 
+    if (_pGraphDataModel->isRegisterPair(idx))
+    {
+        addTextNode(ProjectFileDefinitions::cTypeTag, GraphData::valueTypeToString(_pGraphDataModel->valueType(idx)), &registerElement);
+        addTextNode(ProjectFileDefinitions::cWordOrderTag,
+                    _pGraphDataModel->isLowWordFirst(idx) ? ProjectFileDefinitions::cLowFirstValue : ProjectFileDefinitions::cHighFirstValue,
+                    &registerElement);
+    }
+
+    if (_pGraphDataModel->ingestFilter(idx).isEnabled())
+    {
+        addTextNode(ProjectFileDefinitions::cFilterTag, _pGraphDataModel->ingestFilter(idx).toString(), &registerElement);
+    }
+
+    if (_pGraphDataModel->isVirtual(idx))
+    {
+        addTextNode(ProjectFileDefinitions::cExpressionTag, _pGraphDataModel->expression(idx).toString(), &registerElement);
+    }
+
+    if (_pGraphDataModel->signalFilter(idx).isEnabled())
+    {
+        QDomElement smoothingElement = _domDocument.createElement(ProjectFileDefinitions::cSmoothingTag);
+        smoothingElement.setAttribute(ProjectFileDefinitions::cKeepRawAttribute, convertBoolToText(_pGraphDataModel->isRawSeriesKept(idx)));
+        smoothingElement.appendChild(_domDocument.createTextNode(_pGraphDataModel->signalFilter(idx).toString()));
+        registerElement.appendChild(smoothingElement);
+    }
+
+    if (_pGraphDataModel->alarmRule(idx).isEnabled())
+    {
+        addTextNode(ProjectFileDefinitions::cAlarmTag, _pGraphDataModel->alarmRule(idx).toString(), &registerElement);
+    }
+
     pParentElement->appendChild(registerElement);
 }
 
@@ -7,12 +7,13 @@
 #include "guimodel.h"
 #include "settingsmodel.h"
 #include "graphdatamodel.h"
+#include "stimulusmodel.h"
 
 class ProjectFileExporter : public QObject
 {
     Q_OBJECT
 public:
-    explicit ProjectFileExporter(GuiModel *pGuiModel, SettingsModel *pSettingsModel, GraphDataModel * pGraphDataModel, QObject *parent = 0);
+    explicit ProjectFileExporter(GuiModel *pGuiModel, SettingsModel *pSettingsModel, GraphDataModel * pGraphDataModel, StimulusModel * pStimulusModel, QObject *parent = 0);
 
     void exportProjectFile(QString projectFile);
 
@@ -27,6 +28,7 @@ private:
 
     void createConnectionTags(QDomElement * pParentElement);
     void createLogTag(QDomElement * pParentElement);
+    void createStimulusTag(QDomElement * pParentElement, qint32 idx);
 
     void createScopeTag(QDomElement * pParentElement);
     void createRegisterTag(QDomElement * pParentElement, qint32 idx);
@@ -39,6 +41,7 @@ private:
     GuiModel * _pGuiModel;
     SettingsModel * _pSettingsModel;
     GraphDataModel * _pGraphDataModel;
+    StimulusModel * _pStimulusModel;
 
     QDomDocument _domDocument;
 
@@ -7,11 +7,12 @@
 
 #include "projectfilehandler.h"
 
-ProjectFileHandler::ProjectFileHandler(GuiModel* pGuiModel, SettingsModel* pSettingsModel, GraphDataModel* pGraphDataModel) : QObject(nullptr)
+ProjectFileHandler::ProjectFileHandler(GuiModel* pGuiModel, SettingsModel* pSettingsModel, GraphDataModel* pGraphDataModel, StimulusModel* pStimulusModel) : QObject(nullptr)
 {
     _pGuiModel = pGuiModel;
     _pSettingsModel = pSettingsModel;
     _pGraphDataModel = pGraphDataModel;
+    _pStimulusModel = pStimulusModel;
 }
 
 void ProjectFileHandler::loadProjectFile(QString projectFilePath)
@@ -40,7 +41,7 @@ void ProjectFileHandler::loadProjectFile(QString projectFilePath)
 
 void ProjectFileHandler::selectSettingsExportFile()
 {
-    ProjectFileExporter projectFileExporter(_pGuiModel, _pSettingsModel, _pGraphDataModel);
+    ProjectFileExporter projectFileExporter(_pGuiModel, _pSettingsModel, _pGraphDataModel, _pStimulusModel);
     QString filePath;
     QFileDialog dialog;
     dialog.setFileMode(QFileDialog::AnyFile);
@@ -110,6 +111,15 @@ void ProjectFileHandler::updateConnectionSetting(ProjectFileParser::ProjectSetti
                 _pSettingsModel->setIpAddress(connectionId, pProjectSettings->general.connectionSettings[idx].ip);
             }
 
+            if (pProjectSettings->general.connectionSettings[idx].bSecondaryIp)
+            {
+                _pSettingsModel->setSecondaryIpAddress(connectionId, pProjectSettings->general.connectionSettings[idx].secondaryIp);
+            }
+            else
+            {
+                _pSettingsModel->setSecondaryIpAddress(connectionId, QString());
+            }
+
             if (pProjectSettings->general.connectionSettings[idx].bPort)
             {
                  _pSettingsModel->setPort(connectionId, pProjectSettings->general.connectionSettings[idx].port);
@@ -129,6 +139,8 @@ void ProjectFileHandler::updateConnectionSetting(ProjectFileParser::ProjectSetti
             {
                 _pSettingsModel->setConsecutiveMax(connectionId, pProjectSettings->general.connectionSettings[idx].consecutiveMax);
             }
+
+            _pSettingsModel->setUdpTransport(connectionId, pProjectSettings->general.connectionSettings[idx].bUdpTransport);
         }
     }
 
@@ -138,6 +150,9 @@ void ProjectFileHandler::updateConnectionSetting(ProjectFileParser::ProjectSetti
     }
 
     _pSettingsModel->setAbsoluteTimes(pProjectSettings->general.logSettings.bAbsoluteTimes);
+    _pSettingsModel->setSpillToDisk(pProjectSettings->general.logSettings.bSpillToDisk);
+    _pSettingsModel->setCompressSamples(pProjectSettings->general.logSettings.bCompress);
+    _pSettingsModel->setAlarmCommand(pProjectSettings->general.logSettings.alarmCommand);
 
     _pSettingsModel->setWriteDuringLog(pProjectSettings->general.logSettings.bLogToFile);
     if (pProjectSettings->general.logSettings.bLogToFileFile)
@@ -149,6 +164,48 @@ void ProjectFileHandler::updateConnectionSetting(ProjectFileParser::ProjectSetti
          _pSettingsModel->setWriteDuringLogFileToDefault();
     }
 
+    if (pProjectSettings->general.logSettings.bTrigger)
+    {
+        _pSettingsModel->setTriggerCapture(pProjectSettings->general.logSettings.bTriggerCapture);
+        _pSettingsModel->setTriggerCondition(pProjectSettings->general.logSettings.triggerCondition);
+    }
+    else
+    {
+        _pSettingsModel->setTriggerCapture(false);
+    }
+
+    if (pProjectSettings->general.logSettings.bPreTriggerTime)
+    {
+        _pSettingsModel->setPreTriggerTime(pProjectSettings->general.logSettings.preTriggerTime);
+    }
+
+    if (pProjectSettings->general.logSettings.bPostTriggerTime)
+    {
+        _pSettingsModel->setPostTriggerTime(pProjectSettings->general.logSettings.postTriggerTime);
+    }
+
+    if (pProjectSettings->general.logSettings.bRetention)
+    {
+        _pSettingsModel->setRetentionDuration(pProjectSettings->general.logSettings.retentionDuration);
+        _pSettingsModel->setRetentionSamples(pProjectSettings->general.logSettings.retentionSamples);
+        _pSettingsModel->setRetentionMemory(pProjectSettings->general.logSettings.retentionMemory);
+        _pSettingsModel->setStopAtMemoryLimit(pProjectSettings->general.logSettings.bStopAtMemoryLimit);
+    }
+    else
+    {
+        /* Keep all samples */
+        _pSettingsModel->setRetentionDuration(0);
+        _pSettingsModel->setRetentionSamples(0);
+        _pSettingsModel->setRetentionMemory(0);
+        _pSettingsModel->setStopAtMemoryLimit(false);
+    }
+
+    _pStimulusModel->clear();
+    foreach(Stimulus stimulus, pProjectSettings->general.stimulusList)
+    {
+        _pStimulusModel->add(stimulus);
+    }
+
     if (pProjectSettings->view.scaleSettings.bSliding)
     {
         _pGuiModel->setxAxisSlidingInterval(static_cast<qint32>(pProjectSettings->view.scaleSettings.slidingInterval));
@@ -174,7 +231,8 @@ void ProjectFileHandler::updateConnectionSetting(ProjectFileParser::ProjectSetti
         _pGuiModel->setyAxisScale(BasicGraphView::SCALE_AUTO);
     }
 
-    _pGraphDataModel->clear();
+    /* Registers are added at once: views are rebuilt only once */
+    QList<GraphData> graphDataList;
     for (qint32 i = 0; i < pProjectSettings->scope.registerList.size(); i++)
     {
         GraphData rowData;
@@ -188,9 +246,19 @@ void ProjectFileHandler::updateConnectionSetting(ProjectFileParser::ProjectSetti
         rowData.setColor(pProjectSettings->scope.registerList[i].color);
         rowData.setShift(pProjectSettings->scope.registerList[i].shift);
         rowData.setConnectionId(pProjectSettings->scope.registerList[i].connectionId);
+        rowData.setValueType(pProjectSettings->scope.registerList[i].valueType);
+        rowData.setLowWordFirst(pProjectSettings->scope.registerList[i].bLowWordFirst);
+        rowData.setIngestFilter(pProjectSettings->scope.registerList[i].ingestFilter);
+        rowData.setExpression(pProjectSettings->scope.registerList[i].expression);
+        rowData.setSignalFilter(pProjectSettings->scope.registerList[i].signalFilter);
+        rowData.setRawSeriesKept(pProjectSettings->scope.registerList[i].bRawSeriesKept);
+        rowData.setAlarmRule(pProjectSettings->scope.registerList[i].alarmRule);
 
-        _pGraphDataModel->add(rowData);
+        graphDataList.append(rowData);
     }
 
+    _pGraphDataModel->clear();
+    _pGraphDataModel->add(graphDataList);
+
     _pGuiModel->setFrontGraph(-1);
 }
@@ -6,6 +6,7 @@
 #include "guimodel.h"
 #include "settingsmodel.h"
 #include "graphdatamodel.h"
+#include "stimulusmodel.h"
 
 #include "projectfileparser.h"
 
@@ -13,7 +14,7 @@ class ProjectFileHandler : public QObject
 {
     Q_OBJECT
 public:
-    explicit ProjectFileHandler(GuiModel* pGuiModel, SettingsModel* pSettingsModel, GraphDataModel* pGraphDataModel);
+    explicit ProjectFileHandler(GuiModel* pGuiModel, SettingsModel* pSettingsModel, GraphDataModel* pGraphDataModel, StimulusModel* pStimulusModel);
 
     void loadProjectFile(QString projectFilePath);
 
@@ -32,6 +33,7 @@ private:
     GuiModel* _pGuiModel;
     SettingsModel* _pSettingsModel;
     GraphDataModel* _pGraphDataModel;
+    StimulusModel* _pStimulusModel;
 
 };
 
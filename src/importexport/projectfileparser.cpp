@@ -1,6 +1,7 @@
 
 #include <QtWidgets>
 #include "util.h"
+#include "settingsmodel.h"
 #include "projectfileparser.h"
 #include "projectfiledefinitions.h"
 
@@ -116,6 +117,16 @@ bool ProjectFileParser::parseModbusTag(const QDomElement &element, GeneralSettin
                 break;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cStimulusTag)
+        {
+            pGeneralSettings->stimulusList.append(Stimulus());
+
+            bRet = parseStimulusTag(child, &pGeneralSettings->stimulusList.last());
+            if (!bRet)
+            {
+                break;
+            }
+        }
         else
         {
             // unkown tag: ignore
@@ -137,6 +148,11 @@ bool ProjectFileParser::parseConnectionTag(const QDomElement &element, Connectio
             pConnectionSettings->bIp = true;
             pConnectionSettings->ip = child.text();
         }
+        else if (child.tagName() == ProjectFileDefinitions::cSecondaryIpTag)
+        {
+            pConnectionSettings->bSecondaryIp = true;
+            pConnectionSettings->secondaryIp = child.text().trimmed();
+        }
         else if (child.tagName() == ProjectFileDefinitions::cConnectionIdTag)
         {
             pConnectionSettings->bConnectionId = true;
@@ -187,6 +203,23 @@ bool ProjectFileParser::parseConnectionTag(const QDomElement &element, Connectio
                 break;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cTransportTag)
+        {
+            if (!child.text().toLower().compare(ProjectFileDefinitions::cUdpValue))
+            {
+                pConnectionSettings->bUdpTransport = true;
+            }
+            else if (!child.text().toLower().compare(ProjectFileDefinitions::cTcpValue))
+            {
+                pConnectionSettings->bUdpTransport = false;
+            }
+            else
+            {
+                Util::showError(tr("Transport ( %1 ) is not valid, use tcp or udp").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
         else
         {
             // unkown tag: ignore
@@ -224,6 +257,32 @@ bool ProjectFileParser::parseLogTag(const QDomElement &element, LogSettings * pL
                 pLogSettings->bAbsoluteTimes = false;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cSpillToDiskTag)
+        {
+            if (!child.text().toLower().compare(ProjectFileDefinitions::cTrueValue))
+            {
+                pLogSettings->bSpillToDisk = true;
+            }
+            else
+            {
+                pLogSettings->bSpillToDisk = false;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cCompressTag)
+        {
+            if (!child.text().toLower().compare(ProjectFileDefinitions::cTrueValue))
+            {
+                pLogSettings->bCompress = true;
+            }
+            else
+            {
+                pLogSettings->bCompress = false;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cAlarmCommandTag)
+        {
+            pLogSettings->alarmCommand = child.text().trimmed();
+        }
         else if (child.tagName() == ProjectFileDefinitions::cLogToFileTag)
         {
             bRet = parseLogToFile(child, pLogSettings);
@@ -232,6 +291,22 @@ bool ProjectFileParser::parseLogTag(const QDomElement &element, LogSettings * pL
                 break;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cTriggerTag)
+        {
+            bRet = parseTriggerTag(child, pLogSettings);
+            if (!bRet)
+            {
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cRetentionTag)
+        {
+            bRet = parseRetentionTag(child, pLogSettings);
+            if (!bRet)
+            {
+                break;
+            }
+        }
         else
         {
             // unkown tag: ignore
@@ -311,6 +386,378 @@ bool ProjectFileParser::parseLogToFile(const QDomElement &element, LogSettings *
     return bRet;
 }
 
+bool ProjectFileParser::parseTriggerTag(const QDomElement &element, LogSettings *pLogSettings)
+{
+    bool bRet = true;
+
+    pLogSettings->bTrigger = true;
+
+    // Check attribute
+    QString enabled = element.attribute(ProjectFileDefinitions::cEnabledAttribute, ProjectFileDefinitions::cTrueValue);
+
+    if (!enabled.toLower().compare(ProjectFileDefinitions::cTrueValue))
+    {
+        pLogSettings->bTriggerCapture = true;
+    }
+    else
+    {
+        pLogSettings->bTriggerCapture = false;
+    }
+
+    // Check nodes
+    QDomElement child = element.firstChildElement();
+    while (!child.isNull())
+    {
+        if (child.tagName() == ProjectFileDefinitions::cTypeTag)
+        {
+            TriggerCondition::Type type;
+            bRet = TriggerCondition::stringToType(child.text(), &type);
+            if (bRet)
+            {
+                pLogSettings->triggerCondition.setType(type);
+            }
+            else
+            {
+                Util::showError(tr("Trigger type ( %1 ) is not valid, use above, below, rising, falling or bit").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cConnectionIdTag)
+        {
+            const quint32 connectionId = child.text().toUInt(&bRet);
+            if (bRet && (connectionId < SettingsModel::CONNECTION_ID_CNT))
+            {
+                pLogSettings->triggerCondition.setConnectionId(static_cast<quint8>(connectionId));
+            }
+            else
+            {
+                Util::showError(tr("Trigger connection id ( %1 ) is not valid").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cAddressTag)
+        {
+            const quint32 address = child.text().toUInt(&bRet);
+            if (bRet && (address >= 40001) && (address <= 49999))
+            {
+                pLogSettings->triggerCondition.setRegisterAddress(static_cast<quint16>(address));
+            }
+            else
+            {
+                Util::showError(tr("Trigger address ( %1 ) is not a valid address between 40001 and 49999").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cLevelTag)
+        {
+            const double level = QLocale::system().toDouble(child.text(), &bRet);
+            if (bRet)
+            {
+                pLogSettings->triggerCondition.setLevel(level);
+            }
+            else
+            {
+                Util::showError(tr("Trigger level (%1) is not a valid double. Expected decimal separator is \"%2\".").arg(child.text()).arg(QLocale::system().decimalPoint()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cBitTag)
+        {
+            const quint32 bit = child.text().toUInt(&bRet);
+            if (bRet && (bit < 32))
+            {
+                pLogSettings->triggerCondition.setBit(static_cast<quint8>(bit));
+            }
+            else
+            {
+                Util::showError(tr("Trigger bit ( %1 ) is not a valid bit number (0 - 31)").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cPreTriggerTag)
+        {
+            pLogSettings->bPreTriggerTime = true;
+            pLogSettings->preTriggerTime = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                Util::showError(tr("Pre-trigger time ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cPostTriggerTag)
+        {
+            pLogSettings->bPostTriggerTime = true;
+            pLogSettings->postTriggerTime = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                Util::showError(tr("Post-trigger time ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else
+        {
+            // unkown tag: ignore
+        }
+        child = child.nextSiblingElement();
+    }
+
+    return bRet;
+}
+
+bool ProjectFileParser::parseRetentionTag(const QDomElement &element, LogSettings *pLogSettings)
+{
+    bool bRet = true;
+
+    pLogSettings->bRetention = true;
+
+    QDomElement child = element.firstChildElement();
+    while (!child.isNull())
+    {
+        if (child.tagName() == ProjectFileDefinitions::cDurationTag)
+        {
+            pLogSettings->retentionDuration = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                Util::showError(tr("Retention duration ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cSamplesTag)
+        {
+            pLogSettings->retentionSamples = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                Util::showError(tr("Retention samples ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cMemoryTag)
+        {
+            pLogSettings->retentionMemory = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                Util::showError(tr("Retention memory ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cStopAtLimitTag)
+        {
+            if (!child.text().toLower().compare(ProjectFileDefinitions::cTrueValue))
+            {
+                pLogSettings->bStopAtMemoryLimit = true;
+            }
+            else
+            {
+                pLogSettings->bStopAtMemoryLimit = false;
+            }
+        }
+        else
+        {
+            // unkown tag: ignore
+        }
+        child = child.nextSiblingElement();
+    }
+
+    return bRet;
+}
+
+bool ProjectFileParser::parseStimulusTag(const QDomElement &element, Stimulus *pStimulus)
+{
+    bool bRet = true;
+    QDomElement child = element.firstChildElement();
+    while (!child.isNull())
+    {
+        if (child.tagName() == ProjectFileDefinitions::cTypeTag)
+        {
+            Stimulus::Type type;
+            bRet = Stimulus::stringToType(child.text(), &type);
+            if (bRet)
+            {
+                pStimulus->setType(type);
+            }
+            else
+            {
+                Util::showError(tr("Stimulus type ( %1 ) is not valid, use step, ramp, sine or table").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cConnectionIdTag)
+        {
+            const quint32 connectionId = child.text().toUInt(&bRet);
+            if (bRet && (connectionId < SettingsModel::CONNECTION_ID_CNT))
+            {
+                pStimulus->setConnectionId(static_cast<quint8>(connectionId));
+            }
+            else
+            {
+                Util::showError(tr("Stimulus connection id ( %1 ) is not valid").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cAddressTag)
+        {
+            const quint32 address = child.text().toUInt(&bRet);
+            if (bRet && (address >= 40001) && (address <= 49999))
+            {
+                pStimulus->setRegisterAddress(static_cast<quint16>(address));
+            }
+            else
+            {
+                Util::showError(tr("Stimulus address ( %1 ) is not a valid address between 40001 and 49999").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cIntervalTag)
+        {
+            const quint32 interval = child.text().toUInt(&bRet);
+            if (bRet && (interval > 0))
+            {
+                pStimulus->setInterval(interval);
+            }
+            else
+            {
+                Util::showError(tr("Stimulus interval ( %1 ) is not a valid number").arg(child.text()));
+                bRet = false;
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cStartTag)
+        {
+            qint64 time;
+            bRet = parseStimulusTime(child, tr("start"), &time);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setStartTime(time);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cDurationTag)
+        {
+            qint64 time;
+            bRet = parseStimulusTime(child, tr("duration"), &time);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setDuration(time);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cPeriodTag)
+        {
+            qint64 time;
+            bRet = parseStimulusTime(child, tr("period"), &time);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setPeriod(time);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cInitialTag)
+        {
+            double value;
+            bRet = parseStimulusNumber(child, tr("initial"), &value);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setInitialValue(value);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cFinalTag)
+        {
+            double value;
+            bRet = parseStimulusNumber(child, tr("final"), &value);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setFinalValue(value);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cOffsetTag)
+        {
+            double value;
+            bRet = parseStimulusNumber(child, tr("offset"), &value);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setOffset(value);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cAmplitudeTag)
+        {
+            double value;
+            bRet = parseStimulusNumber(child, tr("amplitude"), &value);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->setAmplitude(value);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cPointTag)
+        {
+            const QString strTime = child.attribute(ProjectFileDefinitions::cTimeAttribute);
+            const qint64 time = strTime.toLongLong(&bRet);
+            if (!bRet || (time < 0))
+            {
+                Util::showError(tr("Stimulus point time ( %1 ) is not a valid number").arg(strTime));
+                bRet = false;
+                break;
+            }
+
+            double value;
+            bRet = parseStimulusNumber(child, tr("point"), &value);
+            if (!bRet)
+            {
+                break;
+            }
+            pStimulus->addTablePoint(time, value);
+        }
+        else
+        {
+            // unkown tag: ignore
+        }
+        child = child.nextSiblingElement();
+    }
+
+    if (bRet && !pStimulus->isValid())
+    {
+        Util::showError(tr("Stimulus on register %1 is incomplete (type: %2)").arg(pStimulus->registerAddress()).arg(Stimulus::typeToString(pStimulus->type())));
+        bRet = false;
+    }
+
+    return bRet;
+}
+
+bool ProjectFileParser::parseStimulusNumber(const QDomElement &element, QString name, double *pValue)
+{
+    bool bRet;
+
+    *pValue = QLocale::system().toDouble(element.text(), &bRet);
+    if (!bRet)
+    {
+        Util::showError(tr("Stimulus %1 (%2) is not a valid double. Expected decimal separator is \"%3\".").arg(name).arg(element.text()).arg(QLocale::system().decimalPoint()));
+    }
+
+    return bRet;
+}
+
+bool ProjectFileParser::parseStimulusTime(const QDomElement &element, QString name, qint64 *pTime)
+{
+    bool bRet;
+
+    *pTime = element.text().toLongLong(&bRet);
+    if (!bRet || (*pTime < 0))
+    {
+        Util::showError(tr("Stimulus %1 ( %2 ) is not a valid time").arg(name).arg(element.text()));
+        bRet = false;
+    }
+
+    return bRet;
+}
+
 bool ProjectFileParser::parseScopeTag(const QDomElement &element, ScopeSettings *pScopeSettings)
 {
     bool bRet = true;
@@ -331,9 +778,12 @@ bool ProjectFileParser::parseScopeTag(const QDomElement &element, ScopeSettings
 
             for (int i = 0; i < pScopeSettings->registerList.size(); i++)
             {
+                /* Virtual channels aren't read, so they can't be duplicate */
                 if (
                         (pScopeSettings->registerList[i].address == registerData.address)
                         && (pScopeSettings->registerList[i].bitmask == registerData.bitmask)
+                        && pScopeSettings->registerList[i].expression.isEmpty()
+                        && registerData.expression.isEmpty()
                     )
                 {
                     bFound = true;
@@ -511,6 +961,73 @@ bool ProjectFileParser::parseRegisterTag(const QDomElement &element, RegisterSet
                 break;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cTypeTag)
+        {
+            bRet = GraphData::stringToValueType(child.text().trimmed(), &pRegisterSettings->valueType);
+            if (!bRet)
+            {
+                Util::showError(tr("Register type (%1) is not valid. Expecting \"16bit\", \"32bit\" or \"float32\".").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cWordOrderTag)
+        {
+            const QString wordOrder = child.text().toLower().trimmed();
+            if (wordOrder == ProjectFileDefinitions::cHighFirstValue)
+            {
+                pRegisterSettings->bLowWordFirst = false;
+            }
+            else if (wordOrder == ProjectFileDefinitions::cLowFirstValue)
+            {
+                pRegisterSettings->bLowWordFirst = true;
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Word order (%1) is not valid. Expecting \"%2\" or \"%3\".").arg(child.text()).arg(ProjectFileDefinitions::cHighFirstValue).arg(ProjectFileDefinitions::cLowFirstValue));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cFilterTag)
+        {
+            bRet = IngestFilter::fromString(child.text(), &pRegisterSettings->ingestFilter);
+            if (!bRet)
+            {
+                Util::showError(tr("Filter (%1) is not valid. Expecting \"none\", \"change\", \"deadband <value>\", \"deadband <value>%\" or \"swinging door <value>\".").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cExpressionTag)
+        {
+            QString errorString;
+            bRet = ChannelExpression::fromString(child.text(), &pRegisterSettings->expression, &errorString);
+            if (!bRet)
+            {
+                Util::showError(tr("Expression (%1) is not valid: %2.").arg(child.text()).arg(errorString));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cSmoothingTag)
+        {
+            bRet = SignalFilter::fromString(child.text(), &pRegisterSettings->signalFilter);
+            if (!bRet)
+            {
+                Util::showError(tr("Smoothing (%1) is not valid. Expecting \"none\", \"average <samples>\", \"exponential <alpha>\", \"lowpass <time constant>\", \"median <samples>\" or \"decimate <samples>\".").arg(child.text()));
+                break;
+            }
+
+            const QString keepRaw = child.attribute(ProjectFileDefinitions::cKeepRawAttribute, ProjectFileDefinitions::cFalseValue);
+            pRegisterSettings->bRawSeriesKept = !keepRaw.toLower().compare(ProjectFileDefinitions::cTrueValue);
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cAlarmTag)
+        {
+            bRet = AlarmRule::fromString(child.text(), &pRegisterSettings->alarmRule);
+            if (!bRet)
+            {
+                Util::showError(tr("Alarm (%1) is not valid. Expecting \"none\", \"above <limit>\", \"below <limit>\", \"outside <low> <high>\", \"rate <limit>\" or \"bit <number>\", optionally followed by \"hysteresis <value>\".").arg(child.text()));
+                break;
+            }
+        }
         else
         {
             // unkown tag: ignore
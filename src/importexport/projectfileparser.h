@@ -5,6 +5,10 @@
 #include <QColor>
 #include <QDomDocument>
 
+#include "graphdata.h"
+#include "stimulus.h"
+#include "triggercondition.h"
+
 class ProjectFileParser : public QObject
 {
     Q_OBJECT
@@ -14,7 +18,7 @@ public:
     {
         _RegisterSettings() : address(40001), text(""), bActive(true), bUnsigned(false), divideFactor(1),
                               multiplyFactor(1), bitmask(0xFFFF), shift(0), connectionId(0),
-                              bColor(false) {}
+                              valueType(GraphData::VALUE_16BIT), bLowWordFirst(false), bRawSeriesKept(false), bColor(false) {}
 
         quint16 address;
         QString text;
@@ -25,6 +29,13 @@ public:
         quint16 bitmask;
         quint32 shift;
         quint8 connectionId;
+        GraphData::ValueType valueType;
+        bool bLowWordFirst;
+        IngestFilter ingestFilter;
+        ChannelExpression expression;
+        SignalFilter signalFilter;
+        bool bRawSeriesKept;
+        AlarmRule alarmRule;
 
         bool bColor;
         QColor color;
@@ -58,26 +69,52 @@ public:
 
     typedef struct _LogSettings
     {
-        _LogSettings() : bPollTime(false), bAbsoluteTimes(false), bLogToFile(true), bLogToFileFile(false) {}
+        _LogSettings() : bPollTime(false), bAbsoluteTimes(false), bSpillToDisk(false), bCompress(false), bLogToFile(true), bLogToFileFile(false),
+                         bTrigger(false), bTriggerCapture(false), bPreTriggerTime(false), bPostTriggerTime(false),
+                         bRetention(false), retentionDuration(0), retentionSamples(0), retentionMemory(0), bStopAtMemoryLimit(false) {}
 
         bool bPollTime;
         quint32 pollTime;
 
         bool bAbsoluteTimes;
 
+        bool bSpillToDisk;
+        bool bCompress;
+
         bool bLogToFile;
         bool bLogToFileFile;
         QString logFile;
 
+        bool bTrigger;
+        bool bTriggerCapture;
+        TriggerCondition triggerCondition;
+
+        bool bPreTriggerTime;
+        quint32 preTriggerTime;
+
+        bool bPostTriggerTime;
+        quint32 postTriggerTime;
+
+        bool bRetention;
+        quint32 retentionDuration;
+        quint32 retentionSamples;
+        quint32 retentionMemory;
+        bool bStopAtMemoryLimit;
+
+        QString alarmCommand;
+
     } LogSettings;
 
     typedef struct _ConnectionSettings
     {
-        _ConnectionSettings() : bIp(false), bConnectionId(false), bPort(false), bSlaveId(false), bTimeout(false), bConsecutiveMax(false) {}
+        _ConnectionSettings() : bIp(false), bSecondaryIp(false), bConnectionId(false), bPort(false), bSlaveId(false), bTimeout(false), bConsecutiveMax(false), bUdpTransport(false) {}
 
         bool bIp;
         QString ip;
 
+        bool bSecondaryIp;
+        QString secondaryIp;
+
         bool bConnectionId;
         quint8 connectionId;
 
@@ -93,12 +130,15 @@ public:
         bool bConsecutiveMax;
         quint8 consecutiveMax;
 
+        bool bUdpTransport;
+
     } ConnectionSettings;
 
     typedef struct _GeneralSettings
     {
         QList<ConnectionSettings> connectionSettings;
         LogSettings logSettings;
+        QList<Stimulus> stimulusList;
 
     } GeneralSettings;
 
@@ -124,6 +164,11 @@ private:
     bool parseConnectionTag(const QDomElement &element, ConnectionSettings *pConnectionSettings);
     bool parseLogTag(const QDomElement &element, LogSettings *pLogSettings);
     bool parseLogToFile(const QDomElement &element, LogSettings *pLogSettings);
+    bool parseTriggerTag(const QDomElement &element, LogSettings *pLogSettings);
+    bool parseRetentionTag(const QDomElement &element, LogSettings *pLogSettings);
+    bool parseStimulusTag(const QDomElement &element, Stimulus *pStimulus);
+    bool parseStimulusNumber(const QDomElement &element, QString name, double *pValue);
+    bool parseStimulusTime(const QDomElement &element, QString name, qint64 *pTime);
 
     bool parseScopeTag(const QDomElement &element, ScopeSettings *pScopeSettings);
     bool parseRegisterTag(const QDomElement &element, RegisterSettings *pRegisterSettings);
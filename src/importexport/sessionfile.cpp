@@ -0,0 +1,609 @@
+#include <QSaveFile>
+#include <QSysInfo>
+
+#include "settingsmodel.h"
+#include "sessionfile.h"
+
+const QString SessionFile::cFileExtension = QString("mbss");
+
+SessionFile::SessionFile() : QObject(nullptr)
+{
+    _pMap = nullptr;
+    _fileSize = 0;
+}
+
+/*!
+ * Write snapshot of session
+ * The file is only replaced when everything is written, so a snapshot that is currently opened (mapped) isn't truncated.
+ * \param filePath      Path of snapshot
+ * \param sessionData   Graphs (with samples), time columns, notes and markers
+ * \return false on failure (see errorString)
+ */
+bool SessionFile::write(const QString &filePath, const SessionData &sessionData)
+{
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        _errorString = tr("Couldn't open session file: %1").arg(filePath);
+        return false;
+    }
+
+    /* Header is written when offset of metadata is known */
+    bool bOk = file.write(QByteArray(_cHeaderSize, 0)) == _cHeaderSize;
+
+    QByteArray metadata;
+    QDataStream metaStream(&metadata, QIODevice::WriteOnly);
+    metaStream.setVersion(QDataStream::Qt_5_9);
+
+    /* Time columns of connections, followed by own time columns of graphs with ingest filter */
+    QList<QSharedPointer<SampleTimebase> > timebaseList = sessionData.timebaseList;
+    for (qint32 graphIdx = 0; graphIdx < sessionData.graphList.size(); graphIdx++)
+    {
+        const QSharedPointer<SampleTimebase> pTimebase = sessionData.graphList[graphIdx].sampleTimebase();
+
+        if (!pTimebase.isNull() && !timebaseList.contains(pTimebase))
+        {
+            timebaseList.append(pTimebase);
+        }
+    }
+
+    metaStream << static_cast<qint32>(sessionData.timebaseList.size()) << static_cast<qint32>(timebaseList.size());
+
+    for (qint32 timebaseIdx = 0; bOk && (timebaseIdx < timebaseList.size()); timebaseIdx++)
+    {
+        const QSharedPointer<SampleTimebase> pTimebase = timebaseList[timebaseIdx];
+
+        QVector<double> chunkFirstKeys;
+        for (qint32 chunkIdx = 0; chunkIdx < pTimebase->chunkCount(); chunkIdx++)
+        {
+            chunkFirstKeys.append(pTimebase->chunkFirstKey(chunkIdx));
+        }
+
+        metaStream << pTimebase->size() << chunkFirstKeys << pTimebase->chunkCount();
+
+        for (qint32 chunkIdx = 0; bOk && (chunkIdx < pTimebase->chunkCount()); chunkIdx++)
+        {
+            bOk = writeChunk(&file, metaStream, pTimebase->storedChunk(chunkIdx));
+        }
+    }
+
+    metaStream << static_cast<qint32>(sessionData.graphList.size());
+
+    for (qint32 graphIdx = 0; bOk && (graphIdx < sessionData.graphList.size()); graphIdx++)
+    {
+        const GraphData &graphData = sessionData.graphList[graphIdx];
+
+        metaStream << graphData.label()
+                   << graphData.color()
+                   << graphData.isVisible()
+                   << graphData.isActive()
+                   << graphData.isUnsigned()
+                   << graphData.multiplyFactor()
+                   << graphData.divideFactor()
+                   << graphData.registerAddress()
+                   << graphData.bitmask()
+                   << graphData.shift()
+                   << graphData.connectionId()
+                   << static_cast<quint32>(graphData.valueType())
+                   << graphData.isLowWordFirst()
+                   << graphData.ingestFilter().toString()
+                   << graphData.expression().toString()
+                   << graphData.signalFilter().toString()
+                   << graphData.isRawSeriesKept()
+                   << graphData.alarmRule().toString();
+
+        /* Graph without samples has no time column */
+        const QSharedPointer<SampleColumn> pColumn = graphData.sampleColumn();
+        const qint32 timebaseIdx = pColumn.isNull() ? -1 : timebaseList.indexOf(graphData.sampleTimebase());
+
+        metaStream << timebaseIdx;
+
+        if (timebaseIdx >= 0)
+        {
+            bOk = writeColumn(&file, metaStream, pColumn);
+        }
+
+        /* Unfiltered values of graph with signal filter (on time column of connection) */
+        const QSharedPointer<SampleColumn> pRawColumn = graphData.rawColumn();
+        const qint32 rawTimebaseIdx = pRawColumn.isNull() ? -1 : timebaseList.indexOf(graphData.rawTimebase());
+
+        metaStream << rawTimebaseIdx;
+
+        if (bOk && (rawTimebaseIdx >= 0))
+        {
+            bOk = writeColumn(&file, metaStream, pRawColumn);
+        }
+    }
+
+    metaStream << static_cast<qint32>(sessionData.noteList.size());
+
+    foreach(Note note, sessionData.noteList)
+    {
+        metaStream << note.keyData() << note.valueData() << note.text() << note.draggable();
+    }
+
+    metaStream << sessionData.bMarkers << sessionData.startMarkerPos << sessionData.endMarkerPos;
+
+    const qint64 metadataOffset = file.pos();
+    bOk = bOk && (file.write(metadata) == metadata.size());
+
+    if (bOk)
+    {
+        QByteArray header;
+        QDataStream headerStream(&header, QIODevice::WriteOnly);
+        headerStream.setVersion(QDataStream::Qt_5_9);
+
+        headerStream << _cMagic
+                     << _cVersion
+                     << static_cast<quint32>(QSysInfo::ByteOrder)
+                     << static_cast<quint32>(0)
+                     << static_cast<quint64>(metadataOffset)
+                     << static_cast<quint64>(metadata.size());
+
+        bOk = file.seek(0) && (file.write(header) == header.size());
+    }
+
+    if (bOk)
+    {
+        bOk = file.commit();
+    }
+    else
+    {
+        file.cancelWriting();
+    }
+
+    if (!bOk)
+    {
+        _errorString = tr("Couldn't write session file: %1").arg(filePath);
+    }
+
+    return bOk;
+}
+
+/*!
+ * Read snapshot of session
+ * The file is memory mapped: the restored columns refer to the chunks in the file and keep it open.
+ * \param filePath      Path of snapshot
+ * \param pSessionData  Restored graphs (with samples), time columns, notes and markers
+ * \return false on failure (see errorString)
+ */
+bool SessionFile::read(const QString &filePath, SessionData * pSessionData)
+{
+    _pFile = QSharedPointer<QFile>(new QFile(filePath));
+
+    if (!_pFile->open(QIODevice::ReadOnly))
+    {
+        _errorString = tr("Couldn't open session file: %1").arg(filePath);
+        return false;
+    }
+
+    _fileSize = _pFile->size();
+    _pMap = nullptr;
+
+    if (_fileSize >= _cHeaderSize)
+    {
+        _pMap = _pFile->map(0, _fileSize);
+    }
+
+    if (_pMap == nullptr)
+    {
+        _errorString = tr("Invalid session file: %1").arg(filePath);
+        return false;
+    }
+
+    quint32 magic;
+    quint32 version;
+    quint32 byteOrder;
+    quint32 reserved;
+    quint64 metadataOffset;
+    quint64 metadataSize;
+
+    QDataStream headerStream(QByteArray::fromRawData(reinterpret_cast<const char *>(_pMap), _cHeaderSize));
+    headerStream.setVersion(QDataStream::Qt_5_9);
+    headerStream >> magic >> version >> byteOrder >> reserved >> metadataOffset >> metadataSize;
+
+    if (magic != _cMagic)
+    {
+        _errorString = tr("Invalid session file: %1").arg(filePath);
+        return false;
+    }
+    else if (version > _cVersion)
+    {
+        _errorString = tr("Session file is created by a newer version of ModbusScope: %1").arg(filePath);
+        return false;
+    }
+    else if (byteOrder != static_cast<quint32>(QSysInfo::ByteOrder))
+    {
+        _errorString = tr("Session file is created on a system with another byte order: %1").arg(filePath);
+        return false;
+    }
+    else if (
+        (metadataOffset < static_cast<quint64>(_cHeaderSize))
+        || (metadataOffset > static_cast<quint64>(_fileSize))
+        || (metadataSize > static_cast<quint64>(_fileSize) - metadataOffset)
+    )
+    {
+        _errorString = tr("Invalid session file: %1").arg(filePath);
+        return false;
+    }
+    else
+    {
+        // Valid header
+    }
+
+    QDataStream metaStream(QByteArray::fromRawData(reinterpret_cast<const char *>(_pMap) + metadataOffset, static_cast<int>(metadataSize)));
+    metaStream.setVersion(QDataStream::Qt_5_9);
+
+    SessionData sessionData;
+    QList<QSharedPointer<SampleTimebase> > timebaseList;
+    qint32 connectionCount;
+    qint32 timebaseCount;
+
+    metaStream >> connectionCount >> timebaseCount;
+
+    bool bOk = (metaStream.status() == QDataStream::Ok) && (connectionCount >= 0) && (connectionCount <= timebaseCount);
+
+    const qint32 keyChunkBytes = SampleCodec::chunkBytes(SampleCodec::FORMAT_KEYS, SampleTimebase::cChunkSize);
+
+    for (qint32 timebaseIdx = 0; bOk && (timebaseIdx < timebaseCount); timebaseIdx++)
+    {
+        qint32 size;
+        QVector<double> chunkFirstKeys;
+        QList<SampleChunkStore::StoredChunk> chunkList;
+
+        metaStream >> size >> chunkFirstKeys;
+
+        bOk = readChunkList(metaStream, keyChunkBytes, &chunkList) && (chunkFirstKeys.size() == chunkList.size());
+
+        /* Last chunk holds last key */
+        const qint64 endRow = static_cast<qint64>(chunkList.size()) * SampleTimebase::cChunkSize;
+        bOk = bOk && (size >= 0) && (size <= endRow) && (chunkList.isEmpty() || (size > endRow - SampleTimebase::cChunkSize));
+
+        if (bOk)
+        {
+            QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+            pTimebase->restore(size, chunkFirstKeys, chunkList, _pFile);
+
+            timebaseList.append(pTimebase);
+        }
+    }
+
+    qint32 graphCount = 0;
+    if (bOk)
+    {
+        metaStream >> graphCount;
+    }
+
+    for (qint32 graphIdx = 0; bOk && (graphIdx < graphCount); graphIdx++)
+    {
+        QString label;
+        QColor color;
+        bool bVisible;
+        bool bActive;
+        bool bUnsigned;
+        double multiplyFactor;
+        double divideFactor;
+        quint16 registerAddress;
+        quint16 bitmask;
+        qint32 shift;
+        quint8 connectionId;
+        quint32 valueType;
+        bool bLowWordFirst;
+        QString filterText;
+        QString expressionText;
+        QString smoothingText;
+        bool bRawSeriesKept = false;
+        QString alarmText;
+        qint32 timebaseIdx;
+        IngestFilter ingestFilter;
+        ChannelExpression expression;
+        SignalFilter signalFilter;
+        AlarmRule alarmRule;
+
+        metaStream >> label >> color >> bVisible >> bActive >> bUnsigned >> multiplyFactor >> divideFactor
+                   >> registerAddress >> bitmask >> shift >> connectionId >> valueType >> bLowWordFirst >> filterText;
+
+        /* Virtual channels are added in version 2 */
+        if (version >= 2)
+        {
+            metaStream >> expressionText;
+        }
+
+        /* Signal filters are added in version 3 */
+        if (version >= 3)
+        {
+            metaStream >> smoothingText >> bRawSeriesKept;
+        }
+
+        /* Alarm rules are added in version 4 */
+        if (version >= 4)
+        {
+            metaStream >> alarmText;
+        }
+
+        metaStream >> timebaseIdx;
+
+        bOk = (metaStream.status() == QDataStream::Ok)
+                && (connectionId < SettingsModel::CONNECTION_ID_CNT)
+                && (valueType <= static_cast<quint32>(GraphData::VALUE_FLOAT32))
+                && IngestFilter::fromString(filterText, &ingestFilter)
+                && (expressionText.isEmpty() || ChannelExpression::fromString(expressionText, &expression))
+                && SignalFilter::fromString(smoothingText, &signalFilter)
+                && AlarmRule::fromString(alarmText, &alarmRule)
+                && (timebaseIdx < timebaseList.size());
+
+        if (bOk)
+        {
+            GraphData graphData;
+
+            graphData.setLabel(label);
+            graphData.setColor(color);
+            graphData.setVisible(bVisible);
+            graphData.setActive(bActive);
+            graphData.setUnsigned(bUnsigned);
+            graphData.setMultiplyFactor(multiplyFactor);
+            graphData.setDivideFactor(divideFactor);
+            graphData.setRegisterAddress(registerAddress);
+            graphData.setBitmask(bitmask);
+            graphData.setShift(shift);
+            graphData.setConnectionId(connectionId);
+            graphData.setValueType(static_cast<GraphData::ValueType>(valueType));
+            graphData.setLowWordFirst(bLowWordFirst);
+            graphData.setIngestFilter(ingestFilter);
+            graphData.setExpression(expression);
+            graphData.setSignalFilter(signalFilter);
+            graphData.setRawSeriesKept(bRawSeriesKept);
+            graphData.setAlarmRule(alarmRule);
+
+            if (timebaseIdx >= 0)
+            {
+                QSharedPointer<SampleColumn> pColumn;
+
+                bOk = readColumn(metaStream, &pColumn);
+                if (bOk)
+                {
+                    graphData.setSampleColumn(timebaseList[timebaseIdx], pColumn);
+                }
+            }
+
+            if (version >= 3)
+            {
+                qint32 rawTimebaseIdx = -1;
+                metaStream >> rawTimebaseIdx;
+
+                bOk = bOk && (metaStream.status() == QDataStream::Ok) && (rawTimebaseIdx < timebaseList.size());
+
+                if (bOk && (rawTimebaseIdx >= 0))
+                {
+                    QSharedPointer<SampleColumn> pRawColumn;
+
+                    bOk = readColumn(metaStream, &pRawColumn);
+                    if (bOk)
+                    {
+                        graphData.setRawColumn(timebaseList[rawTimebaseIdx], pRawColumn);
+                    }
+                }
+            }
+
+            sessionData.graphList.append(graphData);
+        }
+    }
+
+    qint32 noteCount = 0;
+    if (bOk)
+    {
+        metaStream >> noteCount;
+    }
+
+    for (qint32 noteIdx = 0; bOk && (noteIdx < noteCount); noteIdx++)
+    {
+        double keyData;
+        double valueData;
+        QString text;
+        bool bDraggable;
+
+        metaStream >> keyData >> valueData >> text >> bDraggable;
+
+        Note note;
+        note.setKeyData(keyData);
+        note.setValueData(valueData);
+        note.setText(text);
+        note.setDraggable(bDraggable);
+
+        sessionData.noteList.append(note);
+
+        bOk = metaStream.status() == QDataStream::Ok;
+    }
+
+    if (bOk)
+    {
+        metaStream >> sessionData.bMarkers >> sessionData.startMarkerPos >> sessionData.endMarkerPos;
+
+        bOk = metaStream.status() == QDataStream::Ok;
+    }
+
+    if (!bOk)
+    {
+        _errorString = tr("Invalid session file: %1").arg(filePath);
+        return false;
+    }
+
+    sessionData.timebaseList = timebaseList.mid(0, connectionCount);
+
+    *pSessionData = sessionData;
+
+    return true;
+}
+
+QString SessionFile::errorString() const
+{
+    return _errorString;
+}
+
+bool SessionFile::writeChunk(QFileDevice * pFile, QDataStream &metaStream, const SampleChunkStore::StoredChunk &storedChunk)
+{
+    /* Keep data aligned for reading values in place */
+    const qint32 padding = static_cast<qint32>((_cAlignment - pFile->pos() % _cAlignment) % _cAlignment);
+    if ((padding > 0) && (pFile->write(QByteArray(padding, 0)) != padding))
+    {
+        return false;
+    }
+
+    metaStream << static_cast<quint8>(storedChunk.type) << static_cast<quint64>(pFile->pos()) << storedChunk.size;
+
+    if (storedChunk.size > 0)
+    {
+        return pFile->write(storedChunk.pData, storedChunk.size) == storedChunk.size;
+    }
+
+    return true;
+}
+
+/*!
+ * Read chunk descriptions and check that chunks are within mapped file
+ * \param metaStream    Metadata
+ * \param chunkBytes    Size of raw chunk
+ * \param pChunkList    Chunks in mapped file
+ * \return false when chunks are invalid
+ */
+bool SessionFile::readChunkList(QDataStream &metaStream, qint32 chunkBytes, QList<SampleChunkStore::StoredChunk> * pChunkList)
+{
+    qint32 chunkCount;
+    metaStream >> chunkCount;
+
+    for (qint32 chunkIdx = 0; (metaStream.status() == QDataStream::Ok) && (chunkIdx < chunkCount); chunkIdx++)
+    {
+        quint8 type;
+        quint64 offset;
+        qint32 size;
+
+        metaStream >> type >> offset >> size;
+
+        SampleChunkStore::StoredChunk storedChunk;
+        storedChunk.type = static_cast<SampleChunkStore::StoredType>(type);
+        storedChunk.pData = nullptr;
+        storedChunk.size = 0;
+
+        if (type == SampleChunkStore::CHUNK_EMPTY)
+        {
+            /* No data */
+        }
+        else if ((type == SampleChunkStore::CHUNK_RAW) || (type == SampleChunkStore::CHUNK_COMPRESSED))
+        {
+            if (
+                ((type == SampleChunkStore::CHUNK_RAW) && (size != chunkBytes))
+                || (size <= 0)
+                || ((offset % _cAlignment) != 0)
+                || (offset > static_cast<quint64>(_fileSize))
+                || (static_cast<quint64>(size) > static_cast<quint64>(_fileSize) - offset)
+            )
+            {
+                return false;
+            }
+
+            storedChunk.pData = reinterpret_cast<const char *>(_pMap) + offset;
+            storedChunk.size = size;
+        }
+        else
+        {
+            return false;
+        }
+
+        pChunkList->append(storedChunk);
+    }
+
+    return metaStream.status() == QDataStream::Ok;
+}
+
+bool SessionFile::writeColumn(QFileDevice * pFile, QDataStream &metaStream, QSharedPointer<SampleColumn> pColumn)
+{
+    const QList<SampleColumn::Gap> gaps = pColumn->gaps();
+
+    metaStream << static_cast<quint32>(pColumn->type()) << pColumn->size() << pColumn->firstStoredChunk();
+
+    metaStream << static_cast<qint32>(gaps.size());
+    for (qint32 gapIdx = 0; gapIdx < gaps.size(); gapIdx++)
+    {
+        metaStream << gaps[gapIdx].begin << gaps[gapIdx].end;
+    }
+
+    metaStream << pColumn->storedChunkCount();
+    for (qint32 chunkIdx = 0; chunkIdx < pColumn->storedChunkCount(); chunkIdx++)
+    {
+        if (!writeChunk(pFile, metaStream, pColumn->storedChunk(chunkIdx)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SessionFile::readColumn(QDataStream &metaStream, QSharedPointer<SampleColumn> * pColumn)
+{
+    quint32 type;
+    qint32 size;
+    qint32 firstChunk;
+    qint32 gapCount;
+
+    metaStream >> type >> size >> firstChunk >> gapCount;
+
+    if (
+        (metaStream.status() != QDataStream::Ok)
+        || (type > static_cast<quint32>(SampleColumn::TYPE_DOUBLE))
+        || (size < 0)
+        || (firstChunk < 0)
+    )
+    {
+        return false;
+    }
+
+    /* Gaps are sorted and within column */
+    QList<SampleColumn::Gap> gaps;
+    qint32 previousEnd = 0;
+
+    for (qint32 gapIdx = 0; gapIdx < gapCount; gapIdx++)
+    {
+        SampleColumn::Gap gap;
+        metaStream >> gap.begin >> gap.end;
+
+        if (
+            (metaStream.status() != QDataStream::Ok)
+            || (gap.begin < previousEnd)
+            || (gap.end <= gap.begin)
+            || (gap.end > size)
+        )
+        {
+            return false;
+        }
+
+        gaps.append(gap);
+        previousEnd = gap.end;
+    }
+
+    const SampleColumn::Type columnType = static_cast<SampleColumn::Type>(type);
+    const qint32 chunkBytes = SampleCodec::chunkBytes(SampleColumn::codecFormat(columnType), SampleColumn::cChunkSize);
+
+    QList<SampleChunkStore::StoredChunk> chunkList;
+    if (!readChunkList(metaStream, chunkBytes, &chunkList))
+    {
+        return false;
+    }
+
+    /* Last stored chunk holds last row */
+    if (!chunkList.isEmpty())
+    {
+        const qint64 endRow = (static_cast<qint64>(firstChunk) + chunkList.size()) * SampleColumn::cChunkSize;
+
+        if ((size > endRow) || (size <= endRow - SampleColumn::cChunkSize))
+        {
+            return false;
+        }
+    }
+
+    *pColumn = QSharedPointer<SampleColumn>(new SampleColumn(columnType));
+    (*pColumn)->restore(size, firstChunk, gaps, chunkList, _pFile);
+
+    return true;
+}
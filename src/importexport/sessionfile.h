@@ -0,0 +1,76 @@
+#ifndef SESSIONFILE_H
+#define SESSIONFILE_H
+
+#include <QObject>
+#include <QList>
+#include <QDataStream>
+#include <QFileDevice>
+
+#include "graphdata.h"
+#include "note.h"
+
+/*!
+ * Binary snapshot of a session: graph definitions, raw samples, notes and markers
+ *
+ * The chunks of the sample columns are written as they are stored (raw or compressed), so writing doesn't
+ * convert samples. When a snapshot is read, the file is memory mapped and the restored columns refer to the
+ * chunks in the mapped file, only the definitions are parsed. The operating system pages samples in on access.
+ *
+ * Layout:
+ *  - header: magic, format version, byte order of chunk data, offset and size of metadata
+ *  - chunk data (aligned, native byte order)
+ *  - metadata (QDataStream): time columns, graphs with their value column, notes and markers.
+ *    Every chunk is described by its type (raw, compressed or empty), offset and size.
+ */
+class SessionFile : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    typedef struct
+    {
+        QList<GraphData> graphList;
+
+        /* Time column of every connection (graphs with ingest filter have their own time column) */
+        QList<QSharedPointer<SampleTimebase> > timebaseList;
+
+        QList<Note> noteList;
+
+        bool bMarkers;
+        double startMarkerPos;
+        double endMarkerPos;
+
+    } SessionData;
+
+    static const QString cFileExtension;
+
+    SessionFile();
+
+    bool write(const QString &filePath, const SessionData &sessionData);
+    bool read(const QString &filePath, SessionData * pSessionData);
+
+    QString errorString() const;
+
+private:
+
+    bool writeChunk(QFileDevice * pFile, QDataStream &metaStream, const SampleChunkStore::StoredChunk &storedChunk);
+    bool readChunkList(QDataStream &metaStream, qint32 chunkBytes, QList<SampleChunkStore::StoredChunk> * pChunkList);
+
+    bool writeColumn(QFileDevice * pFile, QDataStream &metaStream, QSharedPointer<SampleColumn> pColumn);
+    bool readColumn(QDataStream &metaStream, QSharedPointer<SampleColumn> * pColumn);
+
+    static const quint32 _cMagic = 0x4D425353; /* "MBSS" */
+    static const quint32 _cVersion = 4;
+    static const qint32 _cHeaderSize = 32;
+    static const qint32 _cAlignment = 8;
+
+    QString _errorString;
+
+    /* Mapped file that is read */
+    QSharedPointer<QFile> _pFile;
+    const uchar * _pMap;
+    qint64 _fileSize;
+};
+
+#endif // SESSIONFILE_H
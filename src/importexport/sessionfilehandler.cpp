@@ -0,0 +1,138 @@
+#include <QFileDialog>
+
+#include "util.h"
+#include "settingsmodel.h"
+#include "sessionfile.h"
+
+#include "sessionfilehandler.h"
+
+SessionFileHandler::SessionFileHandler(GuiModel* pGuiModel, GraphDataModel* pGraphDataModel, NoteModel* pNoteModel) : QObject(nullptr)
+{
+    _pGuiModel = pGuiModel;
+    _pGraphDataModel = pGraphDataModel;
+    _pNoteModel = pNoteModel;
+}
+
+/*!
+ * Restore graphs, samples, notes and markers of session snapshot
+ * Samples stay in the (memory mapped) snapshot file, so this doesn't depend on the number of samples.
+ */
+void SessionFileHandler::loadSessionFile(QString sessionFilePath)
+{
+    SessionFile sessionFile;
+    SessionFile::SessionData sessionData;
+
+    if (sessionFile.read(sessionFilePath, &sessionData))
+    {
+        // Set to full auto scaling
+        _pGuiModel->setxAxisScale(BasicGraphView::SCALE_AUTO);
+        _pGuiModel->setyAxisScale(BasicGraphView::SCALE_AUTO);
+
+        _pGuiModel->setFrontGraph(-1);
+
+        _pGraphDataModel->restore(sessionData.graphList, sessionData.timebaseList);
+
+        _pNoteModel->clear();
+        for (qint32 idx = 0; idx < sessionData.noteList.size(); idx++)
+        {
+            _pNoteModel->add(sessionData.noteList[idx]);
+        }
+        _pNoteModel->setNotesDataUpdated(false);
+
+        _pGuiModel->clearMarkersState();
+        if (sessionData.bMarkers)
+        {
+            _pGuiModel->setStartMarkerPos(sessionData.startMarkerPos);
+            _pGuiModel->setEndMarkerPos(sessionData.endMarkerPos);
+        }
+
+        _pGuiModel->setFrontGraph(0);
+
+        /* Snapshot isn't a data file: notes aren't written back to it */
+        _pGuiModel->setProjectFilePath("");
+        _pGuiModel->setDataFilePath("");
+
+        _pGuiModel->setGuiState(GuiModel::DATA_LOADED);
+
+        _pGuiModel->setWindowTitleDetail(QFileInfo(sessionFilePath).fileName());
+    }
+    else
+    {
+        Util::showError(sessionFile.errorString());
+    }
+}
+
+/*!
+ * Write graphs, samples, notes and markers to session snapshot
+ */
+void SessionFileHandler::saveSessionFile(QString sessionFilePath)
+{
+    SessionFile sessionFile;
+    SessionFile::SessionData sessionData;
+
+    sessionData.graphList = _pGraphDataModel->graphDataList();
+
+    for (quint8 connectionId = 0u; connectionId < SettingsModel::CONNECTION_ID_CNT; connectionId++)
+    {
+        sessionData.timebaseList.append(_pGraphDataModel->connectionTimebase(connectionId));
+    }
+
+    for (qint32 idx = 0; idx < _pNoteModel->size(); idx++)
+    {
+        Note note;
+        note.setKeyData(_pNoteModel->keyData(static_cast<quint32>(idx)));
+        note.setValueData(_pNoteModel->valueData(static_cast<quint32>(idx)));
+        note.setText(_pNoteModel->textData(static_cast<quint32>(idx)));
+        note.setDraggable(_pNoteModel->draggable(static_cast<quint32>(idx)));
+
+        sessionData.noteList.append(note);
+    }
+
+    sessionData.bMarkers = _pGuiModel->markerState();
+    sessionData.startMarkerPos = _pGuiModel->startMarkerPos();
+    sessionData.endMarkerPos = _pGuiModel->endMarkerPos();
+
+    if (!sessionFile.write(sessionFilePath, sessionData))
+    {
+        Util::showError(sessionFile.errorString());
+    }
+}
+
+void SessionFileHandler::selectSessionOpenFile()
+{
+    QString filePath;
+    QFileDialog dialog;
+    dialog.setFileMode(QFileDialog::ExistingFile);
+    dialog.setAcceptMode(QFileDialog::AcceptOpen);
+    dialog.setOption(QFileDialog::HideNameFilterDetails, false);
+    dialog.setWindowTitle(tr("Select session file"));
+    dialog.setNameFilter(tr("Session files (*.%1)").arg(SessionFile::cFileExtension));
+    dialog.setDirectory(_pGuiModel->lastDir());
+
+    if (dialog.exec())
+    {
+        filePath = dialog.selectedFiles().first();
+        _pGuiModel->setLastDir(QFileInfo(filePath).dir().absolutePath());
+        loadSessionFile(filePath);
+    }
+}
+
+void SessionFileHandler::selectSessionSaveFile()
+{
+    QString filePath;
+    QFileDialog dialog;
+    dialog.setFileMode(QFileDialog::AnyFile);
+    dialog.setAcceptMode(QFileDialog::AcceptSave);
+    dialog.setOption(QFileDialog::HideNameFilterDetails, false);
+    dialog.setDefaultSuffix(SessionFile::cFileExtension);
+    dialog.setWindowTitle(tr("Select session file"));
+    dialog.setNameFilter(tr("Session files (*.%1)").arg(SessionFile::cFileExtension));
+    dialog.setDirectory(_pGuiModel->lastDir());
+
+    if (dialog.exec())
+    {
+        filePath = dialog.selectedFiles().first();
+        _pGuiModel->setLastDir(QFileInfo(filePath).dir().absolutePath());
+        saveSessionFile(filePath);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef SESSIONFILEHANDLER_H
+#define SESSIONFILEHANDLER_H
+
+#include <QObject>
+
+#include "guimodel.h"
+#include "graphdatamodel.h"
+#include "notemodel.h"
+
+class SessionFileHandler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SessionFileHandler(GuiModel* pGuiModel, GraphDataModel* pGraphDataModel, NoteModel* pNoteModel);
+
+    void loadSessionFile(QString sessionFilePath);
+    void saveSessionFile(QString sessionFilePath);
+
+signals:
+
+public slots:
+    void selectSessionOpenFile();
+    void selectSessionSaveFile();
+
+private:
+
+    GuiModel* _pGuiModel;
+    GraphDataModel* _pGraphDataModel;
+    NoteModel* _pNoteModel;
+
+};
+
+#endif // SESSIONFILEHANDLER_H
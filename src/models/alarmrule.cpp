@@ -0,0 +1,343 @@
+#include <QStringList>
+#include <QtNumeric>
+
+#include "alarmrule.h"
+
+/*!
+ * Constructor
+ * \param mode          Alarm mode
+ * \param limit         Limit (above, below and rate), lower limit (outside) or bit number (bit)
+ * \param hysteresis    Distance from limit before alarm is cleared (not used for bit)
+ * \param upperLimit    Upper limit (outside)
+ */
+AlarmRule::AlarmRule(Mode mode, double limit, double hysteresis, double upperLimit)
+{
+    _mode = mode;
+    _limit = limit;
+    _hysteresis = hysteresis;
+    _upperLimit = upperLimit;
+
+    reset();
+}
+
+AlarmRule::Mode AlarmRule::mode() const
+{
+    return _mode;
+}
+
+double AlarmRule::limit() const
+{
+    return _limit;
+}
+
+double AlarmRule::upperLimit() const
+{
+    return _upperLimit;
+}
+
+double AlarmRule::hysteresis() const
+{
+    return _hysteresis;
+}
+
+bool AlarmRule::isEnabled() const
+{
+    return _mode != ALARM_NONE;
+}
+
+bool AlarmRule::isRaised() const
+{
+    return _bRaised;
+}
+
+bool AlarmRule::operator==(const AlarmRule &other) const
+{
+    return (_mode == other._mode)
+            && (_limit == other._limit)
+            && (_upperLimit == other._upperLimit)
+            && (_hysteresis == other._hysteresis);
+}
+
+bool AlarmRule::operator!=(const AlarmRule &other) const
+{
+    return !(*this == other);
+}
+
+/*!
+ * Clear alarm and forget previous value
+ */
+void AlarmRule::reset()
+{
+    _bRaised = false;
+    _bPrevious = false;
+    _previousKey = 0;
+    _previousValue = 0;
+}
+
+/*!
+ * Check value against rule
+ * \param key       Key of sample (ms)
+ * \param value     Converted value of sample
+ * \param rawValue  Raw register value of sample (bit)
+ * \return Change of alarm state caused by this value
+ */
+AlarmRule::Transition AlarmRule::process(double key, double value, quint32 rawValue)
+{
+    /* NaN or infinite value (float register) can't be compared */
+    if ((_mode != ALARM_BIT) && !qIsFinite(value))
+    {
+        return TRANSITION_NONE;
+    }
+
+    double observed = value;
+
+    if (_mode == ALARM_RATE)
+    {
+        if (!_bPrevious)
+        {
+            _bPrevious = true;
+            _previousKey = key;
+            _previousValue = value;
+
+            return TRANSITION_NONE;
+        }
+        else if (key <= _previousKey)
+        {
+            // Same key: rate is unknown
+            return TRANSITION_NONE;
+        }
+        else
+        {
+            observed = qAbs(value - _previousValue) * 1000 / (key - _previousKey);
+
+            _previousKey = key;
+            _previousValue = value;
+        }
+    }
+
+    if (!_bRaised && isMet(observed, rawValue))
+    {
+        _bRaised = true;
+        return TRANSITION_RAISED;
+    }
+    else if (_bRaised && isCleared(observed, rawValue))
+    {
+        _bRaised = false;
+        return TRANSITION_CLEARED;
+    }
+    else
+    {
+        return TRANSITION_NONE;
+    }
+}
+
+/*!
+ * Description of rule, used in register table and project file
+ * (e.g. "none", "above 80", "below 10 hysteresis 0.5", "outside 10 80 hysteresis 1", "rate 5", "bit 3")
+ */
+QString AlarmRule::toString() const
+{
+    QString text;
+
+    switch (_mode)
+    {
+    case ALARM_ABOVE:
+        text = QString("%1 %2").arg(TriggerCondition::typeToString(TriggerCondition::ABOVE)).arg(_limit);
+        break;
+    case ALARM_BELOW:
+        text = QString("%1 %2").arg(TriggerCondition::typeToString(TriggerCondition::BELOW)).arg(_limit);
+        break;
+    case ALARM_OUTSIDE:
+        text = QString("outside %1 %2").arg(_limit).arg(_upperLimit);
+        break;
+    case ALARM_RATE:
+        text = QString("rate %1").arg(_limit);
+        break;
+    case ALARM_BIT:
+        return QString("%1 %2").arg(TriggerCondition::typeToString(TriggerCondition::BIT_SET)).arg(_limit);
+    default:
+        return QString("none");
+    }
+
+    if (_hysteresis > 0)
+    {
+        text.append(QString(" hysteresis %1").arg(_hysteresis));
+    }
+
+    return text;
+}
+
+/*!
+ * Parse description of rule (see toString)
+ * \param text      Description
+ * \param pRule     Parsed rule
+ * \return false when description isn't valid
+ */
+bool AlarmRule::fromString(const QString &text, AlarmRule * pRule)
+{
+    QStringList parts = text.trimmed().toLower().split(' ', QString::SkipEmptyParts);
+
+    if (parts.isEmpty() || ((parts.size() == 1) && (parts[0] == QString("none"))))
+    {
+        *pRule = AlarmRule();
+        return true;
+    }
+
+    Mode mode;
+    if (!stringToMode(parts.takeFirst(), &mode))
+    {
+        return false;
+    }
+
+    double hysteresis = 0;
+    if ((parts.size() >= 2) && (parts[parts.size() - 2] == QString("hysteresis")))
+    {
+        bool bOk = false;
+        hysteresis = QString(parts.last()).replace(',', '.').toDouble(&bOk);
+
+        if (!bOk || (hysteresis < 0) || (mode == ALARM_BIT))
+        {
+            return false;
+        }
+
+        parts.removeLast();
+        parts.removeLast();
+    }
+
+    /* Accept both decimal separators */
+    QList<double> limits;
+    for (qint32 idx = 0; idx < parts.size(); idx++)
+    {
+        bool bOk = false;
+        limits.append(QString(parts[idx]).replace(',', '.').toDouble(&bOk));
+
+        if (!bOk)
+        {
+            return false;
+        }
+    }
+
+    if (mode == ALARM_OUTSIDE)
+    {
+        /* Alarm must be able to clear */
+        if ((limits.size() != 2) || (limits[0] + 2 * hysteresis > limits[1]))
+        {
+            return false;
+        }
+
+        *pRule = AlarmRule(ALARM_OUTSIDE, limits[0], hysteresis, limits[1]);
+        return true;
+    }
+
+    if (limits.size() != 1)
+    {
+        return false;
+    }
+
+    const double limit = limits[0];
+
+    if (mode == ALARM_RATE)
+    {
+        if ((limit < 0) || (hysteresis > limit))
+        {
+            return false;
+        }
+    }
+    else if (mode == ALARM_BIT)
+    {
+        if ((limit < 0) || (limit > cMaxBit) || (limit != static_cast<qint32>(limit)))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // Any limit is valid
+    }
+
+    *pRule = AlarmRule(mode, limit, hysteresis);
+
+    return true;
+}
+
+/*!
+ * Convert name of mode, above, below and bit are named as the trigger conditions
+ * \param modeText  Name of mode (lower case)
+ * \param pMode     Mode
+ * \return false when name isn't a valid mode
+ */
+bool AlarmRule::stringToMode(const QString &modeText, Mode * pMode)
+{
+    TriggerCondition::Type type;
+
+    if (modeText == QString("outside"))
+    {
+        *pMode = ALARM_OUTSIDE;
+    }
+    else if (modeText == QString("rate"))
+    {
+        *pMode = ALARM_RATE;
+    }
+    else if (!TriggerCondition::stringToType(modeText, &type))
+    {
+        return false;
+    }
+    else if (type == TriggerCondition::ABOVE)
+    {
+        *pMode = ALARM_ABOVE;
+    }
+    else if (type == TriggerCondition::BELOW)
+    {
+        *pMode = ALARM_BELOW;
+    }
+    else if (type == TriggerCondition::BIT_SET)
+    {
+        *pMode = ALARM_BIT;
+    }
+    else
+    {
+        /* Edges aren't a state that can be cleared */
+        return false;
+    }
+
+    return true;
+}
+
+bool AlarmRule::isMet(double value, quint32 rawValue) const
+{
+    switch (_mode)
+    {
+    case ALARM_ABOVE:
+    case ALARM_RATE:
+        return TriggerCondition::isLevelMet(TriggerCondition::ABOVE, _limit, value);
+    case ALARM_BELOW:
+        return TriggerCondition::isLevelMet(TriggerCondition::BELOW, _limit, value);
+    case ALARM_OUTSIDE:
+        return TriggerCondition::isLevelMet(TriggerCondition::BELOW, _limit, value)
+                || TriggerCondition::isLevelMet(TriggerCondition::ABOVE, _upperLimit, value);
+    case ALARM_BIT:
+        return TriggerCondition::isBitSet(rawValue, static_cast<quint8>(_limit));
+    default:
+        return false;
+    }
+}
+
+bool AlarmRule::isCleared(double value, quint32 rawValue) const
+{
+    /* Met condition with limit moved by hysteresis */
+    switch (_mode)
+    {
+    case ALARM_ABOVE:
+    case ALARM_RATE:
+        return !TriggerCondition::isLevelMet(TriggerCondition::ABOVE, _limit - _hysteresis, value);
+    case ALARM_BELOW:
+        return !TriggerCondition::isLevelMet(TriggerCondition::BELOW, _limit + _hysteresis, value);
+    case ALARM_OUTSIDE:
+        return !TriggerCondition::isLevelMet(TriggerCondition::BELOW, _limit + _hysteresis, value)
+                && !TriggerCondition::isLevelMet(TriggerCondition::ABOVE, _upperLimit - _hysteresis, value);
+    case ALARM_BIT:
+        return !isMet(value, rawValue);
+    default:
+        return true;
+    }
+}
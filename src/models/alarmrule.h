@@ -0,0 +1,82 @@
+#ifndef ALARMRULE_H
+#define ALARMRULE_H
+
+#include <QString>
+
+#include "triggercondition.h"
+
+/*!
+ * Alarm condition on the values of a graph
+ *
+ *  - Above: raised when value exceeds limit, cleared when value drops to limit - hysteresis
+ *  - Below: raised when value drops under limit, cleared when value rises to limit + hysteresis
+ *  - Outside: raised when value leaves [limit, upper limit], cleared when value is back
+ *             inside [limit + hysteresis, upper limit - hysteresis]
+ *  - Rate: raised when absolute rate of change (per second) exceeds limit, cleared when rate drops to limit - hysteresis
+ *  - Bit: raised when bit (limit is bit number) of raw register value is set, cleared when bit is reset
+ *
+ * The rule keeps its state, so a raised alarm is only reported once until it is cleared.
+ * Every value is processed in constant time. The limits are checked with the conditions of the
+ * trigger (see TriggerCondition), which also provides the names of above, below and bit.
+ */
+class AlarmRule
+{
+public:
+
+    typedef enum
+    {
+        ALARM_NONE = 0,
+        ALARM_ABOVE,
+        ALARM_BELOW,
+        ALARM_OUTSIDE,
+        ALARM_RATE,
+        ALARM_BIT
+    } Mode;
+
+    typedef enum
+    {
+        TRANSITION_NONE = 0,
+        TRANSITION_RAISED,
+        TRANSITION_CLEARED
+    } Transition;
+
+    explicit AlarmRule(Mode mode = ALARM_NONE, double limit = 0, double hysteresis = 0, double upperLimit = 0);
+
+    Mode mode() const;
+    double limit() const;
+    double upperLimit() const;
+    double hysteresis() const;
+    bool isEnabled() const;
+    bool isRaised() const;
+
+    bool operator==(const AlarmRule &other) const;
+    bool operator!=(const AlarmRule &other) const;
+
+    void reset();
+    Transition process(double key, double value, quint32 rawValue);
+
+    QString toString() const;
+    static bool fromString(const QString &text, AlarmRule * pRule);
+    static bool stringToMode(const QString &modeText, Mode * pMode);
+
+    static const qint32 cMaxBit = TriggerCondition::cMaxBit;
+
+private:
+
+    bool isMet(double value, quint32 rawValue) const;
+    bool isCleared(double value, quint32 rawValue) const;
+
+    Mode _mode;
+    double _limit;
+    double _upperLimit;
+    double _hysteresis;
+
+    bool _bRaised;
+
+    /* Previous value (rate) */
+    bool _bPrevious;
+    double _previousKey;
+    double _previousValue;
+};
+
+#endif // ALARMRULE_H
@@ -0,0 +1,669 @@
+#include <QtMath>
+#include <QStringList>
+#include <QtNumeric>
+
+#include "settingsmodel.h"
+
+#include "channelexpression.h"
+
+/*!
+ * Recursive descent compiler of channel expressions
+ *
+ *  expression := term (('+' | '-') term)*
+ *  term       := unary (('*' | '/') unary)*
+ *  unary      := '-' unary | power
+ *  power      := primary ('^' unary)?
+ *  primary    := number | register | function '(' arguments ')' | '(' expression ')'
+ *  register   := '${' address ('@' connection)? '}'
+ */
+class ChannelExpressionParser
+{
+public:
+
+    ChannelExpressionParser(const QString &text, ChannelExpression * pExpression)
+    {
+        _text = text;
+        _pos = 0;
+        _depth = 0;
+        _maxDepth = 0;
+        _nesting = 0;
+        _pExpression = pExpression;
+    }
+
+    bool compile()
+    {
+        skipSpace();
+
+        if (_pos >= _text.size())
+        {
+            _errorString = QString("Expression is empty");
+            return false;
+        }
+
+        if (!parseExpression())
+        {
+            return false;
+        }
+
+        skipSpace();
+        if (_pos < _text.size())
+        {
+            return fail(QString("Unexpected \"%1\" at position %2").arg(_text.at(_pos)).arg(_pos + 1));
+        }
+
+        _pExpression->_stack.fill(0, _maxDepth);
+
+        return true;
+    }
+
+    QString errorString() const
+    {
+        return _errorString;
+    }
+
+private:
+
+    bool parseExpression()
+    {
+        if (!parseTerm())
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            skipSpace();
+
+            ChannelExpression::OpCode opCode;
+            if (accept('+'))
+            {
+                opCode = ChannelExpression::OP_ADD;
+            }
+            else if (accept('-'))
+            {
+                opCode = ChannelExpression::OP_SUBTRACT;
+            }
+            else
+            {
+                break;
+            }
+
+            if (!parseTerm())
+            {
+                return false;
+            }
+
+            emitInstruction(opCode, 2);
+        }
+
+        return true;
+    }
+
+    bool parseTerm()
+    {
+        if (!parseUnary())
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            skipSpace();
+
+            ChannelExpression::OpCode opCode;
+            if (accept('*'))
+            {
+                opCode = ChannelExpression::OP_MULTIPLY;
+            }
+            else if (accept('/'))
+            {
+                opCode = ChannelExpression::OP_DIVIDE;
+            }
+            else
+            {
+                break;
+            }
+
+            if (!parseUnary())
+            {
+                return false;
+            }
+
+            emitInstruction(opCode, 2);
+        }
+
+        return true;
+    }
+
+    bool parseUnary()
+    {
+        /* Every nested unary, power, parenthesis and function argument passes here */
+        if (_nesting >= _cMaxNesting)
+        {
+            return fail(QString("Expression is nested too deeply at position %1").arg(_pos + 1));
+        }
+
+        _nesting++;
+
+        skipSpace();
+
+        bool bOk;
+        if (accept('-'))
+        {
+            bOk = parseUnary();
+            if (bOk)
+            {
+                emitInstruction(ChannelExpression::OP_NEGATE, 1);
+            }
+        }
+        else
+        {
+            bOk = parsePower();
+        }
+
+        _nesting--;
+
+        return bOk;
+    }
+
+    bool parsePower()
+    {
+        if (!parsePrimary())
+        {
+            return false;
+        }
+
+        skipSpace();
+
+        /* Right associative: 2^3^2 = 2^9 */
+        if (accept('^'))
+        {
+            if (!parseUnary())
+            {
+                return false;
+            }
+
+            emitInstruction(ChannelExpression::OP_POWER, 2);
+        }
+
+        return true;
+    }
+
+    bool parsePrimary()
+    {
+        skipSpace();
+
+        if (_pos >= _text.size())
+        {
+            return fail(QString("Unexpected end of expression"));
+        }
+
+        const QChar character = _text.at(_pos);
+
+        if (accept('('))
+        {
+            if (!parseExpression())
+            {
+                return false;
+            }
+
+            skipSpace();
+            if (!accept(')'))
+            {
+                return fail(QString("Missing \")\" at position %1").arg(_pos + 1));
+            }
+
+            return true;
+        }
+        else if (character == '$')
+        {
+            return parseRegister();
+        }
+        else if (character.isDigit() || (character == '.'))
+        {
+            return parseNumber();
+        }
+        else if (character.isLetter())
+        {
+            return parseFunction();
+        }
+        else
+        {
+            return fail(QString("Unexpected \"%1\" at position %2").arg(character).arg(_pos + 1));
+        }
+    }
+
+    bool parseRegister()
+    {
+        const qint32 start = _pos;
+        const qint32 end = _text.indexOf('}', _pos);
+
+        if (!_text.midRef(_pos).startsWith("${") || (end < 0))
+        {
+            return fail(QString("Register reference at position %1 should look like ${40001} or ${40001@1}").arg(start + 1));
+        }
+
+        const QString reference = _text.mid(_pos + 2, end - _pos - 2).trimmed();
+        const QStringList parts = reference.split('@');
+
+        bool bAddress = false;
+        bool bConnection = true;
+        ChannelExpression::Operand operand;
+
+        const quint32 address = parts[0].trimmed().toUInt(&bAddress);
+        quint32 connectionId = 0;
+        if (parts.size() == 2)
+        {
+            connectionId = parts[1].trimmed().toUInt(&bConnection);
+        }
+
+        if (
+            !bAddress
+            || !bConnection
+            || (parts.size() > 2)
+            || (address > 0xFFFF)
+            || (connectionId >= SettingsModel::CONNECTION_ID_CNT)
+        )
+        {
+            return fail(QString("Register reference \"%1\" is not valid").arg(_text.mid(start, end - start + 1)));
+        }
+
+        operand.registerAddress = static_cast<quint16>(address);
+        operand.connectionId = static_cast<quint8>(connectionId);
+
+        /* Same register is only looked up once per row */
+        qint32 operandIdx = _pExpression->_operands.indexOf(operand);
+        if (operandIdx < 0)
+        {
+            operandIdx = _pExpression->_operands.size();
+            _pExpression->_operands.append(operand);
+        }
+
+        _pos = end + 1;
+
+        emitInstruction(ChannelExpression::OP_OPERAND, 0, operandIdx);
+
+        return true;
+    }
+
+    bool parseNumber()
+    {
+        const qint32 start = _pos;
+
+        while ((_pos < _text.size()) && (_text.at(_pos).isDigit() || (_text.at(_pos) == '.')))
+        {
+            _pos++;
+        }
+
+        /* Exponent */
+        if ((_pos < _text.size()) && (_text.at(_pos).toLower() == 'e'))
+        {
+            qint32 exponentPos = _pos + 1;
+            if ((exponentPos < _text.size()) && ((_text.at(exponentPos) == '+') || (_text.at(exponentPos) == '-')))
+            {
+                exponentPos++;
+            }
+
+            if ((exponentPos < _text.size()) && _text.at(exponentPos).isDigit())
+            {
+                _pos = exponentPos;
+                while ((_pos < _text.size()) && _text.at(_pos).isDigit())
+                {
+                    _pos++;
+                }
+            }
+        }
+
+        bool bOk = false;
+        const double value = _text.mid(start, _pos - start).toDouble(&bOk);
+
+        if (!bOk)
+        {
+            return fail(QString("Number \"%1\" is not valid").arg(_text.mid(start, _pos - start)));
+        }
+
+        emitInstruction(ChannelExpression::OP_CONSTANT, 0, 0, value);
+
+        return true;
+    }
+
+    bool parseFunction()
+    {
+        const qint32 start = _pos;
+
+        while ((_pos < _text.size()) && _text.at(_pos).isLetterOrNumber())
+        {
+            _pos++;
+        }
+
+        const QString name = _text.mid(start, _pos - start).toLower();
+
+        ChannelExpression::OpCode opCode;
+        qint32 argumentCount = 1;
+
+        if (name == "abs")
+        {
+            opCode = ChannelExpression::OP_ABS;
+        }
+        else if (name == "sqrt")
+        {
+            opCode = ChannelExpression::OP_SQRT;
+        }
+        else if (name == "exp")
+        {
+            opCode = ChannelExpression::OP_EXP;
+        }
+        else if (name == "log")
+        {
+            opCode = ChannelExpression::OP_LOG;
+        }
+        else if (name == "min")
+        {
+            opCode = ChannelExpression::OP_MIN;
+            argumentCount = 2;
+        }
+        else if (name == "max")
+        {
+            opCode = ChannelExpression::OP_MAX;
+            argumentCount = 2;
+        }
+        else if (name == "rate")
+        {
+            opCode = ChannelExpression::OP_RATE;
+        }
+        else
+        {
+            return fail(QString("Unknown function \"%1\"").arg(name));
+        }
+
+        skipSpace();
+        if (!accept('('))
+        {
+            return fail(QString("Missing \"(\" after function \"%1\"").arg(name));
+        }
+
+        for (qint32 argIdx = 0; argIdx < argumentCount; argIdx++)
+        {
+            if (argIdx > 0)
+            {
+                skipSpace();
+                if (!accept(','))
+                {
+                    return fail(QString("Function \"%1\" expects %2 arguments").arg(name).arg(argumentCount));
+                }
+            }
+
+            if (!parseExpression())
+            {
+                return false;
+            }
+        }
+
+        skipSpace();
+        if (!accept(')'))
+        {
+            return fail(QString("Missing \")\" after arguments of function \"%1\"").arg(name));
+        }
+
+        qint32 index = 0;
+        if (opCode == ChannelExpression::OP_RATE)
+        {
+            index = _pExpression->_rateStates.size();
+            _pExpression->_rateStates.append(ChannelExpression::RateState());
+        }
+
+        emitInstruction(opCode, argumentCount, index);
+
+        return true;
+    }
+
+    /*!
+     * Add instruction to program and keep track of required stack size
+     * \param opCode        Instruction
+     * \param popCount      Number of values that are taken from stack (one value is pushed)
+     */
+    void emitInstruction(ChannelExpression::OpCode opCode, qint32 popCount, qint32 index = 0, double constant = 0)
+    {
+        ChannelExpression::Instruction instruction;
+
+        instruction.opCode = opCode;
+        instruction.index = index;
+        instruction.constant = constant;
+
+        _pExpression->_program.append(instruction);
+
+        _depth = _depth - popCount + 1;
+        _maxDepth = qMax(_maxDepth, _depth);
+    }
+
+    void skipSpace()
+    {
+        while ((_pos < _text.size()) && _text.at(_pos).isSpace())
+        {
+            _pos++;
+        }
+    }
+
+    bool accept(char character)
+    {
+        if ((_pos < _text.size()) && (_text.at(_pos) == QLatin1Char(character)))
+        {
+            _pos++;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool fail(const QString &errorString)
+    {
+        _errorString = errorString;
+        return false;
+    }
+
+    /* Bound recursion so a crafted project file can't overflow the stack */
+    static const qint32 _cMaxNesting = 256;
+
+    QString _text;
+    qint32 _pos;
+    qint32 _depth;
+    qint32 _maxDepth;
+    qint32 _nesting;
+    QString _errorString;
+    ChannelExpression * _pExpression;
+};
+
+ChannelExpression::ChannelExpression()
+{
+
+}
+
+bool ChannelExpression::isEmpty() const
+{
+    return _program.isEmpty();
+}
+
+/*!
+ * Registers that are used in expression (every register once), in order of evaluate()
+ */
+const QList<ChannelExpression::Operand> &ChannelExpression::operands() const
+{
+    return _operands;
+}
+
+bool ChannelExpression::operator==(const ChannelExpression &other) const
+{
+    return _text == other._text;
+}
+
+bool ChannelExpression::operator!=(const ChannelExpression &other) const
+{
+    return !(*this == other);
+}
+
+/*!
+ * Forget previous rows (rate)
+ */
+void ChannelExpression::reset()
+{
+    for (qint32 idx = 0; idx < _rateStates.size(); idx++)
+    {
+        _rateStates[idx].bValid = false;
+        _rateStates[idx].key = 0;
+        _rateStates[idx].value = 0;
+        _rateStates[idx].rate = qQNaN();
+    }
+}
+
+/*!
+ * Compute value of row
+ * \param operandValues     Value of every operand (see operands())
+ * \param key               Key of row (ms), used by rate()
+ * \param pResult           Value of expression
+ * \return false when value isn't a finite number (division by zero, first row of rate(), ...)
+ */
+bool ChannelExpression::evaluate(const QVector<double> &operandValues, double key, double * pResult)
+{
+    if (_program.isEmpty())
+    {
+        return false;
+    }
+
+    double * pStack = _stack.data();
+    qint32 top = -1;
+
+    for (qint32 idx = 0; idx < _program.size(); idx++)
+    {
+        const Instruction &instruction = _program[idx];
+
+        switch (instruction.opCode)
+        {
+        case OP_CONSTANT:
+            pStack[++top] = instruction.constant;
+            break;
+
+        case OP_OPERAND:
+            pStack[++top] = operandValues[instruction.index];
+            break;
+
+        case OP_ADD:
+            top--;
+            pStack[top] += pStack[top + 1];
+            break;
+
+        case OP_SUBTRACT:
+            top--;
+            pStack[top] -= pStack[top + 1];
+            break;
+
+        case OP_MULTIPLY:
+            top--;
+            pStack[top] *= pStack[top + 1];
+            break;
+
+        case OP_DIVIDE:
+            top--;
+            pStack[top] /= pStack[top + 1];
+            break;
+
+        case OP_POWER:
+            top--;
+            pStack[top] = qPow(pStack[top], pStack[top + 1]);
+            break;
+
+        case OP_NEGATE:
+            pStack[top] = -pStack[top];
+            break;
+
+        case OP_ABS:
+            pStack[top] = qAbs(pStack[top]);
+            break;
+
+        case OP_SQRT:
+            pStack[top] = qSqrt(pStack[top]);
+            break;
+
+        case OP_EXP:
+            pStack[top] = qExp(pStack[top]);
+            break;
+
+        case OP_LOG:
+            pStack[top] = qLn(pStack[top]);
+            break;
+
+        case OP_MIN:
+            top--;
+            pStack[top] = qMin(pStack[top], pStack[top + 1]);
+            break;
+
+        case OP_MAX:
+            top--;
+            pStack[top] = qMax(pStack[top], pStack[top + 1]);
+            break;
+
+        case OP_RATE:
+        {
+            RateState &state = _rateStates[instruction.index];
+            const double value = pStack[top];
+
+            /* Rows with same key keep previous rate */
+            if (state.bValid && (key > state.key))
+            {
+                state.rate = (value - state.value) / (key - state.key) * 1000;
+            }
+
+            if (!state.bValid || (key > state.key))
+            {
+                state.bValid = true;
+                state.key = key;
+                state.value = value;
+            }
+
+            pStack[top] = state.rate;
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    *pResult = pStack[0];
+
+    return qIsFinite(*pResult);
+}
+
+QString ChannelExpression::toString() const
+{
+    return _text;
+}
+
+/*!
+ * Compile expression
+ * \param text              Expression
+ * \param pExpression       Compiled expression (only changed when text is valid)
+ * \param pErrorString      Reason why text isn't valid (optional)
+ * \return false when text isn't a valid expression
+ */
+bool ChannelExpression::fromString(const QString &text, ChannelExpression * pExpression, QString * pErrorString)
+{
+    ChannelExpression expression;
+    ChannelExpressionParser parser(text, &expression);
+
+    if (!parser.compile())
+    {
+        if (pErrorString != nullptr)
+        {
+            *pErrorString = parser.errorString();
+        }
+
+        return false;
+    }
+
+    expression._text = text.trimmed();
+    expression.reset();
+
+    *pExpression = expression;
+
+    return true;
+}
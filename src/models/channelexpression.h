@@ -0,0 +1,98 @@
+#ifndef CHANNELEXPRESSION_H
+#define CHANNELEXPRESSION_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+
+/*!
+ * Expression of a virtual channel: value is computed from the values of other registers
+ *
+ * Registers are referenced as ${40001} (connection 0) or ${40001@1} (connection 1). The expression
+ * supports + - * / ^, parentheses, numbers (decimal point is always '.') and the functions abs, sqrt,
+ * exp, log, min, max and rate. rate(x) is the change of x per second since the previous row.
+ *
+ * The expression is compiled once into a small stack program, so evaluating a row doesn't parse or allocate.
+ * Evaluation is incremental: rate() keeps the value and key of the previous row.
+ */
+class ChannelExpression
+{
+public:
+
+    /* Register that is used in the expression */
+    typedef struct _Operand
+    {
+        _Operand() : registerAddress(0), connectionId(0) {}
+
+        quint16 registerAddress;
+        quint8 connectionId;
+
+        bool operator==(const _Operand &other) const
+        {
+            return (registerAddress == other.registerAddress) && (connectionId == other.connectionId);
+        }
+    } Operand;
+
+    explicit ChannelExpression();
+
+    bool isEmpty() const;
+    const QList<Operand> &operands() const;
+
+    bool operator==(const ChannelExpression &other) const;
+    bool operator!=(const ChannelExpression &other) const;
+
+    void reset();
+    bool evaluate(const QVector<double> &operandValues, double key, double * pResult);
+
+    QString toString() const;
+    static bool fromString(const QString &text, ChannelExpression * pExpression, QString * pErrorString = nullptr);
+
+private:
+
+    typedef enum
+    {
+        OP_CONSTANT = 0,
+        OP_OPERAND,
+        OP_ADD,
+        OP_SUBTRACT,
+        OP_MULTIPLY,
+        OP_DIVIDE,
+        OP_POWER,
+        OP_NEGATE,
+        OP_ABS,
+        OP_SQRT,
+        OP_EXP,
+        OP_LOG,
+        OP_MIN,
+        OP_MAX,
+        OP_RATE
+    } OpCode;
+
+    typedef struct
+    {
+        OpCode opCode;
+        qint32 index; /* Operand (OP_OPERAND) or rate state (OP_RATE) */
+        double constant;
+    } Instruction;
+
+    /* Previous row of rate() */
+    typedef struct
+    {
+        bool bValid;
+        double key;
+        double value;
+        double rate;
+    } RateState;
+
+    friend class ChannelExpressionParser;
+
+    QString _text;
+    QList<Operand> _operands;
+    QVector<Instruction> _program;
+    QVector<RateState> _rateStates;
+
+    /* Evaluation stack, sized by compiler */
+    QVector<double> _stack;
+};
+
+#endif // CHANNELEXPRESSION_H
@@ -8,7 +8,7 @@
  */
 ErrorLogModel::ErrorLogModel(QObject *parent) : QAbstractListModel(parent)
 {
-
+    _memorySize = 0;
 }
 
 /*!
@@ -95,10 +95,19 @@ void ErrorLogModel::clear()
     beginRemoveRows(QModelIndex(), 0, size());
 
     _logList.clear();
+    _memorySize = 0;
 
     endRemoveRows();
 }
 
+/*!
+ * \brief Memory (in bytes) used by log entries (estimate)
+ */
+qint64 ErrorLogModel::memorySize() const
+{
+    return _memorySize;
+}
+
 /*!
  * \brief Add item to model
  * \param log
@@ -109,6 +118,7 @@ void ErrorLogModel::addItem(ErrorLog log)
     beginInsertRows(QModelIndex(), size(), size());
 
     _logList.append(log);
+    _memorySize += static_cast<qint64>(sizeof(ErrorLog) + sizeof(void *)) + log.message().size() * static_cast<qint64>(sizeof(QChar));
 
     /* Call functions to trigger view update */
     endInsertRows();
@@ -18,6 +18,7 @@ public:
     Qt::ItemFlags flags(const QModelIndex & index) const;
 
     qint32 size() const;
+    qint64 memorySize() const;
 
     void clear();
 
@@ -30,6 +31,7 @@ public slots:
 private:
 
     QList<ErrorLog> _logList;
+    qint64 _memorySize;
 };
 
 #endif // ERRORLOGMODEL_H
@@ -0,0 +1,147 @@
+#include <QtMath>
+
+#include "fftplan.h"
+
+/*!
+ * Constructor
+ * \param size      Number of real values (power of two, at least 4)
+ */
+FftPlan::FftPlan(qint32 size)
+{
+    _size = isValidSize(size) ? size : 0;
+
+    const qint32 halfSize = _size / 2;
+
+    _cos.resize(halfSize);
+    _sin.resize(halfSize);
+    for (qint32 idx = 0; idx < halfSize; idx++)
+    {
+        const double angle = 2 * M_PI * idx / _size;
+        _cos[idx] = qCos(angle);
+        _sin[idx] = qSin(angle);
+    }
+
+    qint32 bits = 0;
+    while ((1 << bits) < halfSize)
+    {
+        bits++;
+    }
+
+    _bitReversal.resize(halfSize);
+    for (qint32 idx = 0; idx < halfSize; idx++)
+    {
+        qint32 reversed = 0;
+        for (qint32 bit = 0; bit < bits; bit++)
+        {
+            if (idx & (1 << bit))
+            {
+                reversed |= 1 << (bits - 1 - bit);
+            }
+        }
+
+        _bitReversal[idx] = reversed;
+    }
+}
+
+qint32 FftPlan::size() const
+{
+    return _size;
+}
+
+/*!
+ * Number of bins of spectrum (N/2 + 1)
+ */
+qint32 FftPlan::binCount() const
+{
+    return _size > 0 ? _size / 2 + 1 : 0;
+}
+
+/*!
+ * Forward transform, X[k] = sum(x[n] * exp(-2 * pi * i * k * n / N))
+ * \param pInput    N real values
+ * \param pReal     Real part of bins (binCount values)
+ * \param pImag     Imaginary part of bins (binCount values)
+ */
+void FftPlan::transform(const double * pInput, double * pReal, double * pImag) const
+{
+    const qint32 halfSize = _size / 2;
+
+    if (halfSize == 0)
+    {
+        return;
+    }
+
+    /* Even samples are real part, odd samples are imaginary part, loaded in bit-reversed order */
+    for (qint32 idx = 0; idx < halfSize; idx++)
+    {
+        pReal[_bitReversal[idx]] = pInput[2 * idx];
+        pImag[_bitReversal[idx]] = pInput[2 * idx + 1];
+    }
+
+    /* Radix-2 butterflies of complex FFT of N/2 values (twiddle of length L is entry N/L of table) */
+    for (qint32 length = 2; length <= halfSize; length <<= 1)
+    {
+        const qint32 half = length / 2;
+        const qint32 step = _size / length;
+
+        for (qint32 start = 0; start < halfSize; start += length)
+        {
+            for (qint32 idx = 0; idx < half; idx++)
+            {
+                const double wr = _cos[idx * step];
+                const double wi = -_sin[idx * step];
+
+                const qint32 top = start + idx;
+                const qint32 bottom = top + half;
+
+                const double tr = wr * pReal[bottom] - wi * pImag[bottom];
+                const double ti = wr * pImag[bottom] + wi * pReal[bottom];
+
+                pReal[bottom] = pReal[top] - tr;
+                pImag[bottom] = pImag[top] - ti;
+                pReal[top] += tr;
+                pImag[top] += ti;
+            }
+        }
+    }
+
+    /* Split: X[k] = E[k] + W^k * O[k], with E and O the spectra of even and odd samples */
+    const double zr = pReal[0];
+    const double zi = pImag[0];
+
+    pReal[0] = zr + zi;
+    pImag[0] = 0;
+    pReal[halfSize] = zr - zi;
+    pImag[halfSize] = 0;
+
+    for (qint32 k = 1; k <= halfSize / 2; k++)
+    {
+        const qint32 m = halfSize - k;
+
+        const double zkr = pReal[k];
+        const double zki = pImag[k];
+        const double zmr = pReal[m];
+        const double zmi = pImag[m];
+
+        /* Bin k */
+        double er = (zkr + zmr) / 2;
+        double ei = (zki - zmi) / 2;
+        double orr = (zki + zmi) / 2;
+        double oi = (zmr - zkr) / 2;
+
+        pReal[k] = er + _cos[k] * orr + _sin[k] * oi;
+        pImag[k] = ei + _cos[k] * oi - _sin[k] * orr;
+
+        /* Bin N/2 - k: even and odd parts are mirrored */
+        ei = -ei;
+        oi = -oi;
+
+        pReal[m] = er + _cos[m] * orr + _sin[m] * oi;
+        pImag[m] = ei + _cos[m] * oi - _sin[m] * orr;
+    }
+}
+
+bool FftPlan::isValidSize(qint32 size)
+{
+    return (size >= 4) && ((size & (size - 1)) == 0);
+}
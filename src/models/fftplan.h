@@ -0,0 +1,40 @@
+#ifndef FFTPLAN_H
+#define FFTPLAN_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/*!
+ * Plan of a forward FFT of real values with a fixed size (power of two)
+ *
+ * The twiddle factors and the bit-reversal permutation are calculated once, so every transform of the
+ * same size reuses them and doesn't allocate. The N real values are transformed as N/2 complex values
+ * (even and odd samples) with an iterative radix-2 FFT, followed by a split step that results in the
+ * N/2 + 1 bins of the real spectrum.
+ */
+class FftPlan
+{
+public:
+
+    explicit FftPlan(qint32 size = 0);
+
+    qint32 size() const;
+    qint32 binCount() const;
+
+    void transform(const double * pInput, double * pReal, double * pImag) const;
+
+    static bool isValidSize(qint32 size);
+
+private:
+
+    qint32 _size;
+
+    /* Bit-reversed position of every complex value (N/2) */
+    QVector<qint32> _bitReversal;
+
+    /* cos and sin of 2 * pi * k / N for k < N/2 */
+    QVector<double> _cos;
+    QVector<double> _sin;
+};
+
+#endif // FFTPLAN_H
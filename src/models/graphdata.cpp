@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "graphdata.h"
 
 #include "util.h"
@@ -15,13 +17,14 @@ GraphData::GraphData()
     _multiplyFactor = 1;
     _shift = 0;
     _connectionId = 0;
-
-    _pDataMap = QSharedPointer<QCPGraphDataContainer>(new QCPGraphDataContainer);
+    _valueType = VALUE_16BIT;
+    _bLowWordFirst = false;
+    _bRawSeriesKept = false;
 }
 
 GraphData::~GraphData()
 {
-    _pDataMap.clear();
+    clearData();
 }
 
 bool GraphData::isVisible() const
@@ -75,6 +78,7 @@ bool GraphData::isUnsigned() const
 void GraphData::setUnsigned(bool bUnsigned)
 {
     _bUnsigned = bUnsigned;
+    clearPyramid();
 }
 
 double GraphData::multiplyFactor() const
@@ -85,6 +89,7 @@ double GraphData::multiplyFactor() const
 void GraphData::setMultiplyFactor(double multiplyFactor)
 {
     _multiplyFactor = multiplyFactor;
+    clearPyramid();
 }
 
 double GraphData::divideFactor() const
@@ -95,6 +100,7 @@ double GraphData::divideFactor() const
 void GraphData::setDivideFactor(double divideFactor)
 {
     _divideFactor = divideFactor;
+    clearPyramid();
 }
 
 quint16 GraphData::registerAddress() const
@@ -115,6 +121,7 @@ quint16 GraphData::bitmask() const
 void GraphData::setBitmask(const quint16 &bitmask)
 {
     _bitmask = bitmask;
+    clearPyramid();
 }
 
 qint32 GraphData::shift() const
@@ -125,6 +132,7 @@ qint32 GraphData::shift() const
 void GraphData::setShift(const qint32 &shift)
 {
     _shift = shift;
+    clearPyramid();
 }
 
 quint8 GraphData::connectionId() const
@@ -137,7 +145,441 @@ void GraphData::setConnectionId(const quint8 &connectionId)
     _connectionId = connectionId;
 }
 
-QSharedPointer<QCPGraphDataContainer> GraphData::dataMap()
+GraphData::ValueType GraphData::valueType() const
+{
+    return _valueType;
+}
+
+void GraphData::setValueType(ValueType valueType)
+{
+    _valueType = valueType;
+    clearPyramid();
+}
+
+bool GraphData::isRegisterPair() const
+{
+    return _valueType != VALUE_16BIT;
+}
+
+bool GraphData::isLowWordFirst() const
+{
+    return _bLowWordFirst;
+}
+
+void GraphData::setLowWordFirst(bool bLowWordFirst)
+{
+    _bLowWordFirst = bLowWordFirst;
+    clearPyramid();
+}
+
+IngestFilter GraphData::ingestFilter() const
+{
+    return _ingestFilter;
+}
+
+/*!
+ * Set filter that drops redundant samples, state of previous filter is lost
+ */
+void GraphData::setIngestFilter(const IngestFilter &ingestFilter)
+{
+    _ingestFilter = ingestFilter;
+    _ingestFilter.reset();
+}
+
+/*!
+ * Samples pass the ingest filter (virtual channels and graphs with signal filter skip it)
+ */
+bool GraphData::isIngestFiltered() const
+{
+    return _ingestFilter.isEnabled() && !isVirtual() && !_signalFilter.isEnabled();
+}
+
+/*!
+ * Pass sample through ingest filter (see IngestFilter::process)
+ * \param key           Key of sample
+ * \param bValid        False when sample is an error
+ * \param pRawValue     Raw value of sample, replaced by raw value that should be stored
+ */
+IngestFilter::Action GraphData::filterSample(double key, bool bValid, quint32 * pRawValue)
+{
+    const double value = bValid ? processValue(*pRawValue) : 0;
+
+    return _ingestFilter.process(key, value, bValid, pRawValue);
+}
+
+/*!
+ * Apply value type, signedness, bitmask, shift and factors to raw register value
+ * \param rawValue      Register value (16 bit) or packed register pair (see packRegisterPair)
+ * \return Value as shown in graph
+ */
+double GraphData::processValue(quint32 rawValue) const
+{
+    double processedValue = 0;
+
+    const quint16 firstRegister = static_cast<quint16>(rawValue & 0xFFFF);
+
+    if (isRegisterPair())
+    {
+        const quint16 secondRegister = static_cast<quint16>(rawValue >> 16);
+
+        processedValue = decodeRegisterPair(_valueType, _bUnsigned, _bLowWordFirst, firstRegister, secondRegister);
+    }
+    else
+    {
+        // Apply bitmask
+        if (_bUnsigned)
+        {
+            processedValue = firstRegister & _bitmask;
+        }
+        else
+        {
+            processedValue = static_cast<qint16>(static_cast<qint16>(firstRegister) & _bitmask);
+        }
+
+        // Apply shift
+        if (_shift != 0)
+        {
+            if (_shift > 0)
+            {
+                processedValue = static_cast<qint16>(processedValue) << _shift;
+            }
+            else
+            {
+                processedValue = static_cast<qint16>(processedValue) >> qAbs(_shift);
+            }
+
+            if (!_bUnsigned)
+            {
+                processedValue = static_cast<qint16>(processedValue);
+            }
+        }
+    }
+
+    // Apply multiplyFactor
+    processedValue *= _multiplyFactor;
+
+    // Apply divideFactor
+    processedValue /= _divideFactor;
+
+    return processedValue;
+}
+
+ChannelExpression GraphData::expression() const
+{
+    return _expression;
+}
+
+/*!
+ * Make graph a virtual channel (empty expression: graph is a register again)
+ * A virtual channel belongs to the connection of its first register, so it shares the time column of that connection.
+ */
+void GraphData::setExpression(const ChannelExpression &expression)
+{
+    _expression = expression;
+    _expression.reset();
+
+    if (!_expression.operands().isEmpty())
+    {
+        _connectionId = _expression.operands().first().connectionId;
+    }
+}
+
+bool GraphData::isVirtual() const
+{
+    return !_expression.isEmpty();
+}
+
+/*!
+ * Compute value of virtual channel for a row
+ * \param operandValues     Processed value of every register of expression (see ChannelExpression::operands)
+ * \param key               Key of row
+ * \param pValue            Value of virtual channel
+ * \return false when value isn't valid
+ */
+bool GraphData::evaluateExpression(const QVector<double> &operandValues, double key, double * pValue)
+{
+    return _expression.evaluate(operandValues, key, pValue);
+}
+
+SignalFilter GraphData::signalFilter() const
+{
+    return _signalFilter;
+}
+
+/*!
+ * Set filter that smooths values, state of previous filter is lost
+ */
+void GraphData::setSignalFilter(const SignalFilter &signalFilter)
+{
+    _signalFilter = signalFilter;
+    _signalFilter.reset();
+}
+
+/*!
+ * Pass value through signal filter (see SignalFilter::process)
+ * \param key           Key of sample
+ * \param value         Converted value of sample
+ * \param pResult       Filtered value
+ * \return false when filter has no value for this sample
+ */
+bool GraphData::filterSignal(double key, double value, double * pResult)
+{
+    return _signalFilter.process(key, value, pResult);
+}
+
+bool GraphData::isRawSeriesKept() const
+{
+    return _bRawSeriesKept;
+}
+
+/*!
+ * Keep unfiltered values alongside filtered values (only used with signal filter)
+ */
+void GraphData::setRawSeriesKept(bool bKept)
+{
+    _bRawSeriesKept = bKept;
+}
+
+AlarmRule GraphData::alarmRule() const
+{
+    return _alarmRule;
+}
+
+void GraphData::setAlarmRule(const AlarmRule &alarmRule)
+{
+    _alarmRule = alarmRule;
+    _alarmRule.reset();
+}
+
+/*!
+ * Pack register pair in a single raw value, the first register is kept in the low word.
+ * So the raw value of a pair reads as the first register when interpreted as 16 bit register.
+ */
+quint32 GraphData::packRegisterPair(quint16 firstRegister, quint16 secondRegister)
+{
+    return (static_cast<quint32>(secondRegister) << 16) | firstRegister;
+}
+
+/*!
+ * Combine register pair into a single value
+ * \param valueType         32 bit or float32 (16 bit uses first register only)
+ * \param bUnsigned         Interpret 32 bit integer as unsigned
+ * \param bLowWordFirst     First register contains the low word
+ * \param firstRegister     Value of register at address
+ * \param secondRegister    Value of register at address + 1
+ */
+double GraphData::decodeRegisterPair(ValueType valueType, bool bUnsigned, bool bLowWordFirst, quint16 firstRegister, quint16 secondRegister)
+{
+    double value;
+
+    const quint16 highWord = bLowWordFirst ? secondRegister : firstRegister;
+    const quint16 lowWord = bLowWordFirst ? firstRegister : secondRegister;
+    const quint32 rawValue = (static_cast<quint32>(highWord) << 16) | lowWord;
+
+    switch (valueType)
+    {
+    case VALUE_32BIT:
+        if (bUnsigned)
+        {
+            value = rawValue;
+        }
+        else
+        {
+            value = static_cast<qint32>(rawValue);
+        }
+        break;
+
+    case VALUE_FLOAT32:
+    {
+        float floatValue;
+        std::memcpy(&floatValue, &rawValue, sizeof(floatValue));
+        value = static_cast<double>(floatValue);
+        break;
+    }
+
+    default:
+        value = bUnsigned ? firstRegister : static_cast<qint16>(firstRegister);
+        break;
+    }
+
+    return value;
+}
+
+QString GraphData::valueTypeToString(ValueType valueType)
+{
+    switch (valueType)
+    {
+    case VALUE_16BIT:
+        return QString("16bit");
+    case VALUE_32BIT:
+        return QString("32bit");
+    case VALUE_FLOAT32:
+        return QString("float32");
+    default:
+        return QString();
+    }
+}
+
+bool GraphData::stringToValueType(QString typeString, ValueType * pValueType)
+{
+    for (qint32 idx = VALUE_16BIT; idx <= VALUE_FLOAT32; idx++)
+    {
+        if (typeString.toLower() == valueTypeToString(static_cast<ValueType>(idx)))
+        {
+            *pValueType = static_cast<ValueType>(idx);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * Get samples of graph, values are converted with the settings of this graph on read
+ */
+SampleSeries GraphData::series() const
+{
+    /* Raw values stored with other value type can't be converted (value type changed) */
+    if (
+        !_pColumn.isNull()
+        && (_pColumn->type() != SampleColumn::TYPE_DOUBLE)
+        && (_pColumn->type() != columnType())
+    )
+    {
+        return SampleSeries();
+    }
+
+    return SampleSeries(_pTimebase, _pColumn, this);
+}
+
+QSharedPointer<SampleTimebase> GraphData::sampleTimebase() const
+{
+    return _pTimebase;
+}
+
+QSharedPointer<SampleColumn> GraphData::sampleColumn() const
+{
+    return _pColumn;
+}
+
+/*!
+ * Set storage of samples
+ * \param pTimebase     Time column (shared with other graphs)
+ * \param pColumn       Value column of this graph, rows correspond with time column
+ */
+void GraphData::setSampleColumn(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn)
+{
+    _pTimebase = pTimebase;
+    _pColumn = pColumn;
+    _pPyramid = QSharedPointer<SamplePyramid>(new SamplePyramid());
+}
+
+/*!
+ * Level of detail pyramid of samples (null when graph has no samples)
+ */
+QSharedPointer<SamplePyramid> GraphData::samplePyramid() const
+{
+    return _pPyramid;
+}
+
+void GraphData::clearData()
+{
+    _pTimebase.clear();
+    _pColumn.clear();
+    _pPyramid.clear();
+
+    clearRawData();
+
+    /* Next sample is always kept */
+    _ingestFilter.reset();
+    _expression.reset();
+    _signalFilter.reset();
+}
+
+/*!
+ * Converted values have changed: pyramid is rebuilt on next update
+ */
+void GraphData::clearPyramid()
+{
+    if (!_pPyramid.isNull())
+    {
+        _pPyramid->clear();
+    }
+}
+
+/*!
+ * Get unfiltered samples of graph with signal filter (empty when they aren't kept)
+ */
+SampleSeries GraphData::rawSeries() const
+{
+    if (
+        _pRawColumn.isNull()
+        || ((_pRawColumn->type() != SampleColumn::TYPE_DOUBLE) && (_pRawColumn->type() != rawColumnType()))
+    )
+    {
+        return SampleSeries();
+    }
+
+    return SampleSeries(_pRawTimebase, _pRawColumn, this);
+}
+
+QSharedPointer<SampleTimebase> GraphData::rawTimebase() const
+{
+    return _pRawTimebase;
+}
+
+QSharedPointer<SampleColumn> GraphData::rawColumn() const
+{
+    return _pRawColumn;
+}
+
+/*!
+ * Set storage of unfiltered samples
+ * \param pTimebase     Time column of connection
+ * \param pColumn       Raw value column, rows correspond with time column
+ */
+void GraphData::setRawColumn(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn)
+{
+    _pRawTimebase = pTimebase;
+    _pRawColumn = pColumn;
+}
+
+void GraphData::clearRawData()
+{
+    _pRawTimebase.clear();
+    _pRawColumn.clear();
+}
+
+/*!
+ * Type of value column that holds the samples of this graph (filtered values are stored as double)
+ */
+SampleColumn::Type GraphData::columnType() const
+{
+    if (_signalFilter.isEnabled())
+    {
+        return SampleColumn::TYPE_DOUBLE;
+    }
+    else
+    {
+        return rawColumnType();
+    }
+}
+
+/*!
+ * Type of value column that holds the raw values of this graph
+ */
+SampleColumn::Type GraphData::rawColumnType() const
 {
-    return _pDataMap;
+    if (isVirtual())
+    {
+        return SampleColumn::TYPE_DOUBLE;
+    }
+    else if (isRegisterPair())
+    {
+        return SampleColumn::TYPE_32BIT;
+    }
+    else
+    {
+        return SampleColumn::TYPE_16BIT;
+    }
 }
@@ -4,11 +4,32 @@
 #include <QtGlobal>
 #include <QColor>
 #include "qcustomplot.h"
+#include "sampleseries.h"
+#include "samplepyramid.h"
+#include "ingestfilter.h"
+#include "channelexpression.h"
+#include "signalfilter.h"
+#include "alarmrule.h"
 
 class GraphData
 {
 
 public:
+
+    /*!
+     * Value type of register
+     *  - 16 bit: single register, signed or unsigned
+     *  - 32 bit: register pair, signed or unsigned
+     *  - float32: register pair, IEEE 754 single precision
+     * Bitmask and shift are only applied to 16 bit registers.
+     */
+    typedef enum
+    {
+        VALUE_16BIT = 0,
+        VALUE_32BIT,
+        VALUE_FLOAT32
+    } ValueType;
+
     explicit GraphData();
     ~GraphData();
 
@@ -45,7 +66,57 @@ public:
     quint8 connectionId() const;
     void setConnectionId(const quint8 &connectionId);
 
-    QSharedPointer<QCPGraphDataContainer> dataMap();
+    ValueType valueType() const;
+    void setValueType(ValueType valueType);
+    bool isRegisterPair() const;
+
+    bool isLowWordFirst() const;
+    void setLowWordFirst(bool bLowWordFirst);
+
+    IngestFilter ingestFilter() const;
+    void setIngestFilter(const IngestFilter &ingestFilter);
+    IngestFilter::Action filterSample(double key, bool bValid, quint32 * pRawValue);
+    bool isIngestFiltered() const;
+
+    double processValue(quint32 rawValue) const;
+
+    ChannelExpression expression() const;
+    void setExpression(const ChannelExpression &expression);
+    bool isVirtual() const;
+    bool evaluateExpression(const QVector<double> &operandValues, double key, double * pValue);
+
+    SignalFilter signalFilter() const;
+    void setSignalFilter(const SignalFilter &signalFilter);
+    bool filterSignal(double key, double value, double * pResult);
+
+    bool isRawSeriesKept() const;
+    void setRawSeriesKept(bool bKept);
+
+    AlarmRule alarmRule() const;
+    void setAlarmRule(const AlarmRule &alarmRule);
+
+    static quint32 packRegisterPair(quint16 firstRegister, quint16 secondRegister);
+    static double decodeRegisterPair(ValueType valueType, bool bUnsigned, bool bLowWordFirst, quint16 firstRegister, quint16 secondRegister);
+
+    static QString valueTypeToString(ValueType valueType);
+    static bool stringToValueType(QString typeString, ValueType * pValueType);
+
+    SampleSeries series() const;
+    QSharedPointer<SampleTimebase> sampleTimebase() const;
+    QSharedPointer<SampleColumn> sampleColumn() const;
+    void setSampleColumn(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn);
+    QSharedPointer<SamplePyramid> samplePyramid() const;
+    void clearData();
+    void clearPyramid();
+
+    SampleSeries rawSeries() const;
+    QSharedPointer<SampleTimebase> rawTimebase() const;
+    QSharedPointer<SampleColumn> rawColumn() const;
+    void setRawColumn(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn);
+    void clearRawData();
+
+    SampleColumn::Type columnType() const;
+    SampleColumn::Type rawColumnType() const;
 
 private:
 
@@ -61,8 +132,28 @@ private:
     quint16 _bitmask;
     qint32 _shift;
     quint8 _connectionId;
+    ValueType _valueType;
+    bool _bLowWordFirst;
+    IngestFilter _ingestFilter;
+
+    /* Virtual channel: value is computed from other registers instead of read */
+    ChannelExpression _expression;
+
+    /* Smoothing of values, optionally with unfiltered values kept alongside */
+    SignalFilter _signalFilter;
+    bool _bRawSeriesKept;
+
+    /* Condition that is monitored while logging */
+    AlarmRule _alarmRule;
+
+    /* Samples: time column is shared with other graphs of same connection (own time column with ingest filter) */
+    QSharedPointer<SampleTimebase> _pTimebase;
+    QSharedPointer<SampleColumn> _pColumn;
+    QSharedPointer<SamplePyramid> _pPyramid;
 
-    QSharedPointer<QCPGraphDataContainer> _pDataMap;
+    /* Unfiltered values of graph with signal filter, on time column of connection */
+    QSharedPointer<SampleTimebase> _pRawTimebase;
+    QSharedPointer<SampleColumn> _pRawColumn;
 
 };
 
@@ -2,6 +2,7 @@
 #include "graphdata.h"
 #include "util.h"
 #include <QDebug>
+#include <limits>
 
 #include "graphdatamodel.h"
 
@@ -10,6 +11,16 @@ GraphDataModel::GraphDataModel(SettingsModel * pSettingsModel, QObject *parent)
     _pSettingsModel = pSettingsModel;
     _graphData.clear();
 
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+    {
+        _timebases.append(QSharedPointer<SampleTimebase>(new SampleTimebase()));
+    }
+    _bSamplesDropped = false;
+    _bMemoryLimitReached = false;
+    _bRegisterIndexValid = false;
+    _memorySize = 0;
+    _bMemorySizeValid = false;
+
     connect(this, SIGNAL(visibilityChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
     connect(this, SIGNAL(labelChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
     connect(this, SIGNAL(colorChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
@@ -21,9 +32,20 @@ GraphDataModel::GraphDataModel(SettingsModel * pSettingsModel, QObject *parent)
     connect(this, SIGNAL(bitmaskChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
     connect(this, SIGNAL(shiftChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
     connect(this, SIGNAL(connectionIdChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(valueTypeChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(wordOrderChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(ingestFilterChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(expressionChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(signalFilterChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(rawSeriesKeptChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
+    connect(this, SIGNAL(alarmRuleChanged(quint32)), this, SLOT(modelDataChanged(quint32)));
 
     connect(this, SIGNAL(added(quint32)), this, SLOT(modelDataChanged()));
     connect(this, SIGNAL(removed(quint32)), this, SLOT(modelDataChanged()));
+
+    connect(_pSettingsModel, SIGNAL(retentionChanged()), this, SLOT(applyRetention()));
+    connect(_pSettingsModel, SIGNAL(spillToDiskChanged()), this, SLOT(updateSpillFile()));
+    connect(_pSettingsModel, SIGNAL(compressSamplesChanged()), this, SLOT(updateCompression()));
 }
 
 int GraphDataModel::rowCount(const QModelIndex & /*parent*/) const
@@ -44,8 +66,15 @@ int GraphDataModel::columnCount(const QModelIndex & /*parent*/) const
     * Multiply factor
     * Divide factor
     * Connection id
+    * Value type
+    * Low word first
+    * Ingest filter
+    * Expression
+    * Signal filter
+    * Keep raw
+    * Alarm
     * */
-    return 10; // Number of visible members of struct
+    return 17; // Number of visible members of struct
 }
 
 QVariant GraphDataModel::data(const QModelIndex &index, int role) const
@@ -127,6 +156,66 @@ QVariant GraphDataModel::data(const QModelIndex &index, int role) const
             return QString("Connection %1").arg(connectionId(index.row()) + 1);
         }
         break;
+    case 10:
+        if (role == Qt::DisplayRole)
+        {
+            return GraphData::valueTypeToString(valueType(index.row()));
+        }
+        else if (role == Qt::EditRole)
+        {
+            return static_cast<quint32>(valueType(index.row()));
+        }
+        break;
+    case 11:
+        if (role == Qt::CheckStateRole)
+        {
+            if (isLowWordFirst(index.row()))
+            {
+                return Qt::Checked;
+            }
+            else
+            {
+                return Qt::Unchecked;
+            }
+        }
+        break;
+    case 12:
+        if ((role == Qt::DisplayRole) || (role == Qt::EditRole))
+        {
+            return ingestFilter(index.row()).toString();
+        }
+        break;
+    case 13:
+        if ((role == Qt::DisplayRole) || (role == Qt::EditRole))
+        {
+            return expression(index.row()).toString();
+        }
+        break;
+    case 14:
+        if ((role == Qt::DisplayRole) || (role == Qt::EditRole))
+        {
+            return signalFilter(index.row()).toString();
+        }
+        break;
+    case 15:
+        if (role == Qt::CheckStateRole)
+        {
+            if (isRawSeriesKept(index.row()))
+            {
+                return Qt::Checked;
+            }
+            else
+            {
+                return Qt::Unchecked;
+            }
+        }
+        break;
+    case 16:
+        if ((role == Qt::DisplayRole) || (role == Qt::EditRole))
+        {
+            return alarmRule(index.row()).toString();
+        }
+        break;
     default:
         return QVariant();
         break;
@@ -164,6 +253,20 @@ QVariant GraphDataModel::headerData(int section, Qt::Orientation orientation, in
                 return QString("Divide");
             case 9:
                 return QString("Connection");
+            case 10:
+                return QString("Type");
+            case 11:
+                return QString("Low word first");
+            case 12:
+                return QString("Filter");
+            case 13:
+                return QString("Expression");
+            case 14:
+                return QString("Smoothing");
+            case 15:
+                return QString("Keep raw");
+            case 16:
+                return QString("Alarm");
             default:
                 return QVariant();
             }
@@ -352,6 +455,123 @@ bool GraphDataModel::setData(const QModelIndex & index, const QVariant & value,
             }
         }
         break;
+    case 10:
+        if (role == Qt::EditRole)
+        {
+            bool bSuccess = false;
+            const quint32 newValueType = value.toUInt(&bSuccess);
+
+            if (
+                    (bSuccess)
+                    && (newValueType <= GraphData::VALUE_FLOAT32)
+                )
+            {
+                setValueType(index.row(), static_cast<GraphData::ValueType>(newValueType));
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Value type is not valid"));
+                break;
+            }
+        }
+        break;
+    case 11:
+        if (role == Qt::CheckStateRole)
+        {
+            if (value == Qt::Checked)
+            {
+                setLowWordFirst(index.row(), true);
+            }
+            else
+            {
+                setLowWordFirst(index.row(), false);
+            }
+        }
+        break;
+    case 12:
+        if (role == Qt::EditRole)
+        {
+            IngestFilter newFilter;
+
+            if (IngestFilter::fromString(value.toString(), &newFilter))
+            {
+                setIngestFilter(index.row(), newFilter);
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Filter is not valid. Use \"none\", \"change\", \"deadband 0.5\", \"deadband 2%\" or \"swinging door 0.5\"."));
+                break;
+            }
+        }
+        break;
+    case 13:
+        if (role == Qt::EditRole)
+        {
+            /* Empty expression: graph is a register again */
+            ChannelExpression newExpression;
+            QString errorString;
+
+            if (value.toString().trimmed().isEmpty() || ChannelExpression::fromString(value.toString(), &newExpression, &errorString))
+            {
+                setExpression(index.row(), newExpression);
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Expression is not valid: %1. Use registers like ${40001} or ${40001@1}, for example \"${40001} * ${40002} / 1000\".").arg(errorString));
+                break;
+            }
+        }
+        break;
+    case 14:
+        if (role == Qt::EditRole)
+        {
+            SignalFilter newFilter;
+
+            if (SignalFilter::fromString(value.toString(), &newFilter))
+            {
+                setSignalFilter(index.row(), newFilter);
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Smoothing is not valid. Use \"none\", \"average 10\", \"exponential 0.2\", \"lowpass 1.5\" (time constant in s), \"median 5\" or \"decimate 10\"."));
+                break;
+            }
+        }
+        break;
+    case 15:
+        if (role == Qt::CheckStateRole)
+        {
+            if (value == Qt::Checked)
+            {
+                setRawSeriesKept(index.row(), true);
+            }
+            else
+            {
+                setRawSeriesKept(index.row(), false);
+            }
+        }
+        break;
+    case 16:
+        if (role == Qt::EditRole)
+        {
+            AlarmRule newRule;
+
+            if (AlarmRule::fromString(value.toString(), &newRule))
+            {
+                setAlarmRule(index.row(), newRule);
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Alarm is not valid. Use \"none\", \"above 80\", \"below 10\", \"outside 10 80\", \"rate 5\" (per s) or \"bit 3\". Add \"hysteresis 0.5\" to clear the alarm at a distance of the limit."));
+                break;
+            }
+        }
+        break;
     default:
         break;
 
@@ -382,6 +602,8 @@ Qt::ItemFlags GraphDataModel::flags(const QModelIndex & index) const
     if (
             (index.column() == 1)
             || (index.column() == 2)
+            || (index.column() == 11)
+            || (index.column() == 15)
         )
     {
         // checkable
@@ -403,9 +625,14 @@ Qt::ItemFlags GraphDataModel::flags(const QModelIndex & index) const
 bool GraphDataModel::removeRows (int row, int count, const QModelIndex & parent)
 {
     Q_UNUSED(parent);
-    Q_UNUSED(count);
 
-    removeFromModel(row);
+    QList<qint32> idxList;
+    for (qint32 idx = row; idx < row + count; idx++)
+    {
+        idxList.append(idx);
+    }
+
+    removeRegisters(idxList);
 
     return true;
 }
@@ -489,14 +716,116 @@ qint32 GraphDataModel::shift(quint32 index) const
     return _graphData[index].shift();
 }
 
-quint8 GraphDataModel::connectionId(quint8 index) const
+quint8 GraphDataModel::connectionId(quint32 index) const
 {
     return _graphData[index].connectionId();
 }
 
-QSharedPointer<QCPGraphDataContainer> GraphDataModel::dataMap(quint32 index)
+GraphData::ValueType GraphDataModel::valueType(quint32 index) const
+{
+    return _graphData[index].valueType();
+}
+
+bool GraphDataModel::isRegisterPair(quint32 index) const
+{
+    return _graphData[index].isRegisterPair();
+}
+
+bool GraphDataModel::isLowWordFirst(quint32 index) const
+{
+    return _graphData[index].isLowWordFirst();
+}
+
+IngestFilter GraphDataModel::ingestFilter(quint32 index) const
+{
+    return _graphData[index].ingestFilter();
+}
+
+ChannelExpression GraphDataModel::expression(quint32 index) const
+{
+    return _graphData[index].expression();
+}
+
+/*!
+ * Graph is a virtual channel: its value is computed from other registers, it isn't read
+ */
+bool GraphDataModel::isVirtual(quint32 index) const
+{
+    return _graphData[index].isVirtual();
+}
+
+SignalFilter GraphDataModel::signalFilter(quint32 index) const
+{
+    return _graphData[index].signalFilter();
+}
+
+bool GraphDataModel::isRawSeriesKept(quint32 index) const
+{
+    return _graphData[index].isRawSeriesKept();
+}
+
+AlarmRule GraphDataModel::alarmRule(quint32 index) const
+{
+    return _graphData[index].alarmRule();
+}
+
+/*!
+ * Get samples of graph
+ * The series refers to the graph, so don't keep it when the graph can be removed
+ */
+SampleSeries GraphDataModel::series(quint32 index) const
+{
+    return _graphData[index].series();
+}
+
+/*!
+ * Get keys of common timebase: keys of first active graph
+ * A graph with ingest filter only stores part of the keys, then all keys of its connection are used
+ * (series has no values).
+ */
+SampleSeries GraphDataModel::referenceSeries() const
+{
+    if (_activeGraphList.isEmpty())
+    {
+        return SampleSeries();
+    }
+
+    const GraphData &graphData = _graphData[static_cast<qint32>(_activeGraphList.first())];
+
+    if (
+        (graphData.isIngestFiltered() || graphData.signalFilter().isDecimating())
+        && (graphData.connectionId() < _timebases.size())
+    )
+    {
+        return SampleSeries(_timebases[graphData.connectionId()]);
+    }
+
+    return graphData.series();
+}
+
+/*!
+ * Get unfiltered samples of graph with signal filter (empty when they aren't kept)
+ * The series refers to the graph, so don't keep it when the graph can be removed
+ */
+SampleSeries GraphDataModel::rawSeries(quint32 index) const
+{
+    return _graphData[index].rawSeries();
+}
+
+/*!
+ * Check whether values of graph follow the conversion settings
+ * \return false when samples are loaded from data file (no raw register values)
+ */
+bool GraphDataModel::hasRawValues(quint32 index) const
+{
+    const QSharedPointer<SampleColumn> pColumn = _graphData[index].sampleColumn();
+
+    return pColumn.isNull() || (pColumn->type() != SampleColumn::TYPE_DOUBLE);
+}
+
+double GraphDataModel::processValue(quint32 index, quint32 rawValue) const
 {
-    return _graphData[index].dataMap();
+    return _graphData[index].processValue(rawValue);
 }
 
 void GraphDataModel::setVisible(quint32 index, bool bVisible)
@@ -538,7 +867,8 @@ void GraphDataModel::setActive(quint32 index, bool bActive)
         // When deactivated, clear data
         if (!bActive)
         {
-            _graphData[index].dataMap()->clear();
+            _graphData[index].clearData();
+            invalidateMemorySize();
         }
         else
         {
@@ -582,6 +912,7 @@ void GraphDataModel::setRegisterAddress(quint32 index, const quint16 &registerAd
     if (_graphData[index].registerAddress() != registerAddress)
     {
          _graphData[index].setRegisterAddress(registerAddress);
+         invalidateRegisterIndex();
          emit registerAddressChanged(index);
     }
 }
@@ -591,6 +922,7 @@ void GraphDataModel::setBitmask(quint32 index, const quint16 &bitmask)
     if (_graphData[index].bitmask() != bitmask)
     {
          _graphData[index].setBitmask(bitmask);
+         invalidateRegisterIndex();
          emit bitmaskChanged(index);
     }
 }
@@ -609,129 +941,1142 @@ void GraphDataModel::setConnectionId(quint32 index, const quint8 &connectionId)
     if (_graphData[index].connectionId() != connectionId)
     {
          _graphData[index].setConnectionId(connectionId);
+         invalidateRegisterIndex();
+
+         /* Own time column of filtered graph belongs to previous connection */
+         if (hasOwnTimebase(static_cast<qint32>(index)))
+         {
+             _graphData[index].clearData();
+             invalidateMemorySize();
+         }
+
          emit connectionIdChanged(index);
     }
 }
 
-void GraphDataModel::add(GraphData rowData)
+void GraphDataModel::setValueType(quint32 index, GraphData::ValueType valueType)
 {
-    addToModel(&rowData);
+    if (_graphData[index].valueType() != valueType)
+    {
+         _graphData[index].setValueType(valueType);
+         emit valueTypeChanged(index);
+    }
 }
 
-void GraphDataModel::add(QList<GraphData> graphDataList)
+void GraphDataModel::setLowWordFirst(quint32 index, bool bLowWordFirst)
 {
-    for (qint32 idx = 0; idx < graphDataList.size(); idx++)
+    if (_graphData[index].isLowWordFirst() != bLowWordFirst)
     {
-        add(graphDataList[idx]);
+         _graphData[index].setLowWordFirst(bLowWordFirst);
+         emit wordOrderChanged(index);
     }
 }
 
-void GraphDataModel::add()
+/*!
+ * Set filter that drops redundant samples of graph
+ * Samples of graph are removed, graph with filter has its own time column.
+ */
+void GraphDataModel::setIngestFilter(quint32 index, const IngestFilter &ingestFilter)
 {
-    GraphData data;
-
-    data.setRegisterAddress(nextFreeAddress());
-    data.setLabel(QString("Register %1").arg(data.registerAddress()));
-
-    add(data);
+    if (_graphData[index].ingestFilter() != ingestFilter)
+    {
+         _graphData[index].setIngestFilter(ingestFilter);
+         _graphData[index].clearData();
+         invalidateMemorySize();
+         emit ingestFilterChanged(index);
+    }
 }
 
-void GraphDataModel::add(QList<QString> labelList, QList<double> timeData, QList<QList<double> > data)
+/*!
+ * Set expression of virtual channel (empty expression: graph is a register again)
+ * Samples of graph are removed, virtual channel stores computed values.
+ */
+void GraphDataModel::setExpression(quint32 index, const ChannelExpression &expression)
 {
-    foreach(QString label, labelList)
+    if (_graphData[index].expression() != expression)
     {
-        add();
-        setLabel(_graphData.size() - 1, label);
+         _graphData[index].setExpression(expression);
+         _graphData[index].clearData();
+         invalidateMemorySize();
+         invalidateRegisterIndex();
+         emit expressionChanged(index);
     }
-
-    emit graphsAddData(timeData, data);
 }
 
-void GraphDataModel::removeRegister(qint32 idx)
-{   
-    if (idx < _graphData.size())
+/*!
+ * Set filter that smooths values of graph
+ * Samples of graph are removed, filtered values are stored (decimation: graph has its own time column).
+ * The ingest filter isn't applied to a graph with signal filter.
+ */
+void GraphDataModel::setSignalFilter(quint32 index, const SignalFilter &signalFilter)
+{
+    if (_graphData[index].signalFilter() != signalFilter)
     {
-        removeFromModel(idx);
+         _graphData[index].setSignalFilter(signalFilter);
+         _graphData[index].clearData();
+         invalidateMemorySize();
+         emit signalFilterChanged(index);
     }
 }
 
-void GraphDataModel::clear()
+/*!
+ * Keep unfiltered values of graph with signal filter alongside the filtered values
+ * Unfiltered values are kept from the next sample on.
+ */
+void GraphDataModel::setRawSeriesKept(quint32 index, bool bKept)
 {
-    const qint32 size = _graphData.size();
-
-    for(qint32 idx = 0; idx < size; idx++)
+    if (_graphData[index].isRawSeriesKept() != bKept)
     {
-        removeRegister(0);
+         _graphData[index].setRawSeriesKept(bKept);
+         _graphData[index].clearRawData();
+         invalidateMemorySize();
+         emit rawSeriesKeptChanged(index);
     }
 }
 
-// Get sorted list of active (unique) register addresses for a specific connection id
-void GraphDataModel::activeGraphAddresList(QList<quint16> * pRegisterList, quint8 connectionId)
+/*!
+ * Set condition that is monitored while logging (see AlarmMonitor)
+ * The rule is applied from the next start of logging on.
+ */
+void GraphDataModel::setAlarmRule(quint32 index, const AlarmRule &alarmRule)
 {
-    // Clear list
-    pRegisterList->clear();
-
-    foreach(quint32 idx, _activeGraphList)
+    if (_graphData[index].alarmRule() != alarmRule)
     {
-        if (!pRegisterList->contains(_graphData[idx].registerAddress()))
-        {
-            if (_graphData[idx].connectionId() == connectionId)
-            {
-                pRegisterList->append(_graphData[idx].registerAddress());
-            }
-        }
+         _graphData[index].setAlarmRule(alarmRule);
+         emit alarmRuleChanged(index);
     }
-
-    // sort qList
-    qSort(*pRegisterList);
 }
 
-// Get list of active graph indexes
-void GraphDataModel::activeGraphIndexList(QList<quint16> * pList)
+void GraphDataModel::add(GraphData rowData)
 {
-    // Clear list
-    pList->clear();
+    addToModel(&rowData);
+}
 
-    foreach(quint32 idx, _activeGraphList)
+/*!
+ * Add multiple graphs
+ * Graphs are added with a single model reset, so views are only rebuilt once (instead of once per graph).
+ */
+void GraphDataModel::add(QList<GraphData> graphDataList)
+{
+    if (graphDataList.size() == 1)
     {
-        pList->append(idx);
+        addToModel(&graphDataList[0]);
     }
+    else if (graphDataList.size() > 1)
+    {
+        beginResetModel();
 
-    // sort qList
-    qSort(*pList);
-}
+        _graphData.reserve(_graphData.size() + graphDataList.size());
 
-bool GraphDataModel::getDuplicate(quint16 * pRegister, quint16 * pBitmask, quint8 * pConnectionId)
-{
-    for (qint32 idx = 0; idx < (_graphData.size() - 1); idx++) // Don't need to check last entry
-    {
-        for (int checkIdx = (idx + 1); checkIdx < _graphData.size(); checkIdx++)
+        for (qint32 idx = 0; idx < graphDataList.size(); idx++)
         {
-            if (
-                (_graphData[idx].registerAddress() == _graphData[checkIdx].registerAddress())
-                && (_graphData[idx].bitmask() == _graphData[checkIdx].bitmask())
-                && (_graphData[idx].connectionId() == _graphData[checkIdx].connectionId())
-            )
-            {
-                *pRegister = _graphData[idx].registerAddress();
-                *pBitmask = _graphData[idx].bitmask();
-                *pConnectionId = _graphData[idx].connectionId();
-                return false;
-            }
+            selectColor(&graphDataList[idx]);
+            _graphData.append(graphDataList[idx]);
         }
-    }
 
-    return true;
+        updateActiveGraphList();
+        invalidateRegisterIndex();
+        invalidateMemorySize();
+
+        endResetModel();
+    }
+    else
+    {
+        /* Nothing to add */
+    }
 }
 
-bool GraphDataModel::isPresent(quint16 addr, quint16 bitmask)
+void GraphDataModel::add()
+{
+    GraphData data;
+
+    data.setRegisterAddress(nextFreeAddress());
+    data.setLabel(QString("Register %1").arg(data.registerAddress()));
+
+    add(data);
+}
+
+void GraphDataModel::add(QList<QString> labelList, QList<double> timeData, QList<QList<double> > data)
+{
+    const qint32 firstIdx = _graphData.size();
+
+    QList<GraphData> graphDataList;
+    quint16 address = nextFreeAddress();
+
+    foreach(QString label, labelList)
+    {
+        GraphData graphData;
+
+        graphData.setRegisterAddress(address);
+        graphData.setLabel(label);
+        graphDataList.append(graphData);
+
+        address++;
+    }
+
+    add(graphDataList);
+
+    /* All graphs of data file share the time column of the first connection */
+    clearSamples();
+
+    const QSharedPointer<SampleTimebase> pTimebase = _timebases[0];
+    for (qint32 rowIdx = 0; rowIdx < timeData.size(); rowIdx++)
+    {
+        pTimebase->append(timeData[rowIdx]);
+    }
+
+    /* First list of data contains the time data */
+    for (qint32 idx = firstIdx; idx < _graphData.size(); idx++)
+    {
+        const qint32 dataIdx = idx - firstIdx + 1;
+        QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_DOUBLE));
+
+        if (dataIdx < data.size())
+        {
+            for (qint32 rowIdx = 0; rowIdx < data[dataIdx].size(); rowIdx++)
+            {
+                /* Empty field in data file */
+                if (qIsNaN(data[dataIdx][rowIdx]))
+                {
+                    pColumn->appendMissing(1);
+                }
+                else
+                {
+                    pColumn->appendDouble(data[dataIdx][rowIdx], true);
+                }
+            }
+        }
+
+        pColumn->appendMissing(pTimebase->size() - pColumn->size());
+        pColumn->setSpillFile(_pSpillFile);
+        pColumn->setCompressed(_pSettingsModel->compressSamples());
+
+        _graphData[idx].setSampleColumn(pTimebase, pColumn);
+
+        /* Build level of detail pyramid once for all loaded samples */
+        _graphData[idx].samplePyramid()->update(_graphData[idx].series());
+    }
+
+    emit graphsAddData(timeData, data);
+}
+
+/*!
+ * Replace graphs and samples with graphs of session snapshot
+ * \param graphDataList    Graphs with their (restored) samples
+ * \param timebaseList     Time column of every connection
+ */
+void GraphDataModel::restore(QList<GraphData> graphDataList, QList<QSharedPointer<SampleTimebase> > timebaseList)
+{
+    clear();
+    clearSamples();
+
+    for (qint32 i = 0; (i < _timebases.size()) && (i < timebaseList.size()); i++)
+    {
+        _timebases[i] = timebaseList[i];
+    }
+
+    /* Build level of detail pyramid once for all restored samples */
+    for (qint32 idx = 0; idx < graphDataList.size(); idx++)
+    {
+        if (!graphDataList[idx].samplePyramid().isNull())
+        {
+            graphDataList[idx].samplePyramid()->update(graphDataList[idx].series());
+        }
+    }
+
+    add(graphDataList);
+
+    /* New samples follow current settings */
+    updateSpillFile();
+    updateCompression();
+
+    emit graphsAddData(QList<double>(), QList<QList<double> >());
+}
+
+/*!
+ * Definitions and samples of all graphs (samples are shared, not copied)
+ */
+QList<GraphData> GraphDataModel::graphDataList() const
+{
+    return _graphData;
+}
+
+/*!
+ * Time column shared by the graphs of a connection (graphs without ingest filter)
+ */
+QSharedPointer<SampleTimebase> GraphDataModel::connectionTimebase(quint8 connectionId) const
+{
+    return _timebases[connectionId];
+}
+
+void GraphDataModel::removeRegister(qint32 idx)
+{   
+    if (idx < _graphData.size())
+    {
+        removeFromModel(idx);
+    }
+}
+
+/*!
+ * Remove multiple graphs
+ * Graphs are removed with a single model reset, so views are only rebuilt once (instead of once per graph).
+ * \param idxList     Indexes of graphs to remove (in any order)
+ */
+void GraphDataModel::removeRegisters(QList<qint32> idxList)
+{
+    if (idxList.size() == 1)
+    {
+        removeRegister(idxList[0]);
+    }
+    else if (idxList.size() > 1)
+    {
+        QVector<bool> removeList(_graphData.size(), false);
+
+        for (qint32 listIdx = 0; listIdx < idxList.size(); listIdx++)
+        {
+            if ((idxList[listIdx] >= 0) && (idxList[listIdx] < _graphData.size()))
+            {
+                removeList[idxList[listIdx]] = true;
+            }
+        }
+
+        beginResetModel();
+
+        QList<GraphData> keptGraphData;
+        keptGraphData.reserve(_graphData.size());
+
+        for (qint32 idx = 0; idx < _graphData.size(); idx++)
+        {
+            if (!removeList[idx])
+            {
+                keptGraphData.append(_graphData[idx]);
+            }
+        }
+
+        _graphData = keptGraphData;
+
+        updateActiveGraphList();
+        invalidateRegisterIndex();
+        invalidateMemorySize();
+
+        endResetModel();
+    }
+    else
+    {
+        /* Nothing to remove */
+    }
+}
+
+void GraphDataModel::clear()
+{
+    if (!_graphData.isEmpty())
+    {
+        beginResetModel();
+
+        _graphData.clear();
+
+        updateActiveGraphList();
+        invalidateRegisterIndex();
+        invalidateMemorySize();
+
+        endResetModel();
+    }
+}
+
+/*!
+ * Compute virtual channels of a sample row, after the values of the registers are processed
+ * Lists correspond with active graph list. A virtual channel is invalid when one of its registers isn't
+ * active or couldn't be read. It gets the timestamp of its most recent register.
+ * \param pSuccessList      Success of every active graph
+ * \param pValueList        Processed value of every active graph
+ * \param pTimestampList    Timestamp of every active graph
+ */
+void GraphDataModel::evaluateVirtualChannels(QList<bool> * pSuccessList, QList<double> * pValueList, QList<qint64> * pTimestampList)
+{
+    updateRegisterIndex();
+
+    const qint32 count = qMin(qMin(pSuccessList->size(), pValueList->size()), qMin(pTimestampList->size(), _activeGraphList.size()));
+
+    for (qint32 activeIdx = 0; activeIdx < count; activeIdx++)
+    {
+        GraphData &graphData = _graphData[static_cast<qint32>(_activeGraphList[activeIdx])];
+
+        if (!graphData.isVirtual())
+        {
+            continue;
+        }
+
+        const QList<ChannelExpression::Operand> &operands = graphData.expression().operands();
+
+        bool bValid = true;
+        qint64 timestamp = (*pTimestampList)[activeIdx];
+
+        _operandValues.resize(operands.size());
+
+        for (qint32 operandIdx = 0; operandIdx < operands.size(); operandIdx++)
+        {
+            const qint32 graphIdx = _operandGraphIndex.value(operandKey(operands[operandIdx].connectionId, operands[operandIdx].registerAddress), -1);
+            const qint32 operandActiveIdx = graphIdx >= 0 ? _activeIndexOfGraph[graphIdx] : -1;
+
+            if ((operandActiveIdx < 0) || (operandActiveIdx >= count) || !(*pSuccessList)[operandActiveIdx])
+            {
+                bValid = false;
+                break;
+            }
+
+            _operandValues[operandIdx] = (*pValueList)[operandActiveIdx];
+
+            if ((operandIdx == 0) || ((*pTimestampList)[operandActiveIdx] > timestamp))
+            {
+                timestamp = (*pTimestampList)[operandActiveIdx];
+            }
+        }
+
+        double value = 0;
+        if (bValid)
+        {
+            bValid = graphData.evaluateExpression(_operandValues, static_cast<double>(timestamp), &value);
+        }
+
+        (*pSuccessList)[activeIdx] = bValid;
+        (*pValueList)[activeIdx] = bValid ? value : 0;
+        (*pTimestampList)[activeIdx] = timestamp;
+    }
+}
+
+/*!
+ * Add a sample row: a sample for every active graph
+ * Graphs of the same connection share the key of the first graph of that connection.
+ * \param keyList       Key (x-coordinate) of every active graph
+ * \param successList   Success of every active graph
+ * \param rawValueList  Raw register value of every active graph, packed for register pairs
+ * \param valueList     Processed value of every active graph, only used for virtual channels (no raw value)
+ */
+void GraphDataModel::addSamples(QList<double> keyList, QList<bool> successList, QList<quint32> rawValueList, QList<double> valueList)
+{
+    QList<bool> keyAddedList;
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+    {
+        keyAddedList.append(false);
+    }
+
+    const qint32 count = qMin(qMin(keyList.size(), successList.size()), qMin(rawValueList.size(), _activeGraphList.size()));
+
+    for (qint32 activeIdx = 0; activeIdx < count; activeIdx++)
+    {
+        const quint32 graphIdx = _activeGraphList[activeIdx];
+        GraphData &graphData = _graphData[static_cast<qint32>(graphIdx)];
+        const quint8 connectionId = graphData.connectionId() < SettingsModel::CONNECTION_ID_CNT ? graphData.connectionId() : 0u;
+        const QSharedPointer<SampleTimebase> pTimebase = _timebases[connectionId];
+
+        if (!keyAddedList[connectionId])
+        {
+            const qint64 previousTimebaseSize = pTimebase->memorySize();
+
+            pTimebase->append(keyList[activeIdx]);
+            keyAddedList[connectionId] = true;
+
+            _memorySize += pTimebase->memorySize() - previousTimebaseSize;
+        }
+
+        /* Memory only changes when chunks are appended or sealed */
+        const qint64 previousSize = memorySize(graphIdx);
+
+        if (graphData.signalFilter().isEnabled())
+        {
+            const bool bValid = successList[activeIdx] && (!graphData.isVirtual() || (activeIdx < valueList.size()));
+            const double value = graphData.isVirtual() ? (bValid ? valueList[activeIdx] : 0) : graphData.processValue(rawValueList[activeIdx]);
+
+            addSmoothedSample(&graphData, pTimebase, keyList[activeIdx], bValid, rawValueList[activeIdx], value);
+        }
+        else if (graphData.isIngestFiltered())
+        {
+            addFilteredSample(&graphData, keyList[activeIdx], successList[activeIdx], rawValueList[activeIdx]);
+        }
+        else
+        {
+            /* New column when graph has no samples yet or when connection or value type has changed */
+            QSharedPointer<SampleColumn> pColumn = graphData.sampleColumn();
+            if (
+                pColumn.isNull()
+                || (graphData.sampleTimebase() != pTimebase)
+                || (pColumn->type() != graphData.columnType())
+            )
+            {
+                pColumn = QSharedPointer<SampleColumn>(new SampleColumn(graphData.columnType()));
+                pColumn->setSpillFile(_pSpillFile);
+                pColumn->setCompressed(_pSettingsModel->compressSamples());
+                graphData.setSampleColumn(pTimebase, pColumn);
+            }
+
+            /* Rows before graph was added are missing (not stored) */
+            pColumn->appendMissing(pTimebase->size() - 1 - pColumn->size());
+
+            if (graphData.isVirtual())
+            {
+                const bool bValid = successList[activeIdx] && (activeIdx < valueList.size());
+                pColumn->appendDouble(bValid ? valueList[activeIdx] : 0, bValid);
+            }
+            else
+            {
+                pColumn->append(successList[activeIdx] ? rawValueList[activeIdx] : 0, successList[activeIdx]);
+            }
+
+            graphData.samplePyramid()->update(graphData.series());
+        }
+
+        _memorySize += memorySize(graphIdx) - previousSize;
+    }
+
+    applyRetention();
+}
+
+/*!
+ * Add sample of graph with ingest filter, graph has its own time column with only the samples that are kept
+ */
+void GraphDataModel::addFilteredSample(GraphData * pGraphData, double key, bool bValid, quint32 rawValue)
+{
+    QSharedPointer<SampleColumn> pColumn = pGraphData->sampleColumn();
+    QSharedPointer<SampleTimebase> pTimebase = pGraphData->sampleTimebase();
+
+    if (
+        pColumn.isNull()
+        || (pColumn->type() != pGraphData->columnType())
+        || _timebases.contains(pTimebase)
+    )
+    {
+        pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+        pTimebase->setSpillFile(_pSpillFile);
+        pTimebase->setCompressed(_pSettingsModel->compressSamples());
+
+        pColumn = QSharedPointer<SampleColumn>(new SampleColumn(pGraphData->columnType()));
+        pColumn->setSpillFile(_pSpillFile);
+        pColumn->setCompressed(_pSettingsModel->compressSamples());
+
+        pGraphData->setSampleColumn(pTimebase, pColumn);
+        pGraphData->setIngestFilter(pGraphData->ingestFilter());
+    }
+
+    quint32 storedValue = bValid ? rawValue : 0;
+
+    if (pGraphData->filterSample(key, bValid, &storedValue) == IngestFilter::ACTION_REPLACE_LAST)
+    {
+        pTimebase->replaceLast(key);
+        pColumn->replaceLast(storedValue, bValid);
+    }
+    else
+    {
+        pTimebase->append(key);
+        pColumn->append(storedValue, bValid);
+    }
+
+    pGraphData->samplePyramid()->update(pGraphData->series());
+}
+
+/*!
+ * Add sample of graph with signal filter
+ * Filtered values are stored as double, on the time column of the connection or on its own time column
+ * when the filter decimates. Unfiltered values are kept on the time column of the connection.
+ * \param pTimebase     Time column of connection, key of sample is already added
+ * \param value         Converted value of sample
+ */
+void GraphDataModel::addSmoothedSample(GraphData * pGraphData, QSharedPointer<SampleTimebase> pTimebase, double key, bool bValid, quint32 rawValue, double value)
+{
+    if (pGraphData->isRawSeriesKept())
+    {
+        QSharedPointer<SampleColumn> pRawColumn = pGraphData->rawColumn();
+        if (
+            pRawColumn.isNull()
+            || (pGraphData->rawTimebase() != pTimebase)
+            || (pRawColumn->type() != pGraphData->rawColumnType())
+        )
+        {
+            pRawColumn = QSharedPointer<SampleColumn>(new SampleColumn(pGraphData->rawColumnType()));
+            pRawColumn->setSpillFile(_pSpillFile);
+            pRawColumn->setCompressed(_pSettingsModel->compressSamples());
+            pGraphData->setRawColumn(pTimebase, pRawColumn);
+        }
+
+        pRawColumn->appendMissing(pTimebase->size() - 1 - pRawColumn->size());
+
+        if (pRawColumn->type() == SampleColumn::TYPE_DOUBLE)
+        {
+            pRawColumn->appendDouble(bValid ? value : 0, bValid);
+        }
+        else
+        {
+            pRawColumn->append(bValid ? rawValue : 0, bValid);
+        }
+    }
+
+    /* Errors aren't filtered, but are stored to show them */
+    double filteredValue = 0;
+    if (bValid && !pGraphData->filterSignal(key, value, &filteredValue))
+    {
+        return;
+    }
+
+    QSharedPointer<SampleColumn> pColumn = pGraphData->sampleColumn();
+
+    if (pGraphData->signalFilter().isDecimating())
+    {
+        if (
+            pColumn.isNull()
+            || (pColumn->type() != pGraphData->columnType())
+            || _timebases.contains(pGraphData->sampleTimebase())
+        )
+        {
+            QSharedPointer<SampleTimebase> pOwnTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+            pOwnTimebase->setSpillFile(_pSpillFile);
+            pOwnTimebase->setCompressed(_pSettingsModel->compressSamples());
+
+            pColumn = QSharedPointer<SampleColumn>(new SampleColumn(pGraphData->columnType()));
+            pColumn->setSpillFile(_pSpillFile);
+            pColumn->setCompressed(_pSettingsModel->compressSamples());
+
+            pGraphData->setSampleColumn(pOwnTimebase, pColumn);
+        }
+
+        pGraphData->sampleTimebase()->append(key);
+    }
+    else
+    {
+        if (
+            pColumn.isNull()
+            || (pGraphData->sampleTimebase() != pTimebase)
+            || (pColumn->type() != pGraphData->columnType())
+        )
+        {
+            pColumn = QSharedPointer<SampleColumn>(new SampleColumn(pGraphData->columnType()));
+            pColumn->setSpillFile(_pSpillFile);
+            pColumn->setCompressed(_pSettingsModel->compressSamples());
+            pGraphData->setSampleColumn(pTimebase, pColumn);
+        }
+
+        pColumn->appendMissing(pTimebase->size() - 1 - pColumn->size());
+    }
+
+    pColumn->appendDouble(filteredValue, bValid);
+
+    pGraphData->samplePyramid()->update(pGraphData->series());
+}
+
+/*!
+ * Clear values of graph, keys are kept (other graphs can share them)
+ */
+void GraphDataModel::clearValues(quint32 index)
+{
+    const QSharedPointer<SampleColumn> pColumn = _graphData[index].sampleColumn();
+
+    /* Unfiltered values are kept again from next sample */
+    _graphData[index].clearRawData();
+
+    if (hasOwnTimebase(static_cast<qint32>(index)))
+    {
+        /* Keys aren't shared */
+        _graphData[index].clearData();
+    }
+    else if (!pColumn.isNull())
+    {
+        const qint32 count = pColumn->size();
+
+        pColumn->clear();
+        pColumn->appendMissing(count);
+
+        _graphData[index].clearPyramid();
+    }
+
+    invalidateMemorySize();
+}
+
+/*!
+ * Remove samples of all graphs
+ */
+void GraphDataModel::clearSamples()
+{
+    for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        _graphData[idx].clearData();
+    }
+
+    /* Disk space of previous samples is released together with their columns */
+    if (!_pSpillFile.isNull())
+    {
+        createSpillFile();
+    }
+
+    /* Start with new time columns: series that are still referenced keep their data */
+    for (qint32 i = 0; i < _timebases.size(); i++)
+    {
+        _timebases[i] = QSharedPointer<SampleTimebase>(new SampleTimebase());
+        _timebases[i]->setSpillFile(_pSpillFile);
+        _timebases[i]->setCompressed(_pSettingsModel->compressSamples());
+    }
+
+    _bSamplesDropped = false;
+    _bMemoryLimitReached = false;
+    invalidateMemorySize();
+}
+
+/*!
+ * Return true when oldest samples were removed because of retention limits
+ * (since last clear)
+ */
+bool GraphDataModel::samplesDropped() const
+{
+    return _bSamplesDropped;
+}
+
+/*!
+ * Remove oldest samples when sample store exceeds one of the retention limits
+ * Samples are removed per chunk, so the limits are exceeded by at most one chunk
+ * and removing samples doesn't depend on the number of samples in the store.
+ */
+void GraphDataModel::applyRetention()
+{
+    if (!_pSettingsModel->retentionEnabled())
+    {
+        return;
+    }
+
+    const qint32 maxSamples = static_cast<qint32>(qMin(_pSettingsModel->retentionSamples(), static_cast<quint32>(std::numeric_limits<qint32>::max())));
+    const double maxDuration = static_cast<double>(_pSettingsModel->retentionDuration()) * 1000;
+
+    for (qint32 timebaseIdx = 0; timebaseIdx < _timebases.size(); timebaseIdx++)
+    {
+        const QSharedPointer<SampleTimebase> pTimebase = _timebases[timebaseIdx];
+
+        while (pTimebase->chunkCount() > 1)
+        {
+            /* Samples that are left after removing oldest chunk */
+            const qint32 remainingCount = pTimebase->size() - SampleTimebase::cChunkSize;
+            const double remainingDuration = pTimebase->key(pTimebase->size() - 1) - pTimebase->key(SampleTimebase::cChunkSize);
+
+            if (
+                ((maxSamples != 0) && (remainingCount >= maxSamples))
+                || ((maxDuration > 0) && (remainingDuration >= maxDuration))
+            )
+            {
+                removeFirstChunk(timebaseIdx);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    if (_pSettingsModel->retentionMemory() != 0)
+    {
+        const qint64 maxMemory = static_cast<qint64>(_pSettingsModel->retentionMemory()) * 1024 * 1024;
+
+        /* Running total, only recalculated after graphs or sample storage have changed */
+        if (!_bMemorySizeValid)
+        {
+            _memorySize = totalMemorySize();
+            _bMemorySizeValid = true;
+        }
+
+        if (_pSettingsModel->stopAtMemoryLimit())
+        {
+            /* Samples are kept, log is stopped (once) */
+            if ((_memorySize > maxMemory) && !_bMemoryLimitReached)
+            {
+                _bMemoryLimitReached = true;
+                emit memoryLimitReached();
+            }
+            return;
+        }
+
+        while (_memorySize > maxMemory)
+        {
+            /* Remove oldest chunk of all connections */
+            qint32 oldestIdx = -1;
+            for (qint32 timebaseIdx = 0; timebaseIdx < _timebases.size(); timebaseIdx++)
+            {
+                if (
+                    (_timebases[timebaseIdx]->chunkCount() > 1)
+                    && ((oldestIdx < 0) || (_timebases[timebaseIdx]->key(0) < _timebases[oldestIdx]->key(0)))
+                )
+                {
+                    oldestIdx = timebaseIdx;
+                }
+            }
+
+            if (oldestIdx < 0)
+            {
+                // Nothing left to remove
+                break;
+            }
+
+            removeFirstChunk(oldestIdx);
+        }
+    }
+}
+
+/*!
+ * Start or stop moving sealed chunks of samples to the session directory
+ */
+void GraphDataModel::updateSpillFile()
+{
+    if (_pSettingsModel->spillToDisk())
+    {
+        if (_pSpillFile.isNull())
+        {
+            createSpillFile();
+        }
+    }
+    else
+    {
+        /* Chunks that are already on disk stay there, new chunks are kept in memory */
+        _pSpillFile.clear();
+    }
+
+    for (qint32 i = 0; i < _timebases.size(); i++)
+    {
+        _timebases[i]->setSpillFile(_pSpillFile);
+    }
+
+    for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        const QSharedPointer<SampleColumn> pColumn = _graphData[idx].sampleColumn();
+        if (!pColumn.isNull())
+        {
+            pColumn->setSpillFile(_pSpillFile);
+        }
+
+        const QSharedPointer<SampleColumn> pRawColumn = _graphData[idx].rawColumn();
+        if (!pRawColumn.isNull())
+        {
+            pRawColumn->setSpillFile(_pSpillFile);
+        }
+
+        if (hasOwnTimebase(idx))
+        {
+            _graphData[idx].sampleTimebase()->setSpillFile(_pSpillFile);
+        }
+    }
+
+    invalidateMemorySize();
+}
+
+/*!
+ * Start or stop compressing sealed chunks of samples
+ */
+void GraphDataModel::updateCompression()
+{
+    const bool bCompress = _pSettingsModel->compressSamples();
+
+    for (qint32 i = 0; i < _timebases.size(); i++)
+    {
+        _timebases[i]->setCompressed(bCompress);
+    }
+
+    for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        const QSharedPointer<SampleColumn> pColumn = _graphData[idx].sampleColumn();
+        if (!pColumn.isNull())
+        {
+            pColumn->setCompressed(bCompress);
+        }
+
+        const QSharedPointer<SampleColumn> pRawColumn = _graphData[idx].rawColumn();
+        if (!pRawColumn.isNull())
+        {
+            pRawColumn->setCompressed(bCompress);
+        }
+
+        if (hasOwnTimebase(idx))
+        {
+            _graphData[idx].sampleTimebase()->setCompressed(bCompress);
+        }
+    }
+
+    invalidateMemorySize();
+}
+
+void GraphDataModel::createSpillFile()
+{
+    if (_pSessionDir.isNull())
+    {
+        _pSessionDir.reset(new QTemporaryDir(QDir(QDir::tempPath()).filePath("ModbusScope-XXXXXX")));
+    }
+
+    _pSpillFile.clear();
+
+    if (_pSessionDir->isValid())
+    {
+        _pSpillFile = QSharedPointer<SampleSpillFile>(new SampleSpillFile(_pSessionDir->path()));
+
+        if (!_pSpillFile->isOpen())
+        {
+            _pSpillFile.clear();
+        }
+    }
+
+    if (_pSpillFile.isNull())
+    {
+        qWarning() << "Can't create file to move samples to disk, samples are kept in memory";
+    }
+}
+
+/*!
+ * Remove oldest chunk of time column and the value columns of all graphs on it
+ */
+void GraphDataModel::removeFirstChunk(qint32 timebaseIdx)
+{
+    const QSharedPointer<SampleTimebase> pTimebase = _timebases[timebaseIdx];
+    const qint64 previousSize = sampleMemorySize(timebaseIdx);
+
+    for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        const QSharedPointer<SampleColumn> pColumn = _graphData[idx].sampleColumn();
+        if (!pColumn.isNull() && (_graphData[idx].sampleTimebase() == pTimebase))
+        {
+            pColumn->removeFirstChunk();
+            _graphData[idx].samplePyramid()->removeFirstChunk();
+        }
+
+        const QSharedPointer<SampleColumn> pRawColumn = _graphData[idx].rawColumn();
+        if (!pRawColumn.isNull() && (_graphData[idx].rawTimebase() == pTimebase))
+        {
+            pRawColumn->removeFirstChunk();
+        }
+    }
+
+    pTimebase->removeFirstChunk();
+
+    /* Filtered graphs of connection: remove chunks before first key that is kept,
+     * last sample before that key is kept because it holds the value at that key */
+    for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        if (hasOwnTimebase(idx) && (_graphData[idx].connectionId() == timebaseIdx))
+        {
+            const QSharedPointer<SampleTimebase> pFilterTimebase = _graphData[idx].sampleTimebase();
+
+            while (
+                (pFilterTimebase->chunkCount() > 1)
+                && (pFilterTimebase->key(SampleTimebase::cChunkSize) <= pTimebase->key(0))
+            )
+            {
+                _graphData[idx].sampleColumn()->removeFirstChunk();
+                _graphData[idx].samplePyramid()->removeFirstChunk();
+                pFilterTimebase->removeFirstChunk();
+            }
+        }
+    }
+
+    _memorySize -= previousSize - sampleMemorySize(timebaseIdx);
+    _bSamplesDropped = true;
+}
+
+/*!
+ * Memory (in bytes) used by samples of a graph: value column, level of detail pyramid,
+ * own time column (graph with ingest filter or decimation) and unfiltered values (signal filter).
+ * Time column of connection isn't included.
+ */
+qint64 GraphDataModel::memorySize(quint32 index) const
+{
+    const GraphData &graphData = _graphData[static_cast<qint32>(index)];
+    qint64 size = 0;
+
+    if (!graphData.sampleColumn().isNull())
+    {
+        size += graphData.sampleColumn()->memorySize() + graphData.samplePyramid()->memorySize();
+    }
+
+    if (hasOwnTimebase(static_cast<qint32>(index)))
+    {
+        size += graphData.sampleTimebase()->memorySize();
+    }
+
+    if (!graphData.rawColumn().isNull())
+    {
+        size += graphData.rawColumn()->memorySize();
+    }
+
+    return size;
+}
+
+/*!
+ * Memory (in bytes) used by samples of all connections, this is the size that is limited by the retention memory
+ */
+qint64 GraphDataModel::totalMemorySize() const
+{
+    qint64 size = 0;
+
+    for (qint32 timebaseIdx = 0; timebaseIdx < _timebases.size(); timebaseIdx++)
+    {
+        size += sampleMemorySize(timebaseIdx);
+    }
+
+    return size;
+}
+
+/*!
+ * Memory (in bytes) used by time column and the samples of all graphs on it
+ */
+qint64 GraphDataModel::sampleMemorySize(qint32 timebaseIdx) const
 {
+    const QSharedPointer<SampleTimebase> pTimebase = _timebases[timebaseIdx];
+    qint64 size = pTimebase->memorySize();
+
     for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        const QSharedPointer<SampleColumn> pColumn = _graphData[idx].sampleColumn();
+        if (
+            (!pColumn.isNull() && (_graphData[idx].sampleTimebase() == pTimebase))
+            || (hasOwnTimebase(idx) && (_graphData[idx].connectionId() == timebaseIdx))
+            || (!_graphData[idx].rawColumn().isNull() && (_graphData[idx].rawTimebase() == pTimebase))
+        )
+        {
+            size += memorySize(static_cast<quint32>(idx));
+        }
+        else
+        {
+            // Graph of other connection
+        }
+    }
+
+    return size;
+}
+
+/*!
+ * Graph has time column of its own (graph with ingest filter or decimating signal filter)
+ */
+bool GraphDataModel::hasOwnTimebase(qint32 graphIdx) const
+{
+    const QSharedPointer<SampleTimebase> pTimebase = _graphData[graphIdx].sampleTimebase();
+
+    return !pTimebase.isNull() && !_timebases.contains(pTimebase);
+}
+
+// Get sorted list of active (unique) register addresses for a specific connection id
+void GraphDataModel::activeGraphAddresList(QList<quint16> * pRegisterList, quint8 connectionId)
+{
+    // Clear list
+    pRegisterList->clear();
+
+    foreach(quint32 idx, _activeGraphList)
+    {
+        /* Virtual channels aren't read */
+        if ((_graphData[idx].connectionId() == connectionId) && !_graphData[idx].isVirtual())
+        {
+            if (!pRegisterList->contains(_graphData[idx].registerAddress()))
+            {
+                pRegisterList->append(_graphData[idx].registerAddress());
+            }
+
+            // Register pair also needs second register
+            const quint16 secondAddress = _graphData[idx].registerAddress() + 1;
+            if (
+                _graphData[idx].isRegisterPair()
+                && !pRegisterList->contains(secondAddress)
+            )
+            {
+                pRegisterList->append(secondAddress);
+            }
+        }
+    }
+
+    // sort qList
+    qSort(*pRegisterList);
+}
+
+// Get sorted list of start addresses of active register pairs (32 bit values) for a specific connection id
+void GraphDataModel::activeGraphPairList(QList<quint16> * pPairStartList, quint8 connectionId)
+{
+    // Clear list
+    pPairStartList->clear();
+
+    foreach(quint32 idx, _activeGraphList)
     {
         if (
-            (_graphData[idx].registerAddress() == addr)
-            && (_graphData[idx].bitmask() == bitmask)
+            (_graphData[idx].connectionId() == connectionId)
+            && _graphData[idx].isRegisterPair()
+            && !_graphData[idx].isVirtual()
+            && !pPairStartList->contains(_graphData[idx].registerAddress())
         )
+        {
+            pPairStartList->append(_graphData[idx].registerAddress());
+        }
+    }
+
+    // sort qList
+    qSort(*pPairStartList);
+}
+
+// Get list of active graph indexes
+void GraphDataModel::activeGraphIndexList(QList<quint16> * pList)
+{
+    // Clear list
+    pList->clear();
+
+    foreach(quint32 idx, _activeGraphList)
+    {
+        pList->append(idx);
+    }
+
+    // sort qList
+    qSort(*pList);
+}
+
+bool GraphDataModel::getDuplicate(quint16 * pRegister, quint16 * pBitmask, quint8 * pConnectionId)
+{
+    updateRegisterIndex();
+
+    /* First graph (in order of model) that shares its register with another graph */
+    for (qint32 idx = 0; idx < _graphData.size(); idx++)
+    {
+        const quint64 key = registerKey(_graphData[idx].connectionId(), _graphData[idx].registerAddress(), _graphData[idx].bitmask());
+
+        if (!_graphData[idx].isVirtual() && (_registerCount.value(key) > 1))
+        {
+            *pRegister = _graphData[idx].registerAddress();
+            *pBitmask = _graphData[idx].bitmask();
+            *pConnectionId = _graphData[idx].connectionId();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Signedness of a 16 bit register, as defined by the graph that provides it
+ * \param connectionId     Connection of register
+ * \param address          Register address
+ * \return true when register is unsigned or isn't part of a 16 bit graph (default of a register)
+ */
+bool GraphDataModel::isRegisterUnsigned(quint8 connectionId, quint16 address) const
+{
+    updateRegisterIndex();
+
+    const qint32 graphIdx = _operandGraphIndex.value(operandKey(connectionId, address), -1);
+
+    if (graphIdx < 0)
+    {
+        return true;
+    }
+    else if (_graphData[graphIdx].valueType() == GraphData::VALUE_16BIT)
+    {
+        return _graphData[graphIdx].isUnsigned();
+    }
+    else
+    {
+        /* Signedness of register pair doesn't apply to a single register */
+        return true;
+    }
+}
+
+bool GraphDataModel::isPresent(quint16 addr, quint16 bitmask)
+{
+    updateRegisterIndex();
+
+    /* Register of any connection */
+    for (quint8 connectionId = 0u; connectionId < SettingsModel::CONNECTION_ID_CNT; connectionId++)
+    {
+        if (_registerCount.contains(registerKey(connectionId, addr, bitmask)))
         {
             return true;
         }
@@ -742,16 +2087,12 @@ bool GraphDataModel::isPresent(quint16 addr, quint16 bitmask)
 
 qint32 GraphDataModel::convertToActiveGraphIndex(quint32 graphIdx)
 {
-    qint16 result = -1;
-    for (qint32 activeIdx = 0; activeIdx < _activeGraphList.size(); activeIdx++)
+    if (graphIdx < static_cast<quint32>(_activeIndexOfGraph.size()))
     {
-        if (_activeGraphList[activeIdx] == graphIdx)
-        {
-            result = activeIdx;
-            break;
-        }
+        return _activeIndexOfGraph[static_cast<qint32>(graphIdx)];
     }
-    return result;
+
+    return -1;
 }
 
 qint32 GraphDataModel::convertToGraphIndex(quint32 activeIdx)
@@ -782,16 +2123,87 @@ void GraphDataModel::updateActiveGraphList(void)
 {
     // Clear list
     _activeGraphList.clear();
+    _activeIndexOfGraph.fill(-1, _graphData.size());
 
     for (qint32 idx = 0; idx < _graphData.size(); idx++)
     {
         if (_graphData[idx].isActive())
         {
+            _activeIndexOfGraph[idx] = _activeGraphList.size();
             _activeGraphList.append(idx);
         }
     }
 }
 
+void GraphDataModel::invalidateRegisterIndex()
+{
+    _bRegisterIndexValid = false;
+}
+
+/*!
+ * Recalculate memory size on next retention check, after graphs or sample storage have changed
+ * (samples that are added or removed by retention update the running total)
+ */
+void GraphDataModel::invalidateMemorySize()
+{
+    _bMemorySizeValid = false;
+}
+
+/*!
+ * Rebuild number of graphs per register, when a register has changed since last lookup
+ */
+void GraphDataModel::updateRegisterIndex() const
+{
+    if (!_bRegisterIndexValid)
+    {
+        _registerCount.clear();
+        _registerCount.reserve(_graphData.size());
+        _operandGraphIndex.clear();
+
+        for (qint32 idx = 0; idx < _graphData.size(); idx++)
+        {
+            /* Virtual channels have no register */
+            if (_graphData[idx].isVirtual())
+            {
+                continue;
+            }
+
+            _registerCount[registerKey(_graphData[idx].connectionId(), _graphData[idx].registerAddress(), _graphData[idx].bitmask())]++;
+
+            /* Register is provided by first graph, graph with complete register is preferred over masked graph */
+            const quint32 key = operandKey(_graphData[idx].connectionId(), _graphData[idx].registerAddress());
+            if (
+                !_operandGraphIndex.contains(key)
+                || ((_graphData[idx].bitmask() == 0xFFFF) && (_graphData[_operandGraphIndex[key]].bitmask() != 0xFFFF))
+            )
+            {
+                _operandGraphIndex[key] = idx;
+            }
+        }
+
+        _bRegisterIndexValid = true;
+    }
+}
+
+quint64 GraphDataModel::registerKey(quint8 connectionId, quint16 address, quint16 bitmask)
+{
+    return (static_cast<quint64>(connectionId) << 32) | (static_cast<quint64>(address) << 16) | bitmask;
+}
+
+quint32 GraphDataModel::operandKey(quint8 connectionId, quint16 address)
+{
+    return (static_cast<quint32>(connectionId) << 16) | address;
+}
+
+void GraphDataModel::selectColor(GraphData * pGraphData)
+{
+    if (!pGraphData->color().isValid())
+    {
+        quint32 colorIndex = _graphData.size() % Util::cColorlist.size();
+        pGraphData->setColor(Util::cColorlist[colorIndex]);
+    }
+}
+
 void GraphDataModel::modelDataChanged(qint32 idx)
 {
     // Notify view(s) of changes
@@ -814,15 +2226,13 @@ void GraphDataModel::addToModel(GraphData * pGraphData)
     beginInsertRows(QModelIndex(), size(), size());
 
     /* Select color */
-    if (!pGraphData->color().isValid())
-    {
-        quint32 colorIndex = _graphData.size() % Util::cColorlist.size();
-        pGraphData->setColor(Util::cColorlist[colorIndex]);
-    }
+    selectColor(pGraphData);
 
     _graphData.append(*pGraphData);
 
     updateActiveGraphList();
+    invalidateRegisterIndex();
+    invalidateMemorySize();
 
     /* Call function to trigger view update */
     endInsertRows();
@@ -837,6 +2247,8 @@ void GraphDataModel::removeFromModel(qint32 row)
     _graphData.removeAt(row);
 
     updateActiveGraphList();
+    invalidateRegisterIndex();
+    invalidateMemorySize();
 
     endRemoveRows();
 
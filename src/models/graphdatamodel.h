@@ -4,9 +4,14 @@
 #include <QObject>
 #include <QAbstractTableModel>
 #include <QList>
+#include <QHash>
+#include <QVector>
+#include <QScopedPointer>
+#include <QTemporaryDir>
 
 #include "settingsmodel.h"
 #include "graphdata.h"
+#include "samplespillfile.h"
 
 
 class GraphDataModel : public QAbstractTableModel
@@ -41,8 +46,21 @@ public:
     quint16 registerAddress(quint32 index) const;
     quint16 bitmask(quint32 index) const;
     qint32 shift(quint32 index) const;
-    quint8 connectionId(quint8 index) const;
-    QSharedPointer<QCPGraphDataContainer> dataMap(quint32 index);
+    quint8 connectionId(quint32 index) const;
+    GraphData::ValueType valueType(quint32 index) const;
+    bool isRegisterPair(quint32 index) const;
+    bool isLowWordFirst(quint32 index) const;
+    IngestFilter ingestFilter(quint32 index) const;
+    ChannelExpression expression(quint32 index) const;
+    bool isVirtual(quint32 index) const;
+    SignalFilter signalFilter(quint32 index) const;
+    bool isRawSeriesKept(quint32 index) const;
+    AlarmRule alarmRule(quint32 index) const;
+    SampleSeries series(quint32 index) const;
+    SampleSeries referenceSeries() const;
+    SampleSeries rawSeries(quint32 index) const;
+    bool hasRawValues(quint32 index) const;
+    double processValue(quint32 index, quint32 rawValue) const;
 
     void setVisible(quint32 index, bool bVisible);
     void setLabel(quint32 index, const QString &label);
@@ -55,20 +73,43 @@ public:
     void setBitmask(quint32 index, const quint16 &bitmask);
     void setShift(quint32 index, const qint32 &shift);
     void setConnectionId(quint32 index, const quint8 &connectionId);
+    void setValueType(quint32 index, GraphData::ValueType valueType);
+    void setLowWordFirst(quint32 index, bool bLowWordFirst);
+    void setIngestFilter(quint32 index, const IngestFilter &ingestFilter);
+    void setExpression(quint32 index, const ChannelExpression &expression);
+    void setSignalFilter(quint32 index, const SignalFilter &signalFilter);
+    void setRawSeriesKept(quint32 index, bool bKept);
+    void setAlarmRule(quint32 index, const AlarmRule &alarmRule);
 
     void add(GraphData rowData);
     void add(QList<GraphData> graphDataList);
     void add();
     void add(QList<QString> labelList, QList<double> timeData, QList<QList<double> > data);
+    void restore(QList<GraphData> graphDataList, QList<QSharedPointer<SampleTimebase> > timebaseList);
+
+    QList<GraphData> graphDataList() const;
+    QSharedPointer<SampleTimebase> connectionTimebase(quint8 connectionId) const;
 
     void removeRegister(qint32 idx);
+    void removeRegisters(QList<qint32> idxList);
     void clear();
 
+    void evaluateVirtualChannels(QList<bool> * pSuccessList, QList<double> * pValueList, QList<qint64> * pTimestampList);
+    void addSamples(QList<double> keyList, QList<bool> successList, QList<quint32> rawValueList, QList<double> valueList = QList<double>());
+    void clearValues(quint32 index);
+    void clearSamples();
+    bool samplesDropped() const;
+
+    qint64 memorySize(quint32 index) const;
+    qint64 totalMemorySize() const;
+
     void activeGraphAddresList(QList<quint16> * pRegisterList, quint8 connectionId);
+    void activeGraphPairList(QList<quint16> * pPairStartList, quint8 connectionId);
     void activeGraphIndexList(QList<quint16> * pList);
 
     bool getDuplicate(quint16 * pRegister, quint16 * pBitmask, quint8 * pConnectionId);
     virtual bool isPresent(quint16 addr, quint16 bitmask);
+    bool isRegisterUnsigned(quint8 connectionId, quint16 address) const;
 
     qint32 convertToActiveGraphIndex(quint32 graphIdx);
     qint32 convertToGraphIndex(quint32 activeIdx);
@@ -86,12 +127,24 @@ signals:
     void bitmaskChanged(const quint32 graphIdx);
     void shiftChanged(const quint32 graphIdx);
     void connectionIdChanged(const quint32 graphIdx);
+    void valueTypeChanged(const quint32 graphIdx);
+    void wordOrderChanged(const quint32 graphIdx);
+    void ingestFilterChanged(const quint32 graphIdx);
+    void expressionChanged(const quint32 graphIdx);
+    void signalFilterChanged(const quint32 graphIdx);
+    void rawSeriesKeptChanged(const quint32 graphIdx);
+    void alarmRuleChanged(const quint32 graphIdx);
     void graphsAddData(QList<double>, QList<QList<double> > data);
+    void memoryLimitReached();
 
     void added(const quint32 idx); // When graph definition is added
     void removed(const quint32 idx); // When graph definition is removed
+    /* Bulk add/remove of graph definitions emits modelReset() instead of added/removed per graph */
 
 public slots:
+    void applyRetention();
+    void updateSpillFile();
+    void updateCompression();
 
 private slots:
 
@@ -102,12 +155,54 @@ private slots:
 private:
     quint16 nextFreeAddress();
     void updateActiveGraphList(void);
+    void invalidateRegisterIndex();
+    void updateRegisterIndex() const;
+    void invalidateMemorySize();
+    static quint64 registerKey(quint8 connectionId, quint16 address, quint16 bitmask);
+    static quint32 operandKey(quint8 connectionId, quint16 address);
+    void selectColor(GraphData * pGraphData);
     void addToModel(GraphData * pGraphData);
     void removeFromModel(qint32 row);
+    void addFilteredSample(GraphData * pGraphData, double key, bool bValid, quint32 rawValue);
+    void addSmoothedSample(GraphData * pGraphData, QSharedPointer<SampleTimebase> pTimebase, double key, bool bValid, quint32 rawValue, double value);
+    void removeFirstChunk(qint32 timebaseIdx);
+    bool hasOwnTimebase(qint32 graphIdx) const;
+    qint64 sampleMemorySize(qint32 timebaseIdx) const;
+    void createSpillFile();
+
+    /* Session directory for samples that are moved to disk (declared first: removed last) */
+    QScopedPointer<QTemporaryDir> _pSessionDir;
+    QSharedPointer<SampleSpillFile> _pSpillFile;
 
     QList<GraphData> _graphData;
     QList<quint32> _activeGraphList;
 
+    /* Active index of every graph (-1 when graph isn't active) */
+    QVector<qint32> _activeIndexOfGraph;
+
+    /* Number of graphs per (connection, address, bitmask), rebuilt on first lookup after a change */
+    mutable QHash<quint64, qint32> _registerCount;
+    mutable bool _bRegisterIndexValid;
+
+    /* Graph that provides register (connection, address) to virtual channels, rebuilt with register index */
+    mutable QHash<quint32, qint32> _operandGraphIndex;
+
+    /* Operand values of virtual channel that is evaluated (kept to avoid allocation per row) */
+    QVector<double> _operandValues;
+
+    /* Time column per connection */
+    QList<QSharedPointer<SampleTimebase> > _timebases;
+
+    /* Oldest samples were removed by retention limits */
+    bool _bSamplesDropped;
+
+    /* Retention memory is exceeded while log is stopped at limit */
+    bool _bMemoryLimitReached;
+
+    /* Memory used by samples (see totalMemorySize), kept up to date while samples are added and removed */
+    qint64 _memorySize;
+    bool _bMemorySizeValid;
+
     SettingsModel * _pSettingsModel;
 };
 
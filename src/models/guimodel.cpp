@@ -40,6 +40,7 @@ GuiModel::GuiModel(QObject *parent) : QObject(parent)
     _projectFilePath = "";
     _dataFilePath = "";
     _bHighlightSamples = true;
+    _bLinearInterpolation = false;
     _bCursorValues = false;
     _guiState = INIT;
     _windowTitle = _cWindowTitle;
@@ -82,6 +83,7 @@ void GuiModel::triggerUpdate(void)
 {
     emit frontGraphChanged();
     emit highlightSamplesChanged();
+    emit linearInterpolationChanged();
     emit cursorValuesChanged();
     emit windowTitleChanged();
     emit communicationStatsChanged();
@@ -132,6 +134,25 @@ void GuiModel::setHighlightSamples(bool bHighlightSamples)
     }
 }
 
+/*!
+ * Alignment of samples of different connections to common timebase
+ * \retval true    Linear interpolation
+ * \retval false   Zero-order hold (last sample)
+ */
+bool GuiModel::linearInterpolation() const
+{
+    return _bLinearInterpolation;
+}
+
+void GuiModel::setLinearInterpolation(bool bLinearInterpolation)
+{
+    if (_bLinearInterpolation != bLinearInterpolation)
+    {
+        _bLinearInterpolation = bLinearInterpolation;
+        emit linearInterpolationChanged();
+    }
+}
+
 bool GuiModel::cursorValues() const
 {
     return _bCursorValues;
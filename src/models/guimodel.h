@@ -37,6 +37,7 @@ public:
 
     qint32 frontGraph() const;
     bool highlightSamples() const;
+    bool linearInterpolation() const;
     bool cursorValues() const;
     QString windowTitle();
     QString projectFilePath();
@@ -67,6 +68,7 @@ public:
 public slots:
     void setCursorValues(bool bCursorValues);
     void setHighlightSamples(bool bHighlightSamples);
+    void setLinearInterpolation(bool bLinearInterpolation);
     void setFrontGraph(const qint32 &frontGraph);
 
     void setWindowTitleDetail(QString detail);
@@ -87,6 +89,7 @@ signals:
 
     void frontGraphChanged();
     void highlightSamplesChanged();
+    void linearInterpolationChanged();
     void cursorValuesChanged();
     void windowTitleChanged();
     void xAxisScalingChanged();
@@ -136,6 +139,7 @@ private:
     QString _lastDir; // Last directory opened for import/export/load project
 
     bool _bHighlightSamples;
+    bool _bLinearInterpolation;
     bool _bCursorValues;
     quint32 _guiState;
 
@@ -0,0 +1,291 @@
+#include <limits>
+#include <QtMath>
+
+#include "ingestfilter.h"
+
+/*!
+ * Constructor
+ * \param mode          Filter mode
+ * \param threshold     Deadband (absolute value or percentage) or maximum error of swinging door
+ */
+IngestFilter::IngestFilter(Mode mode, double threshold)
+{
+    _mode = mode;
+    _threshold = threshold;
+
+    reset();
+}
+
+IngestFilter::Mode IngestFilter::mode() const
+{
+    return _mode;
+}
+
+double IngestFilter::threshold() const
+{
+    return _threshold;
+}
+
+bool IngestFilter::isEnabled() const
+{
+    return _mode != FILTER_NONE;
+}
+
+/*!
+ * Kept samples should be connected with linear segments (instead of holding last sample)
+ */
+bool IngestFilter::isLinear() const
+{
+    return _mode == FILTER_SWINGING_DOOR;
+}
+
+bool IngestFilter::operator==(const IngestFilter &other) const
+{
+    return (_mode == other._mode) && (_threshold == other._threshold);
+}
+
+bool IngestFilter::operator!=(const IngestFilter &other) const
+{
+    return !(*this == other);
+}
+
+/*!
+ * Forget previous samples, next sample is always kept
+ */
+void IngestFilter::reset()
+{
+    _bKept = false;
+    _keptKey = 0;
+    _keptValue = 0;
+    _bKeptValid = false;
+    _keptRawValue = 0;
+
+    _bProvisional = false;
+
+    _pendingKey = 0;
+    _pendingValue = 0;
+    _pendingRawValue = 0;
+    _upperSlope = std::numeric_limits<double>::infinity();
+    _lowerSlope = -std::numeric_limits<double>::infinity();
+}
+
+/*!
+ * Decide how sample is stored
+ * \param key           Key of sample
+ * \param value         Converted value of sample
+ * \param bValid        False when sample is an error
+ * \param pRawValue     Raw value of sample, replaced by raw value that should be stored
+ * \return whether sample is added as new row or replaces the provisional last row
+ */
+IngestFilter::Action IngestFilter::process(double key, double value, bool bValid, quint32 * pRawValue)
+{
+    if (_mode == FILTER_NONE)
+    {
+        return ACTION_APPEND;
+    }
+
+    if (!_bKept || (bValid != _bKeptValid))
+    {
+        return keep(key, value, bValid, *pRawValue);
+    }
+
+    if (!bValid)
+    {
+        /* Error continues */
+        *pRawValue = _keptRawValue;
+        return replaceProvisional();
+    }
+
+    if (_mode == FILTER_SWINGING_DOOR)
+    {
+        const double keyDiff = key - _keptKey;
+
+        if (keyDiff > 0)
+        {
+            const double slope = (value - _keptValue) / keyDiff;
+
+            if (_bProvisional && ((slope > _upperSlope) || (slope < _lowerSlope)))
+            {
+                /* Line to sample leaves door: previous sample (provisional row) is kept and door opens from there */
+                _keptKey = _pendingKey;
+                _keptValue = _pendingValue;
+                _keptRawValue = _pendingRawValue;
+
+                openDoor(key, value);
+
+                _pendingKey = key;
+                _pendingValue = value;
+                _pendingRawValue = *pRawValue;
+
+                return ACTION_APPEND;
+            }
+
+            /* Line from kept sample should stay within threshold of this sample as well */
+            _upperSlope = qMin(_upperSlope, (value + _threshold - _keptValue) / keyDiff);
+            _lowerSlope = qMax(_lowerSlope, (value - _threshold - _keptValue) / keyDiff);
+        }
+
+        _pendingKey = key;
+        _pendingValue = value;
+        _pendingRawValue = *pRawValue;
+
+        return replaceProvisional();
+    }
+    else
+    {
+        if (exceedsDeadband(value))
+        {
+            return keep(key, value, bValid, *pRawValue);
+        }
+
+        /* Hold last kept value */
+        *pRawValue = _keptRawValue;
+        return replaceProvisional();
+    }
+}
+
+/*!
+ * Description of filter, used in register table and project file
+ * (e.g. "none", "change", "deadband 0.5", "deadband 2%", "swinging door 0.1")
+ */
+QString IngestFilter::toString() const
+{
+    switch (_mode)
+    {
+    case FILTER_EXACT_CHANGE:
+        return QString("change");
+    case FILTER_DEADBAND:
+        return QString("deadband %1").arg(_threshold);
+    case FILTER_DEADBAND_RELATIVE:
+        return QString("deadband %1%").arg(_threshold);
+    case FILTER_SWINGING_DOOR:
+        return QString("swinging door %1").arg(_threshold);
+    default:
+        return QString("none");
+    }
+}
+
+/*!
+ * Parse description of filter (see toString)
+ * \param text      Description
+ * \param pFilter   Parsed filter
+ * \return false when description isn't valid
+ */
+bool IngestFilter::fromString(const QString &text, IngestFilter * pFilter)
+{
+    const QString filterText = text.trimmed().toLower();
+    const QString cDeadband = QString("deadband");
+    const QString cSwingingDoor = QString("swinging door");
+
+    Mode mode;
+    QString thresholdText;
+
+    if (filterText.isEmpty() || (filterText == QString("none")))
+    {
+        *pFilter = IngestFilter();
+        return true;
+    }
+    else if (filterText == QString("change"))
+    {
+        *pFilter = IngestFilter(FILTER_EXACT_CHANGE);
+        return true;
+    }
+    else if (filterText.startsWith(cDeadband))
+    {
+        thresholdText = filterText.mid(cDeadband.size()).trimmed();
+
+        if (thresholdText.endsWith('%'))
+        {
+            mode = FILTER_DEADBAND_RELATIVE;
+            thresholdText.chop(1);
+        }
+        else
+        {
+            mode = FILTER_DEADBAND;
+        }
+    }
+    else if (filterText.startsWith(cSwingingDoor))
+    {
+        thresholdText = filterText.mid(cSwingingDoor.size()).trimmed();
+        mode = FILTER_SWINGING_DOOR;
+    }
+    else
+    {
+        return false;
+    }
+
+    /* Accept both decimal separators */
+    bool bOk = false;
+    const double threshold = thresholdText.trimmed().replace(',', '.').toDouble(&bOk);
+
+    if (!bOk || (threshold < 0))
+    {
+        return false;
+    }
+
+    *pFilter = IngestFilter(mode, threshold);
+
+    return true;
+}
+
+IngestFilter::Action IngestFilter::keep(double key, double value, bool bValid, quint32 rawValue)
+{
+    _bKept = true;
+    _keptKey = key;
+    _keptValue = value;
+    _bKeptValid = bValid;
+    _keptRawValue = rawValue;
+
+    _bProvisional = false;
+
+    _upperSlope = std::numeric_limits<double>::infinity();
+    _lowerSlope = -std::numeric_limits<double>::infinity();
+
+    return ACTION_APPEND;
+}
+
+IngestFilter::Action IngestFilter::replaceProvisional()
+{
+    const Action action = _bProvisional ? ACTION_REPLACE_LAST : ACTION_APPEND;
+
+    _bProvisional = true;
+
+    return action;
+}
+
+bool IngestFilter::exceedsDeadband(double value) const
+{
+    const double diff = qFabs(value - _keptValue);
+
+    if (_mode == FILTER_DEADBAND)
+    {
+        return diff > _threshold;
+    }
+    else if (_mode == FILTER_DEADBAND_RELATIVE)
+    {
+        return diff > qFabs(_keptValue) * _threshold / 100;
+    }
+    else
+    {
+        return diff > 0;
+    }
+}
+
+/*!
+ * Start door at kept sample through sample
+ */
+void IngestFilter::openDoor(double key, double value)
+{
+    const double keyDiff = key - _keptKey;
+
+    if (keyDiff > 0)
+    {
+        _upperSlope = (value + _threshold - _keptValue) / keyDiff;
+        _lowerSlope = (value - _threshold - _keptValue) / keyDiff;
+    }
+    else
+    {
+        _upperSlope = std::numeric_limits<double>::infinity();
+        _lowerSlope = -std::numeric_limits<double>::infinity();
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef INGESTFILTER_H
+#define INGESTFILTER_H
+
+#include <QString>
+
+/*!
+ * Filter that drops redundant samples of a graph before they are stored
+ *
+ *  - Exact change: sample is kept when value differs from the last kept value
+ *  - Deadband: sample is kept when value differs more than threshold (absolute, or percentage of last kept value)
+ *  - Swinging door: samples are kept so that the line between kept samples stays within threshold of every sample.
+ *    The door holds the range of slopes (from the last kept sample) that stay within threshold of the samples since.
+ *
+ * The last row of a filtered graph is provisional: it always has the key of the most recent sample and is
+ * replaced by the next sample when that sample doesn't need to be kept. For the deadband filters, the provisional
+ * row holds the last kept value, so the row before a change forms the step. For swinging door, the provisional
+ * row holds the most recent value and becomes a kept sample when the line to the next sample leaves the door.
+ * A change in validity (communication error) is always kept.
+ */
+class IngestFilter
+{
+public:
+
+    typedef enum
+    {
+        FILTER_NONE = 0,
+        FILTER_EXACT_CHANGE,
+        FILTER_DEADBAND,
+        FILTER_DEADBAND_RELATIVE,
+        FILTER_SWINGING_DOOR
+    } Mode;
+
+    typedef enum
+    {
+        ACTION_APPEND = 0,  /* Add new row */
+        ACTION_REPLACE_LAST /* Replace provisional last row */
+    } Action;
+
+    explicit IngestFilter(Mode mode = FILTER_NONE, double threshold = 0);
+
+    Mode mode() const;
+    double threshold() const;
+    bool isEnabled() const;
+    bool isLinear() const;
+
+    bool operator==(const IngestFilter &other) const;
+    bool operator!=(const IngestFilter &other) const;
+
+    void reset();
+    Action process(double key, double value, bool bValid, quint32 * pRawValue);
+
+    QString toString() const;
+    static bool fromString(const QString &text, IngestFilter * pFilter);
+
+private:
+
+    Action keep(double key, double value, bool bValid, quint32 rawValue);
+    Action replaceProvisional();
+    bool exceedsDeadband(double value) const;
+    void openDoor(double key, double value);
+
+    Mode _mode;
+    double _threshold;
+
+    /* Last kept sample */
+    bool _bKept;
+    double _keptKey;
+    double _keptValue;
+    bool _bKeptValid;
+    quint32 _keptRawValue;
+
+    /* Last row is provisional */
+    bool _bProvisional;
+
+    /* Swinging door: most recent sample (provisional row) and slopes of door */
+    double _pendingKey;
+    double _pendingValue;
+    quint32 _pendingRawValue;
+    double _upperSlope;
+    double _lowerSlope;
+};
+
+#endif // INGESTFILTER_H
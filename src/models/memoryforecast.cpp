@@ -0,0 +1,84 @@
+
+#include "memoryforecast.h"
+
+MemoryForecast::MemoryForecast()
+{
+
+}
+
+void MemoryForecast::clear()
+{
+    _timestamps.clear();
+    _sizes.clear();
+}
+
+/*!
+ * Add measurement of memory used by samples
+ * \param timestamp     Time of measurement (ms)
+ * \param size          Memory used (bytes)
+ */
+void MemoryForecast::addMeasurement(qint64 timestamp, qint64 size)
+{
+    _timestamps.append(timestamp);
+    _sizes.append(size);
+
+    /* Keep one measurement older than window, so rate covers complete window */
+    while ((_timestamps.size() > 2) && (timestamp - _timestamps[1] >= _cWindow))
+    {
+        _timestamps.removeFirst();
+        _sizes.removeFirst();
+    }
+}
+
+/*!
+ * Last measured memory (bytes)
+ */
+qint64 MemoryForecast::size() const
+{
+    return _sizes.isEmpty() ? 0 : _sizes.last();
+}
+
+bool MemoryForecast::hasGrowthRate() const
+{
+    return (_timestamps.size() >= 2) && (_timestamps.last() - _timestamps.first() >= _cMinimumSpan);
+}
+
+/*!
+ * Growth of memory over the last window (bytes per second)
+ * Negative when retention has removed samples.
+ */
+double MemoryForecast::growthRate() const
+{
+    if (hasGrowthRate())
+    {
+        const double timeSpan = static_cast<double>(_timestamps.last() - _timestamps.first()) / 1000;
+        return static_cast<double>(_sizes.last() - _sizes.first()) / timeSpan;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/*!
+ * Time until memory reaches limit at current growth rate
+ * \param limit     Memory budget (bytes)
+ * \return Time (ms), 0 when limit is already reached, -1 when memory isn't growing
+ */
+qint64 MemoryForecast::timeUntilLimit(qint64 limit) const
+{
+    if (size() >= limit)
+    {
+        return 0;
+    }
+
+    const double rate = growthRate();
+    if (rate > 0)
+    {
+        return static_cast<qint64>(static_cast<double>(limit - size()) / rate * 1000);
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef MEMORYFORECAST_H
+#define MEMORYFORECAST_H
+
+#include <QList>
+
+/*!
+ * Forecast of time until memory budget is used by samples
+ *
+ * Memory used by the samples is measured periodically during a log. Memory
+ * grows in steps (a chunk is allocated at once, full chunks are compressed),
+ * so the growth rate is determined over a window of measurements instead of
+ * between two consecutive measurements.
+ */
+class MemoryForecast
+{
+public:
+    MemoryForecast();
+
+    void clear();
+    void addMeasurement(qint64 timestamp, qint64 size);
+
+    qint64 size() const;
+    bool hasGrowthRate() const;
+    double growthRate() const;
+    qint64 timeUntilLimit(qint64 limit) const;
+
+private:
+
+    QList<qint64> _timestamps;
+    QList<qint64> _sizes;
+
+    /* Measurements that are used for growth rate (ms) */
+    static const qint64 _cWindow = 60 * 1000;
+
+    /* Minimum time between first and last measurement for a reliable growth rate (ms) */
+    static const qint64 _cMinimumSpan = 5 * 1000;
+};
+
+#endif // MEMORYFORECAST_H
@@ -0,0 +1,163 @@
+#include "settingsmodel.h"
+#include "polltracemodel.h"
+
+PollTraceModel::PollTraceModel(QObject *parent) : QObject(parent)
+{
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+    {
+        _cycleLists.append(QList<Cycle>());
+    }
+
+    _maxCycles = 20;
+
+    _clock.start();
+}
+
+qint32 PollTraceModel::maxCycles() const
+{
+    return _maxCycles;
+}
+
+void PollTraceModel::setMaxCycles(qint32 maxCycles)
+{
+    _maxCycles = qMax(maxCycles, 1);
+
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+    {
+        while (_cycleLists[i].size() > _maxCycles)
+        {
+            _cycleLists[i].removeFirst();
+        }
+    }
+
+    emit traceReset();
+}
+
+qint32 PollTraceModel::cycleCount(quint8 connectionId) const
+{
+    if (connectionId < _cycleLists.size())
+    {
+        return _cycleLists[connectionId].size();
+    }
+
+    return 0;
+}
+
+/*!
+ * Get events of cycle
+ * \param connectionId      Connection id
+ * \param cycleIdx          Index of cycle (0 is oldest cycle)
+ */
+PollTraceModel::Cycle PollTraceModel::cycle(quint8 connectionId, qint32 cycleIdx) const
+{
+    if (
+        (connectionId < _cycleLists.size())
+        && (cycleIdx >= 0)
+        && (cycleIdx < _cycleLists[connectionId].size())
+    )
+    {
+        return _cycleLists[connectionId][cycleIdx];
+    }
+
+    return Cycle();
+}
+
+/*!
+ * Add event with current time
+ */
+void PollTraceModel::addEvent(quint8 connectionId, PollTraceModel::EventType type, quint16 address, quint16 count)
+{
+    addEventAt(connectionId, type, _clock.nsecsElapsed() / 1000, address, count);
+}
+
+/*!
+ * Add event to trace, CYCLE_START starts a new cycle and drops the oldest cycle when needed.
+ * Events outside a cycle (writes before first read) are added to a new cycle.
+ * \param connectionId      Connection id
+ * \param type              Type of event
+ * \param time              Time of event in us
+ * \param address           Start address of request
+ * \param count             Number of registers
+ */
+void PollTraceModel::addEventAt(quint8 connectionId, EventType type, qint64 time, quint16 address, quint16 count)
+{
+    if (connectionId >= _cycleLists.size())
+    {
+        return;
+    }
+
+    QList<Cycle> &cycleList = _cycleLists[connectionId];
+
+    if ((type == CYCLE_START) || cycleList.isEmpty())
+    {
+        cycleList.append(Cycle());
+
+        while (cycleList.size() > _maxCycles)
+        {
+            cycleList.removeFirst();
+        }
+    }
+
+    if (cycleList.last().size() < _cMaxEventsPerCycle)
+    {
+        Event event;
+        event.type = type;
+        event.time = time;
+        event.address = address;
+        event.count = count;
+
+        cycleList.last().append(event);
+    }
+
+    if ((type == RESULT) || (type == PROCESSED))
+    {
+        emit traceChanged(connectionId);
+    }
+}
+
+void PollTraceModel::clear()
+{
+    for (quint8 i = 0u; i < SettingsModel::CONNECTION_ID_CNT; i++)
+    {
+        _cycleLists[i].clear();
+    }
+
+    emit traceReset();
+}
+
+QString PollTraceModel::eventTypeToString(EventType type)
+{
+    switch (type)
+    {
+    case CYCLE_START:
+        return QString("Cycle start");
+    case CONNECT_START:
+        return QString("Connect");
+    case CONNECT_END:
+        return QString("Connected");
+    case CONNECT_ERROR:
+        return QString("Connection error");
+    case READ_SEND:
+        return QString("Read request");
+    case READ_SUCCESS:
+        return QString("Read reply");
+    case READ_EXCEPTION:
+        return QString("Read exception");
+    case READ_ERROR:
+        return QString("Read error");
+    case SPLIT:
+        return QString("Split");
+    case WRITE_SEND:
+        return QString("Write request");
+    case WRITE_SUCCESS:
+        return QString("Write reply");
+    case WRITE_ERROR:
+        return QString("Write error");
+    case RESULT:
+        return QString("Result");
+    case PROCESSED:
+        return QString("Processed");
+    default:
+        return QString();
+    }
+}
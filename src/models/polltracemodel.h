@@ -0,0 +1,77 @@
+#ifndef POLLTRACEMODEL_H
+#define POLLTRACEMODEL_H
+
+#include <QObject>
+#include <QList>
+#include <QElapsedTimer>
+
+/*!
+ * Trace of the acquisition path per poll cycle and per connection
+ *
+ * Events are timestamped on arrival (in us), so the trace has to be fed through direct connections.
+ * Only the last cycles of every connection are kept.
+ */
+class PollTraceModel : public QObject
+{
+    Q_OBJECT
+public:
+
+    typedef enum
+    {
+        CYCLE_START = 0,    /*!< Register list read is started */
+        CONNECT_START,      /*!< Connection is being opened */
+        CONNECT_END,        /*!< Connection is opened */
+        CONNECT_ERROR,      /*!< Connection couldn't be opened */
+        READ_SEND,          /*!< Read request is sent (address/count) */
+        READ_SUCCESS,       /*!< Read reply is received (address/count) */
+        READ_EXCEPTION,     /*!< Read reply with modbus exception (address/count) */
+        READ_ERROR,         /*!< Read request failed (address/count) */
+        SPLIT,              /*!< Failed read is split into smaller reads (address/count) */
+        WRITE_SEND,         /*!< Write request is sent (address/count) */
+        WRITE_SUCCESS,      /*!< Write reply is received (address/count) */
+        WRITE_ERROR,        /*!< Write request failed (address/count) */
+        RESULT,             /*!< Results of cycle are emitted (count) */
+        PROCESSED,          /*!< Results of all connections are handled by the application */
+    } EventType;
+
+    typedef struct
+    {
+        EventType type;
+        qint64 time; /* in us */
+        quint16 address;
+        quint16 count;
+    } Event;
+
+    typedef QList<Event> Cycle;
+
+    explicit PollTraceModel(QObject *parent = nullptr);
+
+    qint32 maxCycles() const;
+
+    qint32 cycleCount(quint8 connectionId) const;
+    Cycle cycle(quint8 connectionId, qint32 cycleIdx) const;
+
+    void addEventAt(quint8 connectionId, EventType type, qint64 time, quint16 address = 0, quint16 count = 0);
+
+    static QString eventTypeToString(EventType type);
+
+signals:
+    void traceChanged(quint8 connectionId);
+    void traceReset();
+
+public slots:
+    void setMaxCycles(qint32 maxCycles);
+    void addEvent(quint8 connectionId, PollTraceModel::EventType type, quint16 address, quint16 count);
+    void clear();
+
+private:
+
+    static const qint32 _cMaxEventsPerCycle = 1024;
+
+    QList<QList<Cycle> > _cycleLists;
+    qint32 _maxCycles;
+
+    QElapsedTimer _clock;
+};
+
+#endif // POLLTRACEMODEL_H
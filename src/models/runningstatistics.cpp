@@ -0,0 +1,232 @@
+#include <QtMath>
+#include <QtNumeric>
+
+#include "runningstatistics.h"
+
+/*!
+ * Constructor
+ * \param windowDuration    Duration of window (ms)
+ */
+RunningStatistics::RunningStatistics(double windowDuration)
+{
+    _windowDuration = windowDuration;
+
+    reset();
+}
+
+double RunningStatistics::windowDuration() const
+{
+    return _windowDuration;
+}
+
+/*!
+ * Set duration of window (ms), samples that are out of the window are removed when the next sample is added
+ */
+void RunningStatistics::setWindowDuration(double windowDuration)
+{
+    _windowDuration = windowDuration;
+}
+
+void RunningStatistics::reset()
+{
+    _count = 0;
+    _mean = 0;
+    _m2 = 0;
+    _min = 0;
+    _max = 0;
+    _last = 0;
+
+    _window.clear();
+    _windowStart = 0;
+    _windowSum = 0;
+
+    _minQueue.clear();
+    _minStart = 0;
+    _maxQueue.clear();
+    _maxStart = 0;
+}
+
+/*!
+ * Add sample, keys should be ascending
+ * \param key       Key of sample (ms)
+ * \param value     Value of sample (NaN and infinite values are ignored)
+ */
+void RunningStatistics::add(double key, double value)
+{
+    if (!qIsFinite(value))
+    {
+        return;
+    }
+
+    /* Welford */
+    _count++;
+    const double delta = value - _mean;
+    _mean += delta / _count;
+    _m2 += delta * (value - _mean);
+
+    if (_count == 1)
+    {
+        _min = value;
+        _max = value;
+    }
+    else
+    {
+        _min = qMin(_min, value);
+        _max = qMax(_max, value);
+    }
+
+    _last = value;
+
+    removeExpiredSamples(key);
+
+    Sample sample;
+    sample.key = key;
+    sample.value = value;
+
+    _window.append(sample);
+    _windowSum += value;
+
+    /* Samples that can't become minimum or maximum of window anymore */
+    while ((_minQueue.size() > _minStart) && (_minQueue.last().value >= value))
+    {
+        _minQueue.removeLast();
+    }
+    _minQueue.append(sample);
+
+    while ((_maxQueue.size() > _maxStart) && (_maxQueue.last().value <= value))
+    {
+        _maxQueue.removeLast();
+    }
+    _maxQueue.append(sample);
+}
+
+quint64 RunningStatistics::count() const
+{
+    return _count;
+}
+
+double RunningStatistics::mean() const
+{
+    return _mean;
+}
+
+/*!
+ * Sample variance (n - 1)
+ */
+double RunningStatistics::variance() const
+{
+    if (_count < 2)
+    {
+        return 0;
+    }
+
+    return _m2 / (_count - 1);
+}
+
+double RunningStatistics::standardDeviation() const
+{
+    return qSqrt(variance());
+}
+
+double RunningStatistics::min() const
+{
+    return _min;
+}
+
+double RunningStatistics::max() const
+{
+    return _max;
+}
+
+double RunningStatistics::last() const
+{
+    return _last;
+}
+
+qint32 RunningStatistics::windowCount() const
+{
+    return _window.size() - _windowStart;
+}
+
+double RunningStatistics::windowMean() const
+{
+    if (windowCount() == 0)
+    {
+        return 0;
+    }
+
+    return _windowSum / windowCount();
+}
+
+double RunningStatistics::windowMin() const
+{
+    if (_minStart >= _minQueue.size())
+    {
+        return 0;
+    }
+
+    return _minQueue[_minStart].value;
+}
+
+double RunningStatistics::windowMax() const
+{
+    if (_maxStart >= _maxQueue.size())
+    {
+        return 0;
+    }
+
+    return _maxQueue[_maxStart].value;
+}
+
+void RunningStatistics::removeExpiredSamples(double key)
+{
+    const double startKey = key - _windowDuration;
+
+    while ((_windowStart < _window.size()) && (_window[_windowStart].key <= startKey))
+    {
+        _windowSum -= _window[_windowStart].value;
+        _windowStart++;
+    }
+
+    while ((_minStart < _minQueue.size()) && (_minQueue[_minStart].key <= startKey))
+    {
+        _minStart++;
+    }
+
+    while ((_maxStart < _maxQueue.size()) && (_maxQueue[_maxStart].key <= startKey))
+    {
+        _maxStart++;
+    }
+
+    const qint32 previousStart = _windowStart;
+
+    compact(&_window, &_windowStart);
+    compact(&_minQueue, &_minStart);
+    compact(&_maxQueue, &_maxStart);
+
+    /* Sum is recalculated on compaction, so rounding errors don't accumulate */
+    if (_windowStart == _window.size())
+    {
+        _windowSum = 0;
+    }
+    else if (_windowStart != previousStart)
+    {
+        _windowSum = 0;
+        for (qint32 idx = 0; idx < _window.size(); idx++)
+        {
+            _windowSum += _window[idx].value;
+        }
+    }
+}
+
+/*!
+ * Remove samples before start position, when at least half of the queue is removed (amortized constant time)
+ */
+void RunningStatistics::compact(QVector<Sample> * pQueue, qint32 * pStart)
+{
+    if ((*pStart >= _cMinCompactSize) && (*pStart >= pQueue->size() / 2))
+    {
+        pQueue->remove(0, *pStart);
+        *pStart = 0;
+    }
+}
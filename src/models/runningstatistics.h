@@ -0,0 +1,77 @@
+#ifndef RUNNINGSTATISTICS_H
+#define RUNNINGSTATISTICS_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/*!
+ * Statistics of a value stream that are updated with every sample
+ *
+ * Count, mean and standard deviation of all samples are updated with Welford's algorithm, so the result
+ * doesn't suffer from cancellation. Minimum, maximum and mean of the samples of the last window (duration in ms)
+ * are kept with a sample queue and two monotonic queues. Every sample is added in amortized constant time,
+ * all results are available in constant time.
+ */
+class RunningStatistics
+{
+public:
+
+    explicit RunningStatistics(double windowDuration = 10000);
+
+    double windowDuration() const;
+    void setWindowDuration(double windowDuration);
+
+    void reset();
+    void add(double key, double value);
+
+    quint64 count() const;
+    double mean() const;
+    double variance() const;
+    double standardDeviation() const;
+    double min() const;
+    double max() const;
+    double last() const;
+
+    qint32 windowCount() const;
+    double windowMean() const;
+    double windowMin() const;
+    double windowMax() const;
+
+private:
+
+    typedef struct
+    {
+        double key;
+        double value;
+    } Sample;
+
+    void removeExpiredSamples(double key);
+
+    static void compact(QVector<Sample> * pQueue, qint32 * pStart);
+
+    /* Queues are only compacted when at least this number of samples is removed */
+    static const qint32 _cMinCompactSize = 64;
+
+    double _windowDuration;
+
+    /* All samples */
+    quint64 _count;
+    double _mean;
+    double _m2;
+    double _min;
+    double _max;
+    double _last;
+
+    /* Samples of window, oldest at start position */
+    QVector<Sample> _window;
+    qint32 _windowStart;
+    double _windowSum;
+
+    /* Candidates for minimum and maximum of window: values increase (minimum) or decrease (maximum) from start position */
+    QVector<Sample> _minQueue;
+    qint32 _minStart;
+    QVector<Sample> _maxQueue;
+    qint32 _maxStart;
+};
+
+#endif // RUNNINGSTATISTICS_H
@@ -0,0 +1,348 @@
+
+#include <cstring>
+
+#include "samplechunkstore.h"
+
+/*!
+ * Constructor
+ * \param format        Format of chunk data (used for compression)
+ * \param sampleCount   Number of samples in a chunk
+ */
+SampleChunkStore::SampleChunkStore(SampleCodec::Format format, qint32 sampleCount)
+{
+    _format = format;
+    _sampleCount = sampleCount;
+    _chunkBytes = SampleCodec::chunkBytes(format, sampleCount);
+    _memorySize = 0;
+    _firstHotChunk = 0;
+    _bCompressed = false;
+
+    for (qint32 slot = 0; slot < _cCacheSize; slot++)
+    {
+        _cacheData.append(QByteArray());
+        _cacheChunkIdx.append(-1);
+    }
+    _nextCacheSlot = 0;
+}
+
+qint32 SampleChunkStore::chunkCount() const
+{
+    return _chunkPointers.size();
+}
+
+/*!
+ * Read-only data of chunk
+ * The data of a compressed chunk is only valid until a few other compressed chunks are read.
+ */
+const char * SampleChunkStore::chunk(qint32 chunkIdx) const
+{
+    if (_compressedSizes[chunkIdx] == 0)
+    {
+        return _chunkPointers[chunkIdx];
+    }
+    else
+    {
+        return decompressedChunk(chunkIdx);
+    }
+}
+
+/*!
+ * Writable data of last chunk (always in memory)
+ */
+char * SampleChunkStore::lastChunk()
+{
+    return _memoryChunks.last().data();
+}
+
+/*!
+ * Append chunk, data is initialized to zero
+ */
+void SampleChunkStore::appendChunk()
+{
+    _memoryChunks.append(QByteArray(_chunkBytes, 0));
+    _chunkPointers.append(_memoryChunks.last().constData());
+    _compressedSizes.append(0);
+    _memorySize += _chunkBytes;
+
+    sealChunks();
+}
+
+/*!
+ * Append read-only chunk of zeros, without allocating memory for it
+ */
+void SampleChunkStore::appendEmptyChunk()
+{
+    if (_emptyChunk.isEmpty())
+    {
+        _emptyChunk = QByteArray(_chunkBytes, 0);
+    }
+
+    /* No data in memory: chunk is handled like a chunk in the spill file */
+    _memoryChunks.append(QByteArray());
+    _chunkPointers.append(_emptyChunk.constData());
+    _compressedSizes.append(0);
+
+    sealChunks();
+}
+
+/*!
+ * Append read-only chunk in memory mapped file
+ * \param storedChunk  Chunk data in mapped file (raw or compressed) or empty chunk
+ * \param pFile        Mapped file, kept open (and mapped) while chunks refer to it
+ */
+void SampleChunkStore::appendMappedChunk(const StoredChunk &storedChunk, QSharedPointer<QFile> pFile)
+{
+    if (storedChunk.type == CHUNK_EMPTY)
+    {
+        appendEmptyChunk();
+        return;
+    }
+
+    if (!_mappedFiles.contains(pFile))
+    {
+        _mappedFiles.append(pFile);
+    }
+
+    /* No data in memory: chunk is handled like a chunk in the spill file */
+    _memoryChunks.append(QByteArray());
+    _chunkPointers.append(storedChunk.pData);
+    _compressedSizes.append(storedChunk.type == CHUNK_COMPRESSED ? storedChunk.size : 0);
+
+    sealChunks();
+}
+
+/*!
+ * Copy last chunk to memory when it isn't writable (mapped, compressed or empty chunk)
+ */
+void SampleChunkStore::makeLastChunkWritable()
+{
+    if (_chunkPointers.isEmpty())
+    {
+        return;
+    }
+
+    const qint32 chunkIdx = _chunkPointers.size() - 1;
+
+    if (_memoryChunks[chunkIdx].isEmpty() || (_compressedSizes[chunkIdx] != 0))
+    {
+        const QByteArray data(chunk(chunkIdx), _chunkBytes);
+
+        _memorySize += data.size() - _memoryChunks[chunkIdx].size();
+        _memoryChunks[chunkIdx] = data;
+        _chunkPointers[chunkIdx] = _memoryChunks[chunkIdx].constData();
+        _compressedSizes[chunkIdx] = 0;
+    }
+}
+
+void SampleChunkStore::removeFirstChunk()
+{
+    if (!_chunkPointers.isEmpty())
+    {
+        /* Data in spill file stays there until file is removed */
+        _memorySize -= _memoryChunks.first().size();
+
+        _memoryChunks.removeFirst();
+        _chunkPointers.removeFirst();
+        _compressedSizes.removeFirst();
+
+        if (_firstHotChunk > 0)
+        {
+            _firstHotChunk--;
+        }
+
+        for (qint32 slot = 0; slot < _cCacheSize; slot++)
+        {
+            if (_cacheChunkIdx[slot] >= 0)
+            {
+                _cacheChunkIdx[slot]--;
+            }
+        }
+    }
+}
+
+void SampleChunkStore::clear()
+{
+    _memoryChunks.clear();
+    _chunkPointers.clear();
+    _compressedSizes.clear();
+    _memorySize = 0;
+    _firstHotChunk = 0;
+
+    for (qint32 slot = 0; slot < _cCacheSize; slot++)
+    {
+        _cacheData[slot] = QByteArray();
+        _cacheChunkIdx[slot] = -1;
+    }
+
+    _usedSpillFiles.clear();
+    _mappedFiles.clear();
+}
+
+/*!
+ * Set file to move sealed chunks to
+ * \param pSpillFile    Spill file, null to keep new chunks in memory
+ */
+void SampleChunkStore::setSpillFile(QSharedPointer<SampleSpillFile> pSpillFile)
+{
+    if (_pSpillFile != pSpillFile)
+    {
+        _pSpillFile = pSpillFile;
+
+        /* Chunks that were sealed before are moved as well */
+        _firstHotChunk = 0;
+        sealChunks();
+    }
+}
+
+/*!
+ * Enable compression of sealed chunks
+ * Chunks that are already compressed stay compressed when compression is disabled.
+ */
+void SampleChunkStore::setCompressed(bool bCompressed)
+{
+    if (_bCompressed != bCompressed)
+    {
+        _bCompressed = bCompressed;
+
+        _firstHotChunk = 0;
+        sealChunks();
+    }
+}
+
+/*!
+ * Memory (in bytes) used by chunks that are in memory (including decompressed chunks and shared empty chunk)
+ */
+qint64 SampleChunkStore::memorySize() const
+{
+    qint64 size = _memorySize + _emptyChunk.size();
+
+    for (qint32 slot = 0; slot < _cCacheSize; slot++)
+    {
+        size += _cacheData[slot].size();
+    }
+
+    return size;
+}
+
+/*!
+ * Size (in bytes) of uncompressed chunk
+ */
+qint32 SampleChunkStore::chunkBytes() const
+{
+    return _chunkBytes;
+}
+
+/*!
+ * Data of chunk as it is stored (without decompressing it), used to write session snapshot
+ */
+SampleChunkStore::StoredChunk SampleChunkStore::storedChunk(qint32 chunkIdx) const
+{
+    StoredChunk storedChunk;
+
+    if (_chunkPointers[chunkIdx] == _emptyChunk.constData())
+    {
+        storedChunk.type = CHUNK_EMPTY;
+        storedChunk.pData = nullptr;
+        storedChunk.size = 0;
+    }
+    else if (_compressedSizes[chunkIdx] != 0)
+    {
+        storedChunk.type = CHUNK_COMPRESSED;
+        storedChunk.pData = _chunkPointers[chunkIdx];
+        storedChunk.size = _compressedSizes[chunkIdx];
+    }
+    else
+    {
+        storedChunk.type = CHUNK_RAW;
+        storedChunk.pData = _chunkPointers[chunkIdx];
+        storedChunk.size = _chunkBytes;
+    }
+
+    return storedChunk;
+}
+
+/*!
+ * Compress and/or move sealed chunks (all except the most recent ones)
+ */
+void SampleChunkStore::sealChunks()
+{
+    while (_firstHotChunk < _chunkPointers.size() - _cHotChunkCount)
+    {
+        sealChunk(_firstHotChunk);
+        _firstHotChunk++;
+    }
+}
+
+void SampleChunkStore::sealChunk(qint32 chunkIdx)
+{
+    if (_memoryChunks[chunkIdx].isEmpty())
+    {
+        /* Already in spill file (or empty chunk) */
+        return;
+    }
+
+    if (_bCompressed && (_compressedSizes[chunkIdx] == 0))
+    {
+        const QByteArray compressed = SampleCodec::compress(_format, _sampleCount, _memoryChunks[chunkIdx].constData());
+
+        /* Keep raw chunk when data doesn't compress (e.g. noise) */
+        if (compressed.size() < _chunkBytes)
+        {
+            _memorySize += compressed.size() - _memoryChunks[chunkIdx].size();
+            _memoryChunks[chunkIdx] = compressed;
+            _chunkPointers[chunkIdx] = _memoryChunks[chunkIdx].constData();
+            _compressedSizes[chunkIdx] = compressed.size();
+        }
+    }
+
+    if (!_pSpillFile.isNull())
+    {
+        const char * pStored = _pSpillFile->store(_memoryChunks[chunkIdx].constData(), _memoryChunks[chunkIdx].size());
+
+        /* When spill file is full, chunk is kept in memory */
+        if (pStored != nullptr)
+        {
+            if (!_usedSpillFiles.contains(_pSpillFile))
+            {
+                _usedSpillFiles.append(_pSpillFile);
+            }
+
+            _memorySize -= _memoryChunks[chunkIdx].size();
+            _chunkPointers[chunkIdx] = pStored;
+            _memoryChunks[chunkIdx] = QByteArray();
+        }
+    }
+}
+
+/*!
+ * Decompress chunk in cache (round robin)
+ */
+const char * SampleChunkStore::decompressedChunk(qint32 chunkIdx) const
+{
+    for (qint32 slot = 0; slot < _cCacheSize; slot++)
+    {
+        if (_cacheChunkIdx[slot] == chunkIdx)
+        {
+            return _cacheData[slot].constData();
+        }
+    }
+
+    const qint32 slot = _nextCacheSlot;
+    _nextCacheSlot = (_nextCacheSlot + 1) % _cCacheSize;
+
+    if (_cacheData[slot].size() != _chunkBytes)
+    {
+        _cacheData[slot] = QByteArray(_chunkBytes, 0);
+    }
+
+    const QByteArray compressed = QByteArray::fromRawData(_chunkPointers[chunkIdx], _compressedSizes[chunkIdx]);
+    if (!SampleCodec::decompress(_format, _sampleCount, compressed, _cacheData[slot].data()))
+    {
+        /* Data was compressed by this store, so this shouldn't happen: samples read as invalid */
+        std::memset(_cacheData[slot].data(), 0, static_cast<size_t>(_chunkBytes));
+    }
+
+    _cacheChunkIdx[slot] = chunkIdx;
+
+    return _cacheData[slot].constData();
+}
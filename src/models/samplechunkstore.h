@@ -0,0 +1,112 @@
+#ifndef SAMPLECHUNKSTORE_H
+#define SAMPLECHUNKSTORE_H
+
+#include <QList>
+#include <QByteArray>
+#include <QFile>
+#include <QSharedPointer>
+
+#include "samplespillfile.h"
+#include "samplecodec.h"
+
+/*!
+ * Fixed size memory chunks of a time or value column
+ *
+ * New chunks are allocated in memory. Only the most recent chunks are writable, older chunks are sealed:
+ *  - When compression is enabled, sealed chunks are compressed (see SampleCodec).
+ *    Compressed chunks are decompressed in a small cache when they are read.
+ *  - When a spill file is set, sealed chunks are moved to the spill file.
+ * An empty chunk (e.g. samples missing in value column) doesn't use memory, it refers to a shared chunk of zeros.
+ * Chunks can also refer to a memory mapped file (session snapshot), those chunks are read-only.
+ */
+class SampleChunkStore
+{
+public:
+
+    /* Form in which a chunk is stored (see storedChunk) */
+    typedef enum
+    {
+        CHUNK_RAW = 0,
+        CHUNK_COMPRESSED,
+        CHUNK_EMPTY
+    } StoredType;
+
+    typedef struct
+    {
+        StoredType type;
+        const char * pData;
+        qint32 size;
+    } StoredChunk;
+
+    explicit SampleChunkStore(SampleCodec::Format format, qint32 sampleCount);
+
+    qint32 chunkCount() const;
+    const char * chunk(qint32 chunkIdx) const;
+    char * lastChunk();
+
+    void appendChunk();
+    void appendEmptyChunk();
+    void appendMappedChunk(const StoredChunk &storedChunk, QSharedPointer<QFile> pFile);
+    void makeLastChunkWritable();
+    void removeFirstChunk();
+    void clear();
+
+    void setSpillFile(QSharedPointer<SampleSpillFile> pSpillFile);
+    void setCompressed(bool bCompressed);
+
+    qint64 memorySize() const;
+
+    qint32 chunkBytes() const;
+    StoredChunk storedChunk(qint32 chunkIdx) const;
+
+private:
+    Q_DISABLE_COPY(SampleChunkStore)
+
+    void sealChunks();
+    void sealChunk(qint32 chunkIdx);
+    const char * decompressedChunk(qint32 chunkIdx) const;
+
+    /* Number of chunks (including the chunk that is being filled) that is always kept in memory */
+    static const qint32 _cHotChunkCount = 2;
+
+    /* Number of decompressed chunks that are kept (pointer returned by chunk() stays valid for a few calls) */
+    static const qint32 _cCacheSize = 4;
+
+    SampleCodec::Format _format;
+    qint32 _sampleCount;
+    qint32 _chunkBytes;
+
+    /* Chunks in memory (raw or compressed), empty when chunk is in spill file */
+    QList<QByteArray> _memoryChunks;
+
+    /* Data of all chunks (memory or spill file) */
+    QList<const char *> _chunkPointers;
+
+    /* Size of compressed data, 0 when chunk isn't compressed */
+    QList<qint32> _compressedSizes;
+
+    qint64 _memorySize;
+
+    /* Chunks before this chunk are sealed */
+    qint32 _firstHotChunk;
+
+    bool _bCompressed;
+
+    QSharedPointer<SampleSpillFile> _pSpillFile;
+
+    /* Data of empty chunks */
+    QByteArray _emptyChunk;
+
+    /* Spill files that hold chunks of this store */
+    QList<QSharedPointer<SampleSpillFile> > _usedSpillFiles;
+
+    /* Mapped files that hold chunks of this store */
+    QList<QSharedPointer<QFile> > _mappedFiles;
+
+    /* Decompressed chunks */
+    mutable QList<QByteArray> _cacheData;
+    mutable QList<qint32> _cacheChunkIdx;
+    mutable qint32 _nextCacheSlot;
+};
+
+#endif // SAMPLECHUNKSTORE_H
@@ -0,0 +1,521 @@
+#include <cstring>
+#include <cmath>
+#include <QtAlgorithms>
+#include <QVector>
+
+#include "samplecodec.h"
+
+/*!
+ * Compress chunk
+ * \param format    Layout of chunk
+ * \param count     Number of samples in chunk
+ * \param pChunk    Data of chunk (see chunkBytes for size)
+ * \return compressed data
+ */
+QByteArray SampleCodec::compress(Format format, qint32 count, const char * pChunk)
+{
+    BitWriter writer;
+
+    if (format == FORMAT_KEYS)
+    {
+        QVector<double> keys(count);
+        std::memcpy(keys.data(), pChunk, static_cast<size_t>(count) * sizeof(double));
+
+        compressKeys(&writer, count, keys.constData());
+    }
+    else
+    {
+        XorState state;
+        state.previous = 0;
+        state.leading = -1;
+        state.trailing = 0;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            compressXor(&writer, &state, readValue(format, pChunk, idx));
+        }
+
+        /* Validity bits */
+        const uchar * pValidity = reinterpret_cast<const uchar *>(pChunk) + count * valueSize(format);
+        const qint32 validityBytes = count / 8;
+
+        bool bAllValid = true;
+        bool bAllInvalid = true;
+        for (qint32 idx = 0; idx < validityBytes; idx++)
+        {
+            bAllValid = bAllValid && (pValidity[idx] == 0xFF);
+            bAllInvalid = bAllInvalid && (pValidity[idx] == 0);
+        }
+
+        if (bAllValid || bAllInvalid)
+        {
+            writer.write(1, 1);
+            writer.write(bAllValid ? 1 : 0, 1);
+        }
+        else
+        {
+            writer.write(0, 1);
+            for (qint32 idx = 0; idx < validityBytes; idx++)
+            {
+                writer.write(pValidity[idx], 8);
+            }
+        }
+    }
+
+    return writer.data();
+}
+
+/*!
+ * Decompress chunk
+ * \param format        Layout of chunk
+ * \param count         Number of samples in chunk
+ * \param compressed    Compressed data
+ * \param pChunk        Decompressed data (see chunkBytes for size)
+ * \return false when compressed data is invalid
+ */
+bool SampleCodec::decompress(Format format, qint32 count, const QByteArray &compressed, char * pChunk)
+{
+    BitReader reader(compressed);
+
+    if (format == FORMAT_KEYS)
+    {
+        QVector<double> keys(count);
+
+        decompressKeys(&reader, count, keys.data());
+
+        std::memcpy(pChunk, keys.constData(), static_cast<size_t>(count) * sizeof(double));
+    }
+    else
+    {
+        XorState state;
+        state.previous = 0;
+        state.leading = -1;
+        state.trailing = 0;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            writeValue(format, pChunk, idx, decompressXor(&reader, &state));
+        }
+
+        uchar * pValidity = reinterpret_cast<uchar *>(pChunk) + count * valueSize(format);
+        const qint32 validityBytes = count / 8;
+
+        if (reader.read(1) == 1)
+        {
+            const uchar fill = reader.read(1) == 1 ? 0xFF : 0;
+            std::memset(pValidity, fill, static_cast<size_t>(validityBytes));
+        }
+        else
+        {
+            for (qint32 idx = 0; idx < validityBytes; idx++)
+            {
+                pValidity[idx] = static_cast<uchar>(reader.read(8));
+            }
+        }
+    }
+
+    return reader.isValid();
+}
+
+/*!
+ * Size of uncompressed chunk
+ */
+qint32 SampleCodec::chunkBytes(Format format, qint32 count)
+{
+    if (format == FORMAT_KEYS)
+    {
+        return count * static_cast<qint32>(sizeof(double));
+    }
+    else
+    {
+        return count * valueSize(format) + count / 8;
+    }
+}
+
+void SampleCodec::compressKeys(BitWriter * pWriter, qint32 count, const double * pKeys)
+{
+    /* Timestamps (ms) are whole numbers: use delta of delta */
+    bool bInteger = true;
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        if ((pKeys[idx] != std::floor(pKeys[idx])) || (std::fabs(pKeys[idx]) > 9007199254740992.0))
+        {
+            bInteger = false;
+            break;
+        }
+    }
+
+    pWriter->write(bInteger ? 1 : 0, 1);
+
+    if (bInteger)
+    {
+        qint64 previous = 0;
+        qint64 previousDelta = 0;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            const qint64 key = static_cast<qint64>(pKeys[idx]);
+            const qint64 delta = key - previous;
+            const quint64 deltaOfDelta = zigZagEncode(delta - previousDelta);
+
+            if (deltaOfDelta == 0)
+            {
+                pWriter->write(0, 1);
+            }
+            else if (deltaOfDelta < (1uLL << 7))
+            {
+                pWriter->write(0x2, 2);
+                pWriter->write(deltaOfDelta, 7);
+            }
+            else if (deltaOfDelta < (1uLL << 9))
+            {
+                pWriter->write(0x6, 3);
+                pWriter->write(deltaOfDelta, 9);
+            }
+            else if (deltaOfDelta < (1uLL << 12))
+            {
+                pWriter->write(0xE, 4);
+                pWriter->write(deltaOfDelta, 12);
+            }
+            else if (deltaOfDelta < (1uLL << 32))
+            {
+                pWriter->write(0x1E, 5);
+                pWriter->write(deltaOfDelta, 32);
+            }
+            else
+            {
+                pWriter->write(0x1F, 5);
+                pWriter->write(deltaOfDelta, 64);
+            }
+
+            previousDelta = delta;
+            previous = key;
+        }
+    }
+    else
+    {
+        XorState state;
+        state.previous = 0;
+        state.leading = -1;
+        state.trailing = 0;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            quint64 bits;
+            std::memcpy(&bits, &pKeys[idx], sizeof(bits));
+            compressXor(pWriter, &state, bits);
+        }
+    }
+}
+
+void SampleCodec::decompressKeys(BitReader * pReader, qint32 count, double * pKeys)
+{
+    if (pReader->read(1) == 1)
+    {
+        qint64 previous = 0;
+        qint64 previousDelta = 0;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            quint64 deltaOfDelta;
+
+            if (pReader->read(1) == 0)
+            {
+                deltaOfDelta = 0;
+            }
+            else if (pReader->read(1) == 0)
+            {
+                deltaOfDelta = pReader->read(7);
+            }
+            else if (pReader->read(1) == 0)
+            {
+                deltaOfDelta = pReader->read(9);
+            }
+            else if (pReader->read(1) == 0)
+            {
+                deltaOfDelta = pReader->read(12);
+            }
+            else if (pReader->read(1) == 0)
+            {
+                deltaOfDelta = pReader->read(32);
+            }
+            else
+            {
+                deltaOfDelta = pReader->read(64);
+            }
+
+            const qint64 delta = previousDelta + zigZagDecode(deltaOfDelta);
+            const qint64 key = previous + delta;
+
+            pKeys[idx] = static_cast<double>(key);
+
+            previousDelta = delta;
+            previous = key;
+        }
+    }
+    else
+    {
+        XorState state;
+        state.previous = 0;
+        state.leading = -1;
+        state.trailing = 0;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            const quint64 bits = decompressXor(pReader, &state);
+            std::memcpy(&pKeys[idx], &bits, sizeof(bits));
+        }
+    }
+}
+
+/*!
+ * Store XOR of value with previous value
+ *  - '0': same value
+ *  - '10' + meaningful bits: XOR fits in leading/trailing zeros of previous XOR
+ *  - '11' + leading zeros (6 bits) + length - 1 (6 bits) + meaningful bits
+ */
+void SampleCodec::compressXor(BitWriter * pWriter, XorState * pState, quint64 value)
+{
+    const quint64 xorValue = value ^ pState->previous;
+
+    if (xorValue == 0)
+    {
+        pWriter->write(0, 1);
+    }
+    else
+    {
+        const qint32 leading = static_cast<qint32>(qCountLeadingZeroBits(xorValue));
+        const qint32 trailing = static_cast<qint32>(qCountTrailingZeroBits(xorValue));
+
+        if (
+            (pState->leading >= 0)
+            && (leading >= pState->leading)
+            && (trailing >= pState->trailing)
+        )
+        {
+            pWriter->write(0x2, 2);
+            pWriter->write(xorValue >> pState->trailing, 64 - pState->leading - pState->trailing);
+        }
+        else
+        {
+            const qint32 meaningful = 64 - leading - trailing;
+
+            pWriter->write(0x3, 2);
+            pWriter->write(static_cast<quint64>(leading), 6);
+            pWriter->write(static_cast<quint64>(meaningful - 1), 6);
+            pWriter->write(xorValue >> trailing, meaningful);
+
+            pState->leading = leading;
+            pState->trailing = trailing;
+        }
+    }
+
+    pState->previous = value;
+}
+
+quint64 SampleCodec::decompressXor(BitReader * pReader, XorState * pState)
+{
+    if (pReader->read(1) == 1)
+    {
+        quint64 xorValue;
+
+        if (pReader->read(1) == 0)
+        {
+            if (pState->leading < 0)
+            {
+                /* Invalid data: no previous window */
+                pReader->invalidate();
+                return 0;
+            }
+
+            xorValue = pReader->read(64 - pState->leading - pState->trailing) << pState->trailing;
+        }
+        else
+        {
+            const qint32 leading = static_cast<qint32>(pReader->read(6));
+            const qint32 meaningful = static_cast<qint32>(pReader->read(6)) + 1;
+            const qint32 trailing = 64 - leading - meaningful;
+
+            if (trailing < 0)
+            {
+                pReader->invalidate();
+                return 0;
+            }
+
+            xorValue = pReader->read(meaningful) << trailing;
+
+            pState->leading = leading;
+            pState->trailing = trailing;
+        }
+
+        pState->previous ^= xorValue;
+    }
+
+    return pState->previous;
+}
+
+quint64 SampleCodec::readValue(Format format, const char * pValues, qint32 idx)
+{
+    if (format == FORMAT_16BIT)
+    {
+        quint16 value;
+        std::memcpy(&value, pValues + idx * static_cast<qint32>(sizeof(value)), sizeof(value));
+        return value;
+    }
+    else if (format == FORMAT_32BIT)
+    {
+        quint32 value;
+        std::memcpy(&value, pValues + idx * static_cast<qint32>(sizeof(value)), sizeof(value));
+        return value;
+    }
+    else
+    {
+        quint64 value;
+        std::memcpy(&value, pValues + idx * static_cast<qint32>(sizeof(value)), sizeof(value));
+        return value;
+    }
+}
+
+void SampleCodec::writeValue(Format format, char * pValues, qint32 idx, quint64 value)
+{
+    if (format == FORMAT_16BIT)
+    {
+        const quint16 value16 = static_cast<quint16>(value);
+        std::memcpy(pValues + idx * static_cast<qint32>(sizeof(value16)), &value16, sizeof(value16));
+    }
+    else if (format == FORMAT_32BIT)
+    {
+        const quint32 value32 = static_cast<quint32>(value);
+        std::memcpy(pValues + idx * static_cast<qint32>(sizeof(value32)), &value32, sizeof(value32));
+    }
+    else
+    {
+        std::memcpy(pValues + idx * static_cast<qint32>(sizeof(value)), &value, sizeof(value));
+    }
+}
+
+qint32 SampleCodec::valueSize(Format format)
+{
+    switch (format)
+    {
+    case FORMAT_16BIT:
+        return sizeof(quint16);
+    case FORMAT_32BIT:
+        return sizeof(quint32);
+    default:
+        return sizeof(double);
+    }
+}
+
+quint64 SampleCodec::zigZagEncode(qint64 value)
+{
+    return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+}
+
+qint64 SampleCodec::zigZagDecode(quint64 value)
+{
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+SampleCodec::BitWriter::BitWriter()
+{
+    _buffer = 0;
+    _bufferBits = 0;
+}
+
+/*!
+ * Append bits (most significant bit first)
+ * \param value     Bits to append (in lowest bits of value)
+ * \param bitCount  Number of bits (1 - 64)
+ */
+void SampleCodec::BitWriter::write(quint64 value, qint32 bitCount)
+{
+    while (bitCount > 0)
+    {
+        const qint32 count = qMin(64 - _bufferBits, bitCount);
+        const quint64 mask = count == 64 ? ~0uLL : ((1uLL << count) - 1);
+        const quint64 bits = (value >> (bitCount - count)) & mask;
+
+        _buffer = count == 64 ? bits : ((_buffer << count) | bits);
+        _bufferBits += count;
+        bitCount -= count;
+
+        if (_bufferBits == 64)
+        {
+            for (qint32 shift = 56; shift >= 0; shift -= 8)
+            {
+                _data.append(static_cast<char>((_buffer >> shift) & 0xFF));
+            }
+
+            _buffer = 0;
+            _bufferBits = 0;
+        }
+    }
+}
+
+QByteArray SampleCodec::BitWriter::data() const
+{
+    QByteArray data = _data;
+
+    if (_bufferBits > 0)
+    {
+        const quint64 aligned = _buffer << (64 - _bufferBits);
+        const qint32 byteCount = (_bufferBits + 7) / 8;
+
+        for (qint32 idx = 0; idx < byteCount; idx++)
+        {
+            data.append(static_cast<char>((aligned >> (56 - idx * 8)) & 0xFF));
+        }
+    }
+
+    return data;
+}
+
+SampleCodec::BitReader::BitReader(const QByteArray &data)
+{
+    _pData = reinterpret_cast<const uchar *>(data.constData());
+    _bitCount = static_cast<qint64>(data.size()) * 8;
+    _bitPos = 0;
+    _bValid = true;
+}
+
+/*!
+ * Read bits (most significant bit first)
+ * \param bitCount  Number of bits (1 - 64)
+ * \return bits, 0 when data is exhausted (reader becomes invalid)
+ */
+quint64 SampleCodec::BitReader::read(qint32 bitCount)
+{
+    if (_bitPos + bitCount > _bitCount)
+    {
+        invalidate();
+        return 0;
+    }
+
+    quint64 result = 0;
+
+    while (bitCount > 0)
+    {
+        const qint32 bitOffset = static_cast<qint32>(_bitPos & 0x7);
+        const qint32 available = 8 - bitOffset;
+        const qint32 count = qMin(available, bitCount);
+        const quint32 bits = (static_cast<quint32>(_pData[_bitPos >> 3]) >> (available - count)) & ((1u << count) - 1);
+
+        result = (result << count) | bits;
+        _bitPos += count;
+        bitCount -= count;
+    }
+
+    return result;
+}
+
+bool SampleCodec::BitReader::isValid() const
+{
+    return _bValid;
+}
+
+void SampleCodec::BitReader::invalidate()
+{
+    _bValid = false;
+    _bitPos = _bitCount;
+}
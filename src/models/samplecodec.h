@@ -0,0 +1,82 @@
+#ifndef SAMPLECODEC_H
+#define SAMPLECODEC_H
+
+#include <QByteArray>
+
+/*!
+ * Compression of sealed chunks of the sample store (Gorilla style)
+ *
+ * Keys: delta-of-delta encoding when all keys of the chunk are whole numbers (timestamps in ms),
+ *       XOR encoding otherwise.
+ * Values: XOR with previous value, only the meaningful bits are stored.
+ * Validity bits: single flag when all samples are valid (or invalid), raw bits otherwise.
+ */
+class SampleCodec
+{
+public:
+
+    typedef enum
+    {
+        FORMAT_KEYS = 0,    /* Chunk of doubles */
+        FORMAT_16BIT,       /* Values followed by validity bits */
+        FORMAT_32BIT,
+        FORMAT_DOUBLE
+    } Format;
+
+    static QByteArray compress(Format format, qint32 count, const char * pChunk);
+    static bool decompress(Format format, qint32 count, const QByteArray &compressed, char * pChunk);
+
+    static qint32 chunkBytes(Format format, qint32 count);
+
+private:
+
+    class BitWriter
+    {
+    public:
+        BitWriter();
+        void write(quint64 value, qint32 bitCount);
+        QByteArray data() const;
+
+    private:
+        QByteArray _data;
+        quint64 _buffer;
+        qint32 _bufferBits;
+    };
+
+    class BitReader
+    {
+    public:
+        explicit BitReader(const QByteArray &data);
+        quint64 read(qint32 bitCount);
+        bool isValid() const;
+        void invalidate();
+
+    private:
+        const uchar * _pData;
+        qint64 _bitCount;
+        qint64 _bitPos;
+        bool _bValid;
+    };
+
+    typedef struct
+    {
+        quint64 previous;
+        qint32 leading;
+        qint32 trailing;
+    } XorState;
+
+    static void compressKeys(BitWriter * pWriter, qint32 count, const double * pKeys);
+    static void decompressKeys(BitReader * pReader, qint32 count, double * pKeys);
+
+    static void compressXor(BitWriter * pWriter, XorState * pState, quint64 value);
+    static quint64 decompressXor(BitReader * pReader, XorState * pState);
+
+    static quint64 readValue(Format format, const char * pValues, qint32 idx);
+    static void writeValue(Format format, char * pValues, qint32 idx, quint64 value);
+    static qint32 valueSize(Format format);
+
+    static quint64 zigZagEncode(qint64 value);
+    static qint64 zigZagDecode(quint64 value);
+};
+
+#endif // SAMPLECODEC_H
@@ -0,0 +1,433 @@
+#include <cstring>
+
+#include "samplecolumn.h"
+
+SampleColumn::SampleColumn(Type type) :
+    _chunks(codecFormat(type), cChunkSize)
+{
+    _type = type;
+    _valueSize = valueSize(type);
+    _size = 0;
+    _firstChunk = 0;
+}
+
+SampleColumn::Type SampleColumn::type() const
+{
+    return _type;
+}
+
+qint32 SampleColumn::size() const
+{
+    return _size;
+}
+
+/*!
+ * Sample has a value (false for communication error and for missing row)
+ */
+bool SampleColumn::isValid(qint32 idx) const
+{
+    const char * pChunk = chunkOfRow(idx);
+
+    if (pChunk == nullptr)
+    {
+        return false;
+    }
+
+    const qint32 offset = idx & (cChunkSize - 1);
+    const char validityByte = pChunk[cChunkSize * _valueSize + (offset >> 3)];
+
+    return (validityByte & (1 << (offset & 0x7))) != 0;
+}
+
+/*!
+ * Row has no sample (see appendMissing)
+ */
+bool SampleColumn::isMissing(qint32 idx) const
+{
+    /* Find last gap that begins at or before row */
+    qint32 lower = 0;
+    qint32 upper = _gaps.size();
+
+    while (lower < upper)
+    {
+        const qint32 middle = (lower + upper) / 2;
+
+        if (_gaps[middle].begin <= idx)
+        {
+            lower = middle + 1;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+
+    return (lower > 0) && (idx < _gaps[lower - 1].end);
+}
+
+/*!
+ * Chunk index (row >> cChunkShift) of first chunk that is stored, all rows before it are missing
+ */
+qint32 SampleColumn::firstStoredChunk() const
+{
+    return _firstChunk;
+}
+
+/*!
+ * Raw register value of sample (only for 16 bit and 32 bit columns)
+ */
+quint32 SampleColumn::rawValue(qint32 idx) const
+{
+    const char * pChunk = chunkOfRow(idx);
+
+    if (pChunk == nullptr)
+    {
+        return 0;
+    }
+
+    const qint32 offset = idx & (cChunkSize - 1);
+    const char * pData = pChunk + offset * _valueSize;
+
+    if (_type == TYPE_16BIT)
+    {
+        quint16 value;
+        std::memcpy(&value, pData, sizeof(value));
+        return value;
+    }
+    else if (_type == TYPE_32BIT)
+    {
+        quint32 value;
+        std::memcpy(&value, pData, sizeof(value));
+        return value;
+    }
+    else
+    {
+        // Double column has no raw values
+        return 0;
+    }
+}
+
+/*!
+ * Value of sample (only for double columns)
+ */
+double SampleColumn::doubleValue(qint32 idx) const
+{
+    double value = 0;
+    const char * pChunk = chunkOfRow(idx);
+
+    if ((_type == TYPE_DOUBLE) && (pChunk != nullptr))
+    {
+        const qint32 offset = idx & (cChunkSize - 1);
+        std::memcpy(&value, pChunk + offset * _valueSize, sizeof(value));
+    }
+
+    return value;
+}
+
+void SampleColumn::append(quint32 rawValue, bool bValid)
+{
+    if (_type == TYPE_16BIT)
+    {
+        const quint16 value = static_cast<quint16>(rawValue);
+        appendValue(&value, bValid);
+    }
+    else if (_type == TYPE_32BIT)
+    {
+        appendValue(&rawValue, bValid);
+    }
+    else
+    {
+        const double value = rawValue;
+        appendValue(&value, bValid);
+    }
+}
+
+void SampleColumn::appendDouble(double value, bool bValid)
+{
+    if (_type == TYPE_DOUBLE)
+    {
+        appendValue(&value, bValid);
+    }
+    else
+    {
+        append(static_cast<quint32>(value), bValid);
+    }
+}
+
+/*!
+ * Append invalid samples (communication error)
+ */
+void SampleColumn::appendInvalid(qint32 count)
+{
+    const quint64 zero = 0;
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        appendValue(&zero, false);
+    }
+}
+
+/*!
+ * Append rows without sample (e.g. graph added during logging)
+ * Chunks before the first sample aren't stored and chunks without samples don't use memory.
+ */
+void SampleColumn::appendMissing(qint32 count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    const qint32 end = _size + count;
+
+    if (!_gaps.isEmpty() && (_gaps.last().end == _size))
+    {
+        _gaps.last().end = end;
+    }
+    else
+    {
+        Gap gap;
+        gap.begin = _size;
+        gap.end = end;
+        _gaps.append(gap);
+    }
+
+    if (_chunks.chunkCount() == 0)
+    {
+        /* Nothing stored yet: first chunk starts at next sample */
+        _size = end;
+        _firstChunk = _size >> cChunkShift;
+        return;
+    }
+
+    while (_size < end)
+    {
+        if ((_size & (cChunkSize - 1)) != 0)
+        {
+            /* Rest of current chunk is already cleared */
+            _size = qMin(end, (_size | (cChunkSize - 1)) + 1);
+        }
+        else if (end - _size >= cChunkSize)
+        {
+            _chunks.appendEmptyChunk();
+            _size += cChunkSize;
+        }
+        else
+        {
+            /* Next sample is added in this chunk */
+            _chunks.appendChunk();
+            _size = end;
+        }
+    }
+}
+
+/*!
+ * Replace value of last row (provisional row of graph with ingest filter)
+ */
+void SampleColumn::replaceLast(quint32 rawValue, bool bValid)
+{
+    if (_size == 0)
+    {
+        return;
+    }
+
+    if (_type == TYPE_16BIT)
+    {
+        const quint16 value = static_cast<quint16>(rawValue);
+        setLastValue(&value, bValid);
+    }
+    else if (_type == TYPE_32BIT)
+    {
+        setLastValue(&rawValue, bValid);
+    }
+    else
+    {
+        const double value = rawValue;
+        setLastValue(&value, bValid);
+    }
+}
+
+/*!
+ * Remove oldest chunk of samples (together with first chunk of time column)
+ */
+void SampleColumn::removeFirstChunk()
+{
+    if (_size == 0)
+    {
+        return;
+    }
+
+    if (_firstChunk > 0)
+    {
+        _firstChunk--;
+    }
+    else if (_chunks.chunkCount() > 0)
+    {
+        _chunks.removeFirstChunk();
+    }
+    else
+    {
+        // Only missing rows
+    }
+
+    _size = qMax(_size - cChunkSize, 0);
+
+    /* Rows of gaps move along */
+    for (qint32 gapIdx = _gaps.size() - 1; gapIdx >= 0; gapIdx--)
+    {
+        _gaps[gapIdx].begin = qMax(_gaps[gapIdx].begin - cChunkSize, 0);
+        _gaps[gapIdx].end -= cChunkSize;
+
+        if (_gaps[gapIdx].end <= 0)
+        {
+            _gaps.removeAt(gapIdx);
+        }
+    }
+}
+
+void SampleColumn::clear()
+{
+    _chunks.clear();
+    _size = 0;
+    _firstChunk = 0;
+    _gaps.clear();
+}
+
+/*!
+ * Memory (in bytes) allocated for values and validity bits (chunks in spill file aren't included)
+ */
+qint64 SampleColumn::memorySize() const
+{
+    return _chunks.memorySize();
+}
+
+/*!
+ * Move sealed chunks to spill file (null: keep chunks in memory)
+ */
+void SampleColumn::setSpillFile(QSharedPointer<SampleSpillFile> pSpillFile)
+{
+    _chunks.setSpillFile(pSpillFile);
+}
+
+/*!
+ * Compress sealed chunks
+ */
+void SampleColumn::setCompressed(bool bCompressed)
+{
+    _chunks.setCompressed(bCompressed);
+}
+
+/*!
+ * Number of stored chunks (starting at firstStoredChunk)
+ */
+qint32 SampleColumn::storedChunkCount() const
+{
+    return _chunks.chunkCount();
+}
+
+SampleChunkStore::StoredChunk SampleColumn::storedChunk(qint32 chunkIdx) const
+{
+    return _chunks.storedChunk(chunkIdx);
+}
+
+QList<SampleColumn::Gap> SampleColumn::gaps() const
+{
+    return _gaps;
+}
+
+/*!
+ * Replace samples with chunks of memory mapped session snapshot
+ * \param size         Number of rows
+ * \param firstChunk   Chunk index (of rows) of first stored chunk
+ * \param gaps         Ranges of missing rows
+ * \param chunkList    Chunks in mapped file
+ * \param pFile        Mapped file
+ */
+void SampleColumn::restore(qint32 size, qint32 firstChunk, const QList<Gap> &gaps, const QList<SampleChunkStore::StoredChunk> &chunkList, QSharedPointer<QFile> pFile)
+{
+    clear();
+
+    for (qint32 chunkIdx = 0; chunkIdx < chunkList.size(); chunkIdx++)
+    {
+        _chunks.appendMappedChunk(chunkList[chunkIdx], pFile);
+    }
+
+    /* Mapped data is read-only, new samples are added in last chunk */
+    _chunks.makeLastChunkWritable();
+
+    _size = size;
+    _firstChunk = firstChunk;
+    _gaps = gaps;
+}
+
+qint32 SampleColumn::valueSize(Type type)
+{
+    switch (type)
+    {
+    case TYPE_16BIT:
+        return sizeof(quint16);
+    case TYPE_32BIT:
+        return sizeof(quint32);
+    default:
+        return sizeof(double);
+    }
+}
+
+SampleCodec::Format SampleColumn::codecFormat(Type type)
+{
+    switch (type)
+    {
+    case TYPE_16BIT:
+        return SampleCodec::FORMAT_16BIT;
+    case TYPE_32BIT:
+        return SampleCodec::FORMAT_32BIT;
+    default:
+        return SampleCodec::FORMAT_DOUBLE;
+    }
+}
+
+/*!
+ * Data of chunk that holds row, nullptr when the chunk isn't stored (missing rows before first sample)
+ */
+const char * SampleColumn::chunkOfRow(qint32 idx) const
+{
+    const qint32 chunkIdx = (idx >> cChunkShift) - _firstChunk;
+
+    if ((chunkIdx < 0) || (chunkIdx >= _chunks.chunkCount()))
+    {
+        return nullptr;
+    }
+
+    return _chunks.chunk(chunkIdx);
+}
+
+void SampleColumn::appendValue(const void * pValue, bool bValid)
+{
+    if (((_size & (cChunkSize - 1)) == 0) || (_chunks.chunkCount() == 0))
+    {
+        /* Values and validity bits of new chunk are cleared */
+        _chunks.appendChunk();
+    }
+
+    _size++;
+
+    setLastValue(pValue, bValid);
+}
+
+void SampleColumn::setLastValue(const void * pValue, bool bValid)
+{
+    const qint32 offset = (_size - 1) & (cChunkSize - 1);
+    char * pChunk = _chunks.lastChunk();
+    char * pValidity = pChunk + cChunkSize * _valueSize + (offset >> 3);
+
+    std::memcpy(pChunk + offset * _valueSize, pValue, static_cast<size_t>(_valueSize));
+
+    if (bValid)
+    {
+        *pValidity |= static_cast<char>(1 << (offset & 0x7));
+    }
+    else
+    {
+        *pValidity &= static_cast<char>(~(1 << (offset & 0x7)));
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef SAMPLECOLUMN_H
+#define SAMPLECOLUMN_H
+
+#include "samplechunkstore.h"
+
+/*!
+ * Compact value column of a single graph
+ *
+ * Values are stored as they are received (raw register value) with a validity bit per sample.
+ * A chunk holds the values followed by the validity bits.
+ * Rows correspond with the rows of the time column (SampleTimebase) of the graph.
+ *
+ * Rows can be missing (no sample at all, e.g. graph activated during logging), which is different from an
+ * invalid sample (communication error). Chunks before the first sample aren't stored (start offset) and
+ * chunks that are completely missing don't use memory, so adding missing rows doesn't depend on their number.
+ *  - 16 bit: single register
+ *  - 32 bit: register pair (packed, see GraphData::packRegisterPair)
+ *  - double: values without raw register value (loaded from data file)
+ */
+class SampleColumn
+{
+public:
+
+    typedef enum
+    {
+        TYPE_16BIT = 0,
+        TYPE_32BIT,
+        TYPE_DOUBLE
+    } Type;
+
+    /* Range of missing rows */
+    typedef struct
+    {
+        qint32 begin;
+        qint32 end;
+    } Gap;
+
+    static const qint32 cChunkShift = 12;
+    static const qint32 cChunkSize = 1 << cChunkShift;
+
+    explicit SampleColumn(Type type);
+
+    Type type() const;
+    qint32 size() const;
+
+    bool isValid(qint32 idx) const;
+    bool isMissing(qint32 idx) const;
+    qint32 firstStoredChunk() const;
+    quint32 rawValue(qint32 idx) const;
+    double doubleValue(qint32 idx) const;
+
+    void append(quint32 rawValue, bool bValid);
+    void appendDouble(double value, bool bValid);
+    void appendInvalid(qint32 count);
+    void appendMissing(qint32 count);
+    void replaceLast(quint32 rawValue, bool bValid);
+    void removeFirstChunk();
+    void clear();
+
+    qint64 memorySize() const;
+    void setSpillFile(QSharedPointer<SampleSpillFile> pSpillFile);
+    void setCompressed(bool bCompressed);
+
+    static qint32 valueSize(Type type);
+    static SampleCodec::Format codecFormat(Type type);
+
+    /* Session snapshot */
+    qint32 storedChunkCount() const;
+    SampleChunkStore::StoredChunk storedChunk(qint32 chunkIdx) const;
+    QList<Gap> gaps() const;
+    void restore(qint32 size, qint32 firstChunk, const QList<Gap> &gaps, const QList<SampleChunkStore::StoredChunk> &chunkList, QSharedPointer<QFile> pFile);
+
+private:
+
+    const char * chunkOfRow(qint32 idx) const;
+
+    void appendValue(const void * pValue, bool bValid);
+    void setLastValue(const void * pValue, bool bValid);
+
+    Type _type;
+    qint32 _valueSize;
+
+    SampleChunkStore _chunks;
+    qint32 _size;
+
+    /* Chunk index (of rows) of first stored chunk, rows before it are missing */
+    qint32 _firstChunk;
+
+    /* Ranges of missing rows (sorted) */
+    QList<Gap> _gaps;
+};
+
+#endif // SAMPLECOLUMN_H
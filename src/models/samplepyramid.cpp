@@ -0,0 +1,231 @@
+
+#include <limits>
+#include <QtNumeric>
+
+#include "sampleseries.h"
+#include "samplepyramid.h"
+
+SamplePyramid::SamplePyramid()
+{
+    for (qint32 level = 0; level < cLevelCount; level++)
+    {
+        _levels.append(QList<QVector<Bucket> >());
+    }
+
+    _lastMin.fill(0, cLevelCount);
+    _lastMax.fill(0, cLevelCount);
+
+    _size = 0;
+    _bucketMemorySize = 0;
+    _skippedChunks = 0;
+}
+
+/*!
+ * Number of samples that are included in pyramid
+ */
+qint32 SamplePyramid::size() const
+{
+    return _size;
+}
+
+qint32 SamplePyramid::bucketSize(qint32 level)
+{
+    return 1 << bucketShift(level);
+}
+
+/*!
+ * Number of buckets of level, the last bucket can be incomplete
+ */
+qint32 SamplePyramid::bucketCount(qint32 level) const
+{
+    return (_size + bucketSize(level) - 1) >> bucketShift(level);
+}
+
+/*!
+ * Sample index of minimum value in bucket
+ */
+qint32 SamplePyramid::minIndex(qint32 level, qint32 bucketIdx) const
+{
+    return (bucketIdx << bucketShift(level)) + bucket(level, bucketIdx).minOffset;
+}
+
+/*!
+ * Sample index of maximum value in bucket
+ */
+qint32 SamplePyramid::maxIndex(qint32 level, qint32 bucketIdx) const
+{
+    return (bucketIdx << bucketShift(level)) + bucket(level, bucketIdx).maxOffset;
+}
+
+/*!
+ * Select level with largest buckets that aren't larger than maxBucketSize
+ * \param maxBucketSize     Maximum number of samples in bucket
+ * \return level, -1 when buckets of all levels are too large
+ */
+qint32 SamplePyramid::selectLevel(double maxBucketSize) const
+{
+    qint32 level = -1;
+
+    while (
+           (level + 1 < cLevelCount)
+           && (bucketSize(level + 1) <= maxBucketSize)
+    )
+    {
+        level++;
+    }
+
+    return level;
+}
+
+/*!
+ * Add samples of series that aren't in the pyramid yet
+ * When the series has less samples than the pyramid (samples were cleared), the pyramid is rebuilt.
+ * \param series    Samples of graph
+ */
+void SamplePyramid::update(const SampleSeries &series)
+{
+    /* Provisional last sample isn't added, it can still change */
+    const qint32 count = series.sealedSize();
+
+    if (count < _size)
+    {
+        clear();
+    }
+
+    if (_size == 0)
+    {
+        /* Skip chunks without samples */
+        _skippedChunks = qMin(series.missingChunkCount(), count >> SampleTimebase::cChunkShift);
+        _size = _skippedChunks << SampleTimebase::cChunkShift;
+    }
+
+    for (qint32 idx = _size; idx < count; idx++)
+    {
+        append(series.value(idx));
+    }
+}
+
+/*!
+ * Remove buckets of oldest chunk of samples (see SampleTimebase::removeFirstChunk)
+ */
+void SamplePyramid::removeFirstChunk()
+{
+    if (_skippedChunks > 0)
+    {
+        _skippedChunks--;
+        _size -= SampleTimebase::cChunkSize;
+    }
+    else if (_size > SampleTimebase::cChunkSize)
+    {
+        for (qint32 level = 0; level < cLevelCount; level++)
+        {
+            _bucketMemorySize -= _levels[level].first().capacity() * static_cast<qint64>(sizeof(Bucket));
+            _levels[level].removeFirst();
+        }
+
+        _size -= SampleTimebase::cChunkSize;
+    }
+    else
+    {
+        /* Pyramid only covers (part of) first chunk, rebuild on next update */
+        clear();
+    }
+}
+
+void SamplePyramid::clear()
+{
+    for (qint32 level = 0; level < cLevelCount; level++)
+    {
+        _levels[level].clear();
+    }
+
+    _size = 0;
+    _bucketMemorySize = 0;
+    _skippedChunks = 0;
+}
+
+/*!
+ * Memory (in bytes) allocated for buckets
+ */
+qint64 SamplePyramid::memorySize() const
+{
+    return _bucketMemorySize + (_lastMin.capacity() + _lastMax.capacity()) * static_cast<qint64>(sizeof(double));
+}
+
+void SamplePyramid::append(double value)
+{
+    for (qint32 level = 0; level < cLevelCount; level++)
+    {
+        const qint32 offset = _size & (bucketSize(level) - 1);
+
+        if (offset == 0)
+        {
+            /* First sample of new bucket */
+            const qint32 bucketIdx = _size >> bucketShift(level);
+            const qint32 chunkBucketShift = SampleTimebase::cChunkShift - bucketShift(level);
+
+            if ((bucketIdx & ((1 << chunkBucketShift) - 1)) == 0)
+            {
+                _levels[level].append(QVector<Bucket>());
+                _levels[level].last().reserve(1 << chunkBucketShift);
+                _bucketMemorySize += _levels[level].last().capacity() * static_cast<qint64>(sizeof(Bucket));
+            }
+
+            Bucket newBucket;
+            newBucket.minOffset = 0;
+            newBucket.maxOffset = 0;
+            _levels[level].last().append(newBucket);
+
+            if (qIsNaN(value))
+            {
+                /* Missing sample: replaced by first sample of bucket with a value */
+                _lastMin[level] = std::numeric_limits<double>::infinity();
+                _lastMax[level] = -std::numeric_limits<double>::infinity();
+            }
+            else
+            {
+                _lastMin[level] = value;
+                _lastMax[level] = value;
+            }
+        }
+        else
+        {
+            Bucket &lastBucket = _levels[level].last().last();
+
+            if (value < _lastMin[level])
+            {
+                lastBucket.minOffset = static_cast<quint16>(offset);
+                _lastMin[level] = value;
+            }
+
+            if (value > _lastMax[level])
+            {
+                lastBucket.maxOffset = static_cast<quint16>(offset);
+                _lastMax[level] = value;
+            }
+        }
+    }
+
+    _size++;
+}
+
+const SamplePyramid::Bucket &SamplePyramid::bucket(qint32 level, qint32 bucketIdx) const
+{
+    static const Bucket cMissingBucket = {0, 0};
+
+    const qint32 chunkBucketShift = SampleTimebase::cChunkShift - bucketShift(level);
+    const qint32 chunkIdx = (bucketIdx >> chunkBucketShift) - _skippedChunks;
+
+    if (chunkIdx < 0)
+    {
+        /* First sample of bucket (missing) */
+        return cMissingBucket;
+    }
+
+    return _levels[level][chunkIdx][bucketIdx & ((1 << chunkBucketShift) - 1)];
+}
+
+qint32 SamplePyramid::bucketShift(qint32 level)
+{
+    return (level + 1) * cLevelShift;
+}
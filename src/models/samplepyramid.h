@@ -0,0 +1,77 @@
+#ifndef SAMPLEPYRAMID_H
+#define SAMPLEPYRAMID_H
+
+#include <QList>
+#include <QVector>
+
+#include "sampletimebase.h"
+
+//Forward declaration
+class SampleSeries;
+
+/*!
+ * Level of detail pyramid of a graph, used to plot a large number of samples
+ *
+ * Every level divides the samples in buckets of a fixed size (4, 16, 64, ... samples) and keeps the
+ * index of the minimum and maximum (converted) value of each bucket. Together with the first and last sample
+ * of a bucket, this is enough to draw the bucket in a single pixel column.
+ *
+ * Buckets are stored in chunks that match the chunks of the time column, so the pyramid
+ * can drop its oldest chunk together with the sample store. Chunks without samples at the start of the
+ * series (graph activated during logging) aren't stored. Missing samples (NaN) are only used
+ * when a bucket has no other samples.
+ */
+class SamplePyramid
+{
+public:
+
+    static const qint32 cLevelShift = 2;
+    static const qint32 cLevelCount = SampleTimebase::cChunkShift / cLevelShift;
+
+    explicit SamplePyramid();
+
+    qint32 size() const;
+
+    static qint32 bucketSize(qint32 level);
+    qint32 bucketCount(qint32 level) const;
+    qint32 minIndex(qint32 level, qint32 bucketIdx) const;
+    qint32 maxIndex(qint32 level, qint32 bucketIdx) const;
+
+    qint32 selectLevel(double maxBucketSize) const;
+
+    void update(const SampleSeries &series);
+    void removeFirstChunk();
+    void clear();
+
+    qint64 memorySize() const;
+
+private:
+
+    typedef struct
+    {
+        quint16 minOffset;
+        quint16 maxOffset;
+    } Bucket;
+
+    void append(double value);
+    const Bucket &bucket(qint32 level, qint32 bucketIdx) const;
+
+    static qint32 bucketShift(qint32 level);
+
+    /* Per level: chunks of buckets */
+    QList<QList<QVector<Bucket> > > _levels;
+
+    /* Per level: minimum and maximum value of last bucket */
+    QVector<double> _lastMin;
+    QVector<double> _lastMax;
+
+    qint32 _size;
+
+    /* Memory allocated for chunks of buckets */
+    qint64 _bucketMemorySize;
+
+    /* Number of chunks without samples before first stored chunk */
+    qint32 _skippedChunks;
+};
+
+#endif // SAMPLEPYRAMID_H
@@ -0,0 +1,250 @@
+
+#include <QtNumeric>
+
+#include "graphdata.h"
+#include "sampleseries.h"
+
+SampleSeries::SampleSeries()
+{
+    _pGraphData = nullptr;
+}
+
+/*!
+ * Constructor
+ * \param pTimebase     Time column of graph
+ * \param pColumn       Value column of graph
+ * \param pGraphData    Graph whose settings convert the raw values (nullptr: raw values aren't converted)
+ */
+SampleSeries::SampleSeries(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn, const GraphData * pGraphData)
+{
+    _pTimebase = pTimebase;
+    _pColumn = pColumn;
+    _pGraphData = pGraphData;
+}
+
+/*!
+ * Constructor of series with keys only (e.g. keys of common timebase), values read as 0
+ * \param pTimebase     Time column
+ */
+SampleSeries::SampleSeries(QSharedPointer<SampleTimebase> pTimebase)
+{
+    _pTimebase = pTimebase;
+    _pGraphData = nullptr;
+}
+
+qint32 SampleSeries::size() const
+{
+    if (_pTimebase.isNull())
+    {
+        return 0;
+    }
+
+    if (_pColumn.isNull())
+    {
+        return _pTimebase->size();
+    }
+
+    /* Column can be behind time column while a sample row is being added */
+    return qMin(_pTimebase->size(), _pColumn->size());
+}
+
+/*!
+ * Number of samples that don't change anymore
+ * The last sample of a graph with ingest filter is provisional (replaced by the next sample).
+ */
+qint32 SampleSeries::sealedSize() const
+{
+    const qint32 count = size();
+
+    if ((count > 0) && (_pGraphData != nullptr) && _pGraphData->isIngestFiltered())
+    {
+        return count - 1;
+    }
+
+    return count;
+}
+
+bool SampleSeries::isEmpty() const
+{
+    return size() == 0;
+}
+
+double SampleSeries::key(qint32 idx) const
+{
+    return _pTimebase->key(idx);
+}
+
+double SampleSeries::value(qint32 idx) const
+{
+    if (!isValid(idx))
+    {
+        return isMissing(idx) ? qQNaN() : 0;
+    }
+
+    if (_pColumn->type() == SampleColumn::TYPE_DOUBLE)
+    {
+        return _pColumn->doubleValue(idx);
+    }
+    else if (_pGraphData != nullptr)
+    {
+        return _pGraphData->processValue(_pColumn->rawValue(idx));
+    }
+    else
+    {
+        return _pColumn->rawValue(idx);
+    }
+}
+
+bool SampleSeries::isValid(qint32 idx) const
+{
+    return !_pColumn.isNull() && _pColumn->isValid(idx);
+}
+
+/*!
+ * Graph has no sample for row (e.g. graph wasn't active yet)
+ */
+bool SampleSeries::isMissing(qint32 idx) const
+{
+    return !_pColumn.isNull() && _pColumn->isMissing(idx);
+}
+
+/*!
+ * Number of chunks (of SampleTimebase::cChunkSize rows) at start of series without any sample
+ */
+qint32 SampleSeries::missingChunkCount() const
+{
+    return _pColumn.isNull() ? 0 : _pColumn->firstStoredChunk();
+}
+
+qint32 SampleSeries::findBegin(double sortKey, bool bExpandedRange) const
+{
+    if (isEmpty())
+    {
+        return 0;
+    }
+
+    return qMin(_pTimebase->findBegin(sortKey, bExpandedRange), size());
+}
+
+qint32 SampleSeries::findEnd(double sortKey, bool bExpandedRange) const
+{
+    if (isEmpty())
+    {
+        return 0;
+    }
+
+    return qMin(_pTimebase->findEnd(sortKey, bExpandedRange), size());
+}
+
+QCPRange SampleSeries::keyRange(bool &bFoundRange) const
+{
+    const qint32 count = size();
+
+    bFoundRange = count > 0;
+
+    if (bFoundRange)
+    {
+        return QCPRange(key(0), key(count - 1));
+    }
+
+    return QCPRange();
+}
+
+/*!
+ * Get range of values
+ * \param bFoundRange   Set to true when there are values in range
+ * \param inKeyRange    Only use samples in this key range (default: all samples)
+ */
+QCPRange SampleSeries::valueRange(bool &bFoundRange, const QCPRange &inKeyRange) const
+{
+    QCPRange range;
+    bFoundRange = false;
+
+    qint32 beginIdx = 0;
+    qint32 endIdx = size();
+
+    if (inKeyRange != QCPRange())
+    {
+        beginIdx = findBegin(inKeyRange.lower, false);
+        endIdx = findEnd(inKeyRange.upper, false);
+    }
+
+    /* Use largest buckets of pyramid for the samples in between */
+    const QSharedPointer<SamplePyramid> pPyramid = pyramid();
+    if (!pPyramid.isNull())
+    {
+        pPyramid->update(*this);
+
+        const qint32 level = SamplePyramid::cLevelCount - 1;
+        const qint32 bucketSize = SamplePyramid::bucketSize(level);
+        const qint32 firstBucket = (beginIdx + bucketSize - 1) / bucketSize;
+        const qint32 endBucket = qMin(endIdx, pPyramid->size()) / bucketSize;
+
+        if (firstBucket < endBucket)
+        {
+            expandValueRange(&range, &bFoundRange, beginIdx, firstBucket * bucketSize);
+
+            for (qint32 bucketIdx = firstBucket; bucketIdx < endBucket; bucketIdx++)
+            {
+                expandValueRange(&range, &bFoundRange, value(pPyramid->minIndex(level, bucketIdx)));
+                expandValueRange(&range, &bFoundRange, value(pPyramid->maxIndex(level, bucketIdx)));
+            }
+
+            beginIdx = endBucket * bucketSize;
+        }
+    }
+
+    expandValueRange(&range, &bFoundRange, beginIdx, endIdx);
+
+    return range;
+}
+
+void SampleSeries::expandValueRange(QCPRange * pRange, bool * pbFoundRange, qint32 beginIdx, qint32 endIdx) const
+{
+    for (qint32 idx = beginIdx; idx < endIdx; idx++)
+    {
+        expandValueRange(pRange, pbFoundRange, value(idx));
+    }
+}
+
+void SampleSeries::expandValueRange(QCPRange * pRange, bool * pbFoundRange, double sampleValue)
+{
+    if (qIsNaN(sampleValue))
+    {
+        /* Missing sample */
+        return;
+    }
+
+    if (!*pbFoundRange)
+    {
+        pRange->lower = sampleValue;
+        pRange->upper = sampleValue;
+        *pbFoundRange = true;
+    }
+    else
+    {
+        pRange->expand(sampleValue);
+    }
+}
+
+/*!
+ * Level of detail pyramid of graph (null when series isn't linked to a graph)
+ * The pyramid can be behind the series, call SamplePyramid::update before using it.
+ */
+QSharedPointer<SamplePyramid> SampleSeries::pyramid() const
+{
+    if ((_pGraphData == nullptr) || (_pGraphData->sampleColumn() != _pColumn))
+    {
+        return QSharedPointer<SamplePyramid>();
+    }
+
+    return _pGraphData->samplePyramid();
+}
+
+/*!
+ * Check whether both series share the same time column (same keys for every index)
+ */
+bool SampleSeries::isSameTimebase(const SampleSeries &other) const
+{
+    return !_pTimebase.isNull() && (_pTimebase == other._pTimebase);
+}
@@ -0,0 +1,58 @@
+#ifndef SAMPLESERIES_H
+#define SAMPLESERIES_H
+
+#include <QSharedPointer>
+
+#include "qcustomplot.h"
+#include "sampletimebase.h"
+#include "samplecolumn.h"
+#include "samplepyramid.h"
+
+//Forward declaration
+class GraphData;
+
+/*!
+ * Read access to the samples of a graph: keys of the time column and values of the value column
+ *
+ * Raw register values are converted with the current settings of the graph when they are read,
+ * invalid samples (errors) read as 0 and missing samples read as NaN (gap in graph).
+ * The series refers to the graph, so it shouldn't be kept after the graph is removed.
+ */
+class SampleSeries
+{
+public:
+    explicit SampleSeries();
+    explicit SampleSeries(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn, const GraphData * pGraphData = nullptr);
+    explicit SampleSeries(QSharedPointer<SampleTimebase> pTimebase);
+
+    qint32 size() const;
+    qint32 sealedSize() const;
+    bool isEmpty() const;
+
+    double key(qint32 idx) const;
+    double value(qint32 idx) const;
+    bool isValid(qint32 idx) const;
+    bool isMissing(qint32 idx) const;
+    qint32 missingChunkCount() const;
+
+    qint32 findBegin(double sortKey, bool bExpandedRange = true) const;
+    qint32 findEnd(double sortKey, bool bExpandedRange = true) const;
+
+    QCPRange keyRange(bool &bFoundRange) const;
+    QCPRange valueRange(bool &bFoundRange, const QCPRange &inKeyRange = QCPRange()) const;
+
+    bool isSameTimebase(const SampleSeries &other) const;
+
+    QSharedPointer<SamplePyramid> pyramid() const;
+
+private:
+
+    void expandValueRange(QCPRange * pRange, bool * pbFoundRange, qint32 beginIdx, qint32 endIdx) const;
+    static void expandValueRange(QCPRange * pRange, bool * pbFoundRange, double sampleValue);
+
+    QSharedPointer<SampleTimebase> _pTimebase;
+    QSharedPointer<SampleColumn> _pColumn;
+    const GraphData * _pGraphData;
+};
+
+#endif // SAMPLESERIES_H
@@ -0,0 +1,139 @@
+#include <cstring>
+#include <QDir>
+#include <QDebug>
+
+#include "samplespillfile.h"
+
+/*!
+ * Constructor
+ * \param directory     Session directory, file is removed when the spill file is destroyed
+ */
+SampleSpillFile::SampleSpillFile(const QString &directory) :
+    _file(QDir(directory).filePath("samples_XXXXXX.bin"))
+{
+    _writeOffset = 0;
+    _bDiskFull = false;
+
+    _file.open();
+}
+
+SampleSpillFile::~SampleSpillFile()
+{
+    for (qint32 idx = 0; idx < _segments.size(); idx++)
+    {
+        _file.unmap(_segments[idx]);
+    }
+    _segments.clear();
+
+    _file.close();
+}
+
+bool SampleSpillFile::isOpen() const
+{
+    return _file.isOpen();
+}
+
+/*!
+ * Size of file on disk (in bytes)
+ */
+qint64 SampleSpillFile::size() const
+{
+    return static_cast<qint64>(_segments.size()) * _cSegmentSize;
+}
+
+/*!
+ * Copy data to file
+ * \param pData     Data of chunk
+ * \param size      Size of data (should be smaller than a segment)
+ * \return Pointer to stored data, nullptr on failure (e.g. disk full)
+ */
+const char * SampleSpillFile::store(const char * pData, qint32 size)
+{
+    if (!_file.isOpen() || (size > _cSegmentSize))
+    {
+        return nullptr;
+    }
+
+    /* Keep data aligned for reading values in place (compressed chunks have any size) */
+    _writeOffset = (_writeOffset + _cAlignment - 1) & ~static_cast<qint64>(_cAlignment - 1);
+
+    /* Don't split chunk over segments */
+    if ((_writeOffset % _cSegmentSize) + size > _cSegmentSize)
+    {
+        _writeOffset = (_writeOffset / _cSegmentSize + 1) * _cSegmentSize;
+    }
+
+    const qint32 segmentIdx = static_cast<qint32>(_writeOffset / _cSegmentSize);
+    while (_segments.size() <= segmentIdx)
+    {
+        if (!addSegment())
+        {
+            return nullptr;
+        }
+    }
+
+    char * pStored = reinterpret_cast<char *>(_segments[segmentIdx]) + (_writeOffset % _cSegmentSize);
+    std::memcpy(pStored, pData, static_cast<size_t>(size));
+
+    _writeOffset += size;
+
+    return pStored;
+}
+
+bool SampleSpillFile::addSegment()
+{
+    const qint64 segmentOffset = static_cast<qint64>(_segments.size()) * _cSegmentSize;
+
+    if (_bDiskFull)
+    {
+        return false;
+    }
+
+    if (!allocateSegment(segmentOffset))
+    {
+        qWarning() << "Can't allocate disk space for samples, new samples are kept in memory";
+
+        /* Release part of segment that was allocated */
+        _file.resize(segmentOffset);
+        _bDiskFull = true;
+
+        return false;
+    }
+
+    uchar * pSegment = _file.map(segmentOffset, _cSegmentSize);
+    if (pSegment == nullptr)
+    {
+        return false;
+    }
+
+    _segments.append(pSegment);
+
+    return true;
+}
+
+/*!
+ * Write zeros to segment
+ * Only resizing the file creates a sparse file: a full disk would cause a bus error
+ * when data is copied to the mapped segment.
+ * \param segmentOffset    Offset of segment in file
+ * \return false when disk space couldn't be allocated
+ */
+bool SampleSpillFile::allocateSegment(qint64 segmentOffset)
+{
+    if (!_file.seek(segmentOffset))
+    {
+        return false;
+    }
+
+    const QByteArray zeros(_cAllocateBlockSize, 0);
+
+    for (qint64 offset = 0; offset < _cSegmentSize; offset += zeros.size())
+    {
+        if (_file.write(zeros) != zeros.size())
+        {
+            return false;
+        }
+    }
+
+    return _file.flush();
+}
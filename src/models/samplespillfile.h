@@ -0,0 +1,46 @@
+#ifndef SAMPLESPILLFILE_H
+#define SAMPLESPILLFILE_H
+
+#include <QList>
+#include <QTemporaryFile>
+
+/*!
+ * Memory mapped file in the session directory that holds sealed chunks of the sample store
+ *
+ * The file is mapped in large segments, chunks never cross a segment boundary. Data that is
+ * stored, stays mapped until the file is destroyed, so pointers to stored chunks remain valid.
+ * The operating system pages the data in on access and can drop it again when memory is needed.
+ *
+ * Disk space of a segment is allocated before it is mapped, so a full disk is noticed when the segment
+ * is added (chunks are kept in memory) instead of when data is copied to the mapping.
+ */
+class SampleSpillFile
+{
+public:
+    explicit SampleSpillFile(const QString &directory);
+    ~SampleSpillFile();
+
+    bool isOpen() const;
+    qint64 size() const;
+
+    const char * store(const char * pData, qint32 size);
+
+private:
+    Q_DISABLE_COPY(SampleSpillFile)
+
+    bool addSegment();
+    bool allocateSegment(qint64 segmentOffset);
+
+    static const qint64 _cSegmentSize = 64 * 1024 * 1024;
+    static const qint32 _cAllocateBlockSize = 1024 * 1024;
+    static const qint32 _cAlignment = 8;
+
+    QTemporaryFile _file;
+    QList<uchar *> _segments;
+    qint64 _writeOffset;
+
+    /* Allocating a segment failed, no new segments are added */
+    bool _bDiskFull;
+};
+
+#endif // SAMPLESPILLFILE_H
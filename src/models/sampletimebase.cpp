@@ -0,0 +1,265 @@
+
+#include "sampletimebase.h"
+
+SampleTimebase::SampleTimebase() :
+    _chunks(SampleCodec::FORMAT_KEYS, cChunkSize)
+{
+    _size = 0;
+}
+
+qint32 SampleTimebase::size() const
+{
+    return _size;
+}
+
+double SampleTimebase::key(qint32 idx) const
+{
+    return reinterpret_cast<const double *>(_chunks.chunk(idx >> cChunkShift))[idx & (cChunkSize - 1)];
+}
+
+/*!
+ * Find index of first key at or after sortKey (same behaviour as QCPDataContainer::findBegin)
+ * \param sortKey           Key to search
+ * \param bExpandedRange    Include key before sortKey (for lines that cross the start of the range)
+ * \return index of key, size() when there is no such key
+ */
+qint32 SampleTimebase::findBegin(double sortKey, bool bExpandedRange) const
+{
+    qint32 idx = lowerBound(sortKey);
+
+    if (bExpandedRange && (idx > 0))
+    {
+        idx--;
+    }
+
+    return idx;
+}
+
+/*!
+ * Find index after last key at or before sortKey (same behaviour as QCPDataContainer::findEnd)
+ * \param sortKey           Key to search
+ * \param bExpandedRange    Include key after sortKey (for lines that cross the end of the range)
+ * \return end index (exclusive)
+ */
+qint32 SampleTimebase::findEnd(double sortKey, bool bExpandedRange) const
+{
+    qint32 idx = upperBound(sortKey);
+
+    if (bExpandedRange && (idx < _size))
+    {
+        idx++;
+    }
+
+    return idx;
+}
+
+QCPRange SampleTimebase::keyRange(bool &bFoundRange) const
+{
+    bFoundRange = _size > 0;
+
+    if (bFoundRange)
+    {
+        return QCPRange(_chunkFirstKeys.first(), key(_size - 1));
+    }
+
+    return QCPRange();
+}
+
+qint32 SampleTimebase::chunkCount() const
+{
+    return _chunks.chunkCount();
+}
+
+/*!
+ * Memory (in bytes) allocated for keys (chunks in spill file aren't included)
+ */
+qint64 SampleTimebase::memorySize() const
+{
+    return _chunks.memorySize();
+}
+
+/*!
+ * Append key to time column
+ * Keys never go back in time (e.g. clock adjustment), so a key before the last key is replaced by the last key.
+ */
+void SampleTimebase::append(double key)
+{
+    if ((_size > 0) && (key < this->key(_size - 1)))
+    {
+        key = this->key(_size - 1);
+    }
+
+    if ((_size & (cChunkSize - 1)) == 0)
+    {
+        _chunks.appendChunk();
+        _chunkFirstKeys.append(key);
+    }
+
+    reinterpret_cast<double *>(_chunks.lastChunk())[_size & (cChunkSize - 1)] = key;
+    _size++;
+}
+
+/*!
+ * Replace key of last row (provisional row of graph with ingest filter)
+ */
+void SampleTimebase::replaceLast(double key)
+{
+    if (_size > 1)
+    {
+        key = qMax(key, this->key(_size - 2));
+    }
+
+    const qint32 offset = (_size - 1) & (cChunkSize - 1);
+
+    reinterpret_cast<double *>(_chunks.lastChunk())[offset] = key;
+
+    if (offset == 0)
+    {
+        _chunkFirstKeys.last() = key;
+    }
+}
+
+/*!
+ * Remove oldest chunk of keys, the chunk that is being filled is never removed
+ * The value columns of this time column should remove their first chunk as well.
+ */
+void SampleTimebase::removeFirstChunk()
+{
+    if (_chunks.chunkCount() > 1)
+    {
+        _chunks.removeFirstChunk();
+        _chunkFirstKeys.removeFirst();
+        _size -= cChunkSize;
+    }
+}
+
+void SampleTimebase::clear()
+{
+    _chunks.clear();
+    _chunkFirstKeys.clear();
+    _size = 0;
+}
+
+/*!
+ * Move sealed chunks to spill file (null: keep chunks in memory)
+ */
+void SampleTimebase::setSpillFile(QSharedPointer<SampleSpillFile> pSpillFile)
+{
+    _chunks.setSpillFile(pSpillFile);
+}
+
+/*!
+ * Compress sealed chunks
+ */
+void SampleTimebase::setCompressed(bool bCompressed)
+{
+    _chunks.setCompressed(bCompressed);
+}
+
+SampleChunkStore::StoredChunk SampleTimebase::storedChunk(qint32 chunkIdx) const
+{
+    return _chunks.storedChunk(chunkIdx);
+}
+
+double SampleTimebase::chunkFirstKey(qint32 chunkIdx) const
+{
+    return _chunkFirstKeys[chunkIdx];
+}
+
+/*!
+ * Replace keys with chunks of memory mapped session snapshot
+ * \param size             Number of keys
+ * \param chunkFirstKeys   First key of every chunk
+ * \param chunkList        Chunks in mapped file (size should match)
+ * \param pFile            Mapped file
+ */
+void SampleTimebase::restore(qint32 size, const QVector<double> &chunkFirstKeys, const QList<SampleChunkStore::StoredChunk> &chunkList, QSharedPointer<QFile> pFile)
+{
+    clear();
+
+    for (qint32 chunkIdx = 0; chunkIdx < chunkList.size(); chunkIdx++)
+    {
+        _chunks.appendMappedChunk(chunkList[chunkIdx], pFile);
+    }
+
+    /* Mapped data is read-only, new keys are added in last chunk */
+    _chunks.makeLastChunkWritable();
+
+    _chunkFirstKeys = chunkFirstKeys;
+    _size = size;
+}
+
+qint32 SampleTimebase::lowerBound(double sortKey) const
+{
+    /* Search in single chunk: key before sortKey is in last chunk that starts before sortKey */
+    const qint32 chunkIdx = qMax(chunkCountBefore(sortKey, false) - 1, 0);
+    qint32 low = chunkIdx << cChunkShift;
+    qint32 high = qMin((chunkIdx + 1) << cChunkShift, _size);
+
+    while (low < high)
+    {
+        const qint32 mid = low + (high - low) / 2;
+
+        if (key(mid) < sortKey)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+qint32 SampleTimebase::upperBound(double sortKey) const
+{
+    const qint32 chunkIdx = qMax(chunkCountBefore(sortKey, true) - 1, 0);
+    qint32 low = chunkIdx << cChunkShift;
+    qint32 high = qMin((chunkIdx + 1) << cChunkShift, _size);
+
+    while (low < high)
+    {
+        const qint32 mid = low + (high - low) / 2;
+
+        if (key(mid) <= sortKey)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/*!
+ * Number of chunks that start before sortKey
+ * Searching the chunks first avoids reading (decompressing) a chunk for every step of a search.
+ * \param sortKey         Key to search
+ * \param bIncludeEqual   Also count chunks that start at sortKey
+ */
+qint32 SampleTimebase::chunkCountBefore(double sortKey, bool bIncludeEqual) const
+{
+    qint32 low = 0;
+    qint32 high = _chunkFirstKeys.size();
+
+    while (low < high)
+    {
+        const qint32 mid = low + (high - low) / 2;
+
+        if ((_chunkFirstKeys[mid] < sortKey) || (bIncludeEqual && (_chunkFirstKeys[mid] == sortKey)))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
@@ -0,0 +1,63 @@
+#ifndef SAMPLETIMEBASE_H
+#define SAMPLETIMEBASE_H
+
+#include <QVector>
+
+#include "qcustomplot.h"
+#include "samplechunkstore.h"
+
+/*!
+ * Time column shared by all graphs that are sampled on the same timestamps (graphs of one connection)
+ *
+ * Keys are stored in fixed size chunks, so appending never moves existing keys.
+ * Keys are kept in ascending order. The oldest chunk can be removed (ring buffer retention),
+ * indexes always start at the oldest key that is kept. Sealed chunks can be compressed and/or moved
+ * to a spill file.
+ */
+class SampleTimebase
+{
+public:
+
+    static const qint32 cChunkShift = 12;
+    static const qint32 cChunkSize = 1 << cChunkShift;
+
+    explicit SampleTimebase();
+
+    qint32 size() const;
+    double key(qint32 idx) const;
+
+    qint32 findBegin(double sortKey, bool bExpandedRange = true) const;
+    qint32 findEnd(double sortKey, bool bExpandedRange = true) const;
+    QCPRange keyRange(bool &bFoundRange) const;
+
+    qint32 chunkCount() const;
+    qint64 memorySize() const;
+
+    void append(double key);
+    void replaceLast(double key);
+    void removeFirstChunk();
+    void clear();
+
+    void setSpillFile(QSharedPointer<SampleSpillFile> pSpillFile);
+    void setCompressed(bool bCompressed);
+
+    /* Session snapshot */
+    SampleChunkStore::StoredChunk storedChunk(qint32 chunkIdx) const;
+    double chunkFirstKey(qint32 chunkIdx) const;
+    void restore(qint32 size, const QVector<double> &chunkFirstKeys, const QList<SampleChunkStore::StoredChunk> &chunkList, QSharedPointer<QFile> pFile);
+
+private:
+
+    qint32 lowerBound(double sortKey) const;
+    qint32 upperBound(double sortKey) const;
+    qint32 chunkCountBefore(double sortKey, bool bIncludeEqual) const;
+
+    SampleChunkStore _chunks;
+
+    /* First key of every chunk (always in memory) */
+    QVector<double> _chunkFirstKeys;
+
+    qint32 _size;
+};
+
+#endif // SAMPLETIMEBASE_H
@@ -10,11 +10,13 @@ SettingsModel::SettingsModel(QObject *parent) :
         ConnectionSettings connectionSettings;
 
         connectionSettings.ipAddress = "127.0.0.1";
+        connectionSettings.secondaryIpAddress = QString();
         connectionSettings.port = 502;
         connectionSettings.slaveId = 1;
         connectionSettings.timeout = 1000;
         connectionSettings.consecutiveMax = 125;
         connectionSettings.bConnectionState = false;
+        connectionSettings.bUdpTransport = false;
 
         _connectionSettings.append(connectionSettings);
     }
@@ -26,6 +28,22 @@ SettingsModel::SettingsModel(QObject *parent) :
     _bAbsoluteTimes = false;
     _bWriteDuringLog = true;
     _writeDuringLogFile = SettingsModel::defaultLogPath();
+
+    _bTriggerCapture = false;
+    _preTriggerTime = 1000;
+    _postTriggerTime = 5000;
+
+    _retentionDuration = 0;
+    _retentionSamples = 0;
+    _retentionMemory = 0;
+    _bStopAtMemoryLimit = false;
+
+    _bSpillToDisk = false;
+    _bCompressSamples = false;
+
+    _bPublishLiveData = false;
+
+    _alarmCommand = QString();
 }
 
 SettingsModel::~SettingsModel()
@@ -39,15 +57,26 @@ void SettingsModel::triggerUpdate(void)
     emit writeDuringLogChanged();
     emit writeDuringLogFileChanged();
     emit absoluteTimesChanged();
+    emit triggerCaptureChanged();
+    emit triggerConditionChanged();
+    emit preTriggerTimeChanged();
+    emit postTriggerTimeChanged();
+    emit retentionChanged();
+    emit spillToDiskChanged();
+    emit compressSamplesChanged();
+    emit publishLiveDataChanged();
+    emit alarmCommandChanged();
 
     for(quint8 i = 0; i < CONNECTION_ID_CNT; i++)
     {
         emit ipChanged(i);
+        emit secondaryIpChanged(i);
         emit portChanged(i);
         emit slaveIdChanged(i);
         emit timeoutChanged(i);
         emit consecutiveMaxChanged(i);
         emit connectionStateChanged(i);
+        emit udpTransportChanged(i);
     }
 }
 
@@ -79,6 +108,206 @@ bool SettingsModel::absoluteTimes()
     return _bAbsoluteTimes;
 }
 
+void SettingsModel::setTriggerCapture(bool bTriggerCapture)
+{
+    if (_bTriggerCapture != bTriggerCapture)
+    {
+        _bTriggerCapture = bTriggerCapture;
+        emit triggerCaptureChanged();
+    }
+}
+
+bool SettingsModel::triggerCapture()
+{
+    return _bTriggerCapture;
+}
+
+void SettingsModel::setTriggerCondition(TriggerCondition condition)
+{
+    if (_triggerCondition != condition)
+    {
+        _triggerCondition = condition;
+        emit triggerConditionChanged();
+    }
+}
+
+TriggerCondition SettingsModel::triggerCondition()
+{
+    return _triggerCondition;
+}
+
+void SettingsModel::setPreTriggerTime(quint32 preTriggerTime)
+{
+    if (_preTriggerTime != preTriggerTime)
+    {
+        _preTriggerTime = preTriggerTime;
+        emit preTriggerTimeChanged();
+    }
+}
+
+quint32 SettingsModel::preTriggerTime()
+{
+    return _preTriggerTime;
+}
+
+void SettingsModel::setPostTriggerTime(quint32 postTriggerTime)
+{
+    if (_postTriggerTime != postTriggerTime)
+    {
+        _postTriggerTime = postTriggerTime;
+        emit postTriggerTimeChanged();
+    }
+}
+
+quint32 SettingsModel::postTriggerTime()
+{
+    return _postTriggerTime;
+}
+
+/*!
+ * Set maximum duration of samples kept in memory
+ * \param duration     Duration in seconds (0 is unlimited)
+ */
+void SettingsModel::setRetentionDuration(quint32 duration)
+{
+    if (_retentionDuration != duration)
+    {
+        _retentionDuration = duration;
+        emit retentionChanged();
+    }
+}
+
+/*!
+ * Set maximum number of samples (per connection) kept in memory
+ * \param samples      Number of samples (0 is unlimited)
+ */
+void SettingsModel::setRetentionSamples(quint32 samples)
+{
+    if (_retentionSamples != samples)
+    {
+        _retentionSamples = samples;
+        emit retentionChanged();
+    }
+}
+
+/*!
+ * Set maximum memory used by samples
+ * \param memory       Memory in MB (0 is unlimited)
+ */
+void SettingsModel::setRetentionMemory(quint32 memory)
+{
+    if (_retentionMemory != memory)
+    {
+        _retentionMemory = memory;
+        emit retentionChanged();
+    }
+}
+
+/*!
+ * Stop log when memory limit is reached, instead of removing oldest samples
+ */
+void SettingsModel::setStopAtMemoryLimit(bool bStop)
+{
+    if (_bStopAtMemoryLimit != bStop)
+    {
+        _bStopAtMemoryLimit = bStop;
+        emit retentionChanged();
+    }
+}
+
+quint32 SettingsModel::retentionDuration()
+{
+    return _retentionDuration;
+}
+
+quint32 SettingsModel::retentionSamples()
+{
+    return _retentionSamples;
+}
+
+quint32 SettingsModel::retentionMemory()
+{
+    return _retentionMemory;
+}
+
+bool SettingsModel::stopAtMemoryLimit()
+{
+    return _bStopAtMemoryLimit;
+}
+
+bool SettingsModel::retentionEnabled()
+{
+    return (_retentionDuration != 0) || (_retentionSamples != 0) || (_retentionMemory != 0);
+}
+
+/*!
+ * Move older samples to (memory mapped) files in the session directory
+ */
+void SettingsModel::setSpillToDisk(bool bSpillToDisk)
+{
+    if (_bSpillToDisk != bSpillToDisk)
+    {
+        _bSpillToDisk = bSpillToDisk;
+        emit spillToDiskChanged();
+    }
+}
+
+bool SettingsModel::spillToDisk()
+{
+    return _bSpillToDisk;
+}
+
+/*!
+ * Compress older samples (more samples in same memory, plotting a large range is slower)
+ */
+void SettingsModel::setCompressSamples(bool bCompress)
+{
+    if (_bCompressSamples != bCompress)
+    {
+        _bCompressSamples = bCompress;
+        emit compressSamplesChanged();
+    }
+}
+
+bool SettingsModel::compressSamples()
+{
+    return _bCompressSamples;
+}
+
+void SettingsModel::setPublishLiveData(bool bPublish)
+{
+    if (_bPublishLiveData != bPublish)
+    {
+        _bPublishLiveData = bPublish;
+        emit publishLiveDataChanged();
+    }
+}
+
+/*!
+ * Publish polled samples in live data segment (shared memory) for local processes
+ */
+bool SettingsModel::publishLiveData()
+{
+    return _bPublishLiveData;
+}
+
+void SettingsModel::setAlarmCommand(QString command)
+{
+    if (_alarmCommand != command)
+    {
+        _alarmCommand = command;
+        emit alarmCommandChanged();
+    }
+}
+
+/*!
+ * Local command that is started when an alarm is raised (see AlarmMonitor)
+ */
+QString SettingsModel::alarmCommand()
+{
+    return _alarmCommand;
+}
+
 void SettingsModel::setConsecutiveMax(quint8 connectionId, quint8 max)
 {
     if (connectionId >= CONNECTION_ID_CNT)
@@ -134,6 +363,44 @@ bool SettingsModel::connectionState(quint8 connectionId)
     return _connectionSettings[connectionId].bConnectionState;
 }
 
+void SettingsModel::setUdpTransport(quint8 connectionId, bool bUdp)
+{
+    if (connectionId >= CONNECTION_ID_CNT)
+    {
+        connectionId = CONNECTION_ID_0;
+    }
+
+    if (_connectionSettings[connectionId].bUdpTransport != bUdp)
+    {
+        _connectionSettings[connectionId].bUdpTransport = bUdp;
+        emit udpTransportChanged(connectionId);
+    }
+}
+
+bool SettingsModel::udpTransport(quint8 connectionId)
+{
+    if (connectionId >= CONNECTION_ID_CNT)
+    {
+        connectionId = CONNECTION_ID_0;
+    }
+
+    return _connectionSettings[connectionId].bUdpTransport;
+}
+
+/*!
+ * Check whether both connections address the same slave (ip, standby ip, port, slave id and transport)
+ * \param connectionId          Connection id
+ * \param otherConnectionId     Connection id to compare with
+ */
+bool SettingsModel::isSameEndpoint(quint8 connectionId, quint8 otherConnectionId)
+{
+    return (ipAddress(connectionId) == ipAddress(otherConnectionId))
+            && (secondaryIpAddress(connectionId) == secondaryIpAddress(otherConnectionId))
+            && (port(connectionId) == port(otherConnectionId))
+            && (slaveId(connectionId) == slaveId(otherConnectionId))
+            && (udpTransport(connectionId) == udpTransport(otherConnectionId));
+}
+
 void SettingsModel::setWriteDuringLog(bool bState)
 {
     if (_bWriteDuringLog != bState)
@@ -191,6 +458,33 @@ QString SettingsModel::ipAddress(quint8 connectionId)
     return _connectionSettings[connectionId].ipAddress;
 }
 
+/*!
+ * Set address of redundant (warm-standby) device, empty when not used
+ */
+void SettingsModel::setSecondaryIpAddress(quint8 connectionId, QString ip)
+{
+    if (connectionId >= CONNECTION_ID_CNT)
+    {
+        connectionId = CONNECTION_ID_0;
+    }
+
+    if (_connectionSettings[connectionId].secondaryIpAddress != ip)
+    {
+        _connectionSettings[connectionId].secondaryIpAddress = ip;
+        emit secondaryIpChanged(connectionId);
+    }
+}
+
+QString SettingsModel::secondaryIpAddress(quint8 connectionId)
+{
+    if (connectionId >= CONNECTION_ID_CNT)
+    {
+        connectionId = CONNECTION_ID_0;
+    }
+
+    return _connectionSettings[connectionId].secondaryIpAddress;
+}
+
 void SettingsModel::setPort(quint8 connectionId, quint16 port)
 {
     if (connectionId >= CONNECTION_ID_CNT)
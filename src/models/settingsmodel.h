@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QDir>
 
+#include "triggercondition.h"
+
 class SettingsModel : public QObject
 {
     Q_OBJECT
@@ -17,24 +19,51 @@ public:
     void setWriteDuringLogFile(QString filename);
     void setWriteDuringLogFileToDefault(void);
     void setIpAddress(quint8 connectionId, QString ip);
+    void setSecondaryIpAddress(quint8 connectionId, QString ip);
     void setPort(quint8 connectionId, quint16 port);
     void setSlaveId(quint8 connectionId, quint8 id);
     void setTimeout(quint8 connectionId, quint32 timeout);
     void setConsecutiveMax(quint8 connectionId, quint8 max);
     void setConnectionState(quint8 connectionId, bool bState);
+    void setUdpTransport(quint8 connectionId, bool bUdp);
+    void setTriggerCapture(bool bTriggerCapture);
+    void setTriggerCondition(TriggerCondition condition);
+    void setPreTriggerTime(quint32 preTriggerTime);
+    void setPostTriggerTime(quint32 postTriggerTime);
+    void setRetentionDuration(quint32 duration);
+    void setRetentionSamples(quint32 samples);
+    void setRetentionMemory(quint32 memory);
 
     QString writeDuringLogFile();
     bool writeDuringLog();
     QString ipAddress(quint8 connectionId);
+    QString secondaryIpAddress(quint8 connectionId);
     quint16 port(quint8 connectionId);
     quint8 slaveId(quint8 connectionId);
     quint32 timeout(quint8 connectionId);
     quint8 consecutiveMax(quint8 connectionId);
     bool connectionState(quint8 connectionId);
+    bool udpTransport(quint8 connectionId);
+    bool isSameEndpoint(quint8 connectionId, quint8 otherConnectionId);
 
     quint32 pollTime();
     bool absoluteTimes();
 
+    bool triggerCapture();
+    TriggerCondition triggerCondition();
+    quint32 preTriggerTime();
+    quint32 postTriggerTime();
+
+    quint32 retentionDuration();
+    quint32 retentionSamples();
+    quint32 retentionMemory();
+    bool stopAtMemoryLimit();
+    bool retentionEnabled();
+    bool spillToDisk();
+    bool compressSamples();
+    bool publishLiveData();
+    QString alarmCommand();
+
     static const QString defaultLogPath()
     {
         const QString cDefaultLogFileName = "ModbusScope-autolog.csv";
@@ -58,30 +87,48 @@ public:
 public slots:
     void setWriteDuringLog(bool bState);
     void setAbsoluteTimes(bool bAbsolute);
+    void setSpillToDisk(bool bSpillToDisk);
+    void setCompressSamples(bool bCompress);
+    void setStopAtMemoryLimit(bool bStop);
+    void setPublishLiveData(bool bPublish);
+    void setAlarmCommand(QString command);
 
 signals:
     void pollTimeChanged();
     void writeDuringLogChanged();
     void writeDuringLogFileChanged();
     void absoluteTimesChanged();
+    void triggerCaptureChanged();
+    void triggerConditionChanged();
+    void preTriggerTimeChanged();
+    void postTriggerTimeChanged();
+    void retentionChanged();
+    void spillToDiskChanged();
+    void compressSamplesChanged();
+    void publishLiveDataChanged();
+    void alarmCommandChanged();
 
     void ipChanged(quint8 connectionId);
+    void secondaryIpChanged(quint8 connectionId);
     void portChanged(quint8 connectionId);
     void slaveIdChanged(quint8 connectionId);
     void timeoutChanged(quint8 connectionId);
     void consecutiveMaxChanged(quint8 connectionId);
     void connectionStateChanged(quint8 connectionId);
+    void udpTransportChanged(quint8 connectionId);
 
 private:
 
     typedef struct
     {
         QString ipAddress;
+        QString secondaryIpAddress;
         quint16 port;
         quint8 slaveId;
         quint32 timeout;
         quint8 consecutiveMax;
         bool bConnectionState;
+        bool bUdpTransport;
 
     } ConnectionSettings;
 
@@ -93,6 +140,25 @@ private:
     bool _bWriteDuringLog;
     QString _writeDuringLogFile;
 
+    bool _bTriggerCapture;
+    TriggerCondition _triggerCondition;
+    quint32 _preTriggerTime;
+    quint32 _postTriggerTime;
+
+    /* Limits of sample store, 0 is unlimited */
+    quint32 _retentionDuration; /* in seconds */
+    quint32 _retentionSamples; /* per connection */
+    quint32 _retentionMemory; /* in MB */
+    bool _bStopAtMemoryLimit;
+
+    bool _bSpillToDisk;
+    bool _bCompressSamples;
+
+    bool _bPublishLiveData;
+
+    /* Local command that is started when an alarm is raised, empty is none */
+    QString _alarmCommand;
+
 };
 
 #endif // SETTINGSMODEL_H
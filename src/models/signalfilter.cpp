@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <QStringList>
+#include <QtNumeric>
+
+#include "signalfilter.h"
+
+/*!
+ * Constructor
+ * \param mode          Filter mode
+ * \param parameter     Number of samples (moving average, median and decimation), smoothing factor (exponential)
+ *                      or time constant in seconds (low-pass)
+ */
+SignalFilter::SignalFilter(Mode mode, double parameter)
+{
+    _mode = mode;
+    _parameter = parameter;
+
+    reset();
+}
+
+SignalFilter::Mode SignalFilter::mode() const
+{
+    return _mode;
+}
+
+double SignalFilter::parameter() const
+{
+    return _parameter;
+}
+
+bool SignalFilter::isEnabled() const
+{
+    return _mode != FILTER_NONE;
+}
+
+/*!
+ * Filter produces less samples than it receives (graph has its own time column)
+ */
+bool SignalFilter::isDecimating() const
+{
+    return _mode == FILTER_DECIMATION;
+}
+
+bool SignalFilter::operator==(const SignalFilter &other) const
+{
+    return (_mode == other._mode) && (_parameter == other._parameter);
+}
+
+bool SignalFilter::operator!=(const SignalFilter &other) const
+{
+    return !(*this == other);
+}
+
+/*!
+ * Forget previous samples
+ */
+void SignalFilter::reset()
+{
+    qint32 windowSize = 0;
+    if ((_mode == FILTER_MOVING_AVERAGE) || (_mode == FILTER_MEDIAN))
+    {
+        windowSize = static_cast<qint32>(_parameter);
+    }
+
+    _window.fill(0, windowSize);
+    _windowCount = 0;
+    _windowPos = 0;
+    _windowSum = 0;
+
+    _sortedWindow.clear();
+    _sortedWindow.reserve(windowSize);
+
+    _bOutput = false;
+    _lastKey = 0;
+    _lastOutput = 0;
+
+    _blockCount = 0;
+    _blockSum = 0;
+}
+
+/*!
+ * Filter sample
+ * \param key           Key of sample (ms)
+ * \param value         Converted value of sample
+ * \param pResult       Filtered value
+ * \return false when there is no filtered value for this sample (decimation)
+ */
+bool SignalFilter::process(double key, double value, double * pResult)
+{
+    /* NaN or infinite value (float register) would spoil the state of the filter */
+    if (!qIsFinite(value))
+    {
+        *pResult = value;
+        return !isDecimating();
+    }
+
+    switch (_mode)
+    {
+    case FILTER_MOVING_AVERAGE:
+        *pResult = movingAverage(value);
+        return true;
+
+    case FILTER_MEDIAN:
+        *pResult = median(value);
+        return true;
+
+    case FILTER_EXPONENTIAL:
+    case FILTER_LOW_PASS:
+    {
+        if (!_bOutput)
+        {
+            _lastOutput = value;
+        }
+        else if (_mode == FILTER_EXPONENTIAL)
+        {
+            _lastOutput += _parameter * (value - _lastOutput);
+        }
+        else if (_parameter <= 0)
+        {
+            _lastOutput = value;
+        }
+        else if (key > _lastKey)
+        {
+            /* Discrete first-order low-pass: weight of sample depends on time since previous sample */
+            const double timeDiff = key - _lastKey;
+            _lastOutput += timeDiff / (_parameter * 1000 + timeDiff) * (value - _lastOutput);
+        }
+        else
+        {
+            // Same key: keep previous output
+        }
+
+        _bOutput = true;
+        _lastKey = key;
+
+        *pResult = _lastOutput;
+        return true;
+    }
+
+    case FILTER_DECIMATION:
+        _blockSum += value;
+        _blockCount++;
+
+        if (_blockCount < static_cast<qint32>(_parameter))
+        {
+            return false;
+        }
+
+        *pResult = _blockSum / _blockCount;
+
+        _blockSum = 0;
+        _blockCount = 0;
+
+        return true;
+
+    default:
+        *pResult = value;
+        return true;
+    }
+}
+
+/*!
+ * Description of filter, used in register table and project file
+ * (e.g. "none", "average 10", "exponential 0.2", "lowpass 1.5", "median 5", "decimate 10")
+ */
+QString SignalFilter::toString() const
+{
+    switch (_mode)
+    {
+    case FILTER_MOVING_AVERAGE:
+        return QString("average %1").arg(_parameter);
+    case FILTER_EXPONENTIAL:
+        return QString("exponential %1").arg(_parameter);
+    case FILTER_LOW_PASS:
+        return QString("lowpass %1").arg(_parameter);
+    case FILTER_MEDIAN:
+        return QString("median %1").arg(_parameter);
+    case FILTER_DECIMATION:
+        return QString("decimate %1").arg(_parameter);
+    default:
+        return QString("none");
+    }
+}
+
+/*!
+ * Parse description of filter (see toString)
+ * \param text      Description
+ * \param pFilter   Parsed filter
+ * \return false when description isn't valid
+ */
+bool SignalFilter::fromString(const QString &text, SignalFilter * pFilter)
+{
+    const QStringList parts = text.trimmed().toLower().split(' ', QString::SkipEmptyParts);
+
+    if (parts.isEmpty() || ((parts.size() == 1) && (parts[0] == QString("none"))))
+    {
+        *pFilter = SignalFilter();
+        return true;
+    }
+
+    if (parts.size() != 2)
+    {
+        return false;
+    }
+
+    /* Accept both decimal separators */
+    bool bOk = false;
+    const double parameter = QString(parts[1]).replace(',', '.').toDouble(&bOk);
+
+    if (!bOk)
+    {
+        return false;
+    }
+
+    Mode mode;
+    qint32 maxWindowSize = cMaxWindowSize;
+
+    if (parts[0] == QString("average"))
+    {
+        mode = FILTER_MOVING_AVERAGE;
+    }
+    else if (parts[0] == QString("median"))
+    {
+        mode = FILTER_MEDIAN;
+        maxWindowSize = cMaxMedianSize;
+    }
+    else if (parts[0] == QString("decimate"))
+    {
+        mode = FILTER_DECIMATION;
+    }
+    else if (parts[0] == QString("exponential"))
+    {
+        if ((parameter <= 0) || (parameter > 1))
+        {
+            return false;
+        }
+
+        *pFilter = SignalFilter(FILTER_EXPONENTIAL, parameter);
+        return true;
+    }
+    else if (parts[0] == QString("lowpass"))
+    {
+        if (parameter < 0)
+        {
+            return false;
+        }
+
+        *pFilter = SignalFilter(FILTER_LOW_PASS, parameter);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+
+    /* Number of samples */
+    if ((parameter < 1) || (parameter > maxWindowSize) || (parameter != static_cast<qint32>(parameter)))
+    {
+        return false;
+    }
+
+    *pFilter = SignalFilter(mode, parameter);
+
+    return true;
+}
+
+double SignalFilter::movingAverage(double value)
+{
+    const qint32 windowSize = _window.size();
+
+    if (_windowCount < windowSize)
+    {
+        _window[_windowCount] = value;
+        _windowCount++;
+        _windowSum += value;
+    }
+    else
+    {
+        _windowSum += value - _window[_windowPos];
+        _window[_windowPos] = value;
+        _windowPos = (_windowPos + 1) % windowSize;
+
+        /* Sum is recalculated once per window, so rounding errors don't accumulate */
+        if (_windowPos == 0)
+        {
+            _windowSum = 0;
+            for (qint32 idx = 0; idx < windowSize; idx++)
+            {
+                _windowSum += _window[idx];
+            }
+        }
+    }
+
+    return _windowSum / _windowCount;
+}
+
+double SignalFilter::median(double value)
+{
+    const qint32 windowSize = _window.size();
+
+    if (_windowCount < windowSize)
+    {
+        _window[_windowCount] = value;
+        _windowCount++;
+    }
+    else
+    {
+        /* Oldest sample leaves window */
+        QVector<double>::iterator oldest = std::lower_bound(_sortedWindow.begin(), _sortedWindow.end(), _window[_windowPos]);
+        _sortedWindow.erase(oldest);
+
+        _window[_windowPos] = value;
+        _windowPos = (_windowPos + 1) % windowSize;
+    }
+
+    _sortedWindow.insert(std::lower_bound(_sortedWindow.begin(), _sortedWindow.end(), value), value);
+
+    const qint32 middle = _sortedWindow.size() / 2;
+
+    if (_sortedWindow.size() % 2)
+    {
+        return _sortedWindow[middle];
+    }
+    else
+    {
+        return (_sortedWindow[middle - 1] + _sortedWindow[middle]) / 2;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef SIGNALFILTER_H
+#define SIGNALFILTER_H
+
+#include <QString>
+#include <QVector>
+
+/*!
+ * Filter that smooths the values of a graph while they are logged
+ *
+ *  - Moving average: mean of the last N samples
+ *  - Exponential: exponential moving average with smoothing factor alpha (0 < alpha <= 1)
+ *  - Low-pass: first-order low-pass with time constant (s), follows the real time between samples
+ *  - Median: median of the last N samples, removes spikes
+ *  - Decimation: one sample (mean) per block of N samples
+ *
+ * Every sample is processed in constant time: the window of the moving average keeps a running sum
+ * and the window of the median is kept sorted (window size is limited, see cMaxMedianSize).
+ * Until the window is filled, the available samples are used.
+ */
+class SignalFilter
+{
+public:
+
+    typedef enum
+    {
+        FILTER_NONE = 0,
+        FILTER_MOVING_AVERAGE,
+        FILTER_EXPONENTIAL,
+        FILTER_LOW_PASS,
+        FILTER_MEDIAN,
+        FILTER_DECIMATION
+    } Mode;
+
+    explicit SignalFilter(Mode mode = FILTER_NONE, double parameter = 0);
+
+    Mode mode() const;
+    double parameter() const;
+    bool isEnabled() const;
+    bool isDecimating() const;
+
+    bool operator==(const SignalFilter &other) const;
+    bool operator!=(const SignalFilter &other) const;
+
+    void reset();
+    bool process(double key, double value, double * pResult);
+
+    QString toString() const;
+    static bool fromString(const QString &text, SignalFilter * pFilter);
+
+    static const qint32 cMaxWindowSize = 10000;
+    static const qint32 cMaxMedianSize = 255;
+
+private:
+
+    double movingAverage(double value);
+    double median(double value);
+
+    Mode _mode;
+    double _parameter;
+
+    /* Last samples (moving average and median), _windowPos is the position of the oldest sample */
+    QVector<double> _window;
+    qint32 _windowCount;
+    qint32 _windowPos;
+    double _windowSum;
+
+    /* Values of window in ascending order (median) */
+    QVector<double> _sortedWindow;
+
+    /* Previous output (exponential and low-pass) */
+    bool _bOutput;
+    double _lastKey;
+    double _lastOutput;
+
+    /* Samples of current block (decimation) */
+    qint32 _blockCount;
+    double _blockSum;
+};
+
+#endif // SIGNALFILTER_H
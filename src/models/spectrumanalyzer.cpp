@@ -0,0 +1,318 @@
+#include <QtMath>
+#include <QtNumeric>
+
+#include "sampleseries.h"
+
+#include "spectrumanalyzer.h"
+
+/*!
+ * Constructor
+ * \param windowSize    Number of samples of window (rounded up to power of two)
+ */
+SpectrumAnalyzer::SpectrumAnalyzer(qint32 windowSize)
+{
+    _windowSize = 0;
+    _windowSum = 0;
+    _segmentCount = 0;
+    _frequencyResolution = 0;
+
+    setWindowSize(windowSize);
+}
+
+qint32 SpectrumAnalyzer::windowSize() const
+{
+    return _windowSize;
+}
+
+/*!
+ * Change size of window, all samples and the spectrum are cleared
+ * \param windowSize    Number of samples of window (rounded up to power of two)
+ */
+void SpectrumAnalyzer::setWindowSize(qint32 windowSize)
+{
+    qint32 size = cMinWindowSize;
+    while ((size < windowSize) && (size < cMaxWindowSize))
+    {
+        size <<= 1;
+    }
+
+    if (size != _windowSize)
+    {
+        _windowSize = size;
+        _plan = FftPlan(_windowSize);
+
+        /* Periodic Hann window */
+        _window.resize(_windowSize);
+        _windowSum = 0;
+        for (qint32 idx = 0; idx < _windowSize; idx++)
+        {
+            _window[idx] = 0.5 - 0.5 * qCos(2 * M_PI * idx / _windowSize);
+            _windowSum += _window[idx];
+        }
+
+        _keys.resize(_windowSize);
+        _values.resize(_windowSize);
+
+        _segment.resize(_windowSize);
+        _real.resize(_plan.binCount());
+        _imag.resize(_plan.binCount());
+        _power.resize(_plan.binCount());
+        _amplitudes.resize(_plan.binCount());
+
+        _rangeValues.clear();
+        _rangeValues.reserve(_windowSize);
+    }
+
+    reset();
+}
+
+/*!
+ * Number of samples between spectra of stream
+ */
+qint32 SpectrumAnalyzer::hopSize() const
+{
+    return _windowSize / 4;
+}
+
+/*!
+ * Clear samples of stream and spectrum
+ */
+void SpectrumAnalyzer::reset()
+{
+    _writeIdx = 0;
+    _count = 0;
+    _samplesSinceUpdate = 0;
+
+    _segmentCount = 0;
+    _frequencyResolution = 0;
+    _amplitudes.fill(0);
+}
+
+/*!
+ * Add sample of stream
+ * \param key       Time of sample (ms)
+ * \param value     Value of sample (not finite values are ignored)
+ * \return true when a new spectrum is due (see update)
+ */
+bool SpectrumAnalyzer::add(double key, double value)
+{
+    if (!qIsFinite(value))
+    {
+        return false;
+    }
+
+    _keys[_writeIdx] = key;
+    _values[_writeIdx] = value;
+
+    _writeIdx = (_writeIdx + 1) % _windowSize;
+    if (_count < _windowSize)
+    {
+        _count++;
+    }
+
+    _samplesSinceUpdate++;
+
+    return (_count >= cMinWindowSize) && (_samplesSinceUpdate >= hopSize());
+}
+
+/*!
+ * Number of samples of stream in window
+ */
+qint32 SpectrumAnalyzer::sampleCount() const
+{
+    return _count;
+}
+
+/*!
+ * Calculate spectrum of last window of stream, a window that isn't full yet is zero padded
+ */
+void SpectrumAnalyzer::update()
+{
+    _samplesSinceUpdate = 0;
+    _power.fill(0);
+    _segmentCount = 0;
+
+    if (_count < 2)
+    {
+        return;
+    }
+
+    /* Unroll ring buffer, oldest sample first */
+    const qint32 oldestIdx = _count == _windowSize ? _writeIdx : 0;
+    const qint32 newestIdx = (_writeIdx + _windowSize - 1) % _windowSize;
+
+    _rangeValues.resize(_count);
+    for (qint32 idx = 0; idx < _count; idx++)
+    {
+        _rangeValues[idx] = _values[(oldestIdx + idx) % _windowSize];
+    }
+
+    transformSegment(_rangeValues.constData(), _count);
+
+    finishSpectrum((_keys[newestIdx] - _keys[oldestIdx]) / (_count - 1));
+}
+
+/*!
+ * Calculate average spectrum of samples between two keys (order of keys doesn't matter)
+ * \param series    Samples of graph (invalid and missing samples are skipped)
+ * \param startKey  Key of start of range
+ * \param endKey    Key of end of range
+ * \return Number of averaged windows, 0 when range contains less than 2 samples
+ */
+qint32 SpectrumAnalyzer::analyze(const SampleSeries &series, double startKey, double endKey)
+{
+    if (endKey < startKey)
+    {
+        qSwap(startKey, endKey);
+    }
+
+    const qint32 beginIdx = series.findBegin(startKey, false);
+    const qint32 endIdx = series.findEnd(endKey, false);
+
+    double firstKey = 0;
+    double lastKey = 0;
+
+    _rangeValues.resize(0);
+    for (qint32 idx = beginIdx; idx < endIdx; idx++)
+    {
+        if (!series.isMissing(idx) && series.isValid(idx))
+        {
+            if (_rangeValues.isEmpty())
+            {
+                firstKey = series.key(idx);
+            }
+
+            lastKey = series.key(idx);
+            _rangeValues.append(series.value(idx));
+        }
+    }
+
+    _power.fill(0);
+    _segmentCount = 0;
+
+    const qint32 count = _rangeValues.size();
+    if (count < 2)
+    {
+        _amplitudes.fill(0);
+        _frequencyResolution = 0;
+        return 0;
+    }
+
+    if (count <= _windowSize)
+    {
+        transformSegment(_rangeValues.constData(), count);
+    }
+    else
+    {
+        const qint32 hop = _windowSize / 2;
+        for (qint32 start = 0; start + _windowSize <= count; start += hop)
+        {
+            transformSegment(_rangeValues.constData() + start, _windowSize);
+        }
+    }
+
+    finishSpectrum((lastKey - firstKey) / (count - 1));
+
+    return _segmentCount;
+}
+
+bool SpectrumAnalyzer::hasSpectrum() const
+{
+    return _segmentCount > 0;
+}
+
+/*!
+ * Amplitude of every bin (window size / 2 + 1 bins)
+ * A sine with amplitude A on a bin results in A, a constant value isn't visible because the mean is removed.
+ */
+const QVector<double> &SpectrumAnalyzer::amplitudes() const
+{
+    return _amplitudes;
+}
+
+/*!
+ * Frequency step between bins (Hz)
+ */
+double SpectrumAnalyzer::frequencyResolution() const
+{
+    return _frequencyResolution;
+}
+
+/*!
+ * Number of windows averaged in spectrum
+ */
+qint32 SpectrumAnalyzer::segmentCount() const
+{
+    return _segmentCount;
+}
+
+/*!
+ * Add power spectrum of a segment, the segment is zero padded to the window size
+ * \param pValues   Samples of segment
+ * \param count     Number of samples (at most window size)
+ */
+void SpectrumAnalyzer::transformSegment(const double * pValues, qint32 count)
+{
+    double mean = 0;
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        mean += pValues[idx];
+    }
+    mean /= count;
+
+    double windowSum = 0;
+    if (count == _windowSize)
+    {
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            _segment[idx] = (pValues[idx] - mean) * _window[idx];
+        }
+
+        windowSum = _windowSum;
+    }
+    else
+    {
+        /* Window of length of segment */
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            const double coefficient = 0.5 - 0.5 * qCos(2 * M_PI * idx / count);
+
+            _segment[idx] = (pValues[idx] - mean) * coefficient;
+            windowSum += coefficient;
+        }
+
+        for (qint32 idx = count; idx < _windowSize; idx++)
+        {
+            _segment[idx] = 0;
+        }
+    }
+
+    _plan.transform(_segment.constData(), _real.data(), _imag.data());
+
+    const double scale = 1 / (windowSum * windowSum);
+    for (qint32 idx = 0; idx < _power.size(); idx++)
+    {
+        _power[idx] += (_real[idx] * _real[idx] + _imag[idx] * _imag[idx]) * scale;
+    }
+
+    _segmentCount++;
+}
+
+/*!
+ * Convert average power of segments to amplitude spectrum
+ * \param sampleInterval    Average time between samples (ms)
+ */
+void SpectrumAnalyzer::finishSpectrum(double sampleInterval)
+{
+    const qint32 lastBin = _power.size() - 1;
+
+    for (qint32 idx = 0; idx <= lastBin; idx++)
+    {
+        /* Negative frequencies are folded onto positive bins, except for DC and Nyquist */
+        const double factor = (idx == 0) || (idx == lastBin) ? 1 : 2;
+
+        _amplitudes[idx] = factor * qSqrt(_power[idx] / _segmentCount);
+    }
+
+    _frequencyResolution = sampleInterval > 0 ? 1000 / (_windowSize * sampleInterval) : 0;
+}
@@ -0,0 +1,83 @@
+#ifndef SPECTRUMANALYZER_H
+#define SPECTRUMANALYZER_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "fftplan.h"
+
+//Forward declaration
+class SampleSeries;
+
+/*!
+ * Amplitude spectrum of a value stream or of a range of samples
+ *
+ * Samples are added to a ring buffer of one window (power of two). When the window is full, a new spectrum
+ * is due every hop (a quarter of the window), so consecutive windows overlap and the spectrum follows the
+ * stream without transforming on every sample. A range of samples is analyzed as the average of the spectra
+ * of windows that overlap by half (Welch), a range shorter than the window is zero padded.
+ *
+ * Every window is Hann windowed after the mean is removed. The FFT plan, the window coefficients and all
+ * buffers are only recreated when the window size changes. Samples are assumed to be equidistant, the
+ * frequency resolution is derived from the average sample interval (keys in ms).
+ */
+class SpectrumAnalyzer
+{
+public:
+
+    explicit SpectrumAnalyzer(qint32 windowSize = 1024);
+
+    qint32 windowSize() const;
+    void setWindowSize(qint32 windowSize);
+    qint32 hopSize() const;
+
+    void reset();
+    bool add(double key, double value);
+    qint32 sampleCount() const;
+    void update();
+
+    qint32 analyze(const SampleSeries &series, double startKey, double endKey);
+
+    bool hasSpectrum() const;
+    const QVector<double> &amplitudes() const;
+    double frequencyResolution() const;
+    qint32 segmentCount() const;
+
+    static const qint32 cMinWindowSize = 16;
+    static const qint32 cMaxWindowSize = 1 << 20;
+
+private:
+
+    void transformSegment(const double * pValues, qint32 count);
+    void finishSpectrum(double sampleInterval);
+
+    qint32 _windowSize;
+    FftPlan _plan;
+
+    /* Hann window of full window size */
+    QVector<double> _window;
+    double _windowSum;
+
+    /* Ring buffer of last window, oldest sample at write position when full */
+    QVector<double> _keys;
+    QVector<double> _values;
+    qint32 _writeIdx;
+    qint32 _count;
+    qint32 _samplesSinceUpdate;
+
+    /* Reused buffers of transform */
+    QVector<double> _segment;
+    QVector<double> _real;
+    QVector<double> _imag;
+    QVector<double> _rangeValues;
+
+    /* Sum of squared amplitudes of all segments of spectrum */
+    QVector<double> _power;
+    double _powerWindowSum;
+    qint32 _segmentCount;
+
+    QVector<double> _amplitudes;
+    double _frequencyResolution;
+};
+
+#endif // SPECTRUMANALYZER_H
@@ -0,0 +1,244 @@
+#include <QDateTime>
+
+#include "graphdatamodel.h"
+#include "util.h"
+
+#include "statisticsmodel.h"
+
+StatisticsModel::StatisticsModel(GraphDataModel * pGraphDataModel, QObject *parent) : QAbstractTableModel(parent)
+{
+    _pGraphDataModel = pGraphDataModel;
+    _windowDuration = 10;
+
+    _updateTimer.setSingleShot(true);
+    _updateTimer.setInterval(_cUpdateInterval);
+    connect(&_updateTimer, &QTimer::timeout, this, &StatisticsModel::updateView);
+
+    /* Graph indexes aren't valid anymore */
+    connect(_pGraphDataModel, &GraphDataModel::added, this, &StatisticsModel::clearGraphs);
+    connect(_pGraphDataModel, &GraphDataModel::removed, this, &StatisticsModel::clearGraphs);
+    connect(_pGraphDataModel, &GraphDataModel::activeChanged, this, &StatisticsModel::clearGraphs);
+    connect(_pGraphDataModel, &GraphDataModel::modelReset, this, &StatisticsModel::clearGraphs);
+}
+
+QVariant StatisticsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole)
+    {
+        if (orientation == Qt::Horizontal)
+        {
+            switch (section)
+            {
+            case COLUMN_NAME:
+                return QString("Name");
+            case COLUMN_COUNT:
+                return QString("Count");
+            case COLUMN_LAST:
+                return QString("Last");
+            case COLUMN_MEAN:
+                return QString("Mean");
+            case COLUMN_STD_DEV:
+                return QString("Std dev");
+            case COLUMN_MIN:
+                return QString("Min");
+            case COLUMN_MAX:
+                return QString("Max");
+            case COLUMN_WINDOW_MEAN:
+                return QString("Mean (%1 s)").arg(_windowDuration);
+            case COLUMN_WINDOW_MIN:
+                return QString("Min (%1 s)").arg(_windowDuration);
+            case COLUMN_WINDOW_MAX:
+                return QString("Max (%1 s)").arg(_windowDuration);
+            default:
+                return QVariant();
+            }
+        }
+        else
+        {
+            //Can't happen because it is hidden
+        }
+    }
+
+    return QVariant();
+}
+
+int StatisticsModel::rowCount(const QModelIndex & /*parent*/) const
+{
+    return _graphStatistics.size();
+}
+
+int StatisticsModel::columnCount(const QModelIndex & /*parent*/) const
+{
+    return COLUMN_CNT;
+}
+
+QVariant StatisticsModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    const GraphStatistics &graphStatistics = _graphStatistics[index.row()];
+    const RunningStatistics &statistics = graphStatistics.statistics;
+
+    if (index.column() == COLUMN_NAME)
+    {
+        return _pGraphDataModel->label(graphStatistics.graphIdx);
+    }
+    else if (index.column() == COLUMN_COUNT)
+    {
+        return statistics.count();
+    }
+
+    /* No values (yet) */
+    if (statistics.count() == 0)
+    {
+        return QString();
+    }
+
+    switch (index.column())
+    {
+    case COLUMN_LAST:
+        return Util::formatDoubleForExport(statistics.last());
+    case COLUMN_MEAN:
+        return Util::formatDoubleForExport(statistics.mean());
+    case COLUMN_STD_DEV:
+        return Util::formatDoubleForExport(statistics.standardDeviation());
+    case COLUMN_MIN:
+        return Util::formatDoubleForExport(statistics.min());
+    case COLUMN_MAX:
+        return Util::formatDoubleForExport(statistics.max());
+    case COLUMN_WINDOW_MEAN:
+        return Util::formatDoubleForExport(statistics.windowMean());
+    case COLUMN_WINDOW_MIN:
+        return Util::formatDoubleForExport(statistics.windowMin());
+    case COLUMN_WINDOW_MAX:
+        return Util::formatDoubleForExport(statistics.windowMax());
+    default:
+        return QVariant();
+    }
+}
+
+/*!
+ * Duration of window (s)
+ */
+quint32 StatisticsModel::windowDuration() const
+{
+    return _windowDuration;
+}
+
+quint32 StatisticsModel::graphIndex(qint32 row) const
+{
+    return _graphStatistics[row].graphIdx;
+}
+
+const RunningStatistics &StatisticsModel::statistics(qint32 row) const
+{
+    return _graphStatistics[row].statistics;
+}
+
+/*!
+ * Add a new sample to the statistics
+ * \param timestamp     Time of sample (ms since epoch)
+ * \param successList   Success of each active register
+ * \param values        Value of each active register
+ * \param timestampList Raw timestamp of each active register (empty: all registers are sampled on timestamp)
+ */
+void StatisticsModel::processSample(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList)
+{
+    const qint32 count = qMin(_graphStatistics.size(), qMin(successList.size(), values.size()));
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        if (successList[idx])
+        {
+            const qint64 sampleTime = idx < timestampList.size() ? timestampList[idx] : timestamp;
+
+            _graphStatistics[idx].statistics.add(static_cast<double>(sampleTime), values[idx]);
+        }
+    }
+
+    if ((count > 0) && !_updateTimer.isActive())
+    {
+        _updateTimer.start();
+    }
+}
+
+/*!
+ * Start new statistics for the current active graphs
+ */
+void StatisticsModel::start()
+{
+    beginResetModel();
+
+    _graphStatistics.clear();
+
+    QList<quint16> activeIndexList;
+    _pGraphDataModel->activeGraphIndexList(&activeIndexList);
+
+    for (qint32 idx = 0; idx < activeIndexList.size(); idx++)
+    {
+        GraphStatistics graphStatistics;
+        graphStatistics.graphIdx = activeIndexList[idx];
+        graphStatistics.statistics.setWindowDuration(_windowDuration * 1000);
+
+        _graphStatistics.append(graphStatistics);
+    }
+
+    endResetModel();
+}
+
+/*!
+ * Clear statistics, graphs are kept
+ */
+void StatisticsModel::reset()
+{
+    for (qint32 idx = 0; idx < _graphStatistics.size(); idx++)
+    {
+        _graphStatistics[idx].statistics.reset();
+    }
+
+    updateView();
+}
+
+void StatisticsModel::setWindowDuration(quint32 windowDuration)
+{
+    if (_windowDuration != windowDuration)
+    {
+        _windowDuration = windowDuration;
+
+        for (qint32 idx = 0; idx < _graphStatistics.size(); idx++)
+        {
+            _graphStatistics[idx].statistics.setWindowDuration(_windowDuration * 1000);
+        }
+
+        emit headerDataChanged(Qt::Horizontal, COLUMN_WINDOW_MEAN, COLUMN_WINDOW_MAX);
+        emit windowDurationChanged();
+    }
+}
+
+void StatisticsModel::handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues)
+{
+    Q_UNUSED(rawValues);
+
+    processSample(QDateTime::currentMSecsSinceEpoch(), successList, values, timestampList);
+}
+
+void StatisticsModel::clearGraphs()
+{
+    if (!_graphStatistics.isEmpty())
+    {
+        beginResetModel();
+        _graphStatistics.clear();
+        endResetModel();
+    }
+}
+
+void StatisticsModel::updateView()
+{
+    if (!_graphStatistics.isEmpty())
+    {
+        emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    }
+}
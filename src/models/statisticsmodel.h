@@ -0,0 +1,92 @@
+#ifndef STATISTICSMODEL_H
+#define STATISTICSMODEL_H
+
+#include <QObject>
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QTimer>
+
+#include "runningstatistics.h"
+
+//Forward declaration
+class GraphDataModel;
+
+/*!
+ * Running statistics of the active graphs while logging
+ *
+ * The statistics are fed directly by the communication manager and updated incrementally with every value
+ * (see RunningStatistics), the samples are never scanned again. Views are notified at most once per update
+ * interval, so the cost of the table doesn't depend on the poll rate.
+ */
+class StatisticsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+
+    typedef enum
+    {
+        COLUMN_NAME = 0,
+        COLUMN_COUNT,
+        COLUMN_LAST,
+        COLUMN_MEAN,
+        COLUMN_STD_DEV,
+        COLUMN_MIN,
+        COLUMN_MAX,
+        COLUMN_WINDOW_MEAN,
+        COLUMN_WINDOW_MIN,
+        COLUMN_WINDOW_MAX,
+        COLUMN_CNT
+    } Column;
+
+    explicit StatisticsModel(GraphDataModel * pGraphDataModel, QObject *parent = nullptr);
+
+    // Header:
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+
+    // Basic functionality:
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    quint32 windowDuration() const;
+    quint32 graphIndex(qint32 row) const;
+    const RunningStatistics &statistics(qint32 row) const;
+
+    void processSample(qint64 timestamp, QList<bool> successList, QList<double> values, QList<qint64> timestampList = QList<qint64>());
+
+signals:
+    void windowDurationChanged();
+
+public slots:
+    void start();
+    void reset();
+    void setWindowDuration(quint32 windowDuration);
+    void handleReceivedData(QList<bool> successList, QList<double> values, QList<qint64> timestampList, QList<quint32> rawValues);
+
+private slots:
+    void clearGraphs();
+    void updateView();
+
+private:
+
+    typedef struct
+    {
+        quint32 graphIdx;
+        RunningStatistics statistics;
+    } GraphStatistics;
+
+    GraphDataModel * _pGraphDataModel;
+
+    /* Ordered as active graph list (order of values in sample) */
+    QVector<GraphStatistics> _graphStatistics;
+
+    quint32 _windowDuration; /* in seconds */
+
+    QTimer _updateTimer;
+
+    static const qint32 _cUpdateInterval = 500; /* in ms */
+};
+
+#endif // STATISTICSMODEL_H
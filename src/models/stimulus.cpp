@@ -0,0 +1,375 @@
+#include <QtMath>
+
+#include "stimulus.h"
+
+Stimulus::Stimulus()
+{
+    _type = STEP;
+    _connectionId = 0;
+    _registerAddress = 40001;
+    _startTime = 0;
+    _duration = 0;
+    _interval = 100;
+    _initialValue = 0;
+    _finalValue = 0;
+    _offset = 0;
+    _amplitude = 0;
+    _period = 1000;
+    _tablePoints.clear();
+}
+
+Stimulus::Type Stimulus::type() const
+{
+    return _type;
+}
+
+void Stimulus::setType(Type type)
+{
+    _type = type;
+}
+
+quint8 Stimulus::connectionId() const
+{
+    return _connectionId;
+}
+
+void Stimulus::setConnectionId(quint8 connectionId)
+{
+    _connectionId = connectionId;
+}
+
+quint16 Stimulus::registerAddress() const
+{
+    return _registerAddress;
+}
+
+void Stimulus::setRegisterAddress(quint16 registerAddress)
+{
+    _registerAddress = registerAddress;
+}
+
+qint64 Stimulus::startTime() const
+{
+    return _startTime;
+}
+
+void Stimulus::setStartTime(qint64 startTime)
+{
+    _startTime = qMax(startTime, static_cast<qint64>(0));
+}
+
+qint64 Stimulus::duration() const
+{
+    return _duration;
+}
+
+void Stimulus::setDuration(qint64 duration)
+{
+    _duration = qMax(duration, static_cast<qint64>(0));
+}
+
+quint32 Stimulus::interval() const
+{
+    return _interval;
+}
+
+void Stimulus::setInterval(quint32 interval)
+{
+    _interval = interval;
+}
+
+double Stimulus::initialValue() const
+{
+    return _initialValue;
+}
+
+void Stimulus::setInitialValue(double initialValue)
+{
+    _initialValue = initialValue;
+}
+
+double Stimulus::finalValue() const
+{
+    return _finalValue;
+}
+
+void Stimulus::setFinalValue(double finalValue)
+{
+    _finalValue = finalValue;
+}
+
+double Stimulus::offset() const
+{
+    return _offset;
+}
+
+void Stimulus::setOffset(double offset)
+{
+    _offset = offset;
+}
+
+double Stimulus::amplitude() const
+{
+    return _amplitude;
+}
+
+void Stimulus::setAmplitude(double amplitude)
+{
+    _amplitude = amplitude;
+}
+
+qint64 Stimulus::period() const
+{
+    return _period;
+}
+
+void Stimulus::setPeriod(qint64 period)
+{
+    _period = period;
+}
+
+QMap<qint64, double> Stimulus::tablePoints() const
+{
+    return _tablePoints;
+}
+
+void Stimulus::setTablePoints(const QMap<qint64, double> &tablePoints)
+{
+    _tablePoints = tablePoints;
+}
+
+void Stimulus::addTablePoint(qint64 time, double value)
+{
+    _tablePoints.insert(time, value);
+}
+
+bool Stimulus::isValid() const
+{
+    bool bValid;
+
+    switch (_type)
+    {
+    case STEP:
+        bValid = true;
+        break;
+    case RAMP:
+        bValid = (_interval > 0);
+        break;
+    case SINE:
+        bValid = (_interval > 0) && (_period > 0);
+        break;
+    case TABLE:
+        bValid = !_tablePoints.isEmpty();
+        break;
+    default:
+        bValid = false;
+        break;
+    }
+
+    return bValid;
+}
+
+/*!
+ * Get time of first write at or after time
+ * \param time      Time in ms since start of logging
+ * \return Time of next write, -1 when stimulus is finished
+ */
+qint64 Stimulus::nextWriteTime(qint64 time) const
+{
+    qint64 nextTime = -1;
+
+    if (!isValid())
+    {
+        return -1;
+    }
+
+    switch (_type)
+    {
+    case STEP:
+        if ((time <= 0) && (_startTime > 0))
+        {
+            nextTime = 0;
+        }
+        else if (time <= _startTime)
+        {
+            nextTime = _startTime;
+        }
+        break;
+
+    case RAMP:
+        if ((time <= 0) && (_startTime > 0))
+        {
+            nextTime = 0;
+        }
+        else
+        {
+            nextTime = nextIntervalTime(time);
+        }
+        break;
+
+    case SINE:
+        nextTime = nextIntervalTime(time);
+        break;
+
+    case TABLE:
+    {
+        auto it = _tablePoints.lowerBound(time);
+        if (it != _tablePoints.constEnd())
+        {
+            nextTime = it.key();
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return nextTime;
+}
+
+/*!
+ * Get waveform value on specific time
+ * \param time      Time in ms since start of logging
+ */
+double Stimulus::valueAt(qint64 time) const
+{
+    double value = 0;
+    const qint64 endTime = _startTime + _duration;
+
+    switch (_type)
+    {
+    case STEP:
+        value = time < _startTime ? _initialValue : _finalValue;
+        break;
+
+    case RAMP:
+        if (time < _startTime)
+        {
+            value = _initialValue;
+        }
+        else if ((_duration == 0) || (time >= endTime))
+        {
+            value = _finalValue;
+        }
+        else
+        {
+            value = _initialValue + (_finalValue - _initialValue) * (time - _startTime) / _duration;
+        }
+        break;
+
+    case SINE:
+        if (
+            (time < _startTime)
+            || ((_duration > 0) && (time >= endTime))
+            || (_period <= 0)
+        )
+        {
+            value = _offset;
+        }
+        else
+        {
+            value = _offset + _amplitude * qSin(2 * M_PI * (time - _startTime) / _period);
+        }
+        break;
+
+    case TABLE:
+        if (!_tablePoints.isEmpty())
+        {
+            /* Hold last point at or before time */
+            auto it = _tablePoints.upperBound(time);
+            if (it != _tablePoints.constBegin())
+            {
+                --it;
+            }
+            value = it.value();
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return value;
+}
+
+/*!
+ * Get waveform value as register value (rounded, negative values as 16 bit two's complement)
+ * \param time      Time in ms since start of logging
+ */
+quint16 Stimulus::registerValue(qint64 time) const
+{
+    const qint32 value = qBound(-32768, qRound(valueAt(time)), 65535);
+
+    return static_cast<quint16>(value);
+}
+
+QString Stimulus::typeToString(Type type)
+{
+    switch (type)
+    {
+    case STEP:
+        return QString("step");
+    case RAMP:
+        return QString("ramp");
+    case SINE:
+        return QString("sine");
+    case TABLE:
+        return QString("table");
+    default:
+        return QString();
+    }
+}
+
+bool Stimulus::stringToType(QString typeString, Type * pType)
+{
+    for (qint32 idx = STEP; idx <= TABLE; idx++)
+    {
+        if (typeString.toLower() == typeToString(static_cast<Type>(idx)))
+        {
+            *pType = static_cast<Type>(idx);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * Next write time of periodic stimulus (ramp and sine), end of duration is always included
+ */
+qint64 Stimulus::nextIntervalTime(qint64 time) const
+{
+    qint64 nextTime;
+
+    if (time <= _startTime)
+    {
+        nextTime = _startTime;
+    }
+    else
+    {
+        const qint64 intervalCount = (time - _startTime + _interval - 1) / _interval;
+        nextTime = _startTime + intervalCount * _interval;
+    }
+
+    if (_duration > 0)
+    {
+        const qint64 endTime = _startTime + _duration;
+
+        if (time > endTime)
+        {
+            nextTime = -1;
+        }
+        else if (nextTime > endTime)
+        {
+            nextTime = endTime;
+        }
+    }
+    else if (_type == RAMP)
+    {
+        /* Ramp without duration is a step */
+        nextTime = time <= _startTime ? _startTime : -1;
+    }
+
+    return nextTime;
+}
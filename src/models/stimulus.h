@@ -0,0 +1,85 @@
+#ifndef STIMULUS_H
+#define STIMULUS_H
+
+#include <QMap>
+#include <QString>
+
+/*!
+ * Register write stimulus: a waveform that is written to a holding register during logging
+ *
+ * All times are in ms relative to the start of logging.
+ *  - step:  initial value at start of logging, final value at start time
+ *  - ramp:  initial value until start time, then linear to final value over duration
+ *  - sine:  offset + amplitude * sin(2pi * t / period) from start time during duration (0 = until stopped)
+ *  - table: values at explicit points in time
+ * Ramp and sine are written every interval.
+ */
+class Stimulus
+{
+public:
+
+    typedef enum
+    {
+        STEP = 0,
+        RAMP,
+        SINE,
+        TABLE
+    } Type;
+
+    Stimulus();
+
+    Type type() const;
+    quint8 connectionId() const;
+    quint16 registerAddress() const;
+    qint64 startTime() const;
+    qint64 duration() const;
+    quint32 interval() const;
+    double initialValue() const;
+    double finalValue() const;
+    double offset() const;
+    double amplitude() const;
+    qint64 period() const;
+    QMap<qint64, double> tablePoints() const;
+
+    void setType(Type type);
+    void setConnectionId(quint8 connectionId);
+    void setRegisterAddress(quint16 registerAddress);
+    void setStartTime(qint64 startTime);
+    void setDuration(qint64 duration);
+    void setInterval(quint32 interval);
+    void setInitialValue(double initialValue);
+    void setFinalValue(double finalValue);
+    void setOffset(double offset);
+    void setAmplitude(double amplitude);
+    void setPeriod(qint64 period);
+    void setTablePoints(const QMap<qint64, double> &tablePoints);
+    void addTablePoint(qint64 time, double value);
+
+    bool isValid() const;
+
+    qint64 nextWriteTime(qint64 time) const;
+    double valueAt(qint64 time) const;
+    quint16 registerValue(qint64 time) const;
+
+    static QString typeToString(Type type);
+    static bool stringToType(QString typeString, Type * pType);
+
+private:
+
+    qint64 nextIntervalTime(qint64 time) const;
+
+    Type _type;
+    quint8 _connectionId;
+    quint16 _registerAddress;
+    qint64 _startTime;
+    qint64 _duration;
+    quint32 _interval;
+    double _initialValue;
+    double _finalValue;
+    double _offset;
+    double _amplitude;
+    qint64 _period;
+    QMap<qint64, double> _tablePoints;
+};
+
+#endif // STIMULUS_H
@@ -0,0 +1,35 @@
+#include "stimulusmodel.h"
+
+StimulusModel::StimulusModel(QObject *parent) : QObject(parent)
+{
+    _stimulusList.clear();
+}
+
+qint32 StimulusModel::size() const
+{
+    return _stimulusList.size();
+}
+
+void StimulusModel::add(const Stimulus &stimulus)
+{
+    _stimulusList.append(stimulus);
+
+    emit added(static_cast<quint32>(_stimulusList.size() - 1));
+}
+
+void StimulusModel::clear()
+{
+    _stimulusList.clear();
+
+    emit cleared();
+}
+
+Stimulus StimulusModel::stimulus(qint32 idx) const
+{
+    return _stimulusList.value(idx);
+}
+
+QList<Stimulus> StimulusModel::stimulusList() const
+{
+    return _stimulusList;
+}
@@ -0,0 +1,32 @@
+#ifndef STIMULUSMODEL_H
+#define STIMULUSMODEL_H
+
+#include <QObject>
+#include <QList>
+
+#include "stimulus.h"
+
+class StimulusModel : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StimulusModel(QObject *parent = nullptr);
+
+    qint32 size() const;
+    void add(const Stimulus &stimulus);
+    void clear();
+
+    Stimulus stimulus(qint32 idx) const;
+    QList<Stimulus> stimulusList() const;
+
+signals:
+    void added(const quint32 idx);
+    void cleared();
+
+private:
+
+    QList<Stimulus> _stimulusList;
+
+};
+
+#endif // STIMULUSMODEL_H
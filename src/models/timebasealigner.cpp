@@ -0,0 +1,154 @@
+
+#include "graphdatamodel.h"
+#include "guimodel.h"
+
+#include "timebasealigner.h"
+
+TimebaseAligner::TimebaseAligner(GraphDataModel * pGraphDataModel, GuiModel * pGuiModel)
+{
+    _pGraphDataModel = pGraphDataModel;
+    _pGuiModel = pGuiModel;
+}
+
+/*!
+ * Return samples of reference graph (first active graph), the keys of this graph form the common timebase
+ * \return samples of reference graph, empty series when no graph is active
+ */
+SampleSeries TimebaseAligner::referenceSeries()
+{
+    return _pGraphDataModel->referenceSeries();
+}
+
+/*!
+ * Return value of graph aligned to key
+ * Samples of a graph with swinging door filter are always interpolated linear.
+ * \param graphIdx      Graph index
+ * \param key           Key on common timebase
+ * \param pbNewSample   Set to true when graph has a sample after previous key (optional)
+ */
+double TimebaseAligner::value(quint32 graphIdx, double key, bool * pbNewSample)
+{
+    const qint32 previousCursor = _cursors.value(graphIdx, -1);
+    qint32 cursor = previousCursor;
+
+    const bool bLinear = _pGuiModel->linearInterpolation() || _pGraphDataModel->ingestFilter(graphIdx).isLinear();
+    const double alignedValue = TimebaseAligner::alignedValue(_pGraphDataModel->series(graphIdx), key, bLinear, &cursor);
+
+    _cursors.insert(graphIdx, cursor);
+
+    if (pbNewSample != nullptr)
+    {
+        *pbNewSample = (previousCursor < 0) || (cursor != previousCursor);
+    }
+
+    return alignedValue;
+}
+
+/*!
+ * Get aligned values of all active graphs for key
+ * \param key           Key on common timebase
+ * \param pValueList    Aligned values (in order of active graphs)
+ * \return true when a graph has a sample after previous key, row without new samples can be left out
+ *         when it is written to a data file (graphs with ingest filter)
+ */
+bool TimebaseAligner::alignedRow(double key, QList<double> * pValueList)
+{
+    bool bNewSamples = false;
+
+    pValueList->clear();
+
+    for (qint32 activeIdx = 0; activeIdx < _pGraphDataModel->activeCount(); activeIdx++)
+    {
+        bool bNewSample;
+
+        pValueList->append(value(static_cast<quint32>(_pGraphDataModel->convertToGraphIndex(activeIdx)), key, &bNewSample));
+
+        bNewSamples = bNewSamples || bNewSample;
+    }
+
+    return bNewSamples;
+}
+
+/*!
+ * Forget cursor positions (required when data of graphs is replaced)
+ */
+void TimebaseAligner::resetCursors()
+{
+    _cursors.clear();
+}
+
+/*!
+ * Resample data of a graph on key
+ * Before the first sample, the first sample is used.
+ * After the last sample, the last sample is held.
+ * \param series    Raw samples of graph
+ * \param key       Key to align to
+ * \param bLinear   Interpolate linear between surrounding samples, otherwise hold previous sample
+ * \param pCursor   Index of last sample at or before previous key (-1 when unknown), updated with index for this key
+ * \return Aligned value (0 when graph has no samples)
+ */
+double TimebaseAligner::alignedValue(const SampleSeries &series, double key, bool bLinear, qint32 * pCursor)
+{
+    const qint32 size = series.size();
+
+    if (size == 0)
+    {
+        if (pCursor != nullptr)
+        {
+            *pCursor = -1;
+        }
+        return 0;
+    }
+
+    /* Find last sample at or before key */
+    qint32 idx;
+    if (
+        (pCursor != nullptr)
+        && (*pCursor >= 0)
+        && (*pCursor < size)
+        && (series.key(*pCursor) <= key)
+    )
+    {
+        /* Walk forward from cursor */
+        idx = *pCursor;
+        while ((idx + 1 < size) && (series.key(idx + 1) <= key))
+        {
+            idx++;
+        }
+    }
+    else
+    {
+        idx = series.findEnd(key, false) - 1;
+    }
+
+    if (pCursor != nullptr)
+    {
+        *pCursor = idx;
+    }
+
+    double value;
+    if (idx < 0)
+    {
+        value = series.value(0);
+    }
+    else
+    {
+        value = series.value(idx);
+
+        if (
+            bLinear
+            && (idx + 1 < size)
+            && (series.key(idx) < key)
+        )
+        {
+            const double keyDiff = series.key(idx + 1) - series.key(idx);
+
+            if (keyDiff > 0)
+            {
+                value = value + (series.value(idx + 1) - value) * (key - series.key(idx)) / keyDiff;
+            }
+        }
+    }
+
+    return value;
+}
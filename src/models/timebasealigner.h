@@ -0,0 +1,46 @@
+#ifndef TIMEBASEALIGNER_H
+#define TIMEBASEALIGNER_H
+
+#include <QList>
+#include <QHash>
+
+#include "sampleseries.h"
+
+//Forward declaration
+class GraphDataModel;
+class GuiModel;
+
+/*!
+ * Aligns the samples of all graphs to a common timebase
+ *
+ * Every graph keeps the raw timestamps of its own connection. The timebase
+ * is formed by the keys of the first active graph (reference graph). Values of
+ * the other graphs are resampled on demand, either by holding the last sample
+ * (zero-order hold) or by linear interpolation between the surrounding samples.
+ *
+ * No data is copied: values are looked up directly in the sample store of
+ * the graphs. A cursor per graph remembers the last position, so walking the
+ * timebase in increasing order (export, live logging) doesn't require a search.
+ */
+class TimebaseAligner
+{
+public:
+    explicit TimebaseAligner(GraphDataModel * pGraphDataModel, GuiModel * pGuiModel);
+
+    SampleSeries referenceSeries();
+
+    double value(quint32 graphIdx, double key, bool * pbNewSample = nullptr);
+    bool alignedRow(double key, QList<double> * pValueList);
+    void resetCursors();
+
+    static double alignedValue(const SampleSeries &series, double key, bool bLinear, qint32 * pCursor = nullptr);
+
+private:
+
+    GraphDataModel * _pGraphDataModel;
+    GuiModel * _pGuiModel;
+
+    QHash<quint32, qint32> _cursors;
+};
+
+#endif // TIMEBASEALIGNER_H
@@ -0,0 +1,195 @@
+#include <QtMath>
+
+#include "triggercondition.h"
+
+TriggerCondition::TriggerCondition()
+{
+    _type = RISING_EDGE;
+    _connectionId = 0;
+    _registerAddress = 40001;
+    _level = 0;
+    _bit = 0;
+}
+
+TriggerCondition::Type TriggerCondition::type() const
+{
+    return _type;
+}
+
+quint8 TriggerCondition::connectionId() const
+{
+    return _connectionId;
+}
+
+quint16 TriggerCondition::registerAddress() const
+{
+    return _registerAddress;
+}
+
+double TriggerCondition::level() const
+{
+    return _level;
+}
+
+quint8 TriggerCondition::bit() const
+{
+    return _bit;
+}
+
+void TriggerCondition::setType(Type type)
+{
+    _type = type;
+}
+
+void TriggerCondition::setConnectionId(quint8 connectionId)
+{
+    _connectionId = connectionId;
+}
+
+void TriggerCondition::setRegisterAddress(quint16 registerAddress)
+{
+    _registerAddress = registerAddress;
+}
+
+void TriggerCondition::setLevel(double level)
+{
+    _level = level;
+}
+
+void TriggerCondition::setBit(quint8 bit)
+{
+    _bit = qMin(bit, static_cast<quint8>(cMaxBit));
+}
+
+/*!
+ * Check trigger condition on new value
+ * \param previousValue     Previous value of register (equal to value for first sample)
+ * \param value             New value of register
+ * \param rawValue          New raw register value (before conversion, used for bit)
+ */
+bool TriggerCondition::isMet(double previousValue, double value, quint32 rawValue) const
+{
+    bool bMet;
+
+    switch (_type)
+    {
+    case ABOVE:
+    case BELOW:
+        bMet = isLevelMet(_type, _level, value);
+        break;
+
+    case RISING_EDGE:
+        bMet = (previousValue < _level) && (value >= _level);
+        break;
+
+    case FALLING_EDGE:
+        bMet = (previousValue > _level) && (value <= _level);
+        break;
+
+    case BIT_SET:
+        bMet = isBitSet(rawValue, _bit);
+        break;
+
+    default:
+        bMet = false;
+        break;
+    }
+
+    return bMet;
+}
+
+QString TriggerCondition::description() const
+{
+    QString condition;
+
+    if (_type == BIT_SET)
+    {
+        condition = QString("bit %1 set").arg(_bit);
+    }
+    else
+    {
+        condition = QString("%1 %2").arg(typeToString(_type)).arg(_level);
+    }
+
+    return QString("%1 (Conn %2) %3").arg(_registerAddress).arg(_connectionId).arg(condition);
+}
+
+bool TriggerCondition::operator==(const TriggerCondition &other) const
+{
+    return (_type == other._type)
+            && (_connectionId == other._connectionId)
+            && (_registerAddress == other._registerAddress)
+            && qFuzzyCompare(_level + 1, other._level + 1)
+            && (_bit == other._bit);
+}
+
+bool TriggerCondition::operator!=(const TriggerCondition &other) const
+{
+    return !(*this == other);
+}
+
+/*!
+ * Check level sensitive condition
+ * \param type      ABOVE or BELOW (other types are never met)
+ * \param level     Level of condition
+ * \param value     Value to check
+ */
+bool TriggerCondition::isLevelMet(Type type, double level, double value)
+{
+    if (type == ABOVE)
+    {
+        return value > level;
+    }
+    else if (type == BELOW)
+    {
+        return value < level;
+    }
+    else
+    {
+        // Not level sensitive
+        return false;
+    }
+}
+
+/*!
+ * Check bit of raw register value, the bits of a converted value (multiply, divide, offset) are meaningless
+ * \param rawValue  Raw register value (packed for register pairs)
+ * \param bit       Bit number (0 - 31)
+ */
+bool TriggerCondition::isBitSet(quint32 rawValue, quint8 bit)
+{
+    return (bit <= cMaxBit) && ((rawValue >> bit) & 1u);
+}
+
+QString TriggerCondition::typeToString(Type type)
+{
+    switch (type)
+    {
+    case ABOVE:
+        return QString("above");
+    case BELOW:
+        return QString("below");
+    case RISING_EDGE:
+        return QString("rising");
+    case FALLING_EDGE:
+        return QString("falling");
+    case BIT_SET:
+        return QString("bit");
+    default:
+        return QString();
+    }
+}
+
+bool TriggerCondition::stringToType(QString typeString, Type * pType)
+{
+    for (qint32 idx = ABOVE; idx <= BIT_SET; idx++)
+    {
+        if (typeString.toLower() == typeToString(static_cast<Type>(idx)))
+        {
+            *pType = static_cast<Type>(idx);
+            return true;
+        }
+    }
+
+    return false;
+}
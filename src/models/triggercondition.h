@@ -0,0 +1,66 @@
+#ifndef TRIGGERCONDITION_H
+#define TRIGGERCONDITION_H
+
+#include <QString>
+
+/*!
+ * Trigger condition on the value of a register, used by triggered capture
+ *
+ *  - above/below: level sensitive, met as long as value is above/below level
+ *  - rising/falling: edge sensitive, met when value crosses level
+ *  - bit: level sensitive, met as long as bit is set in raw register value
+ *
+ * The level and bit checks are shared with the alarm rules (see AlarmRule).
+ */
+class TriggerCondition
+{
+public:
+
+    typedef enum
+    {
+        ABOVE = 0,
+        BELOW,
+        RISING_EDGE,
+        FALLING_EDGE,
+        BIT_SET
+    } Type;
+
+    TriggerCondition();
+
+    Type type() const;
+    quint8 connectionId() const;
+    quint16 registerAddress() const;
+    double level() const;
+    quint8 bit() const;
+
+    void setType(Type type);
+    void setConnectionId(quint8 connectionId);
+    void setRegisterAddress(quint16 registerAddress);
+    void setLevel(double level);
+    void setBit(quint8 bit);
+
+    bool isMet(double previousValue, double value, quint32 rawValue) const;
+
+    QString description() const;
+
+    bool operator==(const TriggerCondition &other) const;
+    bool operator!=(const TriggerCondition &other) const;
+
+    static bool isLevelMet(Type type, double level, double value);
+    static bool isBitSet(quint32 rawValue, quint8 bit);
+
+    static QString typeToString(Type type);
+    static bool stringToType(QString typeString, Type * pType);
+
+    static const quint8 cMaxBit = 31;
+
+private:
+
+    Type _type;
+    quint8 _connectionId;
+    quint16 _registerAddress;
+    double _level;
+    quint8 _bit;
+};
+
+#endif // TRIGGERCONDITION_H
@@ -3,6 +3,7 @@
 #include <QMap>
 
 #include "modbusmaster.h"
+#include "polltracemodel.h"
 #include "testslavedata.h"
 #include "testslavemodbus.h"
 
@@ -132,6 +133,54 @@ void TestCommunicationManager::singleSlaveCheckProcessing()
     verifyReceivedDataSignal(arguments, resultList, valueList);
 }
 
+void TestCommunicationManager::singleSlaveRegisterPair()
+{
+    /* 32 bit signed: -2 (0xFFFFFFFE) high word first */
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterState(0, true);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterValue(0, 0xFFFF);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterState(1, true);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterValue(1, 0xFFFE);
+
+    /* float32: 1.5 (0x3FC00000) low word first */
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterState(2, true);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterValue(2, 0x0000);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterState(3, true);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterValue(3, 0x3FC0);
+
+    /* Only 1 register per read: pairs should still be read in one request */
+    _pSettingsModel->setConsecutiveMax(SettingsModel::CONNECTION_ID_0, 1);
+
+    GraphDataModel graphDataModel(_pSettingsModel);
+    graphDataModel.add();
+    graphDataModel.setRegisterAddress(0, 40001);
+    graphDataModel.setUnsigned(0, false);
+    graphDataModel.setValueType(0, GraphData::VALUE_32BIT);
+
+    graphDataModel.add();
+    graphDataModel.setRegisterAddress(1, 40003);
+    graphDataModel.setValueType(1, GraphData::VALUE_FLOAT32);
+    graphDataModel.setLowWordFirst(1, true);
+    graphDataModel.setMultiplyFactor(1, 2);
+
+    CommunicationManager conMan(_pSettingsModel, _pGuiModel, &graphDataModel, _pErrorLogModel);
+
+    QSignalSpy spyReceivedData(&conMan, &CommunicationManager::handleReceivedData);
+
+    /*-- Start communication --*/
+    QVERIFY(conMan.startCommunication());
+
+    QVERIFY(spyReceivedData.wait(20));
+    QCOMPARE(spyReceivedData.count(), 1);
+
+    QList<QVariant> arguments = spyReceivedData.takeFirst(); // take the first signal
+
+    QList<bool> resultList({true, true});
+    QList<double> valueList({-2, 3});
+
+    /* Verify arguments of signal */
+    verifyReceivedDataSignal(arguments, resultList, valueList);
+}
+
 void TestCommunicationManager::singleSlaveFail()
 {
     for (quint8 idx = 0; idx < SettingsModel::CONNECTION_ID_CNT; idx++)
@@ -280,6 +329,68 @@ void TestCommunicationManager::multiSlaveSuccess_3()
     verifyReceivedDataSignal(arguments, resultList, valueList);
 }
 
+void TestCommunicationManager::multiSlaveSameEndpoint()
+{
+    /* Second connection points to the same slave as the first one */
+    _pSettingsModel->setPort(SettingsModel::CONNECTION_ID_1, _pSettingsModel->port(SettingsModel::CONNECTION_ID_0));
+    _pSettingsModel->setSlaveId(SettingsModel::CONNECTION_ID_1, _pSettingsModel->slaveId(SettingsModel::CONNECTION_ID_0));
+
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterState(0, true);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterValue(0, 5020);
+
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterState(1, true);
+    _testSlaveDataList[SettingsModel::CONNECTION_ID_0]->setRegisterValue(1, 5021);
+
+    GraphDataModel graphDataModel(_pSettingsModel);
+    graphDataModel.add();
+    graphDataModel.setConnectionId(0, SettingsModel::CONNECTION_ID_0);
+    graphDataModel.setRegisterAddress(0, 40001);
+
+    graphDataModel.add();
+    graphDataModel.setConnectionId(1, SettingsModel::CONNECTION_ID_1);
+    graphDataModel.setRegisterAddress(1, 40001);
+
+    graphDataModel.add();
+    graphDataModel.setConnectionId(2, SettingsModel::CONNECTION_ID_1);
+    graphDataModel.setRegisterAddress(2, 40002);
+
+    CommunicationManager conMan(_pSettingsModel, _pGuiModel, &graphDataModel, _pErrorLogModel);
+
+    QSignalSpy spyReceivedData(&conMan, &CommunicationManager::handleReceivedData);
+    PollTraceModel pollTraceModel;
+    connect(&conMan, &CommunicationManager::traceEvent, &pollTraceModel, &PollTraceModel::addEvent);
+
+    /*-- Start communication --*/
+    QVERIFY(conMan.startCommunication());
+
+    QVERIFY(spyReceivedData.wait(20));
+    QCOMPARE(spyReceivedData.count(), 1);
+
+    QList<QVariant> arguments = spyReceivedData.takeFirst(); // take the first signal
+
+    QList<bool> resultList({true, true, true});
+    QList<double> valueList({5020, 5020, 5021});
+
+    /* Verify arguments of signal */
+    verifyReceivedDataSignal(arguments, resultList, valueList);
+
+    /* Only one merged read on first connection */
+    QCOMPARE(pollTraceModel.cycleCount(SettingsModel::CONNECTION_ID_1), 0);
+    QCOMPARE(pollTraceModel.cycleCount(SettingsModel::CONNECTION_ID_0), 1);
+
+    quint32 readCount = 0;
+    PollTraceModel::Cycle cycle = pollTraceModel.cycle(SettingsModel::CONNECTION_ID_0, 0);
+    for (qint32 idx = 0; idx < cycle.size(); idx++)
+    {
+        if (cycle[idx].type == PollTraceModel::READ_SEND)
+        {
+            QCOMPARE(cycle[idx].address, static_cast<quint16>(40001));
+            QCOMPARE(cycle[idx].count, static_cast<quint16>(2));
+            readCount++;
+        }
+    }
+    QCOMPARE(readCount, 1u);
+}
 
 void TestCommunicationManager::multiSlaveSingleFail()
 {
@@ -21,10 +21,12 @@ private slots:
     void singleSlaveSuccess();
     void singleSlaveFail();
     void singleSlaveCheckProcessing();
+    void singleSlaveRegisterPair();
 
     void multiSlaveSuccess();
     void multiSlaveSuccess_2();
     void multiSlaveSuccess_3();
+    void multiSlaveSameEndpoint();
     void multiSlaveSingleFail();
     void multiSlaveAllFail();
 
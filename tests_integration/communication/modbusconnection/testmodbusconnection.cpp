@@ -4,6 +4,7 @@
 #include "modbusconnection.h"
 #include "testslavedata.h"
 #include "testslavemodbus.h"
+#include "testslaveudp.h"
 
 #include "testmodbusconnection.h"
 
@@ -23,9 +24,14 @@ void TestModbusConnection::init()
     {
         delete _pTestSlaveModbus;
     }
+    if (!_pTestSlaveUdp.isNull())
+    {
+        delete _pTestSlaveUdp;
+    }
 
     _pTestSlaveData = new TestSlaveData();
     _pTestSlaveModbus= new TestSlaveModbus(_pTestSlaveData);
+    _pTestSlaveUdp = new TestSlaveUdp(_pTestSlaveData);
 
     /* Server not started */
 }
@@ -33,9 +39,11 @@ void TestModbusConnection::init()
 void TestModbusConnection::cleanup()
 {
     _pTestSlaveModbus->disconnectDevice();
+    _pTestSlaveUdp->disconnectDevice();
 
     delete _pTestSlaveData;
     delete _pTestSlaveModbus;
+    delete _pTestSlaveUdp;
 }
 
 void TestModbusConnection::connectionSuccess()
@@ -209,4 +217,179 @@ void TestModbusConnection::readRequestError()
     */
 }
 
+void TestModbusConnection::readRequestSuccessUdp()
+{
+    /* Start server */
+    QVERIFY(_pTestSlaveUdp->connect(_serverConnectionData, _slaveId));
+
+    _pTestSlaveData->setRegisterState(0, true);
+    _pTestSlaveData->setRegisterState(1, true);
+
+    _pTestSlaveData->setRegisterValue(0, 0);
+    _pTestSlaveData->setRegisterValue(1, 1);
+
+    /* Open connection */
+    ModbusConnection * pConnection = new ModbusConnection(this);
+    QSignalSpy spySuccess(pConnection, &ModbusConnection::connectionSuccess);
+    pConnection->openConnection(_serverConnectionData.host(), _serverConnectionData.port(), 1000, true);
+
+    QVERIFY(spySuccess.wait(100));
+
+    QCOMPARE(pConnection->connectionState(), QModbusDevice::ConnectedState);
+
+    QSignalSpy spyResultSuccess(pConnection, &ModbusConnection::readRequestSuccess);
+    QSignalSpy spyResultProtocolError(pConnection, &ModbusConnection::readRequestProtocolError);
+    QSignalSpy spyResultError(pConnection, &ModbusConnection::readRequestError);
+
+    pConnection->sendReadRequest(40001, 2, _slaveId);
+
+    QVERIFY(spyResultSuccess.wait(100));
+    QCOMPARE(spyResultSuccess.count(), 1);
+    QCOMPARE(spyResultProtocolError.count(), 0);
+    QCOMPARE(spyResultError.count(), 0);
+
+    QList<QVariant> arguments = spyResultSuccess.takeFirst(); // take the first signal
+    QCOMPARE(arguments.count(), 2);
+
+    /* Check start address */
+    QCOMPARE(arguments.first().toInt(), 40001);
+
+    /* Check result */
+    QVERIFY((arguments[1].canConvert<QList<quint16> >()));
+    QList<quint16> resultList = arguments[1].value<QList<quint16> >();
+    QCOMPARE(resultList.count(), 2);
+    QCOMPARE(resultList[0], static_cast<quint16>(0));
+    QCOMPARE(resultList[1], static_cast<quint16>(1));
+
+    pConnection->closeConnection();
+}
+
+void TestModbusConnection::readRequestProtocolErrorUdp()
+{
+    /* Start server */
+    QVERIFY(_pTestSlaveUdp->connect(_serverConnectionData, _slaveId));
+
+    _pTestSlaveData->setRegisterState(0, false);
+    _pTestSlaveData->setRegisterState(1, true);
+
+    /* Open connection */
+    ModbusConnection * pConnection = new ModbusConnection(this);
+    QSignalSpy spySuccess(pConnection, &ModbusConnection::connectionSuccess);
+    pConnection->openConnection(_serverConnectionData.host(), _serverConnectionData.port(), 1000, true);
+
+    QVERIFY(spySuccess.wait(100));
+
+    QSignalSpy spyResultSuccess(pConnection, &ModbusConnection::readRequestSuccess);
+    QSignalSpy spyResultProtocolError(pConnection, &ModbusConnection::readRequestProtocolError);
+    QSignalSpy spyResultError(pConnection, &ModbusConnection::readRequestError);
+
+    pConnection->sendReadRequest(40001, 2, _slaveId);
+
+    QVERIFY(spyResultProtocolError.wait(100));
+    QCOMPARE(spyResultSuccess.count(), 0);
+    QCOMPARE(spyResultProtocolError.count(), 1);
+    QCOMPARE(spyResultError.count(), 0);
+
+    QList<QVariant> arguments = spyResultProtocolError.takeFirst();
+    QCOMPARE(static_cast<QModbusPdu::ExceptionCode>(arguments.first().toInt()), QModbusPdu::IllegalDataAddress);
+
+    pConnection->closeConnection();
+}
+
+void TestModbusConnection::readRequestRetransmitUdp()
+{
+    /* Start server */
+    QVERIFY(_pTestSlaveUdp->connect(_serverConnectionData, _slaveId));
+
+    _pTestSlaveData->setRegisterState(0, true);
+    _pTestSlaveData->setRegisterValue(0, 5);
+
+    /* Lose first datagram */
+    _pTestSlaveUdp->setDropCount(1);
+
+    ModbusConnection * pConnection = new ModbusConnection(this);
+    QSignalSpy spySuccess(pConnection, &ModbusConnection::connectionSuccess);
+    pConnection->openConnection(_serverConnectionData.host(), _serverConnectionData.port(), 1000, true);
+
+    QVERIFY(spySuccess.wait(100));
+
+    QSignalSpy spyResultSuccess(pConnection, &ModbusConnection::readRequestSuccess);
+    QSignalSpy spyResultError(pConnection, &ModbusConnection::readRequestError);
+
+    pConnection->sendReadRequest(40001, 1, _slaveId);
+
+    /* Retransmission should happen well before the request timeout */
+    QVERIFY(spyResultSuccess.wait(1000));
+    QCOMPARE(spyResultError.count(), 0);
+    QCOMPARE(_pTestSlaveUdp->receivedCount(), static_cast<quint32>(2));
+
+    QList<quint16> resultList = spyResultSuccess.takeFirst()[1].value<QList<quint16> >();
+    QCOMPARE(resultList.count(), 1);
+    QCOMPARE(resultList[0], static_cast<quint16>(5));
+
+    pConnection->closeConnection();
+}
+
+void TestModbusConnection::readRequestTimeoutUdp()
+{
+    /* Start server */
+    QVERIFY(_pTestSlaveUdp->connect(_serverConnectionData, _slaveId));
+
+    _pTestSlaveData->setRegisterState(0, true);
+
+    /* Lose all datagrams */
+    _pTestSlaveUdp->setDropCount(100);
+
+    ModbusConnection * pConnection = new ModbusConnection(this);
+    QSignalSpy spySuccess(pConnection, &ModbusConnection::connectionSuccess);
+    pConnection->openConnection(_serverConnectionData.host(), _serverConnectionData.port(), 500, true);
+
+    QVERIFY(spySuccess.wait(100));
+
+    QSignalSpy spyResultSuccess(pConnection, &ModbusConnection::readRequestSuccess);
+    QSignalSpy spyResultError(pConnection, &ModbusConnection::readRequestError);
+
+    pConnection->sendReadRequest(40001, 1, _slaveId);
+
+    QVERIFY(spyResultError.wait(1000));
+    QCOMPARE(spyResultSuccess.count(), 0);
+
+    QList<QVariant> arguments = spyResultError.takeFirst();
+    QCOMPARE(arguments[1].value<QModbusDevice::Error>(), QModbusDevice::TimeoutError);
+
+    /* Request is retransmitted before giving up */
+    QVERIFY(_pTestSlaveUdp->receivedCount() > 1);
+
+    pConnection->closeConnection();
+}
+
+void TestModbusConnection::readRequestBenchmarkUdp()
+{
+    /* Start server */
+    QVERIFY(_pTestSlaveUdp->connect(_serverConnectionData, _slaveId));
+
+    QList<uint> registerList;
+    for (uint idx = 0; idx < 50; idx++)
+    {
+        registerList.append(idx);
+    }
+    _pTestSlaveData->setRegisterState(registerList, true);
+
+    ModbusConnection * pConnection = new ModbusConnection(this);
+    QSignalSpy spySuccess(pConnection, &ModbusConnection::connectionSuccess);
+    pConnection->openConnection(_serverConnectionData.host(), _serverConnectionData.port(), 1000, true);
+
+    QVERIFY(spySuccess.wait(100));
+
+    QSignalSpy spyResultSuccess(pConnection, &ModbusConnection::readRequestSuccess);
+
+    QBENCHMARK
+    {
+        pConnection->sendReadRequest(40001, 50, _slaveId);
+        QVERIFY(spyResultSuccess.wait(100));
+    }
+
+    pConnection->closeConnection();
+}
+
 QTEST_GUILESS_MAIN(TestModbusConnection)
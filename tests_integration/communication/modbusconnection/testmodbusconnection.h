@@ -5,6 +5,7 @@
 
 #include "testslavedata.h"
 #include "testslavemodbus.h"
+#include "testslaveudp.h"
 
 
 class TestModbusConnection: public QObject
@@ -22,10 +23,17 @@ private slots:
     void readRequestProtocolError();
     void readRequestError();
 
+    void readRequestSuccessUdp();
+    void readRequestProtocolErrorUdp();
+    void readRequestRetransmitUdp();
+    void readRequestTimeoutUdp();
+    void readRequestBenchmarkUdp();
+
 private:
 
     QPointer<TestSlaveData> _pTestSlaveData;
     QPointer<TestSlaveModbus> _pTestSlaveModbus;
+    QPointer<TestSlaveUdp> _pTestSlaveUdp;
 
     quint8 _slaveId;
 
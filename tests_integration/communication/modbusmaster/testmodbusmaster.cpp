@@ -23,6 +23,7 @@ void TestModbusMaster::init()
     _settingsModel.setPort(SettingsModel::CONNECTION_ID_0, 5020);
     _settingsModel.setTimeout(SettingsModel::CONNECTION_ID_0, 500);
     _settingsModel.setSlaveId(SettingsModel::CONNECTION_ID_0, 1);
+    _settingsModel.setSecondaryIpAddress(SettingsModel::CONNECTION_ID_0, QString());
 
     _serverConnectionData.setPort(_settingsModel.port(SettingsModel::CONNECTION_ID_0));
     _serverConnectionData.setHost(_settingsModel.ipAddress(SettingsModel::CONNECTION_ID_0));
@@ -361,6 +362,118 @@ void TestModbusMaster::multiRequestInvalidAddress()
     }
 }
 
+void TestModbusMaster::writeRegisterSuccess()
+{
+    _pTestSlaveData->setRegisterState(0, true);
+    _pTestSlaveData->setRegisterValue(0, 0);
+
+    ModbusMaster modbusMaster(&_settingsModel, SettingsModel::CONNECTION_ID_0);
+    QSignalSpy spyModbusWriteDone(&modbusMaster, &ModbusMaster::modbusWriteDone);
+
+    modbusMaster.writeRegister(40001, QList<quint16>() << 5);
+
+    QVERIFY(spyModbusWriteDone.wait(100));
+    QCOMPARE(spyModbusWriteDone.count(), 1);
+
+    QList<QVariant> arguments = spyModbusWriteDone.takeFirst(); // take the first signal
+    QCOMPARE(arguments[0].toUInt(), 40001u);
+    QVERIFY(arguments[2].toBool());
+
+    QCOMPARE(_pTestSlaveData->registerValue(0), static_cast<quint16>(5));
+}
+
+void TestModbusMaster::writeRegisterDuringRead()
+{
+    _pTestSlaveData->setRegisterState(0, true);
+    _pTestSlaveData->setRegisterState(1, true);
+    _pTestSlaveData->setRegisterValue(0, 0);
+    _pTestSlaveData->setRegisterValue(1, 1);
+
+    _settingsModel.setConsecutiveMax(SettingsModel::CONNECTION_ID_0, 1);
+
+    ModbusMaster modbusMaster(&_settingsModel, SettingsModel::CONNECTION_ID_0);
+    QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
+    QSignalSpy spyModbusWriteDone(&modbusMaster, &ModbusMaster::modbusWriteDone);
+
+    modbusMaster.readRegisterList(QList<quint16>() << 40001 << 40002);
+    modbusMaster.writeRegister(40002, QList<quint16>() << 10 << 11);
+
+    QVERIFY(spyModbusPollDone.wait(100));
+    QCOMPARE(spyModbusPollDone.count(), 1);
+    QCOMPARE(spyModbusWriteDone.count(), 1);
+
+    /* Write is sent before the reads */
+    QMap<quint16, ModbusResult> result = spyModbusPollDone.takeFirst().first().value<QMap<quint16, ModbusResult> >();
+    QVERIFY(result[40002].isSuccess());
+    QCOMPARE(result[40002].value(), static_cast<quint16>(10));
+
+    QVERIFY(spyModbusWriteDone.takeFirst()[2].toBool());
+    QCOMPARE(_pTestSlaveData->registerValue(2), static_cast<quint16>(11));
+
+    _settingsModel.setConsecutiveMax(SettingsModel::CONNECTION_ID_0, 125);
+}
+
+void TestModbusMaster::writeRegisterNoResponse()
+{
+    _pTestSlaveModbus->disconnectDevice();
+
+    ModbusMaster modbusMaster(&_settingsModel, SettingsModel::CONNECTION_ID_0);
+    QSignalSpy spyModbusWriteDone(&modbusMaster, &ModbusMaster::modbusWriteDone);
+
+    modbusMaster.writeRegister(40001, QList<quint16>() << 5);
+    modbusMaster.writeRegister(40002, QList<quint16>() << 6);
+
+    QVERIFY(spyModbusWriteDone.wait(static_cast<int>(_settingsModel.timeout(SettingsModel::CONNECTION_ID_0)) + 100));
+    if (spyModbusWriteDone.count() < 2)
+    {
+        QVERIFY(spyModbusWriteDone.wait(100));
+    }
+    QCOMPARE(spyModbusWriteDone.count(), 2);
+
+    QVERIFY(spyModbusWriteDone[0][2].toBool() == false);
+    QVERIFY(spyModbusWriteDone[1][2].toBool() == false);
+}
+
+void TestModbusMaster::failoverToStandby()
+{
+    _pTestSlaveData->setRegisterState(0, true);
+    _pTestSlaveData->setRegisterValue(0, 5020);
+
+    /* Primary device is not available, test slave is the standby device */
+    _settingsModel.setIpAddress(SettingsModel::CONNECTION_ID_0, "127.0.0.2");
+    _settingsModel.setSecondaryIpAddress(SettingsModel::CONNECTION_ID_0, "127.0.0.1");
+
+    ModbusMaster modbusMaster(&_settingsModel, SettingsModel::CONNECTION_ID_0);
+
+    QList<quint16> registerList = QList<quint16>() << 40001;
+    QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
+    QSignalSpy spyFailover(&modbusMaster, &ModbusMaster::modbusFailover);
+
+    /* Standby connection is opened in background, so first cycle can still fail */
+    bool bSuccess = false;
+    for (uint i = 0; i < _cReadCount; i++)
+    {
+        modbusMaster.readRegisterList(registerList);
+
+        QVERIFY(spyModbusPollDone.wait(1000));
+        QCOMPARE(spyModbusPollDone.count(), 1);
+
+        QList<QVariant> arguments = spyModbusPollDone.takeFirst(); // take the first signal
+        QMap<quint16, ModbusResult> result = arguments.first().value<QMap<quint16, ModbusResult> >();
+        QCOMPARE(result.keys().count(), 1);
+
+        bSuccess = result[40001].isSuccess();
+    }
+
+    /* Switched over once and stays on standby device */
+    QVERIFY(bSuccess);
+    QCOMPARE(spyFailover.count(), 1);
+
+    QList<QVariant> arguments = spyFailover.takeFirst();
+    QCOMPARE(arguments.first().toString(), QString("127.0.0.1"));
+
+    modbusMaster.closeStandbyConnection();
+}
 
 /* TODO:
  * Add extra test with actual timeout of no response
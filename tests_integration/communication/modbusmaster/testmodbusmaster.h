@@ -25,6 +25,12 @@ private slots:
     void multiRequestNoResponse();
     void multiRequestInvalidAddress();
 
+    void writeRegisterSuccess();
+    void writeRegisterDuringRead();
+    void writeRegisterNoResponse();
+
+    void failoverToStandby();
+
 private:
 
     QPointer<TestSlaveData> _pTestSlaveData;
@@ -4,7 +4,9 @@ INCLUDEPATH += $$PWD
 SOURCES += \
     $$PWD/testslavedata.cpp \
     $$PWD/testslavemodbus.cpp \
+    $$PWD/testslaveudp.cpp \
     
 HEADERS += \
     $$PWD/testslavedata.h \
     $$PWD/testslavemodbus.h \
+    $$PWD/testslaveudp.h \
@@ -87,7 +87,7 @@ bool TestSlaveModbus::writeData(const QModbusDataUnit &newData)
     {
         const uint regAddress = static_cast<uint>(newData.startAddress()) + idx;
         _pTestSlaveData->setRegisterState(regAddress, true);
-        _pTestSlaveData->setRegisterValue(regAddress, newData.value(regAddress));
+        _pTestSlaveData->setRegisterValue(regAddress, newData.value(static_cast<int>(idx)));
     }
 
     emit dataWritten(newData.registerType(), newData.startAddress(), newData.valueCount());
@@ -0,0 +1,236 @@
+#include "testslaveudp.h"
+#include <QDataStream>
+#include <QNetworkDatagram>
+
+TestSlaveUdp::TestSlaveUdp(TestSlaveData *pTestSlaveData, QObject *parent) : QObject(parent)
+{
+    _pTestSlaveData = pTestSlaveData;
+    _pSocket = new QUdpSocket(this);
+
+    _slaveId = 1;
+    _exceptionCode = static_cast<QModbusPdu::ExceptionCode>(0);
+    _bExceptionPersistent = false;
+    _dropCount = 0;
+    _receivedCount = 0;
+
+    QObject::connect(_pSocket, &QUdpSocket::readyRead, this, &TestSlaveUdp::handleReadyRead);
+}
+
+TestSlaveUdp::~TestSlaveUdp()
+{
+
+}
+
+bool TestSlaveUdp::connect(QUrl host, int slaveId)
+{
+    _slaveId = slaveId;
+
+    return _pSocket->bind(QHostAddress(host.host()), static_cast<quint16>(host.port()));
+}
+
+void TestSlaveUdp::disconnectDevice()
+{
+    _pSocket->close();
+}
+
+void TestSlaveUdp::setException(QModbusPdu::ExceptionCode exception, bool bPersistent)
+{
+    _exceptionCode = exception;
+    _bExceptionPersistent = bPersistent;
+}
+
+/* Silently drop the next requests to simulate datagram loss */
+void TestSlaveUdp::setDropCount(quint32 dropCount)
+{
+    _dropCount = dropCount;
+}
+
+quint32 TestSlaveUdp::receivedCount()
+{
+    return _receivedCount;
+}
+
+void TestSlaveUdp::handleReadyRead()
+{
+    while (_pSocket->hasPendingDatagrams())
+    {
+        QNetworkDatagram datagram = _pSocket->receiveDatagram();
+
+        _receivedCount++;
+
+        if (_dropCount > 0)
+        {
+            _dropCount--;
+            continue;
+        }
+
+        QByteArray response = processRequest(datagram.data());
+        if (!response.isEmpty())
+        {
+            _pSocket->writeDatagram(response, datagram.senderAddress(), static_cast<quint16>(datagram.senderPort()));
+        }
+
+        emit requestProcessed();
+    }
+}
+
+QByteArray TestSlaveUdp::processRequest(const QByteArray &request)
+{
+    quint16 transactionId;
+    quint16 protocolId;
+    quint16 length;
+    quint8 unitId;
+    quint8 functionCode;
+
+    if (request.size() < 8)
+    {
+        return QByteArray();
+    }
+
+    QDataStream requestStream(request);
+    requestStream >> transactionId >> protocolId >> length >> unitId >> functionCode;
+
+    if ((protocolId != 0) || (unitId != _slaveId) || (request.size() != 6 + length))
+    {
+        return QByteArray();
+    }
+
+    const QByteArray data = request.mid(8);
+
+    QByteArray pdu;
+    if (_exceptionCode != 0)
+    {
+        pdu.append(static_cast<char>(functionCode | QModbusPdu::ExceptionByte));
+        pdu.append(static_cast<char>(_exceptionCode));
+
+        /* Reset exception when not persistent */
+        if (!_bExceptionPersistent)
+        {
+            _exceptionCode = static_cast<QModbusPdu::ExceptionCode>(0);
+        }
+    }
+    else if (functionCode == QModbusPdu::ReadHoldingRegisters)
+    {
+        pdu = processReadHoldingRegisters(data);
+    }
+    else if (functionCode == QModbusPdu::WriteSingleRegister)
+    {
+        pdu = processWriteSingleRegister(data);
+    }
+    else if (functionCode == QModbusPdu::WriteMultipleRegisters)
+    {
+        pdu = processWriteMultipleRegisters(data);
+    }
+    else
+    {
+        pdu.append(static_cast<char>(functionCode | QModbusPdu::ExceptionByte));
+        pdu.append(static_cast<char>(QModbusPdu::IllegalFunction));
+    }
+
+    QByteArray response;
+    QDataStream responseStream(&response, QIODevice::WriteOnly);
+    responseStream << transactionId << protocolId << static_cast<quint16>(pdu.size() + 1) << unitId;
+    response.append(pdu);
+
+    return response;
+}
+
+QByteArray TestSlaveUdp::processReadHoldingRegisters(const QByteArray &data)
+{
+    quint16 startAddress;
+    quint16 count;
+
+    QDataStream stream(data);
+    stream >> startAddress >> count;
+
+    QByteArray pdu;
+
+    bool bValid = (data.size() == 4) && (count > 0) && (count <= 125);
+    for (uint idx = 0; bValid && (idx < count); idx++)
+    {
+        bValid = _pTestSlaveData->registerState(startAddress + idx);
+    }
+
+    if (bValid)
+    {
+        QDataStream pduStream(&pdu, QIODevice::WriteOnly);
+        pduStream << static_cast<quint8>(QModbusPdu::ReadHoldingRegisters) << static_cast<quint8>(2 * count);
+        for (uint idx = 0; idx < count; idx++)
+        {
+            pduStream << _pTestSlaveData->registerValue(startAddress + idx);
+        }
+    }
+    else
+    {
+        pdu.append(static_cast<char>(QModbusPdu::ReadHoldingRegisters | QModbusPdu::ExceptionByte));
+        pdu.append(static_cast<char>(QModbusPdu::IllegalDataAddress));
+    }
+
+    return pdu;
+}
+
+QByteArray TestSlaveUdp::processWriteSingleRegister(const QByteArray &data)
+{
+    quint16 address;
+    quint16 value;
+
+    QDataStream stream(data);
+    stream >> address >> value;
+
+    QByteArray pdu;
+
+    if (data.size() == 4)
+    {
+        _pTestSlaveData->setRegisterState(address, true);
+        _pTestSlaveData->setRegisterValue(address, value);
+
+        /* Response is echo of request */
+        pdu.append(static_cast<char>(QModbusPdu::WriteSingleRegister));
+        pdu.append(data);
+    }
+    else
+    {
+        pdu.append(static_cast<char>(QModbusPdu::WriteSingleRegister | QModbusPdu::ExceptionByte));
+        pdu.append(static_cast<char>(QModbusPdu::IllegalDataValue));
+    }
+
+    return pdu;
+}
+
+QByteArray TestSlaveUdp::processWriteMultipleRegisters(const QByteArray &data)
+{
+    quint16 startAddress;
+    quint16 count;
+    quint8 byteCount;
+
+    QDataStream stream(data);
+    stream >> startAddress >> count >> byteCount;
+
+    QByteArray pdu;
+
+    if (
+        (data.size() == 5 + 2 * count)
+        && (byteCount == 2 * count)
+        && (count > 0) && (count <= 123)
+    )
+    {
+        for (uint idx = 0; idx < count; idx++)
+        {
+            quint16 value;
+            stream >> value;
+
+            _pTestSlaveData->setRegisterState(startAddress + idx, true);
+            _pTestSlaveData->setRegisterValue(startAddress + idx, value);
+        }
+
+        QDataStream pduStream(&pdu, QIODevice::WriteOnly);
+        pduStream << static_cast<quint8>(QModbusPdu::WriteMultipleRegisters) << startAddress << count;
+    }
+    else
+    {
+        pdu.append(static_cast<char>(QModbusPdu::WriteMultipleRegisters | QModbusPdu::ExceptionByte));
+        pdu.append(static_cast<char>(QModbusPdu::IllegalDataValue));
+    }
+
+    return pdu;
+}
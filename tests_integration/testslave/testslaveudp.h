@@ -0,0 +1,52 @@
+#ifndef TESTSLAVEUDP_H
+#define TESTSLAVEUDP_H
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QModbusPdu>
+#include <QUrl>
+
+#include "testslavedata.h"
+
+class TestSlaveUdp : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestSlaveUdp(TestSlaveData *pTestSlaveData, QObject *parent = nullptr);
+    ~TestSlaveUdp();
+
+    bool connect(QUrl host, int slaveId);
+    void disconnectDevice();
+
+    void setException(QModbusPdu::ExceptionCode exception, bool bPersistent);
+    void setDropCount(quint32 dropCount);
+
+    quint32 receivedCount();
+
+signals:
+    void requestProcessed();
+
+private slots:
+    void handleReadyRead();
+
+private:
+
+    QByteArray processRequest(const QByteArray &request);
+    QByteArray processReadHoldingRegisters(const QByteArray &data);
+    QByteArray processWriteSingleRegister(const QByteArray &data);
+    QByteArray processWriteMultipleRegisters(const QByteArray &data);
+
+    TestSlaveData *_pTestSlaveData;
+    QUdpSocket * _pSocket;
+
+    int _slaveId;
+
+    QModbusPdu::ExceptionCode _exceptionCode;
+    bool _bExceptionPersistent;
+
+    quint32 _dropCount;
+    quint32 _receivedCount;
+
+};
+
+#endif // TESTSLAVEUDP_H
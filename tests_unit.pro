@@ -14,9 +14,26 @@ HEADERS += \
     tests_unit/tst_errorlog.h \
     tests_unit/tst_errorlogmodel.h \
     tests_unit/mockgraphdatamodel.h \
+    tests_unit/testgraphlist.h \
     tests_unit/tst_mbcregistermodel.h \
     tests_unit/tst_readregisters.h \
-    tests_unit/tst_graphdata.h
+    tests_unit/tst_graphdata.h \
+    tests_unit/tst_stimulus.h \
+    tests_unit/tst_triggercapture.h \
+    tests_unit/tst_timebasealigner.h \
+    tests_unit/tst_polltracemodel.h \
+    tests_unit/tst_samplestore.h \
+    tests_unit/tst_samplecodec.h \
+    tests_unit/tst_ingestfilter.h \
+    tests_unit/tst_graphdatamodel.h \
+    tests_unit/tst_sessionfile.h \
+    tests_unit/tst_livesegment.h \
+    tests_unit/tst_memoryforecast.h \
+    tests_unit/tst_channelexpression.h \
+    tests_unit/tst_signalfilter.h \
+    tests_unit/tst_alarmrule.h \
+    tests_unit/tst_runningstatistics.h \
+    tests_unit/tst_spectrumanalyzer.h
 
 # Remove application main
 SOURCES -= \
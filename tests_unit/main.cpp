@@ -3,6 +3,22 @@
 #include "tst_mbcregistermodel.h"
 #include "tst_readregisters.h"
 #include "tst_graphdata.h"
+#include "tst_stimulus.h"
+#include "tst_triggercapture.h"
+#include "tst_timebasealigner.h"
+#include "tst_polltracemodel.h"
+#include "tst_samplestore.h"
+#include "tst_samplecodec.h"
+#include "tst_ingestfilter.h"
+#include "tst_graphdatamodel.h"
+#include "tst_sessionfile.h"
+#include "tst_livesegment.h"
+#include "tst_memoryforecast.h"
+#include "tst_channelexpression.h"
+#include "tst_signalfilter.h"
+#include "tst_alarmrule.h"
+#include "tst_runningstatistics.h"
+#include "tst_spectrumanalyzer.h"
 
 #include <gtest/gtest.h>
 
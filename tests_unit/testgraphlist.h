@@ -0,0 +1,35 @@
+#ifndef TESTGRAPHLIST_H
+#define TESTGRAPHLIST_H
+
+#include "src/models/graphdata.h"
+#include "src/models/graphdatamodel.h"
+
+/* Graph definitions shared by the tests of the models that use them */
+namespace TestGraphList
+{
+    /* Active registers with consecutive addresses, divided over connections in turn */
+    QList<GraphData> create(qint32 count, quint16 firstAddress = 40001, quint8 connectionCount = 1)
+    {
+        QList<GraphData> graphList;
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            GraphData graphData;
+
+            graphData.setRegisterAddress(static_cast<quint16>(firstAddress + idx));
+            graphData.setConnectionId(static_cast<quint8>(idx % connectionCount));
+            graphData.setLabel(QString("Register %1").arg(idx));
+
+            graphList.append(graphData);
+        }
+
+        return graphList;
+    }
+
+    void add(GraphDataModel * pGraphDataModel, qint32 count, quint8 connectionCount = 1)
+    {
+        pGraphDataModel->add(create(count, 40001, connectionCount));
+    }
+}
+
+#endif // TESTGRAPHLIST_H
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QSignalSpy>
+#include <QtNumeric>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/models/alarmrule.h"
+#include "src/communication/alarmmonitor.h"
+
+using namespace testing;
+
+namespace AlarmRuleTest
+{
+    AlarmRule::Transition process(AlarmRule * pRule, double value, quint32 rawValue = 0)
+    {
+        return pRule->process(0, value, rawValue);
+    }
+
+    void addSample(AlarmMonitor * pMonitor, qint64 timestamp, double value0, double value1, bool bSuccess1 = true)
+    {
+        pMonitor->processSample(timestamp,
+                                QList<bool>() << true << bSuccess1,
+                                QList<double>() << value0 << value1);
+    }
+}
+
+TEST(AlarmRule, above)
+{
+    AlarmRule rule(AlarmRule::ALARM_ABOVE, 80, 5);
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 80), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 81), AlarmRule::TRANSITION_RAISED);
+    EXPECT_TRUE(rule.isRaised());
+
+    /* Raised only once */
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 90), AlarmRule::TRANSITION_NONE);
+
+    /* Hysteresis */
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 76), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 75), AlarmRule::TRANSITION_CLEARED);
+    EXPECT_FALSE(rule.isRaised());
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 81), AlarmRule::TRANSITION_RAISED);
+    rule.reset();
+    EXPECT_FALSE(rule.isRaised());
+}
+
+TEST(AlarmRule, below)
+{
+    AlarmRule rule(AlarmRule::ALARM_BELOW, 10, 1);
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 10), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 9), AlarmRule::TRANSITION_RAISED);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 10.5), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 11), AlarmRule::TRANSITION_CLEARED);
+}
+
+TEST(AlarmRule, outside)
+{
+    AlarmRule rule(AlarmRule::ALARM_OUTSIDE, 10, 2, 20);
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 15), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 21), AlarmRule::TRANSITION_RAISED);
+
+    /* Still within hysteresis of upper limit */
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 19), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 18), AlarmRule::TRANSITION_CLEARED);
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 9), AlarmRule::TRANSITION_RAISED);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 11), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 12), AlarmRule::TRANSITION_CLEARED);
+}
+
+TEST(AlarmRule, rate)
+{
+    /* 5 per second */
+    AlarmRule rule(AlarmRule::ALARM_RATE, 5, 1);
+
+    /* No previous value */
+    EXPECT_EQ(rule.process(0, 100, 0), AlarmRule::TRANSITION_NONE);
+
+    EXPECT_EQ(rule.process(1000, 104, 0), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(rule.process(1500, 107, 0), AlarmRule::TRANSITION_RAISED);
+
+    /* Same key */
+    EXPECT_EQ(rule.process(1500, 107, 0), AlarmRule::TRANSITION_NONE);
+
+    /* Falling rate counts as well */
+    EXPECT_EQ(rule.process(2000, 104.5, 0), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(rule.process(3000, 100.5, 0), AlarmRule::TRANSITION_CLEARED);
+}
+
+TEST(AlarmRule, bit)
+{
+    AlarmRule rule(AlarmRule::ALARM_BIT, 3);
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 7, 7), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 0xFF, 0xFF), AlarmRule::TRANSITION_RAISED);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 8, 8), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 0xF7, 0xF7), AlarmRule::TRANSITION_CLEARED);
+
+    /* Bit of raw register value, not of converted value (e.g. divided by 10) */
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 8, 80), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 0.8, 8), AlarmRule::TRANSITION_RAISED);
+
+    /* Float register: raw bits are valid when value isn't */
+    EXPECT_EQ(AlarmRuleTest::process(&rule, qQNaN(), 0), AlarmRule::TRANSITION_CLEARED);
+}
+
+TEST(AlarmRule, notFinite)
+{
+    AlarmRule rule(AlarmRule::ALARM_ABOVE, 80);
+
+    EXPECT_EQ(AlarmRuleTest::process(&rule, qInf()), AlarmRule::TRANSITION_NONE);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, 90), AlarmRule::TRANSITION_RAISED);
+    EXPECT_EQ(AlarmRuleTest::process(&rule, qQNaN()), AlarmRule::TRANSITION_NONE);
+    EXPECT_TRUE(rule.isRaised());
+}
+
+TEST(AlarmRule, fromString)
+{
+    AlarmRule rule;
+
+    ASSERT_TRUE(AlarmRule::fromString("above 80", &rule));
+    EXPECT_EQ(rule.mode(), AlarmRule::ALARM_ABOVE);
+    EXPECT_EQ(rule.limit(), 80.0);
+    EXPECT_EQ(rule.hysteresis(), 0.0);
+    EXPECT_EQ(rule.toString(), QString("above 80"));
+
+    ASSERT_TRUE(AlarmRule::fromString(" Below -2,5 Hysteresis 0,5 ", &rule));
+    EXPECT_EQ(rule.mode(), AlarmRule::ALARM_BELOW);
+    EXPECT_EQ(rule.toString(), QString("below -2.5 hysteresis 0.5"));
+
+    ASSERT_TRUE(AlarmRule::fromString("outside 10 80 hysteresis 1", &rule));
+    EXPECT_EQ(rule.mode(), AlarmRule::ALARM_OUTSIDE);
+    EXPECT_EQ(rule.limit(), 10.0);
+    EXPECT_EQ(rule.upperLimit(), 80.0);
+    EXPECT_EQ(rule.toString(), QString("outside 10 80 hysteresis 1"));
+
+    ASSERT_TRUE(AlarmRule::fromString("rate 5", &rule));
+    EXPECT_EQ(rule.mode(), AlarmRule::ALARM_RATE);
+
+    ASSERT_TRUE(AlarmRule::fromString("bit 15", &rule));
+    EXPECT_EQ(rule.mode(), AlarmRule::ALARM_BIT);
+    EXPECT_EQ(rule.toString(), QString("bit 15"));
+
+    ASSERT_TRUE(AlarmRule::fromString("", &rule));
+    EXPECT_FALSE(rule.isEnabled());
+    EXPECT_EQ(rule.toString(), QString("none"));
+
+    EXPECT_FALSE(AlarmRule::fromString("above", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("above 80 90", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("above 80 hysteresis", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("above 80 hysteresis -1", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("outside 80 10", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("outside 10 20 hysteresis 6", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("rate -1", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("bit 32", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("bit 1.5", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("bit 1 hysteresis 1", &rule));
+    EXPECT_FALSE(AlarmRule::fromString("equal 1", &rule));
+}
+
+TEST(AlarmMonitor, raiseAndClear)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.add();
+    graphDataModel.add();
+    graphDataModel.setActive(1, false);
+    graphDataModel.setAlarmRule(2, AlarmRule(AlarmRule::ALARM_ABOVE, 10, 2));
+
+    AlarmMonitor monitor(&settingsModel, &graphDataModel);
+    QSignalSpy spyRaised(&monitor, &AlarmMonitor::alarmRaised);
+    QSignalSpy spyCleared(&monitor, &AlarmMonitor::alarmCleared);
+
+    monitor.start();
+
+    /* Value of graph 2 is second value of sample (graph 1 isn't active) */
+    AlarmRuleTest::addSample(&monitor, 1000, 50, 5);
+    AlarmRuleTest::addSample(&monitor, 1100, 5, 11);
+    AlarmRuleTest::addSample(&monitor, 1200, 5, 20);
+
+    ASSERT_EQ(spyRaised.count(), 1);
+    QList<QVariant> arguments = spyRaised.takeFirst();
+    EXPECT_EQ(arguments[0].toUInt(), 2u);
+    EXPECT_EQ(arguments[1].toLongLong(), 1100);
+    EXPECT_EQ(arguments[2].toDouble(), 11.0);
+
+    EXPECT_EQ(monitor.activeAlarmCount(), 1);
+    EXPECT_EQ(monitor.alarmCount(), 1u);
+
+    /* Failed read doesn't clear alarm */
+    AlarmRuleTest::addSample(&monitor, 1300, 5, 0, false);
+    EXPECT_EQ(spyCleared.count(), 0);
+
+    AlarmRuleTest::addSample(&monitor, 1400, 5, 8);
+    ASSERT_EQ(spyCleared.count(), 1);
+    EXPECT_EQ(spyCleared.takeFirst()[1].toLongLong(), 1400);
+    EXPECT_EQ(monitor.activeAlarmCount(), 0);
+    EXPECT_EQ(monitor.alarmCount(), 1u);
+
+    /* Rule is copied at start */
+    graphDataModel.setAlarmRule(2, AlarmRule());
+    AlarmRuleTest::addSample(&monitor, 1500, 5, 30);
+    EXPECT_EQ(spyRaised.count(), 1);
+
+    monitor.stop();
+    EXPECT_EQ(monitor.activeAlarmCount(), 0);
+}
+
+TEST(AlarmMonitor, registerTimestamp)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.setAlarmRule(0, AlarmRule(AlarmRule::ALARM_BIT, 0));
+
+    AlarmMonitor monitor(&settingsModel, &graphDataModel);
+    QSignalSpy spyRaised(&monitor, &AlarmMonitor::alarmRaised);
+
+    monitor.start();
+
+    /* Raw timestamp of register is time of alarm */
+    monitor.processSample(2000, QList<bool>() << true, QList<double>() << 1, QList<qint64>() << 1990);
+
+    ASSERT_EQ(spyRaised.count(), 1);
+    EXPECT_EQ(spyRaised.takeFirst()[1].toLongLong(), 1990);
+}
+
+TEST(AlarmMonitor, bitOnRawValue)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.setAlarmRule(0, AlarmRule(AlarmRule::ALARM_BIT, 2));
+
+    AlarmMonitor monitor(&settingsModel, &graphDataModel);
+    QSignalSpy spyRaised(&monitor, &AlarmMonitor::alarmRaised);
+
+    monitor.start();
+
+    /* Converted value has bit set, raw register value hasn't */
+    monitor.processSample(1000, QList<bool>() << true, QList<double>() << 4, QList<qint64>(), QList<quint32>() << 40);
+    EXPECT_EQ(spyRaised.count(), 0);
+
+    monitor.processSample(1100, QList<bool>() << true, QList<double>() << 0.4, QList<qint64>(), QList<quint32>() << 4);
+    EXPECT_EQ(spyRaised.count(), 1);
+}
+
+TEST(AlarmMonitor, commandFailed)
+{
+    SettingsModel settingsModel;
+    settingsModel.setAlarmCommand("/nonexistent/alarm_command");
+
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.setAlarmRule(0, AlarmRule(AlarmRule::ALARM_ABOVE, 10));
+
+    AlarmMonitor monitor(&settingsModel, &graphDataModel);
+    QSignalSpy spyRaised(&monitor, &AlarmMonitor::alarmRaised);
+    QSignalSpy spyFailed(&monitor, &AlarmMonitor::commandFailed);
+
+    monitor.start();
+    monitor.processSample(1000, QList<bool>() << true, QList<double>() << 20);
+
+    /* Alarm is still raised */
+    EXPECT_EQ(spyRaised.count(), 1);
+    ASSERT_EQ(spyFailed.count(), 1);
+    EXPECT_EQ(spyFailed.takeFirst()[0].toString(), QString("/nonexistent/alarm_command"));
+    EXPECT_TRUE(monitor.isCommandFailed());
+
+    monitor.stop();
+    monitor.start();
+    EXPECT_FALSE(monitor.isCommandFailed());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QList>
+#include <QVector>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/models/channelexpression.h"
+
+using namespace testing;
+
+namespace ChannelExpressionTest
+{
+    double evaluate(const QString &text, const QVector<double> &operandValues = QVector<double>())
+    {
+        ChannelExpression expression;
+        double result = 0;
+
+        EXPECT_TRUE(ChannelExpression::fromString(text, &expression));
+        EXPECT_TRUE(expression.evaluate(operandValues, 0, &result));
+
+        return result;
+    }
+
+    GraphData createRegister(quint16 address, quint8 connectionId)
+    {
+        GraphData graphData;
+
+        graphData.setRegisterAddress(address);
+        graphData.setConnectionId(connectionId);
+        graphData.setLabel(QString("Register %1").arg(address));
+
+        return graphData;
+    }
+
+    GraphData createVirtual(const QString &text)
+    {
+        GraphData graphData;
+        ChannelExpression expression;
+
+        EXPECT_TRUE(ChannelExpression::fromString(text, &expression));
+
+        graphData.setExpression(expression);
+        graphData.setLabel(text);
+
+        return graphData;
+    }
+}
+
+TEST(ChannelExpression, arithmetic)
+{
+    EXPECT_EQ(ChannelExpressionTest::evaluate("1 + 2 * 3"), 7.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate("(1 + 2) * 3"), 9.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate("10 - 4 - 3"), 3.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate("-2 ^ 2"), -4.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate("2 ^ 3 ^ 2"), 512.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate("1.5e3 / 3"), 500.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate("max(abs(-3), min(2, 8)) + sqrt(16)"), 7.0);
+}
+
+TEST(ChannelExpression, operands)
+{
+    ChannelExpression expression;
+    ASSERT_TRUE(ChannelExpression::fromString("${40001} * ${40002@1} - ${40001}", &expression));
+
+    /* Every register once */
+    ASSERT_EQ(expression.operands().size(), 2);
+    EXPECT_EQ(expression.operands()[0].registerAddress, 40001);
+    EXPECT_EQ(expression.operands()[0].connectionId, 0);
+    EXPECT_EQ(expression.operands()[1].registerAddress, 40002);
+    EXPECT_EQ(expression.operands()[1].connectionId, 1);
+
+    EXPECT_EQ(ChannelExpressionTest::evaluate("${40001} * ${40002@1} - ${40001}", QVector<double>() << 3 << 5), 12.0);
+}
+
+TEST(ChannelExpression, invalid)
+{
+    ChannelExpression expression;
+    QString errorString;
+
+    EXPECT_FALSE(ChannelExpression::fromString("", &expression));
+    EXPECT_FALSE(ChannelExpression::fromString("1 +", &expression));
+    EXPECT_FALSE(ChannelExpression::fromString("(1 + 2", &expression));
+    EXPECT_FALSE(ChannelExpression::fromString("${40001", &expression));
+    EXPECT_FALSE(ChannelExpression::fromString("${40001@9}", &expression));
+    EXPECT_FALSE(ChannelExpression::fromString("min(1)", &expression));
+
+    EXPECT_FALSE(ChannelExpression::fromString("foo(1)", &expression, &errorString));
+    EXPECT_EQ(errorString, QString("Unknown function \"foo\""));
+
+    EXPECT_TRUE(expression.isEmpty());
+
+    /* Division by zero */
+    double result;
+    ASSERT_TRUE(ChannelExpression::fromString("1 / 0", &expression));
+    EXPECT_FALSE(expression.evaluate(QVector<double>(), 0, &result));
+}
+
+TEST(ChannelExpression, nesting)
+{
+    ChannelExpression expression;
+    QString errorString;
+
+    EXPECT_EQ(ChannelExpressionTest::evaluate(QString(100, '(') + "1" + QString(100, ')')), 1.0);
+    EXPECT_EQ(ChannelExpressionTest::evaluate(QString(100, '-') + "1"), 1.0);
+
+    /* Deep nesting is rejected instead of overflowing the stack */
+    EXPECT_FALSE(ChannelExpression::fromString(QString(100000, '(') + "1" + QString(100000, ')'), &expression, &errorString));
+    EXPECT_TRUE(errorString.startsWith("Expression is nested too deeply"));
+
+    EXPECT_FALSE(ChannelExpression::fromString(QString(100000, '-') + "1", &expression));
+    EXPECT_FALSE(ChannelExpression::fromString("max(1, " + QString(100000, '(') + "1" + QString(100000, ')') + ")", &expression));
+
+    EXPECT_TRUE(expression.isEmpty());
+}
+
+TEST(ChannelExpression, rate)
+{
+    ChannelExpression expression;
+    ASSERT_TRUE(ChannelExpression::fromString("rate(${40001})", &expression));
+
+    double result;
+
+    /* No previous row */
+    EXPECT_FALSE(expression.evaluate(QVector<double>() << 10, 1000, &result));
+
+    ASSERT_TRUE(expression.evaluate(QVector<double>() << 15, 1500, &result));
+    EXPECT_EQ(result, 10.0);
+
+    /* Same key keeps rate */
+    ASSERT_TRUE(expression.evaluate(QVector<double>() << 20, 1500, &result));
+    EXPECT_EQ(result, 10.0);
+
+    ASSERT_TRUE(expression.evaluate(QVector<double>() << 5, 2500, &result));
+    EXPECT_EQ(result, -10.0);
+
+    expression.reset();
+    EXPECT_FALSE(expression.evaluate(QVector<double>() << 5, 3000, &result));
+}
+
+TEST(ChannelExpression, virtualChannel)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add(QList<GraphData>() << ChannelExpressionTest::createRegister(40001, 0)
+                                          << ChannelExpressionTest::createVirtual("${40001} * ${40002@1}")
+                                          << ChannelExpressionTest::createRegister(40002, 1));
+
+    ASSERT_TRUE(graphDataModel.isVirtual(1));
+    EXPECT_EQ(graphDataModel.connectionId(1), 0);
+
+    /* Virtual channel isn't read */
+    QList<quint16> registerList;
+    graphDataModel.activeGraphAddresList(&registerList, 0);
+    ASSERT_EQ(registerList.size(), 1);
+    EXPECT_EQ(registerList[0], 40001);
+
+    QList<bool> successList = QList<bool>() << true << false << true;
+    QList<double> valueList = QList<double>() << 2.5 << 0 << 4;
+    QList<qint64> timestampList = QList<qint64>() << 1000 << 1000 << 1010;
+
+    graphDataModel.evaluateVirtualChannels(&successList, &valueList, &timestampList);
+
+    EXPECT_TRUE(successList[1]);
+    EXPECT_EQ(valueList[1], 10.0);
+    EXPECT_EQ(timestampList[1], 1010);
+
+    /* Computed value is stored */
+    graphDataModel.addSamples(QList<double>() << 1000 << 1000 << 1010, successList, QList<quint32>() << 25 << 0 << 4, valueList);
+
+    const SampleSeries series = graphDataModel.series(1);
+    ASSERT_EQ(series.size(), 1);
+    EXPECT_EQ(series.value(0), 10.0);
+
+    /* Register couldn't be read */
+    successList = QList<bool>() << true << false << false;
+    graphDataModel.evaluateVirtualChannels(&successList, &valueList, &timestampList);
+    EXPECT_FALSE(successList[1]);
+
+    /* Register isn't active */
+    graphDataModel.setActive(2, false);
+    successList = QList<bool>() << true << false;
+    valueList = QList<double>() << 2.5 << 0;
+    timestampList = QList<qint64>() << 1000 << 1000;
+
+    graphDataModel.evaluateVirtualChannels(&successList, &valueList, &timestampList);
+    EXPECT_FALSE(successList[1]);
+}
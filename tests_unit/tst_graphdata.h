@@ -36,5 +36,97 @@ TEST(GraphData, setLabel)
     EXPECT_EQ(graphData.label(), baseString + baseString);
 }
 
+TEST(GraphData, decodeRegisterPair)
+{
+    /* 32 bit integer */
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_32BIT, true, false, 0x0001, 0x0002), 65538.0);
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_32BIT, true, true, 0x0002, 0x0001), 65538.0);
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_32BIT, true, false, 0xFFFF, 0xFFFE), 4294967294.0);
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_32BIT, false, false, 0xFFFF, 0xFFFE), -2.0);
+
+    /* float32: 1.5 = 0x3FC00000, -0.25 = 0xBE800000 */
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_FLOAT32, false, false, 0x3FC0, 0x0000), 1.5);
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_FLOAT32, false, true, 0x0000, 0xBE80), -0.25);
+
+    /* 16 bit only uses first register */
+    EXPECT_EQ(GraphData::decodeRegisterPair(GraphData::VALUE_16BIT, false, false, 0xFFFF, 0x1234), -1.0);
+}
+
+TEST(GraphData, valueTypeString)
+{
+    GraphData::ValueType valueType = GraphData::VALUE_16BIT;
+
+    EXPECT_TRUE(GraphData::stringToValueType("Float32", &valueType));
+    EXPECT_EQ(valueType, GraphData::VALUE_FLOAT32);
+
+    EXPECT_TRUE(GraphData::stringToValueType(GraphData::valueTypeToString(GraphData::VALUE_32BIT), &valueType));
+    EXPECT_EQ(valueType, GraphData::VALUE_32BIT);
+
+    EXPECT_FALSE(GraphData::stringToValueType("64bit", &valueType));
+}
+
+TEST(GraphData, processValue)
+{
+    GraphData graphData;
+
+    /* 16 bit: signedness, bitmask and shift */
+    EXPECT_EQ(graphData.processValue(0xFFFF), 65535.0);
+
+    graphData.setUnsigned(false);
+    EXPECT_EQ(graphData.processValue(0xFFFF), -1.0);
+
+    graphData.setUnsigned(true);
+    graphData.setBitmask(0xFF00);
+    graphData.setShift(-8);
+    EXPECT_EQ(graphData.processValue(0x1234), 18.0);
+
+    graphData.setBitmask(0xFFFF);
+    graphData.setShift(0);
+    graphData.setMultiplyFactor(10);
+    graphData.setDivideFactor(4);
+    EXPECT_EQ(graphData.processValue(2), 5.0);
+
+    /* Register pair: first register in low word of raw value */
+    graphData.setMultiplyFactor(1);
+    graphData.setDivideFactor(1);
+    graphData.setValueType(GraphData::VALUE_32BIT);
+    EXPECT_EQ(graphData.processValue(GraphData::packRegisterPair(0x0001, 0x0002)), 65538.0);
+}
+
+TEST(GraphData, series)
+{
+    GraphData graphData;
+
+    QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+    QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(graphData.columnType()));
+
+    pTimebase->append(0);
+    pColumn->append(100, true);
+    pTimebase->append(10);
+    pColumn->append(0, false);
+    pTimebase->append(20);
+    pColumn->append(200, true);
+
+    graphData.setSampleColumn(pTimebase, pColumn);
+
+    ASSERT_EQ(graphData.series().size(), 3);
+    EXPECT_EQ(graphData.series().value(2), 200.0);
+
+    /* Raw values are converted with current settings */
+    graphData.setMultiplyFactor(3);
+
+    EXPECT_EQ(graphData.series().key(0), 0.0);
+    EXPECT_EQ(graphData.series().value(0), 300.0);
+    EXPECT_FALSE(graphData.series().isValid(1));
+    EXPECT_EQ(graphData.series().value(1), 0.0);
+    EXPECT_EQ(graphData.series().value(2), 600.0);
+
+    /* Column of other value type isn't shown */
+    graphData.setValueType(GraphData::VALUE_32BIT);
+    EXPECT_TRUE(graphData.series().isEmpty());
+
+    graphData.clearData();
+    EXPECT_TRUE(graphData.series().isEmpty());
+}
 
 /* TODO: Add extra test for other functions */
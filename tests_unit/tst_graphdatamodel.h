@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QSignalSpy>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+
+#include "testgraphlist.h"
+
+using namespace testing;
+
+namespace GraphDataModelTest
+{
+    /* Registers of project file: every third register is inactive */
+    QList<GraphData> createGraphList(qint32 count)
+    {
+        QList<GraphData> graphList = TestGraphList::create(count, 0, 2);
+
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            graphList[idx].setActive(idx % 3 != 0);
+        }
+
+        return graphList;
+    }
+}
+
+TEST(GraphDataModel, bulkAdd)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    QSignalSpy spyReset(&graphDataModel, SIGNAL(modelReset()));
+    QSignalSpy spyAdded(&graphDataModel, SIGNAL(added(quint32)));
+
+    graphDataModel.add(GraphDataModelTest::createGraphList(100));
+
+    EXPECT_EQ(spyReset.count(), 1);
+    EXPECT_EQ(spyAdded.count(), 0);
+    EXPECT_EQ(graphDataModel.size(), 100);
+    EXPECT_TRUE(graphDataModel.color(99).isValid());
+
+    /* Single graph is still inserted as row */
+    graphDataModel.add(GraphDataModelTest::createGraphList(1));
+
+    EXPECT_EQ(spyReset.count(), 1);
+    EXPECT_EQ(spyAdded.count(), 1);
+    EXPECT_EQ(graphDataModel.size(), 101);
+}
+
+TEST(GraphDataModel, bulkRemove)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add(GraphDataModelTest::createGraphList(10));
+
+    QSignalSpy spyReset(&graphDataModel, SIGNAL(modelReset()));
+    QSignalSpy spyRemoved(&graphDataModel, SIGNAL(removed(quint32)));
+
+    graphDataModel.removeRegisters(QList<qint32>() << 7 << 2 << 3);
+
+    EXPECT_EQ(spyReset.count(), 1);
+    EXPECT_EQ(spyRemoved.count(), 0);
+    ASSERT_EQ(graphDataModel.size(), 7);
+    EXPECT_EQ(graphDataModel.label(2), QString("Register 4"));
+    EXPECT_EQ(graphDataModel.label(5), QString("Register 8"));
+
+    graphDataModel.clear();
+
+    EXPECT_EQ(spyReset.count(), 2);
+    EXPECT_EQ(graphDataModel.size(), 0);
+    EXPECT_EQ(graphDataModel.activeCount(), 0);
+}
+
+TEST(GraphDataModel, activeIndex)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add(GraphDataModelTest::createGraphList(9));
+
+    /* Graphs 0, 3 and 6 are inactive */
+    EXPECT_EQ(graphDataModel.activeCount(), 6);
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(0), -1);
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(4), 2);
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(8), 5);
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(9), -1);
+    EXPECT_EQ(graphDataModel.convertToGraphIndex(2), 4);
+
+    graphDataModel.setActive(3, true);
+
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(3), 2);
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(4), 3);
+
+    graphDataModel.removeRegister(1);
+
+    EXPECT_EQ(graphDataModel.convertToActiveGraphIndex(3), 2);
+}
+
+TEST(GraphDataModel, registerIndex)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add(GraphDataModelTest::createGraphList(10));
+
+    quint16 reg;
+    quint16 bitmask;
+    quint8 connectionId;
+
+    EXPECT_TRUE(graphDataModel.isPresent(5, 0xFFFF));
+    EXPECT_FALSE(graphDataModel.isPresent(5, 0x00FF));
+    EXPECT_FALSE(graphDataModel.isPresent(10, 0xFFFF));
+    EXPECT_TRUE(graphDataModel.getDuplicate(&reg, &bitmask, &connectionId));
+
+    /* Same register on other connection isn't a duplicate */
+    graphDataModel.setRegisterAddress(7, 4);
+    EXPECT_TRUE(graphDataModel.getDuplicate(&reg, &bitmask, &connectionId));
+    EXPECT_FALSE(graphDataModel.isPresent(7, 0xFFFF));
+
+    graphDataModel.setConnectionId(7, 0);
+    EXPECT_FALSE(graphDataModel.getDuplicate(&reg, &bitmask, &connectionId));
+    EXPECT_EQ(reg, 4);
+    EXPECT_EQ(bitmask, 0xFFFF);
+    EXPECT_EQ(connectionId, 0);
+
+    graphDataModel.setBitmask(7, 0x0001);
+    EXPECT_TRUE(graphDataModel.getDuplicate(&reg, &bitmask, &connectionId));
+    EXPECT_TRUE(graphDataModel.isPresent(4, 0x0001));
+}
+
+TEST(GraphDataModel, registerSignedness)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add(GraphDataModelTest::createGraphList(3));
+
+    graphDataModel.setUnsigned(1, false);
+    graphDataModel.setUnsigned(2, false);
+    graphDataModel.setValueType(2, GraphData::VALUE_32BIT);
+
+    EXPECT_TRUE(graphDataModel.isRegisterUnsigned(0, 0));
+    EXPECT_FALSE(graphDataModel.isRegisterUnsigned(1, 1));
+    EXPECT_TRUE(graphDataModel.isRegisterUnsigned(0, 2));
+
+    /* Register without graph */
+    EXPECT_TRUE(graphDataModel.isRegisterUnsigned(0, 1));
+    EXPECT_TRUE(graphDataModel.isRegisterUnsigned(1, 3));
+}
+
+TEST(GraphDataModel, loadProject)
+{
+    const qint32 count = 20000;
+
+    SettingsModel settingsModel;
+    settingsModel.setRetentionSamples(SampleTimebase::cChunkSize);
+
+    GraphDataModel graphDataModel(&settingsModel);
+
+    quint16 reg;
+    quint16 bitmask;
+    quint8 connectionId;
+
+    /* Same steps as loading a project file */
+    graphDataModel.clear();
+    graphDataModel.add(GraphDataModelTest::createGraphList(count));
+
+    EXPECT_EQ(graphDataModel.size(), count);
+    EXPECT_EQ(graphDataModel.activeCount(), count - (count + 2) / 3);
+    EXPECT_TRUE(graphDataModel.getDuplicate(&reg, &bitmask, &connectionId));
+
+    qint32 activeIdx = 0;
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        ASSERT_TRUE(graphDataModel.isPresent(graphDataModel.registerAddress(idx), graphDataModel.bitmask(idx)));
+        ASSERT_EQ(graphDataModel.convertToActiveGraphIndex(idx), graphDataModel.isActive(idx) ? activeIdx : -1);
+
+        if (graphDataModel.isActive(idx))
+        {
+            activeIdx++;
+        }
+    }
+
+    /* Loaded registers have no samples */
+    EXPECT_EQ(graphDataModel.memorySize(0), 0);
+    EXPECT_EQ(graphDataModel.memorySize(1), 0);
+    EXPECT_FALSE(graphDataModel.samplesDropped());
+
+    /* Log with smaller project: oldest chunks are removed by retention */
+    graphDataModel.clear();
+    graphDataModel.add(GraphDataModelTest::createGraphList(30));
+
+    const qint32 rowCount = 3 * SampleTimebase::cChunkSize + 10;
+    for (qint32 row = 0; row < rowCount; row++)
+    {
+        QList<double> keyList;
+        QList<bool> successList;
+        QList<quint32> rawValueList;
+
+        for (qint32 idx = 0; idx < graphDataModel.activeCount(); idx++)
+        {
+            keyList.append(row * 10);
+            successList.append(true);
+            rawValueList.append(static_cast<quint32>(row));
+        }
+
+        graphDataModel.addSamples(keyList, successList, rawValueList);
+    }
+
+    EXPECT_TRUE(graphDataModel.samplesDropped());
+
+    qint64 graphMemorySize = 0;
+    for (quint32 idx = 0; idx < 30; idx++)
+    {
+        if (graphDataModel.isActive(idx))
+        {
+            const SampleSeries series = graphDataModel.series(idx);
+
+            EXPECT_EQ(series.size(), SampleTimebase::cChunkSize + 10);
+            EXPECT_EQ(series.value(series.size() - 1), static_cast<double>(rowCount - 1));
+
+            graphMemorySize += graphDataModel.memorySize(idx);
+        }
+        else
+        {
+            EXPECT_EQ(graphDataModel.memorySize(idx), 0);
+        }
+    }
+
+    /* Total includes time columns of both connections */
+    EXPECT_GT(graphMemorySize, 0);
+    EXPECT_GT(graphDataModel.totalMemorySize(), graphMemorySize);
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QList>
+#include <QtMath>
+
+#include "src/models/ingestfilter.h"
+
+using namespace testing;
+
+namespace IngestFilterTest
+{
+    typedef struct
+    {
+        double key;
+        quint32 rawValue;
+        bool bValid;
+    } Row;
+
+    /* Feed samples (raw value is index of sample) to filter and collect stored rows */
+    QList<Row> filterSamples(IngestFilter filter, const QList<double> &values, const QList<bool> &validList = QList<bool>())
+    {
+        QList<Row> rows;
+
+        for (qint32 idx = 0; idx < values.size(); idx++)
+        {
+            const bool bValid = idx < validList.size() ? validList[idx] : true;
+            quint32 rawValue = static_cast<quint32>(idx);
+
+            const IngestFilter::Action action = filter.process(idx, values[idx], bValid, &rawValue);
+
+            Row row;
+            row.key = idx;
+            row.rawValue = rawValue;
+            row.bValid = bValid;
+
+            if (action == IngestFilter::ACTION_REPLACE_LAST)
+            {
+                EXPECT_FALSE(rows.isEmpty());
+                rows.last() = row;
+            }
+            else
+            {
+                rows.append(row);
+            }
+        }
+
+        return rows;
+    }
+
+    /* Value of stored rows at key, hold previous row or linear between rows */
+    double reconstruct(const QList<Row> &rows, const QList<double> &values, double key, bool bLinear)
+    {
+        qint32 rowIdx = 0;
+        while ((rowIdx + 1 < rows.size()) && (rows[rowIdx + 1].key <= key))
+        {
+            rowIdx++;
+        }
+
+        const double value = values[static_cast<qint32>(rows[rowIdx].rawValue)];
+
+        if (bLinear && (rowIdx + 1 < rows.size()) && (rows[rowIdx].key < key))
+        {
+            const double nextValue = values[static_cast<qint32>(rows[rowIdx + 1].rawValue)];
+            const double fraction = (key - rows[rowIdx].key) / (rows[rowIdx + 1].key - rows[rowIdx].key);
+
+            return value + (nextValue - value) * fraction;
+        }
+
+        return value;
+    }
+
+    QList<double> noisySine(qint32 count)
+    {
+        QList<double> values;
+        for (qint32 idx = 0; idx < count; idx++)
+        {
+            values.append(100 * qSin(idx / 50.0) + (idx % 3) * 0.1);
+        }
+
+        return values;
+    }
+}
+
+TEST(IngestFilter, none)
+{
+    const QList<double> values = QList<double>() << 1 << 1 << 1 << 2;
+    const QList<IngestFilterTest::Row> rows = IngestFilterTest::filterSamples(IngestFilter(), values);
+
+    EXPECT_EQ(rows.size(), values.size());
+}
+
+TEST(IngestFilter, exactChange)
+{
+    const QList<double> values = QList<double>() << 5 << 5 << 5 << 7 << 7 << 5 << 5;
+    const QList<IngestFilterTest::Row> rows = IngestFilterTest::filterSamples(IngestFilter(IngestFilter::FILTER_EXACT_CHANGE), values);
+
+    /* Kept: 0, 3, 5; hold rows before every change and provisional last row */
+    ASSERT_EQ(rows.size(), 6);
+    EXPECT_EQ(rows[0].key, 0.0);
+    EXPECT_EQ(rows[1].key, 2.0);
+    EXPECT_EQ(rows[1].rawValue, 0u);
+    EXPECT_EQ(rows[2].key, 3.0);
+    EXPECT_EQ(rows[3].key, 4.0);
+    EXPECT_EQ(rows[3].rawValue, 3u);
+    EXPECT_EQ(rows[4].key, 5.0);
+    EXPECT_EQ(rows[5].key, 6.0);
+    EXPECT_EQ(rows[5].rawValue, 5u);
+
+    for (qint32 idx = 0; idx < values.size(); idx++)
+    {
+        EXPECT_EQ(IngestFilterTest::reconstruct(rows, values, idx, false), values[idx]);
+    }
+}
+
+TEST(IngestFilter, deadband)
+{
+    const QList<double> values = IngestFilterTest::noisySine(1000);
+    const double threshold = 10;
+    const QList<IngestFilterTest::Row> rows = IngestFilterTest::filterSamples(IngestFilter(IngestFilter::FILTER_DEADBAND, threshold), values);
+
+    EXPECT_LT(rows.size(), values.size() / 2);
+
+    for (qint32 idx = 0; idx < values.size(); idx++)
+    {
+        EXPECT_LE(qFabs(IngestFilterTest::reconstruct(rows, values, idx, false) - values[idx]), threshold);
+    }
+}
+
+TEST(IngestFilter, deadbandRelative)
+{
+    const QList<double> values = QList<double>() << 100 << 104 << 106 << 108 << 112;
+    const QList<IngestFilterTest::Row> rows = IngestFilterTest::filterSamples(IngestFilter(IngestFilter::FILTER_DEADBAND_RELATIVE, 5), values);
+
+    /* 5% of kept value: 106 is kept (of 100), 112 is kept (of 106) */
+    ASSERT_EQ(rows.size(), 5);
+    EXPECT_EQ(rows[0].rawValue, 0u);
+    EXPECT_EQ(rows[1].key, 1.0);
+    EXPECT_EQ(rows[1].rawValue, 0u);
+    EXPECT_EQ(rows[2].rawValue, 2u);
+    EXPECT_EQ(rows[3].key, 3.0);
+    EXPECT_EQ(rows[3].rawValue, 2u);
+    EXPECT_EQ(rows[4].rawValue, 4u);
+}
+
+TEST(IngestFilter, swingingDoor)
+{
+    const QList<double> values = IngestFilterTest::noisySine(1000);
+    const double threshold = 0.5;
+    const IngestFilter filter(IngestFilter::FILTER_SWINGING_DOOR, threshold);
+    const QList<IngestFilterTest::Row> rows = IngestFilterTest::filterSamples(filter, values);
+
+    EXPECT_TRUE(filter.isLinear());
+    EXPECT_LT(rows.size(), values.size() / 4);
+
+    /* Every kept row is an actual sample */
+    for (qint32 rowIdx = 0; rowIdx < rows.size(); rowIdx++)
+    {
+        EXPECT_EQ(rows[rowIdx].key, static_cast<double>(rows[rowIdx].rawValue));
+    }
+
+    for (qint32 idx = 0; idx < values.size(); idx++)
+    {
+        EXPECT_LE(qFabs(IngestFilterTest::reconstruct(rows, values, idx, true) - values[idx]), threshold + 1e-9);
+    }
+}
+
+TEST(IngestFilter, errors)
+{
+    const QList<double> values = QList<double>() << 1 << 1 << 0 << 0 << 0 << 1;
+    const QList<bool> validList = QList<bool>() << true << true << false << false << false << true;
+    const QList<IngestFilterTest::Row> rows = IngestFilterTest::filterSamples(IngestFilter(IngestFilter::FILTER_DEADBAND, 10), values, validList);
+
+    /* Every change in validity is kept */
+    ASSERT_EQ(rows.size(), 5);
+    EXPECT_TRUE(rows[1].bValid);
+    EXPECT_FALSE(rows[2].bValid);
+    EXPECT_EQ(rows[2].key, 2.0);
+    EXPECT_FALSE(rows[3].bValid);
+    EXPECT_EQ(rows[3].key, 4.0);
+    EXPECT_TRUE(rows[4].bValid);
+}
+
+TEST(IngestFilter, reset)
+{
+    IngestFilter filter(IngestFilter::FILTER_EXACT_CHANGE);
+    quint32 rawValue = 1;
+
+    EXPECT_EQ(filter.process(0, 1, true, &rawValue), IngestFilter::ACTION_APPEND);
+    EXPECT_EQ(filter.process(1, 1, true, &rawValue), IngestFilter::ACTION_APPEND);
+    EXPECT_EQ(filter.process(2, 1, true, &rawValue), IngestFilter::ACTION_REPLACE_LAST);
+
+    filter.reset();
+    EXPECT_EQ(filter.process(3, 1, true, &rawValue), IngestFilter::ACTION_APPEND);
+}
+
+TEST(IngestFilter, string)
+{
+    const QList<IngestFilter> filters = QList<IngestFilter>()
+                                            << IngestFilter()
+                                            << IngestFilter(IngestFilter::FILTER_EXACT_CHANGE)
+                                            << IngestFilter(IngestFilter::FILTER_DEADBAND, 0.5)
+                                            << IngestFilter(IngestFilter::FILTER_DEADBAND_RELATIVE, 2)
+                                            << IngestFilter(IngestFilter::FILTER_SWINGING_DOOR, 0.25);
+
+    for (qint32 idx = 0; idx < filters.size(); idx++)
+    {
+        IngestFilter parsed;
+        EXPECT_TRUE(IngestFilter::fromString(filters[idx].toString(), &parsed));
+        EXPECT_EQ(parsed, filters[idx]);
+    }
+
+    IngestFilter parsed;
+    EXPECT_TRUE(IngestFilter::fromString(" Deadband 1,5 ", &parsed));
+    EXPECT_EQ(parsed, IngestFilter(IngestFilter::FILTER_DEADBAND, 1.5));
+
+    EXPECT_TRUE(IngestFilter::fromString("", &parsed));
+    EXPECT_FALSE(parsed.isEnabled());
+
+    EXPECT_FALSE(IngestFilter::fromString("deadband", &parsed));
+    EXPECT_FALSE(IngestFilter::fromString("deadband -1", &parsed));
+    EXPECT_FALSE(IngestFilter::fromString("average 3", &parsed));
+}
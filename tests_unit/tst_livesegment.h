@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <cmath>
+#include <QTemporaryDir>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/importexport/livesegmentwriter.h"
+#include "src/importexport/livesegmentreader.h"
+
+#include "testgraphlist.h"
+
+using namespace testing;
+
+namespace LiveSegmentTest
+{
+    void publishRow(LiveSegmentWriter * pWriter, qint64 timestamp, QList<double> values, QList<bool> successList)
+    {
+        QList<qint64> timestampList;
+        QList<quint32> rawValues;
+
+        for (qint32 idx = 0; idx < values.size(); idx++)
+        {
+            timestampList.append(timestamp);
+            rawValues.append(static_cast<quint32>(values[idx]));
+        }
+
+        pWriter->publishData(successList, values, timestampList, rawValues);
+    }
+}
+
+TEST(LiveSegment, publishAndRead)
+{
+    QTemporaryDir dir;
+    const QString filePath = dir.filePath("live.shm");
+
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+    TestGraphList::add(&graphDataModel, 3, 2);
+    graphDataModel.setActive(1, false);
+
+    LiveSegmentWriter writer(&graphDataModel);
+    ASSERT_TRUE(writer.start(filePath));
+
+    LiveSegmentReader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    EXPECT_TRUE(reader.isRunning());
+
+    /* Only active graphs are published */
+    ASSERT_EQ(reader.channelCount(), 2);
+    EXPECT_EQ(reader.label(1), QString("Register 2"));
+    EXPECT_EQ(reader.registerAddress(1), 40003);
+    EXPECT_EQ(reader.connectionId(1), 0);
+    EXPECT_EQ(reader.writeCount(), 0u);
+
+    LiveSegmentTest::publishRow(&writer, 1000, QList<double>() << 1.5 << 2, QList<bool>() << true << true);
+    LiveSegmentTest::publishRow(&writer, 1250, QList<double>() << 3 << 0, QList<bool>() << true << false);
+
+    ASSERT_EQ(reader.writeCount(), 2u);
+
+    qint64 timestamp;
+    QList<double> values;
+
+    ASSERT_TRUE(reader.readRow(0, &timestamp, &values));
+    EXPECT_EQ(timestamp, 1000);
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(values[0], 1.5);
+    EXPECT_EQ(values[1], 2.0);
+
+    /* Register that couldn't be read */
+    ASSERT_TRUE(reader.readRow(1, &timestamp, &values));
+    EXPECT_EQ(timestamp, 1250);
+    EXPECT_EQ(values[0], 3.0);
+    EXPECT_TRUE(std::isnan(values[1]));
+
+    EXPECT_FALSE(reader.readRow(2, &timestamp, &values));
+
+    writer.stop();
+    EXPECT_FALSE(reader.isRunning());
+    EXPECT_TRUE(reader.readRow(1, &timestamp, &values));
+}
+
+TEST(LiveSegment, ringOverwrite)
+{
+    QTemporaryDir dir;
+    const QString filePath = dir.filePath("live.shm");
+
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+    TestGraphList::add(&graphDataModel, 1, 2);
+
+    LiveSegmentWriter writer(&graphDataModel);
+    ASSERT_TRUE(writer.start(filePath, 4));
+
+    LiveSegmentReader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    EXPECT_EQ(reader.capacity(), 4u);
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        LiveSegmentTest::publishRow(&writer, idx * 100, QList<double>() << idx, QList<bool>() << true);
+    }
+
+    EXPECT_EQ(reader.writeCount(), 10u);
+    EXPECT_EQ(reader.firstAvailableRow(), 6u);
+
+    qint64 timestamp;
+    QList<double> values;
+
+    /* Slot is reused by row 9 */
+    EXPECT_FALSE(reader.readRow(5, &timestamp, &values));
+
+    ASSERT_TRUE(reader.readRow(6, &timestamp, &values));
+    EXPECT_EQ(timestamp, 600);
+    EXPECT_EQ(values[0], 6.0);
+
+    ASSERT_TRUE(reader.readRow(9, &timestamp, &values));
+    EXPECT_EQ(values[0], 9.0);
+}
+
+TEST(LiveSegment, layoutChanged)
+{
+    QTemporaryDir dir;
+    const QString filePath = dir.filePath("live.shm");
+
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+    TestGraphList::add(&graphDataModel, 2, 2);
+
+    LiveSegmentWriter writer(&graphDataModel);
+    ASSERT_TRUE(writer.start(filePath, 16));
+
+    LiveSegmentReader reader;
+    ASSERT_TRUE(reader.open(filePath));
+
+    LiveSegmentTest::publishRow(&writer, 0, QList<double>() << 1 << 2, QList<bool>() << true << true);
+    EXPECT_FALSE(reader.isLayoutChanged());
+
+    /* New log with more registers: segment grows */
+    TestGraphList::add(&graphDataModel, 2, 2);
+    writer.stop();
+    ASSERT_TRUE(writer.start(filePath, 1000));
+
+    qint64 timestamp;
+    QList<double> values;
+
+    EXPECT_TRUE(reader.isLayoutChanged());
+    EXPECT_FALSE(reader.readRow(0, &timestamp, &values));
+
+    ASSERT_TRUE(reader.open(filePath));
+    EXPECT_FALSE(reader.isLayoutChanged());
+    EXPECT_EQ(reader.channelCount(), 4);
+    EXPECT_EQ(reader.capacity(), 1000u);
+    EXPECT_EQ(reader.writeCount(), 0u);
+
+    LiveSegmentTest::publishRow(&writer, 0, QList<double>() << 1 << 2 << 3 << 4, QList<bool>() << true << true << true << true);
+
+    ASSERT_TRUE(reader.readRow(0, &timestamp, &values));
+    ASSERT_EQ(values.size(), 4);
+    EXPECT_EQ(values[0], 1.0);
+    EXPECT_EQ(values[3], 4.0);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QSignalSpy>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/models/memoryforecast.h"
+
+#include "testgraphlist.h"
+
+using namespace testing;
+
+namespace MemoryForecastTest
+{
+    /* Add rows with a sample for every active graph */
+    void addRows(GraphDataModel * pGraphDataModel, qint32 rowCount)
+    {
+        const qint32 graphCount = pGraphDataModel->activeCount();
+        for (qint32 row = 0; row < rowCount; row++)
+        {
+            QList<double> keyList;
+            QList<bool> successList;
+            QList<quint32> rawValueList;
+
+            for (qint32 idx = 0; idx < graphCount; idx++)
+            {
+                keyList.append(row * 10);
+                successList.append(true);
+                rawValueList.append(static_cast<quint32>(row * (idx + 1)));
+            }
+
+            pGraphDataModel->addSamples(keyList, successList, rawValueList);
+        }
+    }
+}
+
+TEST(MemoryForecast, growthRate)
+{
+    MemoryForecast forecast;
+
+    forecast.addMeasurement(0, 1000);
+    EXPECT_FALSE(forecast.hasGrowthRate());
+    EXPECT_EQ(forecast.timeUntilLimit(2000), -1);
+
+    /* 100 bytes per second */
+    for (qint32 idx = 1; idx <= 10; idx++)
+    {
+        forecast.addMeasurement(idx * 1000, 1000 + idx * 100);
+    }
+
+    ASSERT_TRUE(forecast.hasGrowthRate());
+    EXPECT_DOUBLE_EQ(forecast.growthRate(), 100);
+    EXPECT_EQ(forecast.size(), 2000);
+    EXPECT_EQ(forecast.timeUntilLimit(3000), 10000);
+    EXPECT_EQ(forecast.timeUntilLimit(1500), 0);
+
+    forecast.clear();
+    EXPECT_FALSE(forecast.hasGrowthRate());
+    EXPECT_EQ(forecast.size(), 0);
+}
+
+TEST(MemoryForecast, window)
+{
+    MemoryForecast forecast;
+
+    /* Fast growth at start is outside window after two minutes */
+    forecast.addMeasurement(0, 0);
+    forecast.addMeasurement(1000, 100000);
+
+    for (qint32 idx = 2; idx <= 120; idx++)
+    {
+        forecast.addMeasurement(idx * 1000, 100000 + (idx - 1) * 10);
+    }
+
+    EXPECT_DOUBLE_EQ(forecast.growthRate(), 10);
+
+    /* Retention removed samples: memory doesn't grow */
+    forecast.clear();
+    forecast.addMeasurement(0, 5000);
+    forecast.addMeasurement(10000, 4000);
+
+    EXPECT_LT(forecast.growthRate(), 0);
+    EXPECT_EQ(forecast.timeUntilLimit(10000), -1);
+}
+
+TEST(MemoryForecast, graphMemorySize)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+    TestGraphList::add(&graphDataModel, 3);
+
+    EXPECT_EQ(graphDataModel.memorySize(0), 0);
+
+    MemoryForecastTest::addRows(&graphDataModel, 1000);
+
+    qint64 graphSize = 0;
+    for (quint32 idx = 0; idx < 3; idx++)
+    {
+        EXPECT_GT(graphDataModel.memorySize(idx), 0);
+        graphSize += graphDataModel.memorySize(idx);
+    }
+
+    /* Total includes time column of connection */
+    EXPECT_GT(graphDataModel.totalMemorySize(), graphSize);
+}
+
+TEST(MemoryForecast, stopAtMemoryLimit)
+{
+    SettingsModel settingsModel;
+    settingsModel.setRetentionMemory(1);
+    settingsModel.setStopAtMemoryLimit(true);
+
+    GraphDataModel graphDataModel(&settingsModel);
+    TestGraphList::add(&graphDataModel, 10);
+
+    QSignalSpy spyLimit(&graphDataModel, SIGNAL(memoryLimitReached()));
+
+    MemoryForecastTest::addRows(&graphDataModel, 100000);
+
+    /* Signal is emitted once, no samples are removed */
+    EXPECT_EQ(spyLimit.count(), 1);
+    EXPECT_FALSE(graphDataModel.samplesDropped());
+    EXPECT_GT(graphDataModel.totalMemorySize(), 1024 * 1024);
+
+    /* Drop oldest samples instead */
+    settingsModel.setStopAtMemoryLimit(false);
+
+    EXPECT_EQ(spyLimit.count(), 1);
+    EXPECT_TRUE(graphDataModel.samplesDropped());
+    EXPECT_LE(graphDataModel.totalMemorySize(), 1024 * 1024);
+}
+
+TEST(MemoryForecast, dropAtMemoryLimit)
+{
+    SettingsModel settingsModel;
+    settingsModel.setRetentionMemory(1);
+
+    GraphDataModel graphDataModel(&settingsModel);
+    TestGraphList::add(&graphDataModel, 10);
+
+    /* Graph with its own time column */
+    graphDataModel.setIngestFilter(0, IngestFilter(IngestFilter::FILTER_DEADBAND, 0.5));
+
+    MemoryForecastTest::addRows(&graphDataModel, 100000);
+
+    /* Oldest samples are removed while samples are added, not more than needed */
+    EXPECT_TRUE(graphDataModel.samplesDropped());
+    EXPECT_LE(graphDataModel.totalMemorySize(), 1024 * 1024);
+    EXPECT_GT(graphDataModel.totalMemorySize(), 512 * 1024);
+
+    /* Samples of removed graph don't count anymore */
+    graphDataModel.removeRegister(9);
+    MemoryForecastTest::addRows(&graphDataModel, 10000);
+
+    EXPECT_LE(graphDataModel.totalMemorySize(), 1024 * 1024);
+    EXPECT_GT(graphDataModel.totalMemorySize(), 512 * 1024);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "src/models/polltracemodel.h"
+#include "src/customwidgets/polltimeline.h"
+
+using namespace testing;
+
+TEST(PollTraceModel, cycles)
+{
+    PollTraceModel traceModel;
+
+    traceModel.addEventAt(0, PollTraceModel::CYCLE_START, 100, 0, 2);
+    traceModel.addEventAt(0, PollTraceModel::READ_SEND, 110, 40001, 2);
+    traceModel.addEventAt(0, PollTraceModel::READ_SUCCESS, 150, 40001, 2);
+    traceModel.addEventAt(0, PollTraceModel::RESULT, 160, 0, 2);
+    traceModel.addEventAt(0, PollTraceModel::CYCLE_START, 200, 0, 2);
+
+    EXPECT_EQ(traceModel.cycleCount(0), 2);
+    EXPECT_EQ(traceModel.cycleCount(1), 0);
+
+    PollTraceModel::Cycle cycle = traceModel.cycle(0, 0);
+    ASSERT_EQ(cycle.size(), 4);
+    EXPECT_EQ(cycle[1].type, PollTraceModel::READ_SEND);
+    EXPECT_EQ(cycle[1].time, 110);
+    EXPECT_EQ(cycle[1].address, 40001);
+    EXPECT_EQ(cycle[1].count, 2);
+
+    EXPECT_TRUE(traceModel.cycle(0, 2).isEmpty());
+}
+
+TEST(PollTraceModel, maxCycles)
+{
+    PollTraceModel traceModel;
+    traceModel.setMaxCycles(3);
+
+    for (qint32 idx = 0; idx < 5; idx++)
+    {
+        traceModel.addEventAt(0, PollTraceModel::CYCLE_START, idx * 100);
+    }
+
+    ASSERT_EQ(traceModel.cycleCount(0), 3);
+    EXPECT_EQ(traceModel.cycle(0, 0).first().time, 200);
+    EXPECT_EQ(traceModel.cycle(0, 2).first().time, 400);
+
+    traceModel.clear();
+    EXPECT_EQ(traceModel.cycleCount(0), 0);
+}
+
+TEST(PollTraceModel, segments)
+{
+    PollTraceModel traceModel;
+
+    traceModel.addEventAt(0, PollTraceModel::CYCLE_START, 0);
+    traceModel.addEventAt(0, PollTraceModel::CONNECT_START, 10);
+    traceModel.addEventAt(0, PollTraceModel::CONNECT_END, 30);
+    traceModel.addEventAt(0, PollTraceModel::READ_SEND, 40, 40001, 10);
+    traceModel.addEventAt(0, PollTraceModel::READ_EXCEPTION, 60, 40001, 10);
+    traceModel.addEventAt(0, PollTraceModel::SPLIT, 61, 40001, 10);
+    traceModel.addEventAt(0, PollTraceModel::RESULT, 200, 0, 10);
+    traceModel.addEventAt(0, PollTraceModel::PROCESSED, 250);
+
+    QList<PollTimeline::Segment> segmentList = PollTimeline::segments(traceModel.cycle(0, 0));
+
+    ASSERT_EQ(segmentList.size(), 5);
+
+    EXPECT_EQ(segmentList[0].type, PollTraceModel::CONNECT_END);
+    EXPECT_EQ(segmentList[0].startTime, 10);
+    EXPECT_EQ(segmentList[0].endTime, 30);
+
+    EXPECT_EQ(segmentList[1].type, PollTraceModel::READ_EXCEPTION);
+    EXPECT_EQ(segmentList[1].startTime, 40);
+    EXPECT_EQ(segmentList[1].endTime, 60);
+    EXPECT_EQ(segmentList[1].address, 40001);
+
+    EXPECT_EQ(segmentList[2].type, PollTraceModel::SPLIT);
+    EXPECT_EQ(segmentList[2].startTime, 61);
+    EXPECT_EQ(segmentList[2].endTime, 61);
+
+    EXPECT_EQ(segmentList[3].type, PollTraceModel::RESULT);
+
+    EXPECT_EQ(segmentList[4].type, PollTraceModel::PROCESSED);
+    EXPECT_EQ(segmentList[4].startTime, 200);
+    EXPECT_EQ(segmentList[4].endTime, 250);
+}
@@ -105,6 +105,59 @@ TEST(ReadRegisters, consecutive_3)
     EXPECT_FALSE(readRegister.hasNext());
 }
 
+TEST(ReadRegisters, registerPair_1)
+{
+    ReadRegisters readRegister;
+    QList<quint16> registerList = QList<quint16>() << 0 << 1 << 2 << 3;
+    QList<quint16> pairList = QList<quint16>() << 2;
+
+    readRegister.resetRead(registerList, 3, pairList);
+
+    verifyAndAddErrorResult(&readRegister, 0, 2);
+    verifyAndAddErrorResult(&readRegister, 2, 2);
+
+    EXPECT_FALSE(readRegister.hasNext());
+}
+
+TEST(ReadRegisters, registerPair_2)
+{
+    ReadRegisters readRegister;
+    QList<quint16> registerList = QList<quint16>() << 0 << 1 << 2 << 5;
+    QList<quint16> pairList = QList<quint16>() << 1;
+
+    readRegister.resetRead(registerList, 1, pairList);
+
+    verifyAndAddErrorResult(&readRegister, 0, 1);
+    verifyAndAddErrorResult(&readRegister, 1, 2);
+    verifyAndAddErrorResult(&readRegister, 5, 1);
+
+    EXPECT_FALSE(readRegister.hasNext());
+}
+
+TEST(ReadRegisters, registerPairSplit)
+{
+    ReadRegisters readRegister;
+    QList<quint16> registerList = QList<quint16>() << 0 << 1 << 2 << 3 << 4;
+    QList<quint16> pairList = QList<quint16>() << 1 << 3;
+
+    readRegister.resetRead(registerList, 100, pairList);
+
+    EXPECT_TRUE(readRegister.hasNext());
+    EXPECT_EQ(readRegister.next().address(), 0);
+    EXPECT_EQ(readRegister.next().count(), 5);
+
+    EXPECT_TRUE(readRegister.splitNextToSingleReads());
+
+    verifyAndAddErrorResult(&readRegister, 0, 1);
+
+    EXPECT_FALSE(readRegister.splitNextToSingleReads());
+
+    verifyAndAddErrorResult(&readRegister, 1, 2);
+    verifyAndAddErrorResult(&readRegister, 3, 2);
+
+    EXPECT_FALSE(readRegister.hasNext());
+}
+
 TEST(ReadRegisters, splitNextToSingleReads_1)
 {
     ReadRegisters readRegister;
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QtMath>
+#include <QtNumeric>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/models/runningstatistics.h"
+#include "src/models/statisticsmodel.h"
+
+using namespace testing;
+
+namespace RunningStatisticsTest
+{
+    QString cellText(StatisticsModel * pModel, qint32 row, StatisticsModel::Column column)
+    {
+        return pModel->data(pModel->index(row, column)).toString();
+    }
+}
+
+TEST(RunningStatistics, welford)
+{
+    RunningStatistics statistics;
+
+    EXPECT_EQ(statistics.count(), 0u);
+    EXPECT_EQ(statistics.standardDeviation(), 0.0);
+
+    const QList<double> values = QList<double>() << 2 << 4 << 4 << 4 << 5 << 5 << 7 << 9;
+    for (qint32 idx = 0; idx < values.size(); idx++)
+    {
+        statistics.add(idx, values[idx]);
+    }
+
+    EXPECT_EQ(statistics.count(), 8u);
+    EXPECT_EQ(statistics.mean(), 5.0);
+    EXPECT_DOUBLE_EQ(statistics.variance(), 32.0 / 7);
+    EXPECT_DOUBLE_EQ(statistics.standardDeviation(), qSqrt(32.0 / 7));
+    EXPECT_EQ(statistics.min(), 2.0);
+    EXPECT_EQ(statistics.max(), 9.0);
+    EXPECT_EQ(statistics.last(), 9.0);
+}
+
+TEST(RunningStatistics, largeOffset)
+{
+    RunningStatistics statistics;
+
+    /* Naive sum of squares would lose all precision */
+    statistics.add(0, 1e9 + 4);
+    statistics.add(1, 1e9 + 7);
+    statistics.add(2, 1e9 + 13);
+    statistics.add(3, 1e9 + 16);
+
+    EXPECT_EQ(statistics.mean(), 1e9 + 10);
+    EXPECT_DOUBLE_EQ(statistics.variance(), 30.0);
+}
+
+TEST(RunningStatistics, window)
+{
+    /* Window of 1 s */
+    RunningStatistics statistics(1000);
+
+    statistics.add(0, 5);
+    statistics.add(250, 1);
+    statistics.add(500, 8);
+    statistics.add(750, 3);
+
+    EXPECT_EQ(statistics.windowCount(), 4);
+    EXPECT_EQ(statistics.windowMin(), 1.0);
+    EXPECT_EQ(statistics.windowMax(), 8.0);
+    EXPECT_EQ(statistics.windowMean(), 4.25);
+
+    /* First sample leaves window */
+    statistics.add(1000, 4);
+    EXPECT_EQ(statistics.windowCount(), 4);
+    EXPECT_EQ(statistics.windowMean(), 4.0);
+
+    /* Minimum and maximum leave window */
+    statistics.add(1500, 2);
+    EXPECT_EQ(statistics.windowCount(), 3);
+    EXPECT_EQ(statistics.windowMin(), 2.0);
+    EXPECT_EQ(statistics.windowMax(), 4.0);
+
+    /* Overall statistics are kept */
+    EXPECT_EQ(statistics.count(), 6u);
+    EXPECT_EQ(statistics.min(), 1.0);
+    EXPECT_EQ(statistics.max(), 8.0);
+
+    /* Gap: only new sample is in window */
+    statistics.add(5000, 6);
+    EXPECT_EQ(statistics.windowCount(), 1);
+    EXPECT_EQ(statistics.windowMin(), 6.0);
+    EXPECT_EQ(statistics.windowMax(), 6.0);
+    EXPECT_EQ(statistics.windowMean(), 6.0);
+}
+
+TEST(RunningStatistics, slidingWindow)
+{
+    RunningStatistics statistics(100);
+
+    /* Compare with scan of window, queues are compacted several times */
+    for (qint32 key = 0; key < 2000; key++)
+    {
+        const double value = (key * 37) % 101;
+        statistics.add(key, value);
+
+        double min = value;
+        double max = value;
+        double sum = 0;
+        qint32 count = 0;
+        for (qint32 windowKey = qMax(0, key - 99); windowKey <= key; windowKey++)
+        {
+            const double windowValue = (windowKey * 37) % 101;
+            min = qMin(min, windowValue);
+            max = qMax(max, windowValue);
+            sum += windowValue;
+            count++;
+        }
+
+        ASSERT_EQ(statistics.windowCount(), count);
+        ASSERT_EQ(statistics.windowMin(), min);
+        ASSERT_EQ(statistics.windowMax(), max);
+        ASSERT_DOUBLE_EQ(statistics.windowMean(), sum / count);
+    }
+}
+
+TEST(RunningStatistics, notFinite)
+{
+    RunningStatistics statistics;
+
+    statistics.add(0, 1);
+    statistics.add(1, qQNaN());
+    statistics.add(2, qInf());
+    statistics.add(3, 3);
+
+    EXPECT_EQ(statistics.count(), 2u);
+    EXPECT_EQ(statistics.mean(), 2.0);
+    EXPECT_EQ(statistics.windowCount(), 2);
+    EXPECT_EQ(statistics.max(), 3.0);
+}
+
+TEST(StatisticsModel, activeGraphs)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.add();
+    graphDataModel.add();
+    graphDataModel.setLabel(0, "First");
+    graphDataModel.setLabel(2, "Third");
+    graphDataModel.setActive(1, false);
+
+    StatisticsModel statisticsModel(&graphDataModel);
+    statisticsModel.start();
+
+    ASSERT_EQ(statisticsModel.rowCount(), 2);
+    EXPECT_EQ(statisticsModel.graphIndex(1), 2u);
+    EXPECT_EQ(RunningStatisticsTest::cellText(&statisticsModel, 1, StatisticsModel::COLUMN_NAME), QString("Third"));
+
+    /* No values yet */
+    EXPECT_EQ(RunningStatisticsTest::cellText(&statisticsModel, 0, StatisticsModel::COLUMN_MEAN), QString());
+
+    statisticsModel.processSample(1000, QList<bool>() << true << true, QList<double>() << 1 << 10);
+    statisticsModel.processSample(1100, QList<bool>() << true << false, QList<double>() << 3 << 0);
+
+    EXPECT_EQ(statisticsModel.statistics(0).count(), 2u);
+    EXPECT_EQ(statisticsModel.statistics(0).mean(), 2.0);
+
+    /* Failed read isn't counted */
+    EXPECT_EQ(statisticsModel.statistics(1).count(), 1u);
+    EXPECT_EQ(statisticsModel.statistics(1).last(), 10.0);
+
+    statisticsModel.setWindowDuration(60);
+    EXPECT_EQ(statisticsModel.statistics(0).windowDuration(), 60000.0);
+
+    statisticsModel.reset();
+    EXPECT_EQ(statisticsModel.rowCount(), 2);
+    EXPECT_EQ(statisticsModel.statistics(0).count(), 0u);
+
+    /* Graph index isn't valid after change of graphs */
+    graphDataModel.add();
+    EXPECT_EQ(statisticsModel.rowCount(), 0);
+}
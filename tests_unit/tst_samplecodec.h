@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <cstring>
+#include <QtMath>
+
+#include "src/models/samplecodec.h"
+#include "src/models/sampletimebase.h"
+#include "src/models/samplecolumn.h"
+
+using namespace testing;
+
+namespace SampleCodecTest
+{
+    const qint32 cCount = 4096;
+
+    /* Slow changing register value with noise in lowest bit */
+    quint32 registerValue(qint32 idx)
+    {
+        return static_cast<quint32>(1000 + 200 * qSin(idx / 300.0)) + static_cast<quint32>(idx % 7 == 0);
+    }
+
+    void fillValues(SampleCodec::Format format, QByteArray * pChunk)
+    {
+        *pChunk = QByteArray(SampleCodec::chunkBytes(format, cCount), 0);
+
+        for (qint32 idx = 0; idx < cCount; idx++)
+        {
+            if (format == SampleCodec::FORMAT_16BIT)
+            {
+                const quint16 value = static_cast<quint16>(registerValue(idx));
+                std::memcpy(pChunk->data() + idx * 2, &value, sizeof(value));
+            }
+            else if (format == SampleCodec::FORMAT_32BIT)
+            {
+                const quint32 value = registerValue(idx) << 12;
+                std::memcpy(pChunk->data() + idx * 4, &value, sizeof(value));
+            }
+            else
+            {
+                const double value = registerValue(idx) / 10.0;
+                std::memcpy(pChunk->data() + idx * 8, &value, sizeof(value));
+            }
+        }
+    }
+
+    QByteArray roundTrip(SampleCodec::Format format, const QByteArray &chunk, qint32 * pCompressedSize)
+    {
+        const QByteArray compressed = SampleCodec::compress(format, cCount, chunk.constData());
+        QByteArray result(chunk.size(), 0);
+
+        *pCompressedSize = compressed.size();
+
+        EXPECT_TRUE(SampleCodec::decompress(format, cCount, compressed, result.data()));
+
+        return result;
+    }
+}
+
+TEST(SampleCodec, periodicKeys)
+{
+    /* Poll time of 10 ms with some jitter */
+    QVector<double> keys(SampleCodecTest::cCount);
+    for (qint32 idx = 0; idx < keys.size(); idx++)
+    {
+        keys[idx] = 1500000000000.0 + idx * 10 + (idx % 5 == 0 ? 1 : 0);
+    }
+
+    const QByteArray chunk(reinterpret_cast<const char *>(keys.constData()), keys.size() * static_cast<qint32>(sizeof(double)));
+
+    qint32 compressedSize;
+    EXPECT_EQ(SampleCodecTest::roundTrip(SampleCodec::FORMAT_KEYS, chunk, &compressedSize), chunk);
+    EXPECT_LT(compressedSize * 10, chunk.size());
+}
+
+TEST(SampleCodec, fractionalKeys)
+{
+    QVector<double> keys(SampleCodecTest::cCount);
+    for (qint32 idx = 0; idx < keys.size(); idx++)
+    {
+        keys[idx] = idx * 0.37;
+    }
+
+    const QByteArray chunk(reinterpret_cast<const char *>(keys.constData()), keys.size() * static_cast<qint32>(sizeof(double)));
+
+    qint32 compressedSize;
+    EXPECT_EQ(SampleCodecTest::roundTrip(SampleCodec::FORMAT_KEYS, chunk, &compressedSize), chunk);
+}
+
+TEST(SampleCodec, values)
+{
+    const QList<SampleCodec::Format> formats = QList<SampleCodec::Format>()
+                                                << SampleCodec::FORMAT_16BIT
+                                                << SampleCodec::FORMAT_32BIT
+                                                << SampleCodec::FORMAT_DOUBLE;
+
+    for (qint32 formatIdx = 0; formatIdx < formats.size(); formatIdx++)
+    {
+        QByteArray chunk;
+        SampleCodecTest::fillValues(formats[formatIdx], &chunk);
+
+        const qint32 validityOffset = chunk.size() - SampleCodecTest::cCount / 8;
+        qint32 compressedSize;
+
+        /* All samples invalid */
+        EXPECT_EQ(SampleCodecTest::roundTrip(formats[formatIdx], chunk, &compressedSize), chunk);
+
+        /* All samples valid */
+        std::memset(chunk.data() + validityOffset, 0xFF, SampleCodecTest::cCount / 8);
+        EXPECT_EQ(SampleCodecTest::roundTrip(formats[formatIdx], chunk, &compressedSize), chunk);
+        EXPECT_LT(compressedSize, chunk.size());
+
+        /* Some errors */
+        chunk[validityOffset + 3] = 0x5A;
+        EXPECT_EQ(SampleCodecTest::roundTrip(formats[formatIdx], chunk, &compressedSize), chunk);
+    }
+}
+
+TEST(SampleCodec, invalidData)
+{
+    QByteArray chunk;
+    SampleCodecTest::fillValues(SampleCodec::FORMAT_16BIT, &chunk);
+
+    QByteArray compressed = SampleCodec::compress(SampleCodec::FORMAT_16BIT, SampleCodecTest::cCount, chunk.constData());
+    compressed.truncate(compressed.size() / 2);
+
+    EXPECT_FALSE(SampleCodec::decompress(SampleCodec::FORMAT_16BIT, SampleCodecTest::cCount, compressed, chunk.data()));
+}
+
+TEST(SampleCodec, compressedStore)
+{
+    SampleTimebase timebase;
+    SampleColumn column(SampleColumn::TYPE_16BIT);
+    const qint32 count = SampleTimebase::cChunkSize * 20 + 10;
+
+    timebase.setCompressed(true);
+    column.setCompressed(true);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        timebase.append(idx * 10);
+        column.append(SampleCodecTest::registerValue(idx), (idx % 1000) != 0);
+    }
+
+    /* Two most recent chunks aren't compressed, sealed chunks should be at least 5 times smaller */
+    const qint64 rawChunkSize = SampleCodec::chunkBytes(SampleCodec::FORMAT_KEYS, SampleTimebase::cChunkSize)
+                                + SampleCodec::chunkBytes(SampleCodec::FORMAT_16BIT, SampleTimebase::cChunkSize);
+    const qint64 sealedSize = timebase.memorySize() + column.memorySize() - 2 * rawChunkSize;
+    EXPECT_LT(sealedSize * 5, (timebase.chunkCount() - 2) * rawChunkSize);
+
+    for (qint32 idx = 0; idx < count; idx += 331)
+    {
+        EXPECT_EQ(timebase.key(idx), idx * 10.0);
+        EXPECT_EQ(column.rawValue(idx), static_cast<quint16>(SampleCodecTest::registerValue(idx)));
+        EXPECT_EQ(column.isValid(idx), (idx % 1000) != 0);
+    }
+
+    EXPECT_EQ(timebase.findBegin(12345.0, false), 1235);
+    EXPECT_EQ(timebase.findEnd(12345.0, false), 1235);
+
+    /* Cached chunks move along with removed chunks */
+    timebase.removeFirstChunk();
+    column.removeFirstChunk();
+    EXPECT_EQ(timebase.key(0), SampleTimebase::cChunkSize * 10.0);
+    EXPECT_EQ(column.rawValue(0), static_cast<quint16>(SampleCodecTest::registerValue(SampleTimebase::cChunkSize)));
+
+    /* Chunks stay compressed when compression is disabled */
+    timebase.setCompressed(false);
+    EXPECT_EQ(timebase.key(SampleTimebase::cChunkSize), SampleTimebase::cChunkSize * 20.0);
+}
+
+TEST(SampleCodec, jitteredKeysAndSaturatedValues)
+{
+    /* Poll time with jitter of 1 ms */
+    QVector<double> keys(SampleCodecTest::cCount);
+    for (qint32 idx = 0; idx < keys.size(); idx++)
+    {
+        keys[idx] = 1500000000000.0 + idx * 10 + (idx % 5 == 0 ? 1 : 0);
+    }
+
+    /* All samples valid (validity bits follow the values) */
+    QByteArray values;
+    SampleCodecTest::fillValues(SampleCodec::FORMAT_16BIT, &values);
+    std::memset(values.data() + values.size() - SampleCodecTest::cCount / 8, 0xFF, SampleCodecTest::cCount / 8);
+
+    const QByteArray rawKeys(reinterpret_cast<const char *>(keys.constData()), keys.size() * static_cast<qint32>(sizeof(double)));
+
+    qint32 keysSize = 0;
+    qint32 valuesSize = 0;
+    EXPECT_EQ(SampleCodecTest::roundTrip(SampleCodec::FORMAT_KEYS, rawKeys, &keysSize), rawKeys);
+    EXPECT_EQ(SampleCodecTest::roundTrip(SampleCodec::FORMAT_16BIT, values, &valuesSize), values);
+
+    EXPECT_LT(keysSize * 8, rawKeys.size());
+    EXPECT_LT(valuesSize * 2, values.size());
+}
@@ -0,0 +1,346 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QTemporaryDir>
+
+#include "src/models/sampletimebase.h"
+#include "src/models/samplecolumn.h"
+#include "src/models/sampleseries.h"
+
+using namespace testing;
+
+TEST(SampleStore, timebaseChunks)
+{
+    SampleTimebase timebase;
+    const qint32 count = SampleTimebase::cChunkSize * 2 + 10;
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        timebase.append(idx * 10);
+    }
+
+    ASSERT_EQ(timebase.size(), count);
+    EXPECT_EQ(timebase.key(SampleTimebase::cChunkSize - 1), (SampleTimebase::cChunkSize - 1) * 10.0);
+    EXPECT_EQ(timebase.key(SampleTimebase::cChunkSize), SampleTimebase::cChunkSize * 10.0);
+    EXPECT_EQ(timebase.key(count - 1), (count - 1) * 10.0);
+
+    bool bFound;
+    QCPRange range = timebase.keyRange(bFound);
+    EXPECT_TRUE(bFound);
+    EXPECT_EQ(range.lower, 0.0);
+    EXPECT_EQ(range.upper, (count - 1) * 10.0);
+
+    timebase.clear();
+    EXPECT_EQ(timebase.size(), 0);
+    timebase.keyRange(bFound);
+    EXPECT_FALSE(bFound);
+}
+
+TEST(SampleStore, timebaseAscending)
+{
+    SampleTimebase timebase;
+
+    timebase.append(100);
+    timebase.append(50);
+
+    EXPECT_EQ(timebase.key(1), 100.0);
+}
+
+TEST(SampleStore, timebaseFind)
+{
+    SampleTimebase timebase;
+
+    timebase.append(100);
+    timebase.append(200);
+    timebase.append(300);
+
+    EXPECT_EQ(timebase.findBegin(200, false), 1);
+    EXPECT_EQ(timebase.findBegin(150, false), 1);
+    EXPECT_EQ(timebase.findBegin(150, true), 0);
+    EXPECT_EQ(timebase.findBegin(50, true), 0);
+    EXPECT_EQ(timebase.findBegin(400, false), 3);
+
+    EXPECT_EQ(timebase.findEnd(200, false), 2);
+    EXPECT_EQ(timebase.findEnd(250, false), 2);
+    EXPECT_EQ(timebase.findEnd(250, true), 3);
+    EXPECT_EQ(timebase.findEnd(400, true), 3);
+    EXPECT_EQ(timebase.findEnd(50, false), 0);
+}
+
+TEST(SampleStore, columnValues)
+{
+    SampleColumn column16(SampleColumn::TYPE_16BIT);
+    SampleColumn column32(SampleColumn::TYPE_32BIT);
+    SampleColumn columnDouble(SampleColumn::TYPE_DOUBLE);
+
+    column16.append(0x1234, true);
+    column16.append(0xFFFF, false);
+    column32.append(0x12345678, true);
+    columnDouble.appendDouble(1.5, true);
+
+    EXPECT_EQ(column16.size(), 2);
+    EXPECT_EQ(column16.rawValue(0), 0x1234u);
+    EXPECT_TRUE(column16.isValid(0));
+    EXPECT_FALSE(column16.isValid(1));
+
+    EXPECT_EQ(column32.rawValue(0), 0x12345678u);
+    EXPECT_EQ(columnDouble.doubleValue(0), 1.5);
+}
+
+TEST(SampleStore, columnValidityChunks)
+{
+    SampleColumn column(SampleColumn::TYPE_16BIT);
+    const qint32 count = SampleColumn::cChunkSize + 20;
+
+    column.appendInvalid(SampleColumn::cChunkSize - 1);
+    for (qint32 idx = column.size(); idx < count; idx++)
+    {
+        column.append(static_cast<quint32>(idx), (idx % 2) == 0);
+    }
+
+    ASSERT_EQ(column.size(), count);
+    EXPECT_FALSE(column.isValid(0));
+    EXPECT_FALSE(column.isValid(SampleColumn::cChunkSize - 2));
+    EXPECT_FALSE(column.isValid(SampleColumn::cChunkSize - 1));
+    EXPECT_TRUE(column.isValid(SampleColumn::cChunkSize));
+    EXPECT_EQ(column.rawValue(SampleColumn::cChunkSize), static_cast<quint32>(SampleColumn::cChunkSize));
+    EXPECT_EQ(column.rawValue(count - 1), static_cast<quint32>(count - 1));
+}
+
+TEST(SampleStore, columnMissing)
+{
+    SampleColumn column(SampleColumn::TYPE_16BIT);
+    const qint32 missingCount = SampleColumn::cChunkSize * 3 + 5;
+
+    /* Rows before first sample aren't stored */
+    column.appendMissing(missingCount);
+    EXPECT_EQ(column.size(), missingCount);
+    EXPECT_EQ(column.memorySize(), 0);
+    EXPECT_EQ(column.firstStoredChunk(), 3);
+
+    column.append(0x1234, true);
+    column.append(0x5678, false);
+
+    ASSERT_EQ(column.size(), missingCount + 2);
+    EXPECT_TRUE(column.isMissing(0));
+    EXPECT_TRUE(column.isMissing(missingCount - 1));
+    EXPECT_FALSE(column.isValid(missingCount - 1));
+    EXPECT_EQ(column.rawValue(10), 0u);
+    EXPECT_FALSE(column.isMissing(missingCount));
+    EXPECT_EQ(column.rawValue(missingCount), 0x1234u);
+
+    /* Error isn't missing */
+    EXPECT_FALSE(column.isValid(missingCount + 1));
+    EXPECT_FALSE(column.isMissing(missingCount + 1));
+
+    /* Gap of complete chunks only uses memory for the chunk of the next sample */
+    const qint64 memorySize = column.memorySize();
+    const qint32 gapBegin = column.size();
+    column.appendMissing(SampleColumn::cChunkSize * 4);
+    column.append(0x4321, true);
+
+    const qint64 chunkBytes = SampleColumn::cChunkSize * SampleColumn::valueSize(SampleColumn::TYPE_16BIT) + SampleColumn::cChunkSize / 8;
+    EXPECT_LE(column.memorySize(), memorySize + 2 * chunkBytes);
+    EXPECT_TRUE(column.isMissing(gapBegin));
+    EXPECT_TRUE(column.isMissing(column.size() - 2));
+    EXPECT_FALSE(column.isMissing(column.size() - 1));
+    EXPECT_EQ(column.rawValue(column.size() - 1), 0x4321u);
+
+    /* Start offset and gaps move along with removed chunks */
+    column.removeFirstChunk();
+    EXPECT_EQ(column.firstStoredChunk(), 2);
+    EXPECT_EQ(column.rawValue(missingCount - SampleColumn::cChunkSize), 0x1234u);
+    EXPECT_TRUE(column.isMissing(gapBegin - SampleColumn::cChunkSize));
+
+    column.clear();
+    EXPECT_EQ(column.firstStoredChunk(), 0);
+    EXPECT_FALSE(column.isMissing(0));
+}
+
+TEST(SampleStore, series)
+{
+    QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+    QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_DOUBLE));
+
+    pTimebase->append(0);
+    pTimebase->append(10);
+    pColumn->appendInvalid(1);
+    pColumn->appendDouble(-5, true);
+    pTimebase->append(20);
+
+    /* Rows without value aren't part of series yet */
+    SampleSeries series(pTimebase, pColumn);
+    ASSERT_EQ(series.size(), 2);
+    EXPECT_EQ(series.value(0), 0.0);
+    EXPECT_EQ(series.value(1), -5.0);
+    EXPECT_EQ(series.findEnd(100, false), 2);
+
+    pColumn->appendDouble(3, true);
+    EXPECT_EQ(series.size(), 3);
+
+    bool bFound;
+    QCPRange range = series.valueRange(bFound);
+    EXPECT_TRUE(bFound);
+    EXPECT_EQ(range.lower, -5.0);
+    EXPECT_EQ(range.upper, 3.0);
+
+    EXPECT_TRUE(series.isSameTimebase(SampleSeries(pTimebase, pColumn)));
+    EXPECT_FALSE(series.isSameTimebase(SampleSeries()));
+    EXPECT_TRUE(SampleSeries().isEmpty());
+}
+
+TEST(SampleStore, removeFirstChunk)
+{
+    QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+    QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_16BIT));
+    const qint32 count = SampleTimebase::cChunkSize * 2 + 10;
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        pTimebase->append(idx);
+        pColumn->append(static_cast<quint32>(idx), true);
+    }
+
+    EXPECT_EQ(pTimebase->chunkCount(), 3);
+    EXPECT_EQ(pTimebase->memorySize(), 3 * SampleTimebase::cChunkSize * static_cast<qint64>(sizeof(double)));
+
+    pTimebase->removeFirstChunk();
+    pColumn->removeFirstChunk();
+
+    SampleSeries series(pTimebase, pColumn);
+    ASSERT_EQ(series.size(), count - SampleTimebase::cChunkSize);
+    EXPECT_EQ(series.key(0), static_cast<double>(SampleTimebase::cChunkSize));
+    EXPECT_EQ(series.value(0), static_cast<double>(SampleTimebase::cChunkSize));
+    EXPECT_EQ(series.findBegin(SampleTimebase::cChunkSize + 5, false), 5);
+
+    /* Chunk that is being filled is kept */
+    pTimebase->removeFirstChunk();
+    pTimebase->removeFirstChunk();
+    EXPECT_EQ(pTimebase->chunkCount(), 1);
+    EXPECT_EQ(pTimebase->size(), 10);
+    EXPECT_EQ(pTimebase->key(0), SampleTimebase::cChunkSize * 2.0);
+}
+
+TEST(SampleStore, pyramid)
+{
+    QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+    QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_DOUBLE));
+    SampleSeries series(pTimebase, pColumn);
+    SamplePyramid pyramid;
+
+    for (qint32 idx = 0; idx < 40; idx++)
+    {
+        pTimebase->append(idx);
+        pColumn->appendDouble(idx == 21 ? -10 : idx, true);
+    }
+
+    pyramid.update(series);
+
+    ASSERT_EQ(pyramid.size(), 40);
+    EXPECT_EQ(SamplePyramid::bucketSize(0), 4);
+    EXPECT_EQ(SamplePyramid::bucketSize(1), 16);
+    EXPECT_EQ(pyramid.bucketCount(0), 10);
+    EXPECT_EQ(pyramid.bucketCount(1), 3);
+
+    EXPECT_EQ(pyramid.minIndex(0, 0), 0);
+    EXPECT_EQ(pyramid.maxIndex(0, 0), 3);
+    EXPECT_EQ(pyramid.minIndex(0, 5), 21);
+    EXPECT_EQ(pyramid.minIndex(1, 1), 21);
+    EXPECT_EQ(pyramid.maxIndex(1, 1), 31);
+
+    /* Incomplete last bucket */
+    EXPECT_EQ(pyramid.minIndex(1, 2), 32);
+    EXPECT_EQ(pyramid.maxIndex(1, 2), 39);
+
+    /* Incremental update */
+    pTimebase->append(40);
+    pColumn->appendDouble(100, true);
+    pyramid.update(series);
+    EXPECT_EQ(pyramid.size(), 41);
+    EXPECT_EQ(pyramid.maxIndex(1, 2), 40);
+
+    EXPECT_EQ(pyramid.selectLevel(3), -1);
+    EXPECT_EQ(pyramid.selectLevel(20), 1);
+    EXPECT_EQ(pyramid.selectLevel(1e9), SamplePyramid::cLevelCount - 1);
+}
+
+TEST(SampleStore, pyramidMissing)
+{
+    QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+    QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_DOUBLE));
+    SampleSeries series(pTimebase, pColumn);
+    SamplePyramid pyramid;
+    const qint32 missingCount = SampleTimebase::cChunkSize * 2 + 2;
+
+    for (qint32 idx = 0; idx < missingCount + 10; idx++)
+    {
+        pTimebase->append(idx);
+    }
+
+    /* Graph added during logging */
+    pColumn->appendMissing(missingCount);
+    for (qint32 idx = missingCount; idx < pTimebase->size(); idx++)
+    {
+        pColumn->appendDouble(idx == missingCount + 1 ? -10 : 5, true);
+    }
+
+    EXPECT_TRUE(qIsNaN(series.value(0)));
+    EXPECT_EQ(series.value(missingCount), 5.0);
+
+    bool bFound;
+    QCPRange range = series.valueRange(bFound);
+    EXPECT_TRUE(bFound);
+    EXPECT_EQ(range.lower, -10.0);
+    EXPECT_EQ(range.upper, 5.0);
+
+    pyramid.update(series);
+    ASSERT_EQ(pyramid.size(), pTimebase->size());
+
+    /* Missing sample is only used when bucket has no other samples */
+    EXPECT_EQ(pyramid.minIndex(1, 0), 0);
+    EXPECT_EQ(pyramid.minIndex(0, missingCount / 4), missingCount + 1);
+    EXPECT_EQ(pyramid.maxIndex(0, missingCount / 4), missingCount);
+
+    pyramid.removeFirstChunk();
+    EXPECT_EQ(pyramid.size(), pTimebase->size() - SampleTimebase::cChunkSize);
+}
+
+TEST(SampleStore, spillToDisk)
+{
+    QTemporaryDir sessionDir;
+    ASSERT_TRUE(sessionDir.isValid());
+
+    QSharedPointer<SampleSpillFile> pSpillFile = QSharedPointer<SampleSpillFile>(new SampleSpillFile(sessionDir.path()));
+    ASSERT_TRUE(pSpillFile->isOpen());
+
+    SampleTimebase timebase;
+    SampleColumn column(SampleColumn::TYPE_32BIT);
+    const qint32 count = SampleTimebase::cChunkSize * 5 + 10;
+
+    timebase.setSpillFile(pSpillFile);
+    column.setSpillFile(pSpillFile);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        timebase.append(idx);
+        column.append(static_cast<quint32>(idx) * 3, (idx % 3) != 0);
+    }
+
+    /* Only most recent chunks are kept in memory */
+    EXPECT_EQ(timebase.chunkCount(), 6);
+    EXPECT_EQ(timebase.memorySize(), 2 * SampleTimebase::cChunkSize * static_cast<qint64>(sizeof(double)));
+    EXPECT_GT(pSpillFile->size(), 0);
+
+    for (qint32 idx = 0; idx < count; idx += 997)
+    {
+        EXPECT_EQ(timebase.key(idx), static_cast<double>(idx));
+        EXPECT_EQ(column.rawValue(idx), static_cast<quint32>(idx) * 3);
+        EXPECT_EQ(column.isValid(idx), (idx % 3) != 0);
+    }
+
+    /* Spilled chunks can be removed as well */
+    timebase.removeFirstChunk();
+    column.removeFirstChunk();
+    EXPECT_EQ(timebase.key(0), static_cast<double>(SampleTimebase::cChunkSize));
+    EXPECT_EQ(column.rawValue(0), static_cast<quint32>(SampleTimebase::cChunkSize) * 3);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QTemporaryDir>
+
+#include "src/importexport/sessionfile.h"
+
+using namespace testing;
+
+namespace SessionFileTest
+{
+    const qint32 cCount = SampleTimebase::cChunkSize * 3 + 100;
+    const qint32 cLateStart = SampleTimebase::cChunkSize + 10;
+
+    /* Graph with compressed samples, graph that starts later (missing rows) and filtered graph with own time column */
+    SessionFile::SessionData createSession()
+    {
+        SessionFile::SessionData sessionData;
+
+        QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+        QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_16BIT));
+        QSharedPointer<SampleColumn> pLateColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_32BIT));
+
+        pTimebase->setCompressed(true);
+        pColumn->setCompressed(true);
+
+        pLateColumn->appendMissing(cLateStart);
+
+        for (qint32 idx = 0; idx < cCount; idx++)
+        {
+            pTimebase->append(idx * 10);
+            pColumn->append(static_cast<quint32>(idx % 100), (idx % 7) != 0);
+
+            if (idx >= cLateStart)
+            {
+                pLateColumn->append(static_cast<quint32>(idx) * 1000, true);
+            }
+        }
+
+        QSharedPointer<SampleTimebase> pFilterTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+        QSharedPointer<SampleColumn> pFilterColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_16BIT));
+        pFilterTimebase->append(0);
+        pFilterColumn->append(5, true);
+        pFilterTimebase->append(500);
+        pFilterColumn->append(9, true);
+
+        GraphData graphData;
+        graphData.setLabel("Pressure");
+        graphData.setRegisterAddress(40001);
+        graphData.setMultiplyFactor(2.5);
+        graphData.setSampleColumn(pTimebase, pColumn);
+        sessionData.graphList.append(graphData);
+
+        GraphData lateGraphData;
+        lateGraphData.setLabel("Energy");
+        lateGraphData.setRegisterAddress(40010);
+        lateGraphData.setValueType(GraphData::VALUE_32BIT);
+        lateGraphData.setSampleColumn(pTimebase, pLateColumn);
+        sessionData.graphList.append(lateGraphData);
+
+        GraphData filterGraphData;
+        filterGraphData.setLabel("Temperature");
+        filterGraphData.setRegisterAddress(40020);
+        filterGraphData.setConnectionId(1);
+        filterGraphData.setIngestFilter(IngestFilter(IngestFilter::FILTER_DEADBAND, 0.5));
+        filterGraphData.setSampleColumn(pFilterTimebase, pFilterColumn);
+        sessionData.graphList.append(filterGraphData);
+
+        /* Inactive graph without samples */
+        GraphData emptyGraphData;
+        emptyGraphData.setLabel("Unused");
+        emptyGraphData.setActive(false);
+        sessionData.graphList.append(emptyGraphData);
+
+        sessionData.timebaseList.append(pTimebase);
+        sessionData.timebaseList.append(QSharedPointer<SampleTimebase>(new SampleTimebase()));
+
+        Note note;
+        note.setKeyData(1234);
+        note.setValueData(5.5);
+        note.setText("Valve opened");
+        sessionData.noteList.append(note);
+
+        sessionData.bMarkers = true;
+        sessionData.startMarkerPos = 100;
+        sessionData.endMarkerPos = 2000;
+
+        return sessionData;
+    }
+}
+
+TEST(SessionFile, roundTrip)
+{
+    QTemporaryDir dir;
+    const QString filePath = dir.filePath("session.mbss");
+
+    SessionFile writer;
+    ASSERT_TRUE(writer.write(filePath, SessionFileTest::createSession()));
+
+    SessionFile reader;
+    SessionFile::SessionData sessionData;
+    ASSERT_TRUE(reader.read(filePath, &sessionData));
+
+    ASSERT_EQ(sessionData.graphList.size(), 4);
+    ASSERT_EQ(sessionData.timebaseList.size(), 2);
+
+    const GraphData &graphData = sessionData.graphList[0];
+    EXPECT_EQ(graphData.label(), QString("Pressure"));
+    EXPECT_EQ(graphData.registerAddress(), 40001);
+    EXPECT_EQ(graphData.multiplyFactor(), 2.5);
+    EXPECT_EQ(graphData.sampleTimebase(), sessionData.timebaseList[0]);
+
+    const QSharedPointer<SampleTimebase> pTimebase = graphData.sampleTimebase();
+    const QSharedPointer<SampleColumn> pColumn = graphData.sampleColumn();
+    ASSERT_EQ(pTimebase->size(), SessionFileTest::cCount);
+    ASSERT_EQ(pColumn->size(), SessionFileTest::cCount);
+
+    for (qint32 idx = 0; idx < SessionFileTest::cCount; idx += 97)
+    {
+        EXPECT_EQ(pTimebase->key(idx), idx * 10.0);
+        EXPECT_EQ(pColumn->rawValue(idx), static_cast<quint32>(idx % 100));
+        EXPECT_EQ(pColumn->isValid(idx), (idx % 7) != 0);
+    }
+    EXPECT_EQ(pTimebase->findBegin(12345.0, false), 1235);
+
+    const QSharedPointer<SampleColumn> pLateColumn = sessionData.graphList[1].sampleColumn();
+    EXPECT_EQ(sessionData.graphList[1].valueType(), GraphData::VALUE_32BIT);
+    EXPECT_EQ(sessionData.graphList[1].sampleTimebase(), pTimebase);
+    EXPECT_TRUE(pLateColumn->isMissing(SessionFileTest::cLateStart - 1));
+    EXPECT_FALSE(pLateColumn->isMissing(SessionFileTest::cLateStart));
+    EXPECT_EQ(pLateColumn->rawValue(SessionFileTest::cCount - 1), static_cast<quint32>(SessionFileTest::cCount - 1) * 1000);
+
+    /* Own time column of filtered graph */
+    const GraphData &filterGraphData = sessionData.graphList[2];
+    EXPECT_EQ(filterGraphData.ingestFilter(), IngestFilter(IngestFilter::FILTER_DEADBAND, 0.5));
+    EXPECT_EQ(filterGraphData.connectionId(), 1);
+    ASSERT_EQ(filterGraphData.sampleTimebase()->size(), 2);
+    EXPECT_NE(filterGraphData.sampleTimebase(), sessionData.timebaseList[1]);
+    EXPECT_EQ(filterGraphData.sampleTimebase()->key(1), 500.0);
+    EXPECT_EQ(filterGraphData.sampleColumn()->rawValue(1), 9u);
+
+    EXPECT_FALSE(sessionData.graphList[3].isActive());
+    EXPECT_TRUE(sessionData.graphList[3].sampleColumn().isNull());
+
+    ASSERT_EQ(sessionData.noteList.size(), 1);
+    EXPECT_EQ(sessionData.noteList[0].text(), QString("Valve opened"));
+    EXPECT_EQ(sessionData.noteList[0].keyData(), 1234.0);
+
+    EXPECT_TRUE(sessionData.bMarkers);
+    EXPECT_EQ(sessionData.startMarkerPos, 100.0);
+    EXPECT_EQ(sessionData.endMarkerPos, 2000.0);
+}
+
+TEST(SessionFile, appendAfterRestore)
+{
+    QTemporaryDir dir;
+    const QString filePath = dir.filePath("session.mbss");
+
+    SessionFile writer;
+    ASSERT_TRUE(writer.write(filePath, SessionFileTest::createSession()));
+
+    SessionFile reader;
+    SessionFile::SessionData sessionData;
+    ASSERT_TRUE(reader.read(filePath, &sessionData));
+
+    /* Mapped chunks are read-only, last chunk is copied to memory */
+    const QSharedPointer<SampleTimebase> pTimebase = sessionData.graphList[0].sampleTimebase();
+    const QSharedPointer<SampleColumn> pColumn = sessionData.graphList[0].sampleColumn();
+
+    pTimebase->append(SessionFileTest::cCount * 10);
+    pColumn->append(77, true);
+
+    EXPECT_EQ(pTimebase->size(), SessionFileTest::cCount + 1);
+    EXPECT_EQ(pTimebase->key(SessionFileTest::cCount), SessionFileTest::cCount * 10.0);
+    EXPECT_EQ(pTimebase->key(SessionFileTest::cCount - 1), (SessionFileTest::cCount - 1) * 10.0);
+    EXPECT_EQ(pColumn->rawValue(SessionFileTest::cCount), 77u);
+
+    /* Snapshot can be written again while it is mapped */
+    ASSERT_TRUE(writer.write(filePath, sessionData));
+    EXPECT_EQ(pTimebase->key(100), 1000.0);
+
+    SessionFile rereader;
+    SessionFile::SessionData rereadData;
+    ASSERT_TRUE(rereader.read(filePath, &rereadData));
+    EXPECT_EQ(rereadData.graphList[0].sampleTimebase()->size(), SessionFileTest::cCount + 1);
+}
+
+TEST(SessionFile, invalidFile)
+{
+    QTemporaryDir dir;
+    const QString filePath = dir.filePath("session.mbss");
+
+    SessionFile sessionFile;
+    SessionFile::SessionData sessionData;
+
+    EXPECT_FALSE(sessionFile.read(dir.filePath("missing.mbss"), &sessionData));
+
+    QFile textFile(filePath);
+    ASSERT_TRUE(textFile.open(QIODevice::WriteOnly));
+    textFile.write(QByteArray("Time (ms);Register 1\n0;1\n10;2\n"));
+    textFile.close();
+
+    EXPECT_FALSE(sessionFile.read(filePath, &sessionData));
+    EXPECT_FALSE(sessionFile.errorString().isEmpty());
+
+    /* Truncated snapshot */
+    ASSERT_TRUE(sessionFile.write(filePath, SessionFileTest::createSession()));
+
+    QFile snapshotFile(filePath);
+    ASSERT_TRUE(snapshotFile.resize(snapshotFile.size() / 2));
+
+    EXPECT_FALSE(sessionFile.read(filePath, &sessionData));
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QtNumeric>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/models/signalfilter.h"
+
+using namespace testing;
+
+namespace SignalFilterTest
+{
+    double process(SignalFilter * pFilter, double key, double value)
+    {
+        double result = 0;
+
+        EXPECT_TRUE(pFilter->process(key, value, &result));
+
+        return result;
+    }
+
+    void addSample(GraphDataModel * pGraphDataModel, double key, bool bSuccess, quint32 rawValue)
+    {
+        pGraphDataModel->addSamples(QList<double>() << key, QList<bool>() << bSuccess, QList<quint32>() << rawValue);
+    }
+}
+
+TEST(SignalFilter, movingAverage)
+{
+    SignalFilter filter(SignalFilter::FILTER_MOVING_AVERAGE, 3);
+
+    /* Window isn't filled yet */
+    EXPECT_EQ(SignalFilterTest::process(&filter, 0, 1), 1.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 1, 2), 1.5);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 2, 3), 2.0);
+
+    EXPECT_EQ(SignalFilterTest::process(&filter, 3, 4), 3.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 4, 11), 6.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 5, 3), 6.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 6, 7), 7.0);
+
+    filter.reset();
+    EXPECT_EQ(SignalFilterTest::process(&filter, 7, 5), 5.0);
+}
+
+TEST(SignalFilter, exponential)
+{
+    SignalFilter filter(SignalFilter::FILTER_EXPONENTIAL, 0.5);
+
+    EXPECT_EQ(SignalFilterTest::process(&filter, 0, 10), 10.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 100, 20), 15.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 200, 20), 17.5);
+}
+
+TEST(SignalFilter, lowPass)
+{
+    /* Time constant of 1 s */
+    SignalFilter filter(SignalFilter::FILTER_LOW_PASS, 1);
+
+    EXPECT_EQ(SignalFilterTest::process(&filter, 0, 0), 0.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 1000, 10), 5.0);
+
+    /* Same key */
+    EXPECT_EQ(SignalFilterTest::process(&filter, 1000, 100), 5.0);
+
+    EXPECT_EQ(SignalFilterTest::process(&filter, 4000, 25), 20.0);
+}
+
+TEST(SignalFilter, median)
+{
+    SignalFilter filter(SignalFilter::FILTER_MEDIAN, 3);
+
+    EXPECT_EQ(SignalFilterTest::process(&filter, 0, 1), 1.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 1, 100), 50.5);
+
+    /* Spike is removed */
+    EXPECT_EQ(SignalFilterTest::process(&filter, 2, 2), 2.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 3, 3), 3.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 4, 4), 3.0);
+    EXPECT_EQ(SignalFilterTest::process(&filter, 5, 4), 4.0);
+}
+
+TEST(SignalFilter, decimation)
+{
+    SignalFilter filter(SignalFilter::FILTER_DECIMATION, 2);
+    double result = 0;
+
+    EXPECT_TRUE(filter.isDecimating());
+
+    EXPECT_FALSE(filter.process(0, 1, &result));
+    ASSERT_TRUE(filter.process(1, 3, &result));
+    EXPECT_EQ(result, 2.0);
+
+    EXPECT_FALSE(filter.process(2, 5, &result));
+    ASSERT_TRUE(filter.process(3, 9, &result));
+    EXPECT_EQ(result, 7.0);
+}
+
+TEST(SignalFilter, notFinite)
+{
+    SignalFilter filter(SignalFilter::FILTER_MOVING_AVERAGE, 2);
+
+    EXPECT_EQ(SignalFilterTest::process(&filter, 0, 2), 2.0);
+    EXPECT_TRUE(qIsNaN(SignalFilterTest::process(&filter, 1, qQNaN())));
+
+    /* State isn't changed by NaN */
+    EXPECT_EQ(SignalFilterTest::process(&filter, 2, 4), 3.0);
+}
+
+TEST(SignalFilter, fromString)
+{
+    SignalFilter filter;
+
+    ASSERT_TRUE(SignalFilter::fromString("average 10", &filter));
+    EXPECT_EQ(filter.mode(), SignalFilter::FILTER_MOVING_AVERAGE);
+    EXPECT_EQ(filter.parameter(), 10.0);
+    EXPECT_EQ(filter.toString(), QString("average 10"));
+
+    ASSERT_TRUE(SignalFilter::fromString(" Exponential 0,25 ", &filter));
+    EXPECT_EQ(filter.mode(), SignalFilter::FILTER_EXPONENTIAL);
+    EXPECT_EQ(filter.toString(), QString("exponential 0.25"));
+
+    ASSERT_TRUE(SignalFilter::fromString("lowpass 1.5", &filter));
+    EXPECT_EQ(filter.mode(), SignalFilter::FILTER_LOW_PASS);
+
+    ASSERT_TRUE(SignalFilter::fromString("median 5", &filter));
+    EXPECT_EQ(filter.mode(), SignalFilter::FILTER_MEDIAN);
+
+    ASSERT_TRUE(SignalFilter::fromString("decimate 4", &filter));
+    EXPECT_EQ(filter.mode(), SignalFilter::FILTER_DECIMATION);
+
+    ASSERT_TRUE(SignalFilter::fromString("", &filter));
+    EXPECT_FALSE(filter.isEnabled());
+    EXPECT_EQ(filter.toString(), QString("none"));
+
+    EXPECT_FALSE(SignalFilter::fromString("average", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("average 1.5", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("average 0", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("median 256", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("exponential 0", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("exponential 1.5", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("lowpass -1", &filter));
+    EXPECT_FALSE(SignalFilter::fromString("highpass 1", &filter));
+}
+
+TEST(SignalFilter, rawSeriesKept)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.setSignalFilter(0, SignalFilter(SignalFilter::FILTER_MOVING_AVERAGE, 2));
+    graphDataModel.setRawSeriesKept(0, true);
+
+    SignalFilterTest::addSample(&graphDataModel, 0, true, 10);
+    SignalFilterTest::addSample(&graphDataModel, 100, true, 20);
+    SignalFilterTest::addSample(&graphDataModel, 200, false, 0);
+    SignalFilterTest::addSample(&graphDataModel, 300, true, 40);
+
+    const SampleSeries series = graphDataModel.series(0);
+    ASSERT_EQ(series.size(), 4);
+    EXPECT_EQ(series.value(0), 10.0);
+    EXPECT_EQ(series.value(1), 15.0);
+    EXPECT_FALSE(series.isValid(2));
+
+    /* Error isn't part of window */
+    EXPECT_EQ(series.value(3), 30.0);
+
+    const SampleSeries rawSeries = graphDataModel.rawSeries(0);
+    ASSERT_EQ(rawSeries.size(), 4);
+    EXPECT_TRUE(rawSeries.isSameTimebase(series));
+    EXPECT_EQ(rawSeries.value(1), 20.0);
+    EXPECT_EQ(rawSeries.value(3), 40.0);
+
+    /* Converted with settings of graph */
+    graphDataModel.setMultiplyFactor(0, 2);
+    EXPECT_EQ(graphDataModel.rawSeries(0).value(3), 80.0);
+
+    graphDataModel.setRawSeriesKept(0, false);
+    EXPECT_TRUE(graphDataModel.rawSeries(0).isEmpty());
+}
+
+TEST(SignalFilter, decimationOwnTimebase)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    graphDataModel.add();
+    graphDataModel.add();
+    graphDataModel.setSignalFilter(1, SignalFilter(SignalFilter::FILTER_DECIMATION, 3));
+
+    for (quint32 idx = 0; idx < 7; idx++)
+    {
+        graphDataModel.addSamples(QList<double>() << idx * 100 << idx * 100,
+                                  QList<bool>() << true << true,
+                                  QList<quint32>() << idx << idx);
+    }
+
+    EXPECT_EQ(graphDataModel.series(0).size(), 7);
+
+    const SampleSeries series = graphDataModel.series(1);
+    ASSERT_EQ(series.size(), 2);
+    EXPECT_FALSE(series.isSameTimebase(graphDataModel.series(0)));
+    EXPECT_EQ(series.key(0), 200.0);
+    EXPECT_EQ(series.value(0), 1.0);
+    EXPECT_EQ(series.key(1), 500.0);
+    EXPECT_EQ(series.value(1), 4.0);
+
+    EXPECT_GT(graphDataModel.memorySize(1), 0);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QtMath>
+
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/models/fftplan.h"
+#include "src/models/spectrumanalyzer.h"
+
+using namespace testing;
+
+namespace SpectrumAnalyzerTest
+{
+    /* Sine with amplitude and frequency (Hz) sampled every 10 ms (100 Hz), on top of offset */
+    double sample(qint32 idx, double amplitude, double frequency)
+    {
+        return 50 + amplitude * qSin(2 * M_PI * frequency * idx / 100);
+    }
+
+    qint32 peakBin(const QVector<double> &amplitudes)
+    {
+        qint32 peak = 0;
+        for (qint32 idx = 1; idx < amplitudes.size(); idx++)
+        {
+            if (amplitudes[idx] > amplitudes[peak])
+            {
+                peak = idx;
+            }
+        }
+
+        return peak;
+    }
+}
+
+TEST(FftPlan, compareWithDft)
+{
+    const qint32 size = 64;
+    FftPlan plan(size);
+
+    ASSERT_EQ(plan.size(), size);
+    ASSERT_EQ(plan.binCount(), size / 2 + 1);
+
+    QVector<double> input(size);
+    for (qint32 idx = 0; idx < size; idx++)
+    {
+        input[idx] = qSin(idx * 1.3) + (idx % 7) - 0.25 * (idx % 3);
+    }
+
+    QVector<double> real(plan.binCount());
+    QVector<double> imag(plan.binCount());
+    plan.transform(input.constData(), real.data(), imag.data());
+
+    for (qint32 bin = 0; bin < plan.binCount(); bin++)
+    {
+        double dftReal = 0;
+        double dftImag = 0;
+        for (qint32 idx = 0; idx < size; idx++)
+        {
+            dftReal += input[idx] * qCos(2 * M_PI * bin * idx / size);
+            dftImag -= input[idx] * qSin(2 * M_PI * bin * idx / size);
+        }
+
+        ASSERT_NEAR(real[bin], dftReal, 1e-9);
+        ASSERT_NEAR(imag[bin], dftImag, 1e-9);
+    }
+}
+
+TEST(FftPlan, invalidSize)
+{
+    EXPECT_EQ(FftPlan(0).size(), 0);
+    EXPECT_EQ(FftPlan(2).size(), 0);
+    EXPECT_EQ(FftPlan(48).size(), 0);
+    EXPECT_EQ(FftPlan(48).binCount(), 0);
+}
+
+TEST(SpectrumAnalyzer, stream)
+{
+    /* Rounded to power of two */
+    SpectrumAnalyzer analyzer(1000);
+    EXPECT_EQ(analyzer.windowSize(), 1024);
+    EXPECT_EQ(analyzer.hopSize(), 256);
+    EXPECT_FALSE(analyzer.hasSpectrum());
+
+    /* 6.25 Hz is bin 64 with resolution of 100 Hz / 1024 */
+    qint32 dueCount = 0;
+    for (qint32 idx = 0; idx < 2048; idx++)
+    {
+        if (analyzer.add(idx * 10.0, SpectrumAnalyzerTest::sample(idx, 3, 6.25)))
+        {
+            /* First spectrum after first hop, window is zero padded */
+            if (dueCount == 0)
+            {
+                EXPECT_EQ(idx, 255);
+            }
+
+            dueCount++;
+            analyzer.update();
+        }
+    }
+
+    EXPECT_EQ(dueCount, 8);
+    EXPECT_EQ(analyzer.sampleCount(), 1024);
+
+    ASSERT_TRUE(analyzer.hasSpectrum());
+    ASSERT_EQ(analyzer.amplitudes().size(), 513);
+    EXPECT_DOUBLE_EQ(analyzer.frequencyResolution(), 100.0 / 1024);
+    EXPECT_EQ(SpectrumAnalyzerTest::peakBin(analyzer.amplitudes()), 64);
+    EXPECT_NEAR(analyzer.amplitudes()[64], 3.0, 1e-9);
+
+    /* Mean is removed */
+    EXPECT_NEAR(analyzer.amplitudes()[0], 0.0, 1e-9);
+
+    /* No new spectrum before next hop */
+    EXPECT_FALSE(analyzer.add(20480, 50));
+
+    analyzer.setWindowSize(256);
+    EXPECT_EQ(analyzer.sampleCount(), 0);
+    EXPECT_FALSE(analyzer.hasSpectrum());
+}
+
+TEST(SpectrumAnalyzer, markerRange)
+{
+    SettingsModel settingsModel;
+    GraphDataModel graphDataModel(&settingsModel);
+
+    QList<double> timeData;
+    QList<double> valueData;
+    for (qint32 idx = 0; idx < 10000; idx++)
+    {
+        timeData.append(idx * 10.0);
+        valueData.append(SpectrumAnalyzerTest::sample(idx, 2, 12.5));
+    }
+
+    graphDataModel.add(QStringList() << "Sine", timeData, QList<QList<double> >() << timeData << valueData);
+
+    const SampleSeries series = graphDataModel.series(0);
+    SpectrumAnalyzer analyzer(256);
+
+    /* 4001 samples between markers (order doesn't matter): windows overlap by half */
+    EXPECT_EQ(analyzer.analyze(series, 50000, 10000), 30);
+    EXPECT_EQ(analyzer.segmentCount(), 30);
+    EXPECT_DOUBLE_EQ(analyzer.frequencyResolution(), 100.0 / 256);
+
+    /* 12.5 Hz is bin 32 */
+    EXPECT_EQ(SpectrumAnalyzerTest::peakBin(analyzer.amplitudes()), 32);
+    EXPECT_NEAR(analyzer.amplitudes()[32], 2.0, 1e-9);
+
+    /* Range shorter than window is zero padded */
+    EXPECT_EQ(analyzer.analyze(series, 0, 1000), 1);
+    EXPECT_DOUBLE_EQ(analyzer.frequencyResolution(), 100.0 / 256);
+
+    /* Single sample */
+    EXPECT_EQ(analyzer.analyze(series, 0, 5), 0);
+    EXPECT_FALSE(analyzer.hasSpectrum());
+}
+
+TEST(SpectrumAnalyzer, hopUpdates)
+{
+    SpectrumAnalyzer analyzer(256);
+    ASSERT_EQ(analyzer.hopSize(), 64);
+
+    /* 6.25 Hz is bin 16 with resolution of 100 Hz / 256 */
+    const qint32 spectrumCount = 8;
+    const qint32 sampleCount = analyzer.windowSize() + spectrumCount * analyzer.hopSize();
+    qint32 updateCount = 0;
+
+    for (qint32 idx = 0; idx < sampleCount; idx++)
+    {
+        if (analyzer.add(idx * 10.0, SpectrumAnalyzerTest::sample(idx, 1, 6.25)))
+        {
+            analyzer.update();
+            updateCount++;
+        }
+    }
+
+    /* Every hop, including the zero padded windows before the window is filled */
+    EXPECT_EQ(updateCount, 4 + spectrumCount);
+
+    ASSERT_TRUE(analyzer.hasSpectrum());
+    ASSERT_EQ(analyzer.amplitudes().size(), 129);
+    EXPECT_EQ(SpectrumAnalyzerTest::peakBin(analyzer.amplitudes()), 16);
+    EXPECT_NEAR(analyzer.amplitudes()[16], 1.0, 1e-9);
+    EXPECT_NEAR(analyzer.amplitudes()[0], 0.0, 1e-9);
+}
+
+/* Large windows take long in a debug build, run with --gtest_also_run_disabled_tests */
+TEST(SpectrumAnalyzer, DISABLED_largeWindow)
+{
+    const QList<qint32> windowSizes = QList<qint32>() << 4096 << 65536 << 1048576;
+
+    for (qint32 sizeIdx = 0; sizeIdx < windowSizes.size(); sizeIdx++)
+    {
+        SpectrumAnalyzer analyzer(windowSizes[sizeIdx]);
+        ASSERT_EQ(analyzer.windowSize(), windowSizes[sizeIdx]);
+
+        const qint32 sampleCount = analyzer.windowSize() + analyzer.hopSize();
+        for (qint32 idx = 0; idx < sampleCount; idx++)
+        {
+            if (analyzer.add(idx * 10.0, SpectrumAnalyzerTest::sample(idx, 1, 6.25)))
+            {
+                analyzer.update();
+            }
+        }
+
+        /* 6.25 Hz is in the center of a bin for every window size */
+        const qint32 bin = analyzer.windowSize() / 16;
+
+        ASSERT_TRUE(analyzer.hasSpectrum());
+        EXPECT_EQ(SpectrumAnalyzerTest::peakBin(analyzer.amplitudes()), bin);
+        EXPECT_NEAR(analyzer.amplitudes()[bin], 1.0, 1e-6);
+    }
+}
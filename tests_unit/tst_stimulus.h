@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "src/models/stimulus.h"
+
+using namespace testing;
+
+TEST(Stimulus, step)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::STEP);
+    stimulus.setStartTime(1000);
+    stimulus.setInitialValue(10);
+    stimulus.setFinalValue(20);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 0);
+    EXPECT_EQ(stimulus.nextWriteTime(1), 1000);
+    EXPECT_EQ(stimulus.nextWriteTime(1000), 1000);
+    EXPECT_EQ(stimulus.nextWriteTime(1001), -1);
+
+    EXPECT_EQ(stimulus.registerValue(0), 10);
+    EXPECT_EQ(stimulus.registerValue(999), 10);
+    EXPECT_EQ(stimulus.registerValue(1000), 20);
+}
+
+TEST(Stimulus, stepAtStart)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::STEP);
+    stimulus.setStartTime(0);
+    stimulus.setFinalValue(5);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 0);
+    EXPECT_EQ(stimulus.nextWriteTime(1), -1);
+
+    EXPECT_EQ(stimulus.registerValue(0), 5);
+}
+
+TEST(Stimulus, ramp)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::RAMP);
+    stimulus.setStartTime(1000);
+    stimulus.setDuration(1000);
+    stimulus.setInterval(300);
+    stimulus.setInitialValue(0);
+    stimulus.setFinalValue(100);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 0);
+    EXPECT_EQ(stimulus.nextWriteTime(1), 1000);
+    EXPECT_EQ(stimulus.nextWriteTime(1001), 1300);
+    EXPECT_EQ(stimulus.nextWriteTime(1300), 1300);
+    EXPECT_EQ(stimulus.nextWriteTime(1901), 2000);
+    EXPECT_EQ(stimulus.nextWriteTime(2001), -1);
+
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(500), 0);
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(1500), 50);
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(2000), 100);
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(5000), 100);
+}
+
+TEST(Stimulus, rampWithoutDuration)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::RAMP);
+    stimulus.setStartTime(500);
+    stimulus.setInitialValue(1);
+    stimulus.setFinalValue(2);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 0);
+    EXPECT_EQ(stimulus.nextWriteTime(1), 500);
+    EXPECT_EQ(stimulus.nextWriteTime(501), -1);
+
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(500), 2);
+}
+
+TEST(Stimulus, sine)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::SINE);
+    stimulus.setInterval(100);
+    stimulus.setPeriod(1000);
+    stimulus.setOffset(5);
+    stimulus.setAmplitude(10);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 0);
+    EXPECT_EQ(stimulus.nextWriteTime(1), 100);
+    EXPECT_EQ(stimulus.nextWriteTime(250), 300);
+    EXPECT_EQ(stimulus.nextWriteTime(100000), 100000);
+
+    EXPECT_NEAR(stimulus.valueAt(0), 5, 1e-9);
+    EXPECT_NEAR(stimulus.valueAt(250), 15, 1e-9);
+    EXPECT_NEAR(stimulus.valueAt(750), -5, 1e-9);
+}
+
+TEST(Stimulus, sineDuration)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::SINE);
+    stimulus.setStartTime(100);
+    stimulus.setDuration(250);
+    stimulus.setInterval(100);
+    stimulus.setPeriod(1000);
+    stimulus.setAmplitude(10);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 100);
+    EXPECT_EQ(stimulus.nextWriteTime(301), 350);
+    EXPECT_EQ(stimulus.nextWriteTime(351), -1);
+
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(350), 0);
+}
+
+TEST(Stimulus, sineNegativeRegisterValue)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::SINE);
+    stimulus.setInterval(100);
+    stimulus.setPeriod(1000);
+    stimulus.setAmplitude(10);
+
+    EXPECT_EQ(stimulus.registerValue(750), static_cast<quint16>(-10));
+}
+
+TEST(Stimulus, table)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::TABLE);
+    stimulus.addTablePoint(1500, 2);
+    stimulus.addTablePoint(500, 1);
+
+    EXPECT_EQ(stimulus.nextWriteTime(0), 500);
+    EXPECT_EQ(stimulus.nextWriteTime(501), 1500);
+    EXPECT_EQ(stimulus.nextWriteTime(1501), -1);
+
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(0), 1);
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(1000), 1);
+    EXPECT_DOUBLE_EQ(stimulus.valueAt(2000), 2);
+}
+
+TEST(Stimulus, invalid)
+{
+    Stimulus stimulus;
+    stimulus.setType(Stimulus::SINE);
+    stimulus.setPeriod(0);
+
+    EXPECT_FALSE(stimulus.isValid());
+    EXPECT_EQ(stimulus.nextWriteTime(0), -1);
+
+    stimulus.setType(Stimulus::TABLE);
+
+    EXPECT_FALSE(stimulus.isValid());
+}
+
+TEST(Stimulus, typeString)
+{
+    Stimulus::Type type = Stimulus::STEP;
+
+    EXPECT_TRUE(Stimulus::stringToType("Ramp", &type));
+    EXPECT_EQ(type, Stimulus::RAMP);
+
+    EXPECT_TRUE(Stimulus::stringToType(Stimulus::typeToString(Stimulus::TABLE), &type));
+    EXPECT_EQ(type, Stimulus::TABLE);
+
+    EXPECT_FALSE(Stimulus::stringToType("square", &type));
+}
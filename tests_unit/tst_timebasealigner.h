@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "src/models/timebasealigner.h"
+
+using namespace testing;
+
+SampleSeries createAlignerData(QSharedPointer<SampleTimebase> pTimebase, QSharedPointer<SampleColumn> pColumn)
+{
+    pTimebase->append(100);
+    pColumn->appendDouble(10, true);
+    pTimebase->append(200);
+    pColumn->appendDouble(20, true);
+    pTimebase->append(300);
+    pColumn->appendDouble(40, true);
+
+    return SampleSeries(pTimebase, pColumn);
+}
+
+SampleSeries createAlignerData()
+{
+    return createAlignerData(QSharedPointer<SampleTimebase>(new SampleTimebase()),
+                             QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_DOUBLE)));
+}
+
+TEST(TimebaseAligner, empty)
+{
+    SampleSeries series;
+    qint32 cursor = 5;
+
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 100, false, &cursor), 0);
+    EXPECT_EQ(cursor, -1);
+}
+
+TEST(TimebaseAligner, zeroOrderHold)
+{
+    SampleSeries series = createAlignerData();
+
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 50, false), 10);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 100, false), 10);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 150, false), 10);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 200, false), 20);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 299, false), 20);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 1000, false), 40);
+}
+
+TEST(TimebaseAligner, linear)
+{
+    SampleSeries series = createAlignerData();
+
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 50, true), 10);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 150, true), 15);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 200, true), 20);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 250, true), 30);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 1000, true), 40);
+}
+
+TEST(TimebaseAligner, cursor)
+{
+    QSharedPointer<SampleTimebase> pTimebase = QSharedPointer<SampleTimebase>(new SampleTimebase());
+    QSharedPointer<SampleColumn> pColumn = QSharedPointer<SampleColumn>(new SampleColumn(SampleColumn::TYPE_DOUBLE));
+    SampleSeries series = createAlignerData(pTimebase, pColumn);
+    qint32 cursor = -1;
+
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 50, false, &cursor), 10);
+    EXPECT_EQ(cursor, -1);
+
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 210, false, &cursor), 20);
+    EXPECT_EQ(cursor, 1);
+
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 310, false, &cursor), 40);
+    EXPECT_EQ(cursor, 2);
+
+    /* Going back in time */
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 110, false, &cursor), 10);
+    EXPECT_EQ(cursor, 0);
+
+    /* Data added after cursor was set */
+    pTimebase->append(400);
+    pColumn->appendDouble(80, true);
+    EXPECT_DOUBLE_EQ(TimebaseAligner::alignedValue(series, 350, true, &cursor), 60);
+    EXPECT_EQ(cursor, 2);
+}
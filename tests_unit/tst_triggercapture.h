@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QSignalSpy>
+
+#include "src/models/triggercondition.h"
+#include "src/models/settingsmodel.h"
+#include "src/models/graphdatamodel.h"
+#include "src/communication/triggercapture.h"
+
+using namespace testing;
+
+TEST(TriggerCondition, level)
+{
+    TriggerCondition condition;
+    condition.setLevel(10);
+
+    condition.setType(TriggerCondition::ABOVE);
+    EXPECT_FALSE(condition.isMet(0, 10, 10));
+    EXPECT_TRUE(condition.isMet(11, 11, 11));
+
+    condition.setType(TriggerCondition::BELOW);
+    EXPECT_TRUE(condition.isMet(9, 9, 9));
+    EXPECT_FALSE(condition.isMet(10, 10, 10));
+}
+
+TEST(TriggerCondition, edge)
+{
+    TriggerCondition condition;
+    condition.setLevel(10);
+
+    condition.setType(TriggerCondition::RISING_EDGE);
+    EXPECT_TRUE(condition.isMet(9, 10, 10));
+    EXPECT_FALSE(condition.isMet(10, 11, 11));
+    EXPECT_FALSE(condition.isMet(11, 9, 9));
+
+    condition.setType(TriggerCondition::FALLING_EDGE);
+    EXPECT_TRUE(condition.isMet(11, 10, 10));
+    EXPECT_FALSE(condition.isMet(10, 9, 9));
+    EXPECT_FALSE(condition.isMet(9, 11, 11));
+}
+
+TEST(TriggerCondition, bit)
+{
+    TriggerCondition condition;
+    condition.setType(TriggerCondition::BIT_SET);
+    condition.setBit(3);
+
+    EXPECT_TRUE(condition.isMet(0, 8, 8));
+    EXPECT_TRUE(condition.isMet(0, 0xFF, 0xFF));
+    EXPECT_FALSE(condition.isMet(0, 7, 7));
+
+    /* Bit of raw register value, not of converted value (e.g. divided by 10) */
+    EXPECT_TRUE(condition.isMet(0, 0.8, 8));
+    EXPECT_FALSE(condition.isMet(0, 8, 80));
+
+    /* Bit of second register of pair */
+    condition.setBit(31);
+    EXPECT_TRUE(condition.isMet(0, -1, 0x80000000u));
+}
+
+TEST(TriggerCondition, typeString)
+{
+    TriggerCondition::Type type = TriggerCondition::ABOVE;
+
+    EXPECT_TRUE(TriggerCondition::stringToType("Falling", &type));
+    EXPECT_EQ(type, TriggerCondition::FALLING_EDGE);
+
+    EXPECT_FALSE(TriggerCondition::stringToType("edge", &type));
+}
+
+class TriggerCaptureTest : public Test
+{
+protected:
+    void SetUp()
+    {
+        _pSettingsModel = new SettingsModel();
+        _pGraphDataModel = new GraphDataModel(_pSettingsModel);
+
+        GraphData graphData;
+        graphData.setRegisterAddress(40001);
+        _pGraphDataModel->add(graphData);
+        graphData.setRegisterAddress(40002);
+        _pGraphDataModel->add(graphData);
+
+        TriggerCondition condition;
+        condition.setType(TriggerCondition::RISING_EDGE);
+        condition.setRegisterAddress(40002);
+        condition.setLevel(5);
+
+        _pSettingsModel->setPollTime(100);
+        _pSettingsModel->setTriggerCapture(true);
+        _pSettingsModel->setTriggerCondition(condition);
+        _pSettingsModel->setPreTriggerTime(300);
+        _pSettingsModel->setPostTriggerTime(200);
+    }
+
+    void TearDown()
+    {
+        delete _pGraphDataModel;
+        delete _pSettingsModel;
+    }
+
+    void addSample(TriggerCapture * pCapture, qint64 timestamp, double triggerValue)
+    {
+        pCapture->processSample(timestamp, QList<bool>() << true << true, QList<double>() << timestamp << triggerValue);
+    }
+
+    SettingsModel * _pSettingsModel;
+    GraphDataModel * _pGraphDataModel;
+};
+
+TEST_F(TriggerCaptureTest, disabled)
+{
+    _pSettingsModel->setTriggerCapture(false);
+
+    TriggerCapture capture(_pSettingsModel, _pGraphDataModel);
+    QSignalSpy spyReleased(&capture, &TriggerCapture::sampleReleased);
+
+    EXPECT_TRUE(capture.start());
+    EXPECT_EQ(capture.state(), TriggerCapture::DISABLED);
+
+    addSample(&capture, 0, 0);
+    addSample(&capture, 100, 10);
+
+    EXPECT_EQ(spyReleased.count(), 2);
+}
+
+TEST_F(TriggerCaptureTest, rawTimestamps)
+{
+    _pSettingsModel->setTriggerCapture(false);
+
+    TriggerCapture capture(_pSettingsModel, _pGraphDataModel);
+    QSignalSpy spyReleased(&capture, &TriggerCapture::sampleReleased);
+
+    EXPECT_TRUE(capture.start());
+
+    /* Without raw timestamps, all registers are sampled on sample timestamp */
+    addSample(&capture, 100, 0);
+
+    /* Raw timestamps are passed unchanged */
+    capture.processSample(200, QList<bool>() << true << true, QList<double>() << 0 << 0, QList<qint64>() << 180 << 195);
+
+    ASSERT_EQ(spyReleased.count(), 2);
+    EXPECT_EQ(spyReleased[0][3].value<QList<qint64> >(), QList<qint64>() << 100 << 100);
+    EXPECT_EQ(spyReleased[1][3].value<QList<qint64> >(), QList<qint64>() << 180 << 195);
+}
+
+TEST_F(TriggerCaptureTest, inactiveRegister)
+{
+    _pGraphDataModel->setActive(1, false);
+
+    TriggerCapture capture(_pSettingsModel, _pGraphDataModel);
+
+    EXPECT_FALSE(capture.start());
+    EXPECT_EQ(capture.state(), TriggerCapture::DISABLED);
+}
+
+TEST_F(TriggerCaptureTest, capture)
+{
+    TriggerCapture capture(_pSettingsModel, _pGraphDataModel);
+    QSignalSpy spyReleased(&capture, &TriggerCapture::sampleReleased);
+    QSignalSpy spyTriggered(&capture, &TriggerCapture::triggered);
+
+    EXPECT_TRUE(capture.start());
+    EXPECT_EQ(capture.state(), TriggerCapture::ARMED);
+
+    for (qint64 time = 0; time < 1000; time += 100)
+    {
+        addSample(&capture, time, 0);
+    }
+
+    EXPECT_EQ(spyReleased.count(), 0);
+
+    addSample(&capture, 1000, 6);
+
+    EXPECT_EQ(capture.state(), TriggerCapture::CAPTURING);
+    EXPECT_EQ(capture.eventCount(), 1u);
+    ASSERT_EQ(spyTriggered.count(), 1);
+    EXPECT_EQ(spyTriggered[0][0].toLongLong(), 1000);
+    EXPECT_DOUBLE_EQ(spyTriggered[0][1].toDouble(), 6);
+
+    /* Pre-trigger window (700 - 900) and trigger sample */
+    ASSERT_EQ(spyReleased.count(), 4);
+    EXPECT_EQ(spyReleased[0][0].toLongLong(), 700);
+    EXPECT_EQ(spyReleased[3][0].toLongLong(), 1000);
+
+    /* Post-trigger window */
+    addSample(&capture, 1100, 6);
+    addSample(&capture, 1200, 6);
+
+    EXPECT_EQ(spyReleased.count(), 6);
+    EXPECT_EQ(capture.state(), TriggerCapture::ARMED);
+
+    /* No new edge */
+    addSample(&capture, 1300, 6);
+
+    EXPECT_EQ(spyReleased.count(), 6);
+    EXPECT_EQ(spyTriggered.count(), 1);
+
+    /* New edge */
+    addSample(&capture, 1400, 0);
+    addSample(&capture, 1500, 7);
+
+    EXPECT_EQ(spyTriggered.count(), 2);
+    EXPECT_EQ(capture.eventCount(), 2u);
+    EXPECT_EQ(spyReleased.count(), 6 + 3);
+}
+
+TEST_F(TriggerCaptureTest, failedSampleIgnored)
+{
+    TriggerCapture capture(_pSettingsModel, _pGraphDataModel);
+    QSignalSpy spyTriggered(&capture, &TriggerCapture::triggered);
+
+    EXPECT_TRUE(capture.start());
+
+    addSample(&capture, 0, 0);
+    capture.processSample(100, QList<bool>() << true << false, QList<double>() << 0 << 10);
+    addSample(&capture, 200, 0);
+
+    EXPECT_EQ(spyTriggered.count(), 0);
+}
+
+TEST_F(TriggerCaptureTest, bitOnRawValue)
+{
+    TriggerCondition condition;
+    condition.setType(TriggerCondition::BIT_SET);
+    condition.setRegisterAddress(40002);
+    condition.setBit(2);
+    _pSettingsModel->setTriggerCondition(condition);
+
+    TriggerCapture capture(_pSettingsModel, _pGraphDataModel);
+    QSignalSpy spyTriggered(&capture, &TriggerCapture::triggered);
+
+    EXPECT_TRUE(capture.start());
+
+    /* Converted value has bit set, raw register value hasn't */
+    capture.processSample(0, QList<bool>() << true << true, QList<double>() << 0 << 4, QList<qint64>(), QList<quint32>() << 0 << 40);
+    EXPECT_EQ(spyTriggered.count(), 0);
+
+    capture.processSample(100, QList<bool>() << true << true, QList<double>() << 0 << 0.4, QList<qint64>(), QList<quint32>() << 0 << 4);
+    EXPECT_EQ(spyTriggered.count(), 1);
+}